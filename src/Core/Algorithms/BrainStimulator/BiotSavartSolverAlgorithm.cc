@@ -66,7 +66,8 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 			  numprocessors_(Parallel::NumCores()),
 			  barrier_("BSV KernelBase Barrier", numprocessors_),
 			  typeOut(t),
-			  matOut(0)
+			  matOut(0),
+			  openingAngle_(algo->get(Parameters::OpeningAngle).toDouble())
 			{
 			}
 			
@@ -106,6 +107,10 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 			DenseMatrix *matOut;
 			MatrixHandle matOutHandle;
 
+			//! opening angle of the multipole tree, zero sums directly
+			double openingAngle_;
+			std::unique_ptr<MultipoleTree> tree_;
+
 			bool PreIntegration( FieldHandle& mesh, FieldHandle& coil )
 			{
 					this->vmesh = mesh->vmesh();
@@ -224,6 +229,17 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 						coilNodes.push_back(Vector(enode2));
 					}
 
+					//! the coil is discretized once, for the direct sums and the tree alike
+					DiscretizeCoil();
+
+					if (openingAngle_ > 0.0)
+					{
+						std::vector<Vector> elemCurrents(elemSteps.size());
+						for (size_t e = 0; e < elemSteps.size(); e++)
+							elemCurrents[e] = elemSteps[e] * elemCurrentMagnitudes[e];
+						tree_.reset(new MultipoleTree(elemPositions, elemCurrents, openingAngle_));
+					}
+
 					//! Start the multi threaded
 					Parallel::RunTasks([this](int i) { ParallelKernel(i); }, numprocessors_);
 					
@@ -252,6 +268,59 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 
 				//! keep nodes on the coil cached
 				std::vector<Vector> coilNodes;
+
+				//! current elements of the discretized coil: midpoint, dL and |I|
+				std::vector<Point> elemPositions;
+				std::vector<Vector> elemSteps;
+				std::vector<double> elemCurrentMagnitudes;
+
+				//! Split the coil into the current elements I dL used by the
+				//! integration, located at the midpoints of the curve elements
+				void DiscretizeCoil()
+				{
+					elemPositions.clear();
+					elemSteps.clear();
+					elemCurrentMagnitudes.clear();
+
+					double current = 1.0;
+					double prevSegLen = 123456789.12345678;
+					int nips = 0;
+
+					for (size_t iC0 = 0, iC1 = 1, iCV = 0; iC0 < coilNodes.size(); iC0 += 2, iC1 += 2, iCV++)
+					{
+						vcoilField->get_value(current, iCV);
+						current = current == 0.0 ? 1.0 : current;
+
+						const Vector& coilNodeThis = current >= 0.0 ? coilNodes[iC0] : coilNodes[iC1];
+						const Vector& coilNodeNext = current >= 0.0 ? coilNodes[iC1] : coilNodes[iC0];
+
+						double newSegLen = (coilNodeNext - coilNodeThis).length();
+
+						if (extstep > 0)
+						{
+							nips = newSegLen / extstep;
+						}
+						else if (Abs(prevSegLen - newSegLen) > 0.00000001)
+						{
+							prevSegLen = newSegLen;
+							nips = AdjustNumberOfIntegrationPoints(newSegLen);
+						}
+
+						if (nips < 3)
+						{
+							algo_->warning("integration step too big");
+						}
+
+						for (int iip = 0; iip < nips - 1; iip++)
+						{
+							Vector p0 = Interpolate(coilNodeThis, coilNodeNext, static_cast<double>(iip) / static_cast<double>(nips));
+							Vector p1 = Interpolate(coilNodeThis, coilNodeNext, static_cast<double>(iip + 1) / static_cast<double>(nips));
+							elemPositions.push_back(Point((p0 + p1) / 2));
+							elemSteps.push_back(p1 - p0);
+							elemCurrentMagnitudes.push_back(Abs(current));
+						}
+					}
+				}
 				
 				//! execute in parallel
 				void ParallelKernel(int proc_num)
@@ -260,7 +329,6 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 					assert(proc_num >= 0);
 
 					int cnt = 0;
-					double current = 1.0; 
 					Point modelNode;
 
 					const index_type begins = (modelSize * proc_num) / numprocessors_;
@@ -268,16 +336,6 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 
 					assert( begins <= ends );
 
-					//! buffer of points used for integration
-					std::vector<Vector> integrPoints;
-					integrPoints.reserve(256);
-
-					//! keep previous step length
-					//! used for optimization purpose
-					double prevSegLen = 123456789.12345678;
-
-					//! number of integration points
-					int nips = 0;
 					index_type helpme=0;
 
 					try{
@@ -292,99 +350,43 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 							// result
 							Vector F;
 
-							for( size_t iC0 = 0, iC1 =1, iCV = 0; 
-								iC0 < coilNodes.size(); 
-								iC0+=2, iC1+=2, iCV++)
+							if (tree_)
 							{
-								vcoilField->get_value(current,iCV);
-
-								current = current == 0.0 ? 1.0 : current;
-
-								Vector coilNodeThis;
-								Vector coilNodeNext;
-
-								if(current >= 0.0)
-								{
-									coilNodeThis = coilNodes[iC0];
-									coilNodeNext = coilNodes[iC1];
-								}
-								else
-								{
-									coilNodeThis = coilNodes[iC1];
-									coilNodeNext = coilNodes[iC0];
-								}
-
-								//! Length of the curve element
-								Vector diffNodes = coilNodeNext - coilNodeThis;
-								double newSegLen = diffNodes.length();
+								//! A = 1e-7 sum I dL / R and B = curl A
+								if (typeOut == 1) F = 1.0e-7 * tree_->curl(modelNode);
+								if (typeOut == 2) F = 1.0e-7 * tree_->potential(modelNode);
+							}
+							else
+							//! integration over the current elements of the coil
+							for(size_t e = 0; e < elemPositions.size(); e++)
+							{
+								//! Vector connecting the infinitesimal curve-element			
+								Vector Rxyz = Vector(elemPositions[e]) - Vector(modelNode);
 
-								//first check if externally suplied integration step is available and use it
-								if(extstep > 0)
-								{
-									nips = newSegLen / extstep;
-								}
-								else
-								{
-									//! optimization
-									//! only rexompute integration step only if segment length changes
-									if( Abs(prevSegLen - newSegLen ) > 0.00000001 )
-									{
-										prevSegLen = newSegLen;
-
-										//auto adaptive integration step calculation
-										nips =  AdjustNumberOfIntegrationPoints(newSegLen);
-									}
-								}
+								//! Infinitesimal curve-element components
+								const Vector& dLxyz = elemSteps[e];
 
-								if( nips < 3 )
-								{
-									algo_->warning("integration step too big");
-								}
+								double Rn = Rxyz.length();
 								
-								integrPoints.clear();
-								
-								//! curve segment discretization
-								for(int iip = 0; iip < nips; iip++)
+								//! check for distance between coil and model close to zero
+								//! it might cause numerical stability issues with respect to the cross-product
+								if(Rn < 0.00001)
 								{
-									double interpolant = static_cast<double>(iip) / static_cast<double>(nips);
-									Vector v = Interpolate( coilNodeThis, coilNodeNext, interpolant );
-									integrPoints.push_back( v );
+									algo_->warning("coil<->model distance approaching zero!");
 								}
 
-
-								//! integration step over line segment				
-								for(int iip = 0; iip < nips -1; iip++)								
+								if(typeOut == 1)
 								{
-									//! Vector connecting the infinitesimal curve-element			
-									Vector Rxyz = (integrPoints[iip] + integrPoints[iip+1] ) / 2  - Vector(modelNode);
-
-									//! Infinitesimal curve-element components
-									Vector dLxyz = integrPoints[iip+1] - integrPoints[iip];
-
-									double Rn = Rxyz.length();
-									
-									//! check for distance between coil and model close to zero
-									//! it might cause numerical stability issues with respect to the cross-product
-									if(Rn < 0.00001)
-									{
-										algo_->warning("coil<->model distance approaching zero!");
-									}
-
-									if(typeOut == 1)
-									{
-										//! Biot-Savart Magnetic Field
-										F +=  1.0e-7 * Cross( Rxyz, dLxyz ) * ( Abs(current) / (Rn*Rn*Rn) );
-									
-									}	
+									//! Biot-Savart Magnetic Field
+									F +=  1.0e-7 * Cross( Rxyz, dLxyz ) * ( elemCurrentMagnitudes[e] / (Rn*Rn*Rn) );
 								
-									if(typeOut == 2)
-									{
-										//! Biot-Savart Magnetic Vector Potential Field
-										F += 1.0e-7 * dLxyz * ( Abs(current) / (Rn) );
-									}
-									
+								}	
+							
+								if(typeOut == 2)
+								{
+									//! Biot-Savart Magnetic Vector Potential Field
+									F += 1.0e-7 * dLxyz * ( elemCurrentMagnitudes[e] / (Rn) );
 								}
-
 							}
 
 							matOut->put(iM,0, F[0]);
@@ -605,7 +607,19 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 					
 					//needed?
 					vmesh->synchronize(Mesh::NODES_E | Mesh::EDGES_E);
-										
+
+					if (openingAngle_ > 0.0)
+					{
+						std::vector<Point> dipoleLocations(coilSize);
+						std::vector<Vector> dipoleMoments(coilSize);
+						for (VMesh::Elem::index_type iC = 0; iC < coilSize; iC++)
+						{
+							vcoilField->get_value(dipoleMoments[iC], iC);
+							vcoilField->get_center(dipoleLocations[iC], iC);
+						}
+						tree_.reset(new MultipoleTree(dipoleLocations, dipoleMoments, openingAngle_));
+					}
+
 
 					//! Start the multi threaded
 					Parallel::RunTasks([this](int i) { ParallelKernel(i); }, numprocessors_);
@@ -644,6 +658,13 @@ ALGORITHM_PARAMETER_DEF(BrainStimulator, OutType);
 							
 							double Rl;
 
+							if (tree_)
+							{
+								//! the dipole fields are grad div and -curl of sum m / R
+								if (typeOut == 1) F = 1.0e-7 * tree_->gradientOfDivergence(modelNode);
+								if (typeOut == 2) F = -1.0e-7 * tree_->curl(modelNode);
+							}
+							else
 							for(VMesh::Elem::index_type  iC = 0; iC < coilSize; iC++)
 							{
 								vcoilField->get_value(dipoleMoment,iC);
@@ -0,0 +1,338 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/BrainStimulator/MultipoleTree.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::BrainStimulator;
+using namespace SCIRun::Core::Geometry;
+
+ALGORITHM_PARAMETER_DEF(BrainStimulator, OpeningAngle);
+
+namespace
+{
+  // The kernels evaluate one derived quantity of Phi for d = x - r, either
+  // for a single charge q (direct) or for the moments of a cluster (far).
+
+  class PotentialKernel
+  {
+  public:
+    void direct(const double d[3], const Vector& q, double out[3]) const
+    {
+      const double r = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+      for (int a = 0; a < 3; a++) out[a] += q[a] / r;
+    }
+
+    void far(const double d[3], const double M[3], const double D[3][3], const double Q[3][3][3], double out[3]) const
+    {
+      const double r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+      const double r = std::sqrt(r2);
+      const double ir3 = 1.0 / (r2 * r);
+      const double ir5 = ir3 / r2;
+
+      for (int a = 0; a < 3; a++)
+      {
+        double Dd = 0.0, dQd = 0.0, trQ = 0.0;
+        for (int j = 0; j < 3; j++)
+        {
+          Dd += D[a][j] * d[j];
+          trQ += Q[a][j][j];
+          for (int k = 0; k < 3; k++) dQd += d[j] * Q[a][j][k] * d[k];
+        }
+        out[a] += M[a] / r + Dd * ir3 + 0.5 * (3.0 * dQd * ir5 - trQ * ir3);
+      }
+    }
+  };
+
+  class CurlKernel
+  {
+  public:
+    void direct(const double d[3], const Vector& q, double out[3]) const
+    {
+      const double r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+      const double ir3 = 1.0 / (r2 * std::sqrt(r2));
+      out[0] += (q[1] * d[2] - q[2] * d[1]) * ir3;
+      out[1] += (q[2] * d[0] - q[0] * d[2]) * ir3;
+      out[2] += (q[0] * d[1] - q[1] * d[0]) * ir3;
+    }
+
+    void far(const double d[3], const double M[3], const double D[3][3], const double Q[3][3][3], double out[3]) const
+    {
+      const double r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+      const double r = std::sqrt(r2);
+      const double ir3 = 1.0 / (r2 * r);
+      const double ir5 = ir3 / r2;
+      const double ir7 = ir5 / r2;
+
+      // J[a][i] = d Phi_a / d x_i
+      double J[3][3];
+      for (int a = 0; a < 3; a++)
+      {
+        double Dd = 0.0, dQd = 0.0, trQ = 0.0, Qd[3] = { 0.0, 0.0, 0.0 };
+        for (int j = 0; j < 3; j++)
+        {
+          Dd += D[a][j] * d[j];
+          trQ += Q[a][j][j];
+          for (int k = 0; k < 3; k++)
+          {
+            dQd += d[j] * Q[a][j][k] * d[k];
+            Qd[j] += Q[a][j][k] * d[k];
+          }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+          J[a][i] = -M[a] * d[i] * ir3
+            - (3.0 * Dd * d[i] * ir5 - D[a][i] * ir3)
+            + 0.5 * (-15.0 * dQd * d[i] * ir7 + 3.0 * (d[i] * trQ + 2.0 * Qd[i]) * ir5);
+        }
+      }
+
+      out[0] += J[2][1] - J[1][2];
+      out[1] += J[0][2] - J[2][0];
+      out[2] += J[1][0] - J[0][1];
+    }
+  };
+
+  class GradientOfDivergenceKernel
+  {
+  public:
+    void direct(const double d[3], const Vector& q, double out[3]) const
+    {
+      const double r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+      const double ir3 = 1.0 / (r2 * std::sqrt(r2));
+      const double qd = q[0] * d[0] + q[1] * d[1] + q[2] * d[2];
+      for (int i = 0; i < 3; i++) out[i] += 3.0 * qd * d[i] * ir3 / r2 - q[i] * ir3;
+    }
+
+    void far(const double d[3], const double M[3], const double D[3][3], const double Q[3][3][3], double out[3]) const
+    {
+      const double r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+      const double r = std::sqrt(r2);
+      const double ir3 = 1.0 / (r2 * r);
+      const double ir5 = ir3 / r2;
+      const double ir7 = ir5 / r2;
+      const double ir9 = ir7 / r2;
+
+      double Md = 0.0, dDd = 0.0, trD = 0.0, S3 = 0.0;
+      double Dd[3] = { 0.0, 0.0, 0.0 }, DTd[3] = { 0.0, 0.0, 0.0 };
+      double u[3] = { 0.0, 0.0, 0.0 }, t[3] = { 0.0, 0.0, 0.0 };
+      double dQid[3] = { 0.0, 0.0, 0.0 }, w[3] = { 0.0, 0.0, 0.0 };
+
+      for (int a = 0; a < 3; a++)
+      {
+        Md += M[a] * d[a];
+        trD += D[a][a];
+        for (int j = 0; j < 3; j++)
+        {
+          dDd += d[a] * D[a][j] * d[j];
+          Dd[a] += D[a][j] * d[j];
+          DTd[j] += D[a][j] * d[a];
+          u[j] += Q[a][j][a];
+          t[a] += Q[a][j][j];
+          for (int k = 0; k < 3; k++)
+          {
+            const double Qd = Q[a][j][k] * d[k];
+            dQid[a] += d[j] * Qd;
+            w[j] += d[a] * Qd;
+          }
+        }
+        S3 += d[a] * dQid[a];
+      }
+
+      double ud = 0.0, td = 0.0;
+      for (int a = 0; a < 3; a++)
+      {
+        ud += u[a] * d[a];
+        td += t[a] * d[a];
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        out[i] += 3.0 * Md * d[i] * ir5 - M[i] * ir3
+          + 15.0 * d[i] * dDd * ir7 - 3.0 * (d[i] * trD + Dd[i] + DTd[i]) * ir5
+          + 0.5 * (105.0 * d[i] * S3 * ir9
+                   - 15.0 * (2.0 * d[i] * ud + d[i] * td + dQid[i] + 2.0 * w[i]) * ir7
+                   + 3.0 * (2.0 * u[i] + t[i]) * ir5);
+      }
+    }
+  };
+}
+
+MultipoleTree::MultipoleTree(const std::vector<Point>& positions,
+  const std::vector<Vector>& charges, double openingAngle, size_t leafSize) :
+  openingAngle_(openingAngle), leafSize_(std::max<size_t>(leafSize, 1))
+{
+  const size_t num = std::min(positions.size(), charges.size());
+  sources_.resize(num);
+  for (size_t s = 0; s < num; s++)
+  {
+    sources_[s].position_ = positions[s];
+    sources_[s].charge_ = charges[s];
+  }
+
+  if (num > 0)
+  {
+    nodes_.reserve(2 * num / leafSize_ + 1);
+    build(0, num, 0);
+  }
+}
+
+int MultipoleTree::build(size_t begin, size_t end, int depth)
+{
+  const int index = static_cast<int>(nodes_.size());
+  nodes_.push_back(Node());
+
+  Node n;
+  n.begin_ = begin;
+  n.end_ = end;
+  std::fill(n.children_, n.children_ + 8, -1);
+
+  Vector center(0.0, 0.0, 0.0);
+  for (size_t s = begin; s < end; s++) center += Vector(sources_[s].position_);
+  n.center_ = Point(center / static_cast<double>(end - begin));
+
+  n.radius_ = 0.0;
+  std::fill(&n.M_[0], &n.M_[0] + 3, 0.0);
+  std::fill(&n.D_[0][0], &n.D_[0][0] + 9, 0.0);
+  std::fill(&n.Q_[0][0][0], &n.Q_[0][0][0] + 27, 0.0);
+
+  for (size_t s = begin; s < end; s++)
+  {
+    const Vector delta = sources_[s].position_ - n.center_;
+    const Vector& q = sources_[s].charge_;
+    n.radius_ = std::max(n.radius_, delta.length());
+    for (int a = 0; a < 3; a++)
+    {
+      n.M_[a] += q[a];
+      for (int j = 0; j < 3; j++)
+      {
+        n.D_[a][j] += q[a] * delta[j];
+        for (int k = 0; k < 3; k++) n.Q_[a][j][k] += q[a] * delta[j] * delta[k];
+      }
+    }
+  }
+
+  // Split at the centroid; as long as the sources do not coincide every
+  // split separates at least one source from the others.
+  if (end - begin > leafSize_ && n.radius_ > 0.0 && depth < 64)
+  {
+    const Point c = n.center_;
+    auto first = sources_.begin() + begin;
+    auto last = sources_.begin() + end;
+    auto zsplit = std::partition(first, last, [&c](const Source& s) { return s.position_.z() < c.z(); });
+    decltype(first) bounds[9];
+    bounds[0] = first;
+    bounds[8] = last;
+    bounds[4] = zsplit;
+    for (int h = 0; h < 2; h++)
+    {
+      auto ysplit = std::partition(bounds[4*h], bounds[4*h+4], [&c](const Source& s) { return s.position_.y() < c.y(); });
+      bounds[4*h+2] = ysplit;
+      bounds[4*h+1] = std::partition(bounds[4*h], ysplit, [&c](const Source& s) { return s.position_.x() < c.x(); });
+      bounds[4*h+3] = std::partition(ysplit, bounds[4*h+4], [&c](const Source& s) { return s.position_.x() < c.x(); });
+    }
+
+    for (int o = 0; o < 8; o++)
+    {
+      if (bounds[o] != bounds[o+1])
+      {
+        n.children_[o] = build(bounds[o] - sources_.begin(), bounds[o+1] - sources_.begin(), depth + 1);
+      }
+    }
+  }
+
+  nodes_[index] = n;
+  return index;
+}
+
+template <class Kernel>
+Vector MultipoleTree::evaluate(const Point& x, const Kernel& kernel) const
+{
+  double out[3] = { 0.0, 0.0, 0.0 };
+  if (nodes_.empty()) return Vector(0.0, 0.0, 0.0);
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const Node& n = nodes_[stack.back()];
+    stack.pop_back();
+
+    const double d[3] = { x.x() - n.center_.x(), x.y() - n.center_.y(), x.z() - n.center_.z() };
+    const double r = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+
+    if (n.radius_ < openingAngle_ * r && n.radius_ < r)
+    {
+      kernel.far(d, n.M_, n.D_, n.Q_, out);
+      continue;
+    }
+
+    bool leaf = true;
+    for (int o = 0; o < 8; o++)
+    {
+      if (n.children_[o] >= 0)
+      {
+        stack.push_back(n.children_[o]);
+        leaf = false;
+      }
+    }
+
+    if (leaf)
+    {
+      for (size_t s = n.begin_; s < n.end_; s++)
+      {
+        const Point& p = sources_[s].position_;
+        const double ds[3] = { x.x() - p.x(), x.y() - p.y(), x.z() - p.z() };
+        // A source at the evaluation point has no defined contribution
+        if (ds[0] == 0.0 && ds[1] == 0.0 && ds[2] == 0.0) continue;
+        kernel.direct(ds, sources_[s].charge_, out);
+      }
+    }
+  }
+
+  return Vector(out[0], out[1], out[2]);
+}
+
+Vector MultipoleTree::potential(const Point& x) const
+{
+  return evaluate(x, PotentialKernel());
+}
+
+Vector MultipoleTree::curl(const Point& x) const
+{
+  return evaluate(x, CurlKernel());
+}
+
+Vector MultipoleTree::gradientOfDivergence(const Point& x) const
+{
+  return evaluate(x, GradientOfDivergenceKernel());
+}
@@ -0,0 +1,117 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_BRAINSTIMULATOR_MULTIPOLETREE_H
+#define CORE_ALGORITHMS_BRAINSTIMULATOR_MULTIPOLETREE_H 1
+
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/GeometryPrimitives/Vector.h>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <vector>
+#include <Core/Algorithms/BrainStimulator/share.h>
+
+///@file MultipoleTree
+///@brief Barnes-Hut octree for the magnetic field kernels.
+///
+///@details
+/// The Biot-Savart and dipole kernels used by the BrainStimulator algorithms
+/// are derivatives of the potential of vector valued point charges
+///
+///   Phi(x) = sum_s q_s / |x - r_s|
+///
+/// (a current element q = I dl gives A ~ Phi and B ~ curl Phi, a magnetic
+/// dipole q = m gives A ~ -curl Phi and B ~ grad div Phi). The tree stores
+/// the sources in an octree and evaluates Phi and its derivatives with a
+/// Cartesian multipole expansion up to quadrupole order for every cluster
+/// that is well separated from the evaluation point, and by direct
+/// summation for all other clusters.
+///
+/// A cluster of radius s at distance d is well separated if s / d is smaller
+/// than the opening angle. The relative error of a far field term decreases
+/// as (s/d)^3, hence smaller opening angles are more accurate; an opening
+/// angle of zero evaluates all sums directly. The tree is not modified by the
+/// evaluation functions, which can be called concurrently.
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace BrainStimulator {
+
+  ALGORITHM_PARAMETER_DECL(OpeningAngle);
+
+  class SCISHARE MultipoleTree
+  {
+  public:
+    MultipoleTree(const std::vector<Geometry::Point>& positions,
+                  const std::vector<Geometry::Vector>& charges,
+                  double openingAngle, size_t leafSize = 16);
+
+    /// Phi(x)
+    Geometry::Vector potential(const Geometry::Point& x) const;
+    /// curl Phi(x)
+    Geometry::Vector curl(const Geometry::Point& x) const;
+    /// grad (div Phi)(x)
+    Geometry::Vector gradientOfDivergence(const Geometry::Point& x) const;
+
+    size_t num_sources() const { return sources_.size(); }
+
+  private:
+    struct Source
+    {
+      Geometry::Point position_;
+      Geometry::Vector charge_;
+    };
+
+    struct Node
+    {
+      Geometry::Point center_;
+      double radius_;
+      size_t begin_;
+      size_t end_;
+      int children_[8];
+      // Moments about the center: M_a = sum q_a, D_aj = sum q_a d_j and
+      // Q_ajk = sum q_a d_j d_k with d = r - center
+      double M_[3];
+      double D_[3][3];
+      double Q_[3][3][3];
+    };
+
+    int build(size_t begin, size_t end, int depth);
+
+    template <class Kernel>
+    Geometry::Vector evaluate(const Geometry::Point& x, const Kernel& kernel) const;
+
+    std::vector<Source> sources_;
+    std::vector<Node> nodes_;
+    double openingAngle_;
+    size_t leafSize_;
+  };
+
+}}}}
+
+#endif
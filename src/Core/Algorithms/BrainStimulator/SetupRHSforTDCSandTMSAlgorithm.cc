@@ -156,7 +156,8 @@ AlgorithmOutput SetupTDCSAlgorithm::run(const AlgorithmInput& input) const
   }  
   
   // obtaining number of electrodes
-  DenseMatrixHandle elc_sponge_location = convertMatrix::toDense(input.get<Matrix>(ELECTRODE_SPONGE_LOCATION_AVR));
+  auto elc_sponge_location_input = input.get<Matrix>(ELECTRODE_SPONGE_LOCATION_AVR);
+  DenseMatrixHandle elc_sponge_location = convertMatrix::toDense(elc_sponge_location_input);
   if (!elc_sponge_location)
   {
    THROW_ALGORITHM_PROCESSING_ERROR("Electrode sponges matrix (center locations) is not allocated."); 
@@ -170,24 +171,44 @@ AlgorithmOutput SetupTDCSAlgorithm::run(const AlgorithmInput& input) const
   
   AlgorithmOutput output; 
   
-  DenseMatrixHandle lhs_knowns, elc_element, elc_element_typ, elc_element_def, elc_contact_imp, rhs, selectmatrixind;
-  FieldHandle elec_sponge_surf;
-  std::vector<double> electrode_sponge_areas;
-  boost::tie(lhs_knowns, elc_element, elc_element_typ, elc_element_def, elc_contact_imp, rhs, elec_sponge_surf, selectmatrixind, electrode_sponge_areas) = run(mesh, all_elc_values, all_imp_elc_values, num_of_elc, scalp_tri_surf, elc_tri_surf, elc_sponge_location);
-  
-  output[LHS_KNOWNS] = lhs_knowns;
-  output[ELECTRODE_ELEMENT] = elc_element;
-  output[ELECTRODE_ELEMENT_TYPE] = elc_element_typ;
-  output[ELECTRODE_ELEMENT_DEFINITION] = elc_element_def;
-  output[ELECTRODE_CONTACT_IMPEDANCE] = elc_contact_imp;
+  std::vector<Variable> lhs_settings(all_imp_elc_values.begin(), all_imp_elc_values.end());
+  lhs_settings.push_back(get(Parameters::refnode));
+  lhs_settings.push_back(get(Parameters::normal_dot_product_bound));
+  lhs_settings.push_back(get(Parameters::pointdistancebound));
+  lhs_settings.push_back(get(Parameters::GetContactSurface));
+
+  auto& cache = lhsCache_;
+  const bool reuse_lhs = cache.lhs_knowns && cache.mesh == mesh && cache.scalp_tri_surf == scalp_tri_surf
+    && cache.elc_tri_surf == elc_tri_surf && cache.elc_sponge_location == elc_sponge_location_input && cache.settings == lhs_settings;
+
+  DenseMatrixHandle rhs;
+  if (reuse_lhs)
+  {
+    rhs = create_rhs(mesh, elc_tri_surf, all_elc_values, num_of_elc);
+  }
+  else
+  {
+    boost::tie(cache.lhs_knowns, cache.elc_element, cache.elc_element_typ, cache.elc_element_def, cache.elc_contact_imp, rhs, cache.elec_sponge_surf, cache.selectmatrixind, cache.electrode_sponge_areas) = run(mesh, all_elc_values, all_imp_elc_values, num_of_elc, scalp_tri_surf, elc_tri_surf, elc_sponge_location);
+    cache.mesh = mesh;
+    cache.scalp_tri_surf = scalp_tri_surf;
+    cache.elc_tri_surf = elc_tri_surf;
+    cache.elc_sponge_location = elc_sponge_location_input;
+    cache.settings = lhs_settings;
+  }
+
+  output[LHS_KNOWNS] = cache.lhs_knowns;
+  output[ELECTRODE_ELEMENT] = cache.elc_element;
+  output[ELECTRODE_ELEMENT_TYPE] = cache.elc_element_typ;
+  output[ELECTRODE_ELEMENT_DEFINITION] = cache.elc_element_def;
+  output[ELECTRODE_CONTACT_IMPEDANCE] = cache.elc_contact_imp;
   output[RHS] = rhs;
-  output[SELECTMATRIXINDECES] = selectmatrixind;
-  output[ELECTRODE_SPONGE_SURF] = elec_sponge_surf;
+  output[SELECTMATRIXINDECES] = cache.selectmatrixind;
+  output[ELECTRODE_SPONGE_SURF] = cache.elec_sponge_surf;
   
   Variable::List surface_area;
-  for (long i=0; i<electrode_sponge_areas.size(); i++)
+  for (long i=0; i<cache.electrode_sponge_areas.size(); i++)
   {
-    surface_area.push_back(makeVariable("surf_area_" + boost::lexical_cast<std::string>(i), electrode_sponge_areas[i]));
+    surface_area.push_back(makeVariable("surf_area_" + boost::lexical_cast<std::string>(i), cache.electrode_sponge_areas[i]));
   }
   VariableHandle var_surface_area(new Variable(Name("surf_areas"), surface_area));
   output.setAdditionalAlgoOutput(var_surface_area);
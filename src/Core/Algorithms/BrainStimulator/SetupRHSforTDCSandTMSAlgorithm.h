@@ -88,6 +88,19 @@ namespace BrainStimulator {
     static const double electode_current_summation_bound;
     SCIRun::Core::Datatypes::DenseMatrixHandle create_rhs(FieldHandle mesh, FieldHandle elc_tri_surf, const std::vector<Variable>& elcs, int num_of_elc) const;    
     boost::tuple<Datatypes::DenseMatrixHandle, Datatypes::DenseMatrixHandle, Datatypes::DenseMatrixHandle, Datatypes::DenseMatrixHandle, Datatypes::DenseMatrixHandle, Datatypes::DenseMatrixHandle, FieldHandle, std::vector<double>> create_lhs(FieldHandle mesh, const std::vector<Variable>& impelc, FieldHandle scalp_tri_surf, FieldHandle elc_tri_surf, SCIRun::Core::Datatypes::DenseMatrixHandle elc_sponge_location) const;
+
+    /// The left-hand side outputs only depend on the input meshes, the sponge locations, the impedances and the
+    /// search settings. They are kept so that a change of electrode currents only rebuilds the RHS, and BuildTDCSMatrix
+    /// and the solver downstream receive unchanged inputs.
+    struct LhsCache
+    {
+      FieldHandle mesh, scalp_tri_surf, elc_tri_surf, elec_sponge_surf;
+      Datatypes::MatrixHandle elc_sponge_location;
+      std::vector<Variable> settings;
+      Datatypes::DenseMatrixHandle lhs_knowns, elc_element, elc_element_typ, elc_element_def, elc_contact_imp, selectmatrixind;
+      std::vector<double> electrode_sponge_areas;
+    };
+    mutable LhsCache lhsCache_;
   };
 
 }}}}
@@ -44,6 +44,7 @@ DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <memory>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Geometry;
@@ -60,6 +61,11 @@ AlgorithmInputName SimulateForwardMagneticFieldAlgo::DetectorLocations("Detector
 AlgorithmOutputName SimulateForwardMagneticFieldAlgo::MagneticField("MagneticField");
 AlgorithmOutputName SimulateForwardMagneticFieldAlgo::MagneticFieldMagnitudes("MagneticFieldMagnitudes");
 
+SimulateForwardMagneticFieldAlgo::SimulateForwardMagneticFieldAlgo()
+{
+  addParameter(Parameters::OpeningAngle, 0.0);
+}
+
 class CalcFMField
 {
   public:
@@ -77,6 +83,7 @@ class CalcFMField
   private:
     void interpolate(int proc, Point p);
     void set_up_cell_cache();
+    void set_up_tree();
     void calc_parallel(int proc);
 
     const AlgorithmBase* algo_;
@@ -93,6 +100,9 @@ class CalcFMField
 
     std::vector<per_cell_cache>  cell_cache_;
 
+    // cells and dipoles as sources of a multipole tree, if enabled
+    std::unique_ptr<MultipoleTree> tree_;
+
     VField* efld_; // Electric Field
     VField* ctfld_; // Conductivity Field
     VField* dipfld_; // Dipole Field
@@ -186,6 +196,37 @@ void CalcFMField::set_up_cell_cache()
   }
 }
 
+void CalcFMField::set_up_tree()
+{
+  const double openingAngle = algo_->get(Parameters::OpeningAngle).toDouble();
+  if (openingAngle <= 0.0) return;
+
+  VMesh::size_type num_dipoles = dipmsh_->num_nodes();
+  std::vector<Point> positions;
+  std::vector<Vector> charges;
+  positions.reserve(cell_cache_.size() + num_dipoles);
+  charges.reserve(cell_cache_.size() + num_dipoles);
+
+  for (const auto& c : cell_cache_)
+  {
+    positions.push_back(c.center_);
+    charges.push_back(c.cur_density_ * c.volume_);
+  }
+
+  Point pt;
+  Vector P;
+  for (VMesh::Node::index_type dip_idx = 0; dip_idx < num_dipoles; dip_idx++)
+  {
+    dipmsh_->get_center(pt, dip_idx);
+    dipfld_->value(P, dip_idx);
+    positions.push_back(pt);
+    charges.push_back(P);
+  }
+
+  tree_.reset(new MultipoleTree(positions, charges, openingAngle));
+  emsh_->synchronize(Mesh::ELEM_LOCATE_E);
+}
+
 void CalcFMField::calc_parallel(int proc)
 {
 
@@ -211,28 +252,46 @@ void CalcFMField::calc_parallel(int proc)
 
     detmsh_->get_center(pt, idx);
 
-    // init the interp val to 0
-    interp_value_[proc] = Vector(0,0,0);
-    interpolate(proc, pt);
+    if (tree_)
+    {
+      // sum of the cells and dipoles, without the cell containing the detector
+      mag_field = tree_->curl(pt);
 
-    mag_field = interp_value_[proc];
+      VMesh::Elem::index_type inside_cell;
+      if (emsh_->locate(inside_cell, pt))
+      {
+        const per_cell_cache &c = cell_cache_[inside_cell];
+        Vector radius = pt - c.center_;
+        double length = radius.length();
+        if (length > 0.0)
+          mag_field -= Cross(c.cur_density_, radius) * (c.volume_ / (length * length * length));
+      }
+    }
+    else
+    {
+      // init the interp val to 0
+      interp_value_[proc] = Vector(0,0,0);
+      interpolate(proc, pt);
 
-    Vector normal;
-    detfld_->get_value(normal,idx);
+      mag_field = interp_value_[proc];
 
-    // iterate over the dipoles.
-    for (VMesh::Node::index_type dip_idx = 0; dip_idx < num_dipoles; dip_idx++)
-    {
-      dipmsh_->get_center(pt2, dip_idx);
-      dipfld_->value(P,dip_idx);
+      // iterate over the dipoles.
+      for (VMesh::Node::index_type dip_idx = 0; dip_idx < num_dipoles; dip_idx++)
+      {
+        dipmsh_->get_center(pt2, dip_idx);
+        dipfld_->value(P,dip_idx);
 
-      Vector radius = pt - pt2; // detector - source
-      Vector valuePXR = Cross(P, radius);
-      double length = radius.length();
+        Vector radius = pt - pt2; // detector - source
+        Vector valuePXR = Cross(P, radius);
+        double length = radius.length();
 
-      mag_field += valuePXR / (length * length * length);
+        mag_field += valuePXR / (length * length * length);
+      }
     }
 
+    Vector normal;
+    detfld_->get_value(normal,idx);
+
     mag_field *= one_over_4_pi;
     magmagfld_->set_value(Dot(mag_field, normal),idx);
     magfld_->set_value(mag_field,idx);
@@ -302,6 +361,7 @@ boost::tuple<FieldHandle,FieldHandle> CalcFMField::calc_forward_magnetic_field(F
 
   // cache per cell calculations that are used over and over again.
   set_up_cell_cache();
+  set_up_tree();
 
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
   // do the parallel work.
@@ -36,6 +36,7 @@
 ///  The modules has four inputs: an electric field distribution (first) for mesh elements with defnied conductivity tensors (second), dipole sources (third)
 ///  within that mesh and detector locations (fourth) to compute the magnetic field at. All inputs are of Field datatype. The algorithm/module is multi-threaded and
 ///  outputs the magnetic vector potential and its magnitudes as first and second output.
+///  A positive OpeningAngle sums the cell and dipole contributions with a multipole tree instead of directly.
 
 #ifndef CORE_ALGORITHMS_BRAINSTIMULATOR_SIMULATEFORWARDMAGNETICFIELD_H
 #define CORE_ALGORITHMS_BRAINSTIMULATOR_SIMULATEFORWARDMAGNETICFIELD_H 1
@@ -43,6 +44,7 @@
 #include <Core/Datatypes/MatrixFwd.h>
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <vector>
+#include <Core/Algorithms/BrainStimulator/MultipoleTree.h>
 #include <Core/Algorithms/BrainStimulator/share.h>
 
 namespace SCIRun {
@@ -53,7 +55,8 @@ namespace SCIRun {
 class SCISHARE SimulateForwardMagneticFieldAlgo : public AlgorithmBase
 {
   public:
-    
+    SimulateForwardMagneticFieldAlgo();
+
     static AlgorithmInputName ElectricField;
     static AlgorithmInputName ConductivityTensor;
     static AlgorithmInputName DipoleSources;
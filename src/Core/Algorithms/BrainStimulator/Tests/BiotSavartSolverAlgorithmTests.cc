@@ -0,0 +1,140 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/BrainStimulator/BiotSavartSolverAlgorithm.h>
+#include <Core/Algorithms/BrainStimulator/MultipoleTree.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <cmath>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::BrainStimulator;
+
+namespace
+{
+  // Nodes of a block above the coils, where the field is evaluated.
+  FieldHandle CreateModel()
+  {
+    FieldInformation fi("LatVolMesh", 1, "double");
+    MeshHandle mesh = CreateMesh(fi, 9, 9, 9, Point(-0.05, -0.05, 0.02), Point(0.05, 0.05, 0.12));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  // Circular loop of radius 5 cm in the xy plane carrying 2 A.
+  FieldHandle CreateLoopCoil(int segments)
+  {
+    FieldInformation fi("CurveMesh", 0, "double");
+    MeshHandle mesh = CreateMesh(fi);
+    VMesh* vmesh = mesh->vmesh();
+    for (int s = 0; s < segments; s++)
+    {
+      const double phi = 2.0 * M_PI * s / segments;
+      vmesh->add_point(Point(0.05 * std::cos(phi), 0.05 * std::sin(phi), 0.0));
+    }
+    VMesh::Node::array_type nodes(2);
+    for (int s = 0; s < segments; s++)
+    {
+      nodes[0] = s;
+      nodes[1] = (s + 1) % segments;
+      vmesh->add_elem(nodes);
+    }
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    field->vfield()->set_all_values(2.0);
+    return field;
+  }
+
+  // Magnetic dipoles pointing along z on a square grid in the xy plane.
+  FieldHandle CreateDipoleCoil(int n)
+  {
+    FieldInformation fi("PointCloudMesh", 0, "Vector");
+    MeshHandle mesh = CreateMesh(fi);
+    VMesh* vmesh = mesh->vmesh();
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < n; i++)
+        vmesh->add_point(Point(-0.04 + 0.08 * i / (n - 1), -0.04 + 0.08 * j / (n - 1), 0.0));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    for (VMesh::index_type k = 0; k < static_cast<VMesh::index_type>(n * n); k++)
+      field->vfield()->set_value(Vector(0.0, 0.1 * (k % 3), 1.0), k);
+    return field;
+  }
+
+  // Largest difference between the rows of two n x 3 matrices, relative to the largest row of the first.
+  double RelativeDifference(const DenseMatrix& expected, const DenseMatrix& actual)
+  {
+    double maxNorm = 0.0, maxDiff = 0.0;
+    for (int r = 0; r < expected.rows(); r++)
+    {
+      maxNorm = std::max(maxNorm, expected.row(r).norm());
+      maxDiff = std::max(maxDiff, (expected.row(r) - actual.row(r)).norm());
+    }
+    return maxDiff / maxNorm;
+  }
+
+  void ExpectTreeCloseToDirectSum(FieldHandle coil)
+  {
+    FieldHandle model = CreateModel();
+    for (int outType = 1; outType <= 2; outType++)
+    {
+      BiotSavartSolverAlgorithm direct, tree;
+      tree.set(Parameters::OpeningAngle, 0.25);
+
+      MatrixHandle exact, approx;
+      ASSERT_TRUE(direct.run(model, coil, exact, outType));
+      ASSERT_TRUE(tree.run(model, coil, approx, outType));
+      auto exactDense = castMatrix::toDense(exact);
+      auto approxDense = castMatrix::toDense(approx);
+      ASSERT_TRUE(exactDense && approxDense);
+      ASSERT_EQ(static_cast<int>(model->vmesh()->num_nodes()), exactDense->rows());
+      ASSERT_EQ(3, exactDense->cols());
+
+      EXPECT_GT(exactDense->norm(), 0.0);
+      EXPECT_LT(RelativeDifference(*exactDense, *approxDense), 5e-3);
+    }
+  }
+}
+
+TEST(BiotSavartSolverAlgorithmTests, LoopCoilTreeMatchesDirectSum)
+{
+  ExpectTreeCloseToDirectSum(CreateLoopCoil(64));
+}
+
+TEST(BiotSavartSolverAlgorithmTests, DipoleCoilTreeMatchesDirectSum)
+{
+  ExpectTreeCloseToDirectSum(CreateDipoleCoil(20));
+}
@@ -0,0 +1,186 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/BrainStimulator/MultipoleTree.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms::BrainStimulator;
+
+namespace
+{
+  class MultipoleTreeTest : public ::testing::Test
+  {
+  protected:
+    virtual void SetUp()
+    {
+      boost::random::mt19937 gen(42);
+      boost::random::uniform_real_distribution<> coord(-1.0, 1.0);
+      for (int s = 0; s < 2000; s++)
+      {
+        positions_.push_back(Point(coord(gen), coord(gen), coord(gen)));
+        charges_.push_back(Vector(coord(gen), coord(gen), coord(gen)));
+      }
+      for (int p = 0; p < 20; p++)
+      {
+        // evaluation points on a shell around the sources
+        Vector dir(coord(gen), coord(gen), coord(gen));
+        dir.safe_normalize();
+        targets_.push_back(Point(dir * (2.0 + coord(gen))));
+      }
+    }
+
+    Vector directPotential(const Point& x) const
+    {
+      Vector sum(0.0, 0.0, 0.0);
+      for (size_t s = 0; s < positions_.size(); s++)
+        sum += charges_[s] / (x - positions_[s]).length();
+      return sum;
+    }
+
+    Vector directCurl(const Point& x) const
+    {
+      Vector sum(0.0, 0.0, 0.0);
+      for (size_t s = 0; s < positions_.size(); s++)
+      {
+        const Vector d = x - positions_[s];
+        const double r = d.length();
+        sum += Cross(charges_[s], d) / (r * r * r);
+      }
+      return sum;
+    }
+
+    Vector directGradientOfDivergence(const Point& x) const
+    {
+      Vector sum(0.0, 0.0, 0.0);
+      for (size_t s = 0; s < positions_.size(); s++)
+      {
+        const Vector d = x - positions_[s];
+        const double r = d.length();
+        const double r2 = r * r;
+        sum += (3.0 * Dot(charges_[s], d) / r2 * d - charges_[s]) / (r2 * r);
+      }
+      return sum;
+    }
+
+    static double relativeError(const Vector& approx, const Vector& exact)
+    {
+      return (approx - exact).length() / exact.length();
+    }
+
+    std::vector<Point> positions_;
+    std::vector<Vector> charges_;
+    std::vector<Point> targets_;
+  };
+}
+
+TEST_F(MultipoleTreeTest, ZeroOpeningAngleIsDirectSummation)
+{
+  MultipoleTree tree(positions_, charges_, 0.0);
+  ASSERT_EQ(positions_.size(), tree.num_sources());
+
+  for (const auto& x : targets_)
+  {
+    EXPECT_LT(relativeError(tree.potential(x), directPotential(x)), 1e-12);
+    EXPECT_LT(relativeError(tree.curl(x), directCurl(x)), 1e-12);
+    EXPECT_LT(relativeError(tree.gradientOfDivergence(x), directGradientOfDivergence(x)), 1e-12);
+  }
+}
+
+TEST_F(MultipoleTreeTest, FarFieldMatchesDirectSummation)
+{
+  MultipoleTree tree(positions_, charges_, 0.15);
+
+  // The random charges largely cancel, hence the relative error is well
+  // above the error of the individual far field terms
+  for (const auto& x : targets_)
+  {
+    EXPECT_LT(relativeError(tree.potential(x), directPotential(x)), 2e-3);
+    EXPECT_LT(relativeError(tree.curl(x), directCurl(x)), 1e-2);
+    EXPECT_LT(relativeError(tree.gradientOfDivergence(x), directGradientOfDivergence(x)), 3e-2);
+  }
+}
+
+TEST_F(MultipoleTreeTest, ErrorDecreasesWithOpeningAngle)
+{
+  MultipoleTree coarse(positions_, charges_, 0.7);
+  MultipoleTree fine(positions_, charges_, 0.2);
+
+  double coarseError = 0.0, fineError = 0.0;
+  for (const auto& x : targets_)
+  {
+    const Vector exact = directCurl(x);
+    coarseError += relativeError(coarse.curl(x), exact);
+    fineError += relativeError(fine.curl(x), exact);
+  }
+  EXPECT_LT(fineError, coarseError);
+}
+
+TEST_F(MultipoleTreeTest, ExpansionErrorIsThirdOrder)
+{
+  // A single cluster seen from increasing distances: the quadrupole
+  // expansion leaves a relative error proportional to (s/d)^3
+  MultipoleTree tree(positions_, charges_, 0.99, positions_.size());
+
+  double previous[3] = { 0.0, 0.0, 0.0 };
+  for (double distance = 16.0; distance <= 128.0; distance *= 2.0)
+  {
+    const Point x(0.6 * distance, 0.48 * distance, 0.64 * distance);
+    const double error[3] = {
+      relativeError(tree.potential(x), directPotential(x)),
+      relativeError(tree.curl(x), directCurl(x)),
+      relativeError(tree.gradientOfDivergence(x), directGradientOfDivergence(x)) };
+    if (distance > 16.0)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        EXPECT_GT(previous[k] / error[k], 6.0);
+        EXPECT_LT(previous[k] / error[k], 10.0);
+      }
+    }
+    std::copy(error, error + 3, previous);
+  }
+}
+
+TEST(MultipoleTreeSingleSourceTest, ClusterOfOneIsExact)
+{
+  std::vector<Point> positions(1, Point(0.1, -0.2, 0.3));
+  std::vector<Vector> charges(1, Vector(1.0, 2.0, -0.5));
+  MultipoleTree tree(positions, charges, 0.5);
+
+  const Point x(3.0, 1.0, -2.0);
+  const Vector d = x - positions[0];
+  const double r = d.length();
+  EXPECT_NEAR(0.0, (tree.potential(x) - charges[0] / r).length(), 1e-14);
+  EXPECT_NEAR(0.0, (tree.curl(x) - Cross(charges[0], d) / (r * r * r)).length(), 1e-14);
+  EXPECT_NEAR(0.0, tree.potential(positions[0]).length(), 0.0);
+}
@@ -0,0 +1,210 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/GetFieldBoundaryAlgo.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <functional>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  FieldHandle CreateLatVol(int n, double size, int basis_order)
+  {
+    FieldInformation fi("LatVolMesh", basis_order, "double");
+    MeshHandle mesh = CreateMesh(fi, n, n, n, Point(-size, -size, -size), Point(size, size, size));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  FieldHandle CreateSurface(std::function<void(VMesh*)> build)
+  {
+    FieldInformation fi("TriSurfMesh", 1, "double");
+    MeshHandle mesh = CreateMesh(fi);
+    build(mesh->vmesh());
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  std::vector<double> Values(FieldHandle field)
+  {
+    std::vector<double> values;
+    field->vfield()->get_values(values);
+    return values;
+  }
+}
+
+TEST(CalculateDistanceFieldFastSweepingTests, MatchesExactDistanceToSphere)
+{
+  FieldHandle sphere = CreateTriSurfSphere(12, 24);
+  for (int basis_order = 0; basis_order <= 1; basis_order++)
+  {
+    FieldHandle grid = CreateLatVol(33, 2.0, basis_order);
+
+    CalculateDistanceFieldAlgo algo;
+    FieldHandle exact, fast;
+    ASSERT_TRUE(algo.runImpl(grid, sphere, exact));
+    algo.setOption(Parameters::DistanceMethod, "fast sweeping (approximate)");
+    ASSERT_TRUE(algo.runImpl(grid, sphere, fast));
+
+    const std::vector<double> a = Values(exact), b = Values(fast);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++)
+      EXPECT_NEAR(a[i], b[i], 1e-12);
+  }
+}
+
+TEST(CalculateDistanceFieldFastSweepingTests, TruncatesDistanceToLatVolBoundary)
+{
+  // The boundary of a LatVol is a quad surface.
+  FieldHandle box = CreateLatVol(6, 1.0, 1);
+  GetFieldBoundaryAlgo boundary;
+  FieldHandle surface;
+  ASSERT_TRUE(boundary.run(box, surface));
+  ASSERT_TRUE(surface->vmesh()->is_quadsurfmesh());
+
+  FieldHandle grid = CreateLatVol(40, 2.0, 1);
+  CalculateDistanceFieldAlgo algo;
+  algo.set(Parameters::Truncate, true);
+  algo.set(Parameters::TruncateDistance, 0.5);
+  FieldHandle exact, fast;
+  ASSERT_TRUE(algo.runImpl(grid, surface, exact));
+  algo.setOption(Parameters::DistanceMethod, "fast sweeping (approximate)");
+  ASSERT_TRUE(algo.runImpl(grid, surface, fast));
+
+  const std::vector<double> a = Values(exact), b = Values(fast);
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    EXPECT_LE(b[i], 0.5);
+    EXPECT_NEAR(a[i], b[i], 1e-12);
+  }
+}
+
+TEST(CalculateDistanceFieldFastSweepingTests, SignedDistanceMatchesExactSign)
+{
+  FieldHandle sphere = CreateTriSurfSphere(16, 32);
+  FieldHandle grid = CreateLatVol(41, 1.6, 1);
+
+  CalculateSignedDistanceFieldAlgo algo;
+  FieldHandle exact, fast;
+  ASSERT_TRUE(algo.run(grid, sphere, exact));
+  algo.setOption(CalculateSignedDistanceFieldAlgo::DistanceMethod, "fast sweeping (approximate)");
+  ASSERT_TRUE(algo.run(grid, sphere, fast));
+
+  const std::vector<double> a = Values(exact), b = Values(fast);
+  ASSERT_EQ(a.size(), b.size());
+  size_t inside = 0;
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    EXPECT_NEAR(a[i], b[i], 1e-12);
+    // The sign of a sample on the surface is arbitrary.
+    if (std::abs(a[i]) > 1e-9)
+      EXPECT_EQ(a[i] < 0.0, b[i] < 0.0);
+    inside += (b[i] < 0.0);
+  }
+  EXPECT_GT(inside, 0u);
+  EXPECT_LT(inside, a.size() / 2);
+}
+
+TEST(CalculateDistanceFieldFastSweepingTests, ResultDoesNotDependOnCoreCount)
+{
+  FieldHandle sphere = CreateTriSurfSphere(10, 20);
+  FieldHandle grid = CreateLatVol(45, 1.5, 0);
+
+  CalculateSignedDistanceFieldAlgo algo;
+  algo.setOption(CalculateSignedDistanceFieldAlgo::DistanceMethod, "fast sweeping (approximate)");
+  auto results = runOnOneAndAllCores([&]() -> std::vector<double>
+  {
+    FieldHandle output;
+    EXPECT_TRUE(algo.run(grid, sphere, output));
+    return output ? Values(output) : std::vector<double>();
+  });
+
+  EXPECT_FALSE(results.first.empty());
+  EXPECT_EQ(results.first, results.second);
+}
+
+TEST(CalculateDistanceFieldFastSweepingTests, NestedAndConcaveSurfacesStayCloseToExactMethod)
+{
+  // A hollow shell between two concentric spheres, with the inner one facing the center,
+  // and a sphere with deep dents around its equator.
+  FieldHandle shell = CreateSurface([](VMesh* vmesh)
+  {
+    AddTriSurfSphere(vmesh, 16, 32, [](double, double) { return 1.0; });
+    AddTriSurfSphere(vmesh, 12, 24, [](double, double) { return 0.45; }, true);
+  });
+  FieldHandle dented = CreateSurface([](VMesh* vmesh)
+  {
+    AddTriSurfSphere(vmesh, 24, 48, [](double theta, double phi)
+      { return 1.0 - 0.4*std::pow(std::sin(theta), 4)*std::pow(std::cos(2.0*phi), 2); });
+  });
+
+  const int n = 37;
+  const double size = 1.4, spacing = 2.0*size / (n - 1);
+  for (auto surface : { shell, dented })
+  {
+    FieldHandle grid = CreateLatVol(n, size, 1);
+    CalculateSignedDistanceFieldAlgo algo;
+    FieldHandle exact, fast;
+    ASSERT_TRUE(algo.run(grid, surface, exact));
+    algo.setOption(CalculateSignedDistanceFieldAlgo::DistanceMethod, "fast sweeping (approximate)");
+    ASSERT_TRUE(algo.run(grid, surface, fast));
+
+    const std::vector<double> a = Values(exact), b = Values(fast);
+    ASSERT_EQ(a.size(), b.size());
+    size_t differ = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      // Every swept value is the distance to some element, so it never undercuts the
+      // exact one, and a local minimum only costs a fraction of a grid spacing.
+      EXPECT_GE(std::abs(b[i]), std::abs(a[i]) - 1e-12);
+      EXPECT_LT(std::abs(b[i]) - std::abs(a[i]), spacing);
+      if (std::abs(a[i]) > 1e-9)
+        EXPECT_EQ(a[i] < 0.0, b[i] < 0.0);
+      differ += (std::abs(b[i]) - std::abs(a[i]) > 1e-12);
+    }
+    EXPECT_LT(differ, a.size() / 1000);
+  }
+}
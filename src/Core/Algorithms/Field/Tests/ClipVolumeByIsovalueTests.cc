@@ -36,6 +36,7 @@ last change: 04/21/2015
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Algorithms/Legacy/Fields/ClipMesh/ClipMeshByIsovalue.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
@@ -118,3 +119,82 @@ TEST(ClipVolumeByIsovalueAlgoTest, DISABLED_ClipVolumeByIsovalue_LatVol_DataOnNo
   EXPECT_EQ(output->vmesh()->num_elems(),1);
   EXPECT_EQ(output->vfield()->num_values(),8);
 }
+
+namespace
+{
+  // A sheared n^3 grid of tets with a smooth field on the nodes.
+  FieldHandle CreateTetGrid(int n)
+  {
+    FieldHandle field = CreateTetVolCubeGrid(n, LINEARDATA_E, DOUBLE_E,
+      [](int i, int j, int k) { return Point(i, j + 0.1*i, k); });
+    VMesh* mesh = field->vmesh();
+    for (VMesh::index_type i = 0; i < mesh->num_nodes(); i++)
+    {
+      Point p;
+      mesh->get_center(p, VMesh::Node::index_type(i));
+      field->vfield()->set_value(std::sin(0.5*p.x()) + std::cos(0.4*p.y()) * std::sin(0.3*p.z()), i);
+    }
+    return field;
+  }
+}
+
+TEST(ClipVolumeByIsovalueAlgoTest, CutNodesAreSharedBetweenTets)
+{
+  FieldInformation fi("TetVolMesh", 1, "double");
+  FieldHandle input = CreateField(fi);
+  VMesh* mesh = input->vmesh();
+  mesh->add_point(Point(0,0,0));
+  mesh->add_point(Point(1,0,0));
+  mesh->add_point(Point(0,1,0));
+  mesh->add_point(Point(0,0,1));
+  mesh->add_point(Point(0,0,-1));
+  VMesh::Node::array_type nodes(4);
+  nodes[0] = 0; nodes[1] = 1; nodes[2] = 2; nodes[3] = 3;
+  mesh->add_elem(nodes);
+  nodes[3] = 4;
+  mesh->add_elem(nodes);
+  input->vfield()->resize_values();
+  double values[5] = { 1, 0, 0, 0, 0 };
+  for (int i = 0; i < 5; i++)
+    input->vfield()->set_value(values[i], i);
+
+  ClipMeshByIsovalueAlgo algo;
+  algo.set(ClipMeshByIsovalueAlgo::ScalarIsoValue, 0.5);
+  algo.set(ClipMeshByIsovalueAlgo::LessThanIsoValue, true);
+  FieldHandle output;
+  ASSERT_TRUE(algo.run(input, output));
+  // the kept corner and one break point on each of the four cut edges
+  EXPECT_EQ(5, output->vmesh()->num_nodes());
+  EXPECT_EQ(2, output->vmesh()->num_elems());
+  double value;
+  output->vfield()->get_value(value, 0);
+  EXPECT_EQ(1, value);
+  for (VMesh::index_type i = 1; i < 5; i++)
+  {
+    output->vfield()->get_value(value, i);
+    EXPECT_EQ(0.5, value);
+  }
+}
+
+TEST(ClipVolumeByIsovalueAlgoTest, ResultDoesNotDependOnCoreCount)
+{
+  FieldHandle input = CreateTetGrid(12);
+  for (bool lessThan : { false, true })
+  {
+    ClipMeshByIsovalueAlgo algo;
+    algo.set(ClipMeshByIsovalueAlgo::ScalarIsoValue, 0.2);
+    algo.set(ClipMeshByIsovalueAlgo::LessThanIsoValue, lessThan);
+
+    auto results = runOnOneAndAllCores([&]() -> FieldHandle
+    {
+      FieldHandle output;
+      EXPECT_TRUE(algo.run(input, output));
+      return output;
+    });
+    FieldHandle serial = results.first, parallel = results.second;
+    ASSERT_TRUE(serial && parallel);
+
+    EXPECT_GT(serial->vmesh()->num_elems(), 0);
+    ExpectIdenticalFields(serial, parallel);
+  }
+}
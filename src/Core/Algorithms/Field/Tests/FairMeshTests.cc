@@ -0,0 +1,106 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/SmoothMesh/FairMesh.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // Mean distance of the nodes to the origin and the spread around it.
+  void RadiusStatistics(FieldHandle field, double& mean, double& deviation)
+  {
+    VMesh* vmesh = field->vmesh();
+    const size_t num_nodes = vmesh->num_nodes();
+    std::vector<double> radius(num_nodes);
+    Point p;
+    mean = 0.0;
+    for (size_t i = 0; i < num_nodes; i++)
+    {
+      vmesh->get_point(p, VMesh::Node::index_type(i));
+      radius[i] = Vector(p).length();
+      mean += radius[i] / num_nodes;
+    }
+    deviation = 0.0;
+    for (size_t i = 0; i < num_nodes; i++)
+      deviation += (radius[i] - mean)*(radius[i] - mean) / num_nodes;
+    deviation = std::sqrt(deviation);
+  }
+
+  FieldHandle Fair(FieldHandle input, const std::string& method, int iterations)
+  {
+    FairMeshAlgo algo;
+    algo.setOption(Parameters::FairMeshMethod, method);
+    algo.set(Parameters::NumIterations, iterations);
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(input, output));
+    return output;
+  }
+}
+
+TEST(FairMeshTests, SmoothsNoiseWithoutShrinking)
+{
+  FieldHandle input = CreateTriSurfSphere(30, 60, 1.0, 0.05);
+  double mean, deviation;
+  RadiusStatistics(input, mean, deviation);
+  ASSERT_GT(deviation, 0.02);
+
+  for (const std::string method : { "fast", "desbrun", "hc" })
+  {
+    FieldHandle output = Fair(input, method, 10);
+    ASSERT_EQ(input->vmesh()->num_nodes(), output->vmesh()->num_nodes());
+
+    double faired_mean, faired_deviation;
+    RadiusStatistics(output, faired_mean, faired_deviation);
+    EXPECT_LT(faired_deviation, 0.5*deviation) << method;
+    EXPECT_NEAR(mean, faired_mean, 0.02) << method;
+  }
+}
+
+TEST(FairMeshTests, LeavesInputUntouched)
+{
+  FieldHandle input = CreateTriSurfSphere(10, 20, 1.0, 0.05);
+  Point before, after;
+  input->vmesh()->get_point(before, VMesh::Node::index_type(5));
+  Fair(input, "hc", 5);
+  input->vmesh()->get_point(after, VMesh::Node::index_type(5));
+  EXPECT_EQ(before, after);
+}
+
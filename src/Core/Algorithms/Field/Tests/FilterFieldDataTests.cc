@@ -0,0 +1,214 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/ApplyFilterToFieldData.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/DilateFieldData.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/ErodeFieldData.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  FieldHandle CreateLatVol(int ni, int nj, int nk, int basis_order, const std::string& type)
+  {
+    FieldInformation fi("LatVolMesh", basis_order, type);
+    MeshHandle mesh = CreateMesh(fi, ni, nj, nk, Point(0.0, 0.0, 0.0), Point(1.0, 1.0, 1.0));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  template <class DATA>
+  void FillValues(FieldHandle field, int num_labels)
+  {
+    VField* vfield = field->vfield();
+    for (VMesh::index_type idx = 0; idx < vfield->num_values(); idx++)
+      vfield->set_value(static_cast<DATA>((idx * 7919 + (idx / 5) * 104729) % num_labels), idx);
+  }
+
+  // The filter one value at a time through the mesh neighbor queries.
+  template <class DATA>
+  std::vector<DATA> Reference(FieldHandle field, int num_iter, bool dilate)
+  {
+    VField* vfield = field->vfield();
+    VMesh* vmesh = field->vmesh();
+    const bool elem_data = (vfield->basis_order() == 0);
+    vmesh->synchronize(elem_data ? Mesh::ELEM_NEIGHBORS_E : Mesh::NODE_NEIGHBORS_E);
+
+    std::vector<DATA> values, next;
+    vfield->get_values(values);
+    next.resize(values.size());
+    for (int it = 0; it < num_iter; it++)
+    {
+      for (VMesh::index_type idx = 0; idx < static_cast<VMesh::index_type>(values.size()); idx++)
+      {
+        std::vector<VMesh::index_type> neighbors;
+        if (elem_data)
+        {
+          VMesh::Elem::array_type elems;
+          vmesh->get_neighbors(elems, VMesh::Elem::index_type(idx));
+          neighbors.assign(elems.begin(), elems.end());
+        }
+        else
+        {
+          VMesh::Node::array_type nodes;
+          vmesh->get_neighbors(nodes, VMesh::Node::index_type(idx));
+          neighbors.assign(nodes.begin(), nodes.end());
+        }
+        DATA val = values[idx];
+        for (auto n : neighbors)
+          if (dilate ? values[n] > val : values[n] < val) val = values[n];
+        next[idx] = val;
+      }
+      values.swap(next);
+    }
+    return values;
+  }
+
+  template <class DATA>
+  void ExpectMatchesReference(FieldHandle input, int num_iter)
+  {
+    DilateFieldDataAlgo dilate;
+    dilate.set(Parameters::FilterIterations, num_iter);
+    FieldHandle dilated;
+    ASSERT_TRUE(dilate.runImpl(input, dilated));
+    std::vector<DATA> values;
+    dilated->vfield()->get_values(values);
+    EXPECT_EQ(Reference<DATA>(input, num_iter, true), values);
+
+    ErodeFieldDataAlgo erode;
+    erode.set(Parameters::FilterIterations, num_iter);
+    FieldHandle eroded;
+    ASSERT_TRUE(erode.runImpl(input, eroded));
+    eroded->vfield()->get_values(values);
+    EXPECT_EQ(Reference<DATA>(input, num_iter, false), values);
+  }
+}
+
+TEST(FilterFieldDataTests, LatVolLabelsMatchNeighborFilter)
+{
+  FieldHandle input = CreateLatVol(13, 9, 7, 1, "int");
+  FillValues<int>(input, 5);
+  ExpectMatchesReference<int>(input, 3);
+}
+
+TEST(FilterFieldDataTests, LatVolElementDataMatchesNeighborFilter)
+{
+  FieldHandle input = CreateLatVol(8, 11, 6, 0, "double");
+  FillValues<double>(input, 17);
+  ExpectMatchesReference<double>(input, 2);
+}
+
+TEST(FilterFieldDataTests, LatVolMaskMatchesNeighborFilter)
+{
+  // Rows of 70 values span two words of the packed mask.
+  FieldHandle input = CreateLatVol(70, 5, 4, 1, "unsigned char");
+  VField* vfield = input->vfield();
+  for (VMesh::index_type idx = 0; idx < vfield->num_values(); idx++)
+    vfield->set_value(static_cast<unsigned char>((idx % 23 == 0 || idx % 64 == 63) ? 1 : 0), idx);
+  ExpectMatchesReference<unsigned char>(input, 1);
+  ExpectMatchesReference<unsigned char>(input, 3);
+}
+
+TEST(FilterFieldDataTests, TetVolMatchesNeighborFilter)
+{
+  FieldHandle input = CreateTetVolCubeGrid(4, LINEARDATA_E, INT_E);
+  FillValues<int>(input, 4);
+  ExpectMatchesReference<int>(input, 2);
+}
+
+TEST(FilterFieldDataTests, LeavesInputUntouched)
+{
+  FieldHandle input = CreateLatVol(6, 6, 6, 1, "int");
+  FillValues<int>(input, 3);
+  std::vector<int> before, after;
+  input->vfield()->get_values(before);
+
+  DilateFieldDataAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(input, output));
+  input->vfield()->get_values(after);
+  EXPECT_EQ(before, after);
+}
+
+TEST(FilterFieldDataTests, RejectsVectorData)
+{
+  FieldHandle input = CreateLatVol(4, 4, 4, 1, "Vector");
+  ErodeFieldDataAlgo algo;
+  FieldHandle output;
+  EXPECT_FALSE(algo.runImpl(input, output));
+}
+
+TEST(FilterFieldDataTests, ApplyFilterMatchesErodeThenDilate)
+{
+  FieldHandle input = CreateLatVol(9, 7, 5, 1, "int");
+  FillValues<int>(input, 4);
+
+  ErodeFieldDataAlgo erode;
+  erode.set(Parameters::FilterIterations, 2);
+  FieldHandle eroded;
+  ASSERT_TRUE(erode.runImpl(input, eroded));
+  DilateFieldDataAlgo dilate;
+  dilate.set(Parameters::FilterIterations, 2);
+  FieldHandle expected;
+  ASSERT_TRUE(dilate.runImpl(eroded, expected));
+
+  std::vector<int> values, expectedValues;
+  expected->vfield()->get_values(expectedValues);
+  ApplyFilterToFieldDataAlgo algo;
+  algo.set(Parameters::FilterIterations, 2);
+  algo.setOption(Parameters::MorphologicalMethod, "erodedilate");
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(input, output));
+  output->vfield()->get_values(values);
+  EXPECT_EQ(expectedValues, values);
+
+  algo.setOption(Parameters::MorphologicalMethod, "erode");
+  ASSERT_TRUE(algo.runImpl(input, output));
+  output->vfield()->get_values(values);
+  std::vector<int> erodedValues;
+  eroded->vfield()->get_values(erodedValues);
+  EXPECT_EQ(erodedValues, values);
+
+  algo.setOption(Parameters::MorphologicalMethod, "dilate");
+  ASSERT_TRUE(algo.runImpl(input, output));
+  output->vfield()->get_values(values);
+  EXPECT_EQ(Reference<int>(input, 2, true), values);
+}
@@ -287,3 +287,60 @@ TEST(GenerateStreamLinesTests, ManySeedsMultithreadedStreamlineLength)
     EXPECT_NEAR(max, meshOutputByMethodTotalLength[method].second, 1e-1);
   }
 }
+
+TEST(GenerateStreamLinesTests, MultithreadedOutputMatchesSingleThreaded)
+{
+  FieldInformation fi("LatVolMesh", 1, "Vector");
+  auto mesh = CreateMesh(fi, 9, 9, 9, Point(-1, -1, -1), Point(1, 1, 1));
+  auto vectorField = CreateField(fi, mesh);
+  for (VMesh::Node::index_type i = 0; i < vectorField->vmesh()->num_nodes(); ++i)
+  {
+    Point p;
+    vectorField->vmesh()->get_point(p, i);
+    vectorField->vfield()->set_value(Vector(-p.y(), p.x(), 0.2), i);
+  }
+
+  FieldInformation si("PointCloudMesh", 1, "double");
+  auto seeds = CreateField(si);
+  for (int i = 0; i < 100; ++i)
+    seeds->vmesh()->add_point(Point(0.015 * i - 0.75, 0.5 - 0.01 * i, 0.012 * i - 0.6));
+  seeds->vfield()->resize_values();
+
+  for (const auto& method : { "RungeKutta", "RungeKuttaFehlberg" })
+  {
+    FieldHandle single, multi;
+    GenerateStreamLinesAlgo algo;
+    algo.set(Parameters::StreamlineMaxSteps, 200);
+    algo.setOption(Parameters::StreamlineValue, "Distance from seed");
+    algo.setOption(Parameters::StreamlineMethod, method);
+
+    algo.set(Parameters::UseMultithreading, false);
+    algo.runImpl(vectorField, seeds, single);
+    algo.set(Parameters::UseMultithreading, true);
+    algo.runImpl(vectorField, seeds, multi);
+
+    ASSERT_GT(single->vmesh()->num_nodes(), 100);
+    ASSERT_EQ(single->vmesh()->num_nodes(), multi->vmesh()->num_nodes());
+    ASSERT_EQ(single->vmesh()->num_elems(), multi->vmesh()->num_elems());
+
+    for (VMesh::Node::index_type i = 0; i < single->vmesh()->num_nodes(); ++i)
+    {
+      Point p, q;
+      double a, b;
+      single->vmesh()->get_point(p, i);
+      multi->vmesh()->get_point(q, i);
+      single->vfield()->get_value(a, i);
+      multi->vfield()->get_value(b, i);
+      EXPECT_EQ(p, q);
+      EXPECT_EQ(a, b);
+    }
+
+    VMesh::Node::array_type e1, e2;
+    for (VMesh::Elem::index_type i = 0; i < single->vmesh()->num_elems(); ++i)
+    {
+      single->vmesh()->get_nodes(e1, i);
+      multi->vmesh()->get_nodes(e2, i);
+      EXPECT_EQ(e1, e2);
+    }
+  }
+}
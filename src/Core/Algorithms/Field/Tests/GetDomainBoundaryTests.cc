@@ -31,10 +31,13 @@
 
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Matrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Legacy/Fields/DomainFields/GetDomainBoundaryAlgo.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Core/Logging/Log.h>
 
@@ -146,6 +149,110 @@ TEST_F(GetDomainBoundaryTests, CanLogErrorMessage)
   EXPECT_FALSE(algo.runImpl(input, elemLink, output));
 }
 
+namespace
+{
+  // An n^3 grid of cubes, six tets around the diagonal of every cube. Cubes with i < n/2 are labeled 1,
+  // the others 2.
+  FieldHandle CreateLabeledTetCube(int n)
+  {
+    FieldHandle field = CreateTetVolCubeGrid(n, CONSTANTDATA_E, INT_E);
+    for (VMesh::index_type e = 0; e < field->vmesh()->num_elems(); e++)
+      field->vfield()->set_value((e / 6) % n < n/2 ? 1 : 2, e);
+    return field;
+  }
+}
+
+TEST(GetDomainBoundaryTetVolTests, FindsInterfaceBetweenLabels)
+{
+  const int n = 4;
+  FieldHandle input = CreateLabeledTetCube(n);
+
+  GetDomainBoundaryAlgo algo;
+  algo.set(Parameters::UseRange, true);
+  algo.set(Parameters::MinRange, 1);
+  algo.set(Parameters::MaxRange, 2);
+  algo.set(Parameters::AddOuterBoundary, false);
+
+  FieldHandle boundary;
+  SparseRowMatrixHandle unused;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.runImpl(input, unused, boundary, mapping));
+
+  VMesh* omesh = boundary->vmesh();
+  ASSERT_TRUE(omesh->is_trisurfmesh());
+  EXPECT_EQ(2*n*n, omesh->num_elems());
+  EXPECT_EQ((n+1)*(n+1), omesh->num_nodes());
+  for (VMesh::index_type i = 0; i < omesh->num_nodes(); i++)
+  {
+    Point p;
+    omesh->get_center(p, VMesh::Node::index_type(i));
+    EXPECT_EQ(static_cast<double>(n/2), p.x());
+  }
+
+  // Interface faces are owned by the lower numbered element, which is on the side labeled 1.
+  ASSERT_TRUE(mapping != nullptr);
+  auto map = castMatrix::toSparse(mapping);
+  EXPECT_EQ(omesh->num_elems(), map->nrows());
+  EXPECT_EQ(input->vmesh()->num_elems(), map->ncols());
+  for (VMesh::index_type f = 0; f < omesh->num_elems(); f++)
+  {
+    SparseRowMatrix::InnerIterator it(*map, f);
+    ASSERT_TRUE(it);
+    int parentLabel, faceLabel;
+    input->vfield()->get_value(parentLabel, it.col());
+    boundary->vfield()->get_value(faceLabel, f);
+    EXPECT_EQ(1, parentLabel);
+    EXPECT_EQ(1, faceLabel);
+  }
+}
+
+TEST(GetDomainBoundaryTetVolTests, ResultDoesNotDependOnCoreCount)
+{
+  FieldHandle input = CreateLabeledTetCube(12);
+
+  GetDomainBoundaryAlgo algo;
+  algo.set(Parameters::UseRange, true);
+  algo.set(Parameters::MinRange, 1);
+  algo.set(Parameters::MaxRange, 2);
+  algo.set(Parameters::DisconnectBoundaries, true);
+
+  auto results = runOnOneAndAllCores([&]() -> FieldHandle
+  {
+    FieldHandle output;
+    SparseRowMatrixHandle unused;
+    EXPECT_TRUE(algo.runImpl(input, unused, output));
+    return output;
+  });
+  FieldHandle serial = results.first, parallel = results.second;
+  ASSERT_TRUE(serial && parallel);
+
+  VMesh* a = serial->vmesh();
+  VMesh* b = parallel->vmesh();
+  ASSERT_EQ(a->num_nodes(), b->num_nodes());
+  ASSERT_EQ(a->num_elems(), b->num_elems());
+  // The interface between the labels is added once for each side.
+  EXPECT_GT(a->num_nodes(), 6*12*12 + 2);
+
+  for (VMesh::index_type i = 0; i < a->num_nodes(); i++)
+  {
+    Point p, q;
+    a->get_center(p, VMesh::Node::index_type(i));
+    b->get_center(q, VMesh::Node::index_type(i));
+    EXPECT_EQ(p, q);
+  }
+  VMesh::Node::array_type na, nb;
+  for (VMesh::index_type e = 0; e < a->num_elems(); e++)
+  {
+    a->get_nodes(na, VMesh::Elem::index_type(e));
+    b->get_nodes(nb, VMesh::Elem::index_type(e));
+    EXPECT_EQ(na, nb);
+    int va, vb;
+    serial->vfield()->get_value(va, e);
+    parallel->vfield()->get_value(vb, e);
+    EXPECT_EQ(va, vb);
+  }
+}
+
 #if GTEST_HAS_COMBINE
 
 /*Get Parameterized Tests
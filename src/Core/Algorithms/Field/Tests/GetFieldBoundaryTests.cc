@@ -36,6 +36,7 @@
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/GetFieldBoundaryAlgo.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -155,4 +156,73 @@ TEST(GetFieldBoundaryTest, CanLogErrorMessage)
   EXPECT_FALSE(algo.run(input, output, mapping));
 
   EXPECT_FALSE(algo.run(input, output));
-}
\ No newline at end of file
+}
+
+namespace
+{
+  // An n^3 grid of cubes, six tets around the diagonal of every cube, with the element index as data.
+  FieldHandle CreateTetCube(int n)
+  {
+    FieldHandle field = CreateTetVolCubeGrid(n, CONSTANTDATA_E, DOUBLE_E);
+    for (VMesh::index_type i = 0; i < field->vmesh()->num_elems(); i++)
+      field->vfield()->set_value(static_cast<double>(i), i);
+    return field;
+  }
+}
+
+TEST(GetFieldBoundaryTest, TetVolBoundaryIsCubeSurface)
+{
+  const int n = 4;
+  FieldHandle input = CreateTetCube(n);
+
+  GetFieldBoundaryAlgo algo;
+  FieldHandle boundary;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.run(input, boundary, mapping));
+
+  VMesh* omesh = boundary->vmesh();
+  ASSERT_TRUE(omesh->is_trisurfmesh());
+  EXPECT_EQ(12*n*n, omesh->num_elems());
+  EXPECT_EQ(6*n*n + 2, omesh->num_nodes());
+
+  ASSERT_TRUE(mapping != nullptr);
+  auto map = castMatrix::toSparse(mapping);
+  EXPECT_EQ(omesh->num_elems(), map->nrows());
+  EXPECT_EQ(input->vmesh()->num_elems(), map->ncols());
+  EXPECT_EQ(omesh->num_elems(), map->nonZeros());
+
+  // Every boundary face lies on the cube surface, belongs to the element it maps to
+  // and carries the data of that element.
+  VMesh* imesh = input->vmesh();
+  VMesh::Node::array_type fnodes, enodes;
+  for (VMesh::index_type f = 0; f < omesh->num_elems(); f++)
+  {
+    SparseRowMatrix::InnerIterator it(*map, f);
+    ASSERT_TRUE(it);
+    const VMesh::index_type parent = it.col();
+    EXPECT_EQ(1.0, it.value());
+
+    omesh->get_nodes(fnodes, VMesh::Elem::index_type(f));
+    imesh->get_nodes(enodes, VMesh::Elem::index_type(parent));
+    int onSurface[3] = { 0, 0, 0 };
+    for (const auto& fn : fnodes)
+    {
+      Point p, q;
+      omesh->get_center(p, fn);
+      bool found = false;
+      for (const auto& en : enodes)
+      {
+        imesh->get_center(q, en);
+        if (p == q) found = true;
+      }
+      EXPECT_TRUE(found);
+      for (int d = 0; d < 3; d++)
+        if (p[d] == 0.0 || p[d] == n) onSurface[d]++;
+    }
+    EXPECT_TRUE(onSurface[0] == 3 || onSurface[1] == 3 || onSurface[2] == 3);
+
+    double value;
+    boundary->vfield()->get_value(value, f);
+    EXPECT_EQ(static_cast<double>(parent), value);
+  }
+}
@@ -0,0 +1,229 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Algorithms/Legacy/Fields/MeshData/GetMeshQualityFieldAlgo.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // A block of n^3 cubes, each split into six tets around its main diagonal, with perturbed
+  // nodes. The last tet gets two of its nodes swapped, which turns it inside out.
+  FieldHandle CreateTetBlock(int n)
+  {
+    FieldHandle field = CreateTetVolCubeGrid(n, LINEARDATA_E, DOUBLE_E, [](int i, int j, int k)
+    {
+      return Point(i + 0.1*std::sin(3.0*i + j), j + 0.1*std::cos(i + 2.0*k), k + 0.1*std::sin(j + k));
+    });
+
+    VMesh* vmesh = field->vmesh();
+    VMesh::Node::array_type nodes;
+    vmesh->get_nodes(nodes, VMesh::Elem::index_type(vmesh->num_elems() - 1));
+    std::swap(nodes[0], nodes[1]);
+    vmesh->set_nodes(nodes, VMesh::Elem::index_type(vmesh->num_elems() - 1));
+    return field;
+  }
+
+  FieldHandle CreateSimplexField(const std::string& meshType, const std::vector<Point>& points,
+    const std::vector<std::vector<int> >& elems)
+  {
+    FieldInformation fi(meshType, 1, "double");
+    MeshHandle mesh = CreateMesh(fi);
+    VMesh* vmesh = mesh->vmesh();
+    for (const auto& p : points)
+      vmesh->add_point(p);
+    for (const auto& elem : elems)
+    {
+      VMesh::Node::array_type nodes;
+      for (int n : elem)
+        nodes.push_back(VMesh::Node::index_type(n));
+      vmesh->add_elem(nodes);
+    }
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  std::vector<double> RunMetric(FieldHandle input, const std::string& name)
+  {
+    GetMeshQualityFieldAlgo algo;
+    algo.setOption(Parameters::Metric, name);
+    FieldHandle output;
+    EXPECT_TRUE(algo.run(input, output));
+    std::vector<double> values;
+    if (output)
+      output->vfield()->get_values(values);
+    return values;
+  }
+
+  double metric(VMesh* mesh, const std::string& name, VMesh::Elem::index_type idx)
+  {
+    if (name == "jacobian") return mesh->jacobian_metric(idx);
+    if (name == "volume") return mesh->volume_metric(idx);
+    if (name == "insc_circ_ratio") return mesh->inscribed_circumscribed_radius_metric(idx);
+    return mesh->scaled_jacobian_metric(idx);
+  }
+}
+
+TEST(GetMeshQualityFieldTests, ValuesMatchMeshMetrics)
+{
+  FieldHandle input = CreateTetBlock(6);
+  VMesh* imesh = input->vmesh();
+
+  for (const std::string name : { "scaled_jacobian", "jacobian", "volume", "insc_circ_ratio" })
+  {
+    GetMeshQualityFieldAlgo algo;
+    algo.setOption(Parameters::Metric, name);
+    FieldHandle output;
+    ASSERT_TRUE(algo.run(input, output));
+
+    VField* ofield = output->vfield();
+    ASSERT_EQ(imesh->num_elems(), ofield->num_values());
+    for (VMesh::Elem::index_type idx = 0; idx < imesh->num_elems(); idx++)
+    {
+      double value;
+      ofield->get_value(value, idx);
+      EXPECT_EQ(metric(imesh, name, idx), value) << name << " element " << idx;
+    }
+  }
+}
+
+TEST(GetMeshQualityFieldTests, StatisticsAndHistogramCoverAllElements)
+{
+  FieldHandle input = CreateTetBlock(6);
+  VMesh* imesh = input->vmesh();
+
+  GetMeshQualityFieldAlgo algo;
+  algo.setOption(Parameters::Metric, "volume");
+  algo.set(Parameters::HistogramBins, 20);
+  FieldHandle output;
+  DenseMatrixHandle histogram, statistics;
+  ASSERT_TRUE(algo.run(input, output, histogram, statistics));
+
+  double minimum = 1e300, maximum = -1e300, sum = 0.0;
+  size_t negative = 0;
+  for (VMesh::Elem::index_type idx = 0; idx < imesh->num_elems(); idx++)
+  {
+    const double value = imesh->volume_metric(idx);
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+    sum += value;
+    if (value < 0.0) negative++;
+  }
+
+  ASSERT_EQ(1, statistics->nrows());
+  ASSERT_EQ(4, statistics->ncols());
+  EXPECT_EQ(minimum, (*statistics)(0, 0));
+  EXPECT_EQ(maximum, (*statistics)(0, 1));
+  EXPECT_NEAR(sum / imesh->num_elems(), (*statistics)(0, 2), 1e-12);
+  EXPECT_EQ(1, negative);
+  EXPECT_EQ(negative, (*statistics)(0, 3));
+
+  ASSERT_EQ(20, histogram->nrows());
+  ASSERT_EQ(3, histogram->ncols());
+  EXPECT_EQ(minimum, (*histogram)(0, 0));
+  EXPECT_EQ(maximum, (*histogram)(19, 1));
+  double total = 0.0;
+  for (int k = 0; k < histogram->nrows(); k++)
+    total += (*histogram)(k, 2);
+  EXPECT_EQ(imesh->num_elems(), total);
+  EXPECT_EQ(1, (*histogram)(0, 2));
+}
+
+// Regular tet, corner tet of the unit cube and the inverted corner tet.
+TEST(GetMeshQualityFieldTests, ConditionNumberAndAspectRatioOfTets)
+{
+  FieldHandle input = CreateSimplexField("TetVolMesh",
+    { Point(1,1,1), Point(-1,1,-1), Point(1,-1,-1), Point(-1,-1,1),
+      Point(0,0,0), Point(1,0,0), Point(0,1,0), Point(0,0,1) },
+    { {0,1,2,3}, {4,5,6,7}, {4,6,5,7} });
+
+  // corner tet: c1 = e1, c2 = (2e2 - e1)/sqrt(3), c3 = (3e3 - e2 - e1)/sqrt(6) give
+  // |C|^2 = 9/2, |adj C|^2 = 6 and det C = sqrt(2), so sqrt(27) / (3 sqrt(2)) = sqrt(3/2)
+  const auto condition = RunMetric(input, "condition_number");
+  ASSERT_EQ(3, condition.size());
+  EXPECT_NEAR(1.0, condition[0], 1e-12);
+  EXPECT_NEAR(std::sqrt(1.5), condition[1], 1e-12);
+  EXPECT_NEAR(-std::sqrt(1.5), condition[2], 1e-12);
+
+  // corner tet: h_max = sqrt(2), surface 3/2 + sqrt(3)/2 and volume 1/6, so
+  // sqrt(2) (3 + sqrt(3)) / 2 / sqrt(6) = (1 + sqrt(3)) / 2
+  const auto aspect = RunMetric(input, "aspect_ratio");
+  ASSERT_EQ(3, aspect.size());
+  EXPECT_NEAR(1.0, aspect[0], 1e-12);
+  EXPECT_NEAR((1.0 + std::sqrt(3.0)) / 2.0, aspect[1], 1e-12);
+  EXPECT_NEAR(-(1.0 + std::sqrt(3.0)) / 2.0, aspect[2], 1e-12);
+}
+
+TEST(GetMeshQualityFieldTests, ConditionNumberAndAspectRatioOfTriangles)
+{
+  FieldHandle input = CreateSimplexField("TriSurfMesh",
+    { Point(0,0,0), Point(1,0,0), Point(0.5,0.5*std::sqrt(3.0),0), Point(0,1,0) },
+    { {0,1,2}, {0,1,3} });
+
+  const auto condition = RunMetric(input, "condition_number");
+  ASSERT_EQ(2, condition.size());
+  EXPECT_NEAR(1.0, condition[0], 1e-12);
+  EXPECT_NEAR(2.0 / std::sqrt(3.0), condition[1], 1e-12);
+
+  const auto aspect = RunMetric(input, "aspect_ratio");
+  ASSERT_EQ(2, aspect.size());
+  EXPECT_NEAR(1.0, aspect[0], 1e-12);
+  EXPECT_NEAR((1.0 + std::sqrt(2.0)) / std::sqrt(3.0), aspect[1], 1e-12);
+}
+
+TEST(GetMeshQualityFieldTests, ConditionNumberNeedsSimplexMesh)
+{
+  FieldInformation fi("LatVolMesh", 1, "double");
+  MeshHandle mesh = CreateMesh(fi, 3, 3, 3, Point(0,0,0), Point(1,1,1));
+  GetMeshQualityFieldAlgo algo;
+  algo.setOption(Parameters::Metric, "condition_number");
+  FieldHandle output;
+  EXPECT_FALSE(algo.run(CreateField(fi, mesh), output));
+}
+
+TEST(GetMeshQualityFieldTests, RejectsEmptyHistogram)
+{
+  GetMeshQualityFieldAlgo algo;
+  algo.set(Parameters::HistogramBins, 0);
+  FieldHandle output;
+  EXPECT_FALSE(algo.run(CreateTetBlock(1), output));
+}
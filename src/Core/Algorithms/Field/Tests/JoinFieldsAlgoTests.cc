@@ -71,6 +71,37 @@ protected:
     FieldHandle ofh = CreateField(lfi,mesh);
     return ofh;
   }
+
+  // n x n square of triangles with its lower left corner at (x0, y0) and node data x+y.
+  FieldHandle CreateTriSurfPatch(double x0, double y0, int n)
+  {
+    FieldInformation fi(TRISURFMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle field = CreateField(fi);
+    VMesh* mesh = field->vmesh();
+    for (int j = 0; j <= n; j++)
+      for (int i = 0; i <= n; i++)
+        mesh->add_point(Point(x0 + i, y0 + j, 0.0));
+
+    VMesh::Node::array_type nodes(3);
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < n; i++)
+      {
+        const int c = j*(n+1) + i;
+        nodes[0] = c; nodes[1] = c+1; nodes[2] = c+n+2;
+        mesh->add_elem(nodes);
+        nodes[0] = c; nodes[1] = c+n+2; nodes[2] = c+n+1;
+        mesh->add_elem(nodes);
+      }
+
+    field->vfield()->resize_values();
+    for (VMesh::index_type i = 0; i < mesh->num_nodes(); i++)
+    {
+      Point p;
+      mesh->get_center(p, VMesh::Node::index_type(i));
+      field->vfield()->set_value(p.x() + p.y(), i);
+    }
+    return field;
+  }
 };
 
 // parameters:
@@ -125,6 +156,80 @@ TEST_F(JoinFieldsAlgoTests, CanJoinMultipleLatVolsGeneric)
   EXPECT_EQ(914, output->vmesh()->num_nodes());
 }
 
+TEST_F(JoinFieldsAlgoTests, CanMergeSharedNodesOfTriSurfPatches)
+{
+  JoinFieldsAlgo algo;
+
+  FieldList input;
+  for (int j = 0; j < 3; j++)
+    for (int i = 0; i < 3; i++)
+      input.push_back(CreateTriSurfPatch(4.0*i, 4.0*j, 4));
+  // the center patch once more, all of its elements are duplicates
+  input.push_back(CreateTriSurfPatch(4.0, 4.0, 4));
+
+  FieldHandle output;
+  EXPECT_TRUE(algo.runImpl(input, output));
+  EXPECT_EQ(13*13, output->vmesh()->num_nodes());
+  EXPECT_EQ(10*2*16, output->vmesh()->num_elems());
+
+  algo.set(JoinFieldsAlgo::MergeElems, true);
+  EXPECT_TRUE(algo.runImpl(input, output));
+  EXPECT_EQ(13*13, output->vmesh()->num_nodes());
+  EXPECT_EQ(9*2*16, output->vmesh()->num_elems());
+
+  for (VMesh::index_type i = 0; i < output->vmesh()->num_nodes(); i++)
+  {
+    Point p;
+    double value;
+    output->vmesh()->get_center(p, VMesh::Node::index_type(i));
+    output->vfield()->get_value(value, i);
+    EXPECT_DOUBLE_EQ(p.x() + p.y(), value);
+  }
+
+  algo.set(JoinFieldsAlgo::MergeElems, false);
+  algo.set(JoinFieldsAlgo::MergeNodes, false);
+  EXPECT_TRUE(algo.runImpl(input, output));
+  EXPECT_EQ(10*5*5, output->vmesh()->num_nodes());
+}
+
+TEST_F(JoinFieldsAlgoTests, MergedFieldDoesNotDependOnCoreCount)
+{
+  FieldList input;
+  for (int j = 0; j < 4; j++)
+    for (int i = 0; i < 4; i++)
+      input.push_back(CreateTriSurfPatch(20.0*i + 0.001*j, 20.0*j, 20));
+
+  JoinFieldsAlgo algo;
+  algo.set(JoinFieldsAlgo::Tolerance, 0.01);
+  algo.set(JoinFieldsAlgo::MergeElems, true);
+
+  auto results = runOnOneAndAllCores([&]() -> FieldHandle
+  {
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(input, output));
+    return output;
+  });
+  FieldHandle serial = results.first, parallel = results.second;
+  ASSERT_TRUE(serial && parallel);
+
+  ASSERT_EQ(serial->vmesh()->num_nodes(), parallel->vmesh()->num_nodes());
+  ASSERT_EQ(serial->vmesh()->num_elems(), parallel->vmesh()->num_elems());
+  for (VMesh::index_type i = 0; i < serial->vmesh()->num_nodes(); i++)
+  {
+    Point p, q;
+    serial->vmesh()->get_center(p, VMesh::Node::index_type(i));
+    parallel->vmesh()->get_center(q, VMesh::Node::index_type(i));
+    EXPECT_EQ(p, q);
+  }
+  VMesh::Node::array_type n1, n2;
+  for (VMesh::index_type e = 0; e < serial->vmesh()->num_elems(); e++)
+  {
+    serial->vmesh()->get_nodes(n1, VMesh::Elem::index_type(e));
+    parallel->vmesh()->get_nodes(n2, VMesh::Elem::index_type(e));
+    EXPECT_EQ(n1, n2);
+  }
+}
+
 #if GTEST_HAS_COMBINE
 
 // Get Parameterized Tests
@@ -0,0 +1,161 @@
+/*
+For more information, please see: http://software.sci.utah.edu
+
+The MIT License
+
+Copyright (c) 2015 Scientific Computing and Imaging Institute,
+University of Utah.
+
+License for the specific language governing rights and limitations under
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/RefineMesh.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <set>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // A jittered n^3 grid of tets with a linear function on the nodes.
+  FieldHandle CreateTetGrid(int n)
+  {
+    FieldHandle field = CreateTetVolCubeGrid(n, LINEARDATA_E, DOUBLE_E,
+      [](int i, int j, int k) { return Point(i + 0.01*j*j, j + 0.1*i, k); });
+    VMesh* mesh = field->vmesh();
+    for (VMesh::index_type i = 0; i < mesh->num_nodes(); i++)
+    {
+      Point p;
+      mesh->get_center(p, VMesh::Node::index_type(i));
+      field->vfield()->set_value(p.x() - 0.5*p.y() + 0.25*p.z() - 2.0, i);
+    }
+    return field;
+  }
+
+  FieldHandle CreateTriGrid(int n)
+  {
+    FieldInformation fi("TriSurfMesh", 0, "double");
+    FieldHandle field = CreateField(fi);
+    VMesh* mesh = field->vmesh();
+    for (int j = 0; j <= n; j++)
+      for (int i = 0; i <= n; i++)
+        mesh->add_point(Point(i, j + 0.1*i, 0.0));
+
+    VMesh::Node::array_type nodes(3);
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < n; i++)
+      {
+        const int c = j*(n+1) + i;
+        nodes[0] = c; nodes[1] = c + 1; nodes[2] = c + n + 2;
+        mesh->add_elem(nodes);
+        nodes[0] = c; nodes[1] = c + n + 2; nodes[2] = c + n + 1;
+        mesh->add_elem(nodes);
+      }
+
+    field->vfield()->resize_values();
+    for (VMesh::index_type i = 0; i < mesh->num_elems(); i++)
+      field->vfield()->set_value(static_cast<double>(i % 7) - 3.0, i);
+    return field;
+  }
+}
+
+TEST(RefineMeshAlgoTest, RefinesEveryTetIntoEightAndInterpolatesNodeData)
+{
+  FieldHandle input = CreateTetGrid(3);
+  RefineMeshAlgo algo;
+  algo.setOption(Parameters::AddConstraints, "all");
+
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(input, output));
+
+  // One midpoint is added for every distinct edge of the input.
+  std::set<std::pair<VMesh::index_type, VMesh::index_type> > edges;
+  VMesh::Node::array_type nodes;
+  for (VMesh::index_type e = 0; e < input->vmesh()->num_elems(); e++)
+  {
+    input->vmesh()->get_nodes(nodes, VMesh::Elem::index_type(e));
+    for (size_t i = 0; i < 4; i++)
+      for (size_t j = i + 1; j < 4; j++)
+        edges.insert(std::make_pair(std::min(nodes[i], nodes[j]), std::max(nodes[i], nodes[j])));
+  }
+  EXPECT_EQ(input->vmesh()->num_nodes() + edges.size(), output->vmesh()->num_nodes());
+  EXPECT_EQ(8 * input->vmesh()->num_elems(), output->vmesh()->num_elems());
+
+  // The data is linear, so the interpolated midpoint values are exact.
+  VMesh* mesh = output->vmesh();
+  for (VMesh::index_type i = 0; i < mesh->num_nodes(); i++)
+  {
+    Point p;
+    mesh->get_center(p, VMesh::Node::index_type(i));
+    double v;
+    output->vfield()->get_value(v, i);
+    EXPECT_NEAR(p.x() - 0.5*p.y() + 0.25*p.z() - 2.0, v, 1e-12);
+  }
+}
+
+TEST(RefineMeshAlgoTest, ResultDoesNotDependOnCoreCount)
+{
+  FieldHandle input = CreateTetGrid(10);
+  RefineMeshAlgo algo;
+  algo.setOption(Parameters::AddConstraints, "lessthan");
+
+  auto results = runOnOneAndAllCores([&]() -> FieldHandle
+  {
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(input, output));
+    return output;
+  });
+  FieldHandle serial = results.first, parallel = results.second;
+  ASSERT_TRUE(serial && parallel);
+
+  EXPECT_GT(serial->vmesh()->num_elems(), input->vmesh()->num_elems());
+  EXPECT_LT(serial->vmesh()->num_elems(), 8 * input->vmesh()->num_elems());
+  ExpectIdenticalFields(serial, parallel);
+}
+
+TEST(RefineMeshAlgoTest, IterationsMatchRepeatedRuns)
+{
+  FieldHandle input = CreateTriGrid(12);
+  RefineMeshAlgo algo;
+  algo.setOption(Parameters::AddConstraints, "greaterthan");
+
+  FieldHandle once, twice, iterated;
+  ASSERT_TRUE(algo.runImpl(input, once));
+  ASSERT_TRUE(algo.runImpl(once, twice));
+
+  algo.set(Parameters::RefineIterations, 2);
+  ASSERT_TRUE(algo.runImpl(input, iterated));
+
+  EXPECT_GT(twice->vmesh()->num_elems(), once->vmesh()->num_elems());
+  ExpectIdenticalFields(twice, iterated);
+}
@@ -0,0 +1,113 @@
+/*
+For more information, please see: http://software.sci.utah.edu
+
+The MIT License
+
+Copyright (c) 2015 Scientific Computing and Imaging Institute,
+University of Utah.
+
+License for the specific language governing rights and limitations under
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/ResampleMesh/ResampleRegularMesh.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+namespace
+{
+  // LatVol with node data given by f(i,j,k) on the node indices.
+  template <class F>
+  FieldHandle CreateLatVol(int nx, int ny, int nz, const std::string& type, F f)
+  {
+    FieldInformation fi("LatVolMesh", 1, type);
+    MeshHandle mesh = CreateMesh(fi, nx, ny, nz, Point(0.0, 0.0, 0.0), Point(nx, ny, nz));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    for (int k = 0; k < nz; k++)
+      for (int j = 0; j < ny; j++)
+        for (int i = 0; i < nx; i++)
+          field->vfield()->set_value(f(i, j, k), VMesh::index_type((k*ny + j)*nx + i));
+    return field;
+  }
+}
+
+TEST(ResampleRegularMeshTests, HalvesLatVolWithTentKernel)
+{
+  FieldHandle input = CreateLatVol(16, 12, 8, "double", [](int i, int, int) { return static_cast<double>(i); });
+
+  ResampleRegularMeshAlgo algo;
+  algo.setOption(Parameters::ResampleMethod, "Tent");
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(input, output));
+
+  VMesh::dimension_type dims;
+  output->vmesh()->get_dimensions(dims);
+  ASSERT_EQ(3, dims.size());
+  EXPECT_EQ(8, dims[0]);
+  EXPECT_EQ(6, dims[1]);
+  EXPECT_EQ(4, dims[2]);
+
+  // Away from the boundary a linear function is sampled at the new cell centers.
+  for (int k = 0; k < 4; k++)
+    for (int j = 0; j < 6; j++)
+      for (int i = 1; i < 7; i++)
+      {
+        double value;
+        output->vfield()->get_value(value, VMesh::index_type((k*6 + j)*8 + i));
+        EXPECT_NEAR(2.0*i + 0.5, value, 1e-12);
+      }
+}
+
+TEST(ResampleRegularMeshTests, KeepsConstantIntegerData)
+{
+  FieldHandle input = CreateLatVol(10, 7, 5, "unsigned char", [](int, int, int) { return 200.0; });
+
+  ResampleRegularMeshAlgo algo;
+  algo.setOption(Parameters::ResampleMethod, "Cubic (Catmull-Rom)");
+  algo.set(Parameters::ResampleXDim, 23.0);
+  algo.set(Parameters::ResampleXDimUseScalingFactor, false);
+  algo.set(Parameters::ResampleZDim, 2.0);
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(input, output));
+
+  VMesh::dimension_type dims;
+  output->vmesh()->get_dimensions(dims);
+  EXPECT_EQ(23, dims[0]);
+  EXPECT_EQ(3, dims[1]);
+  EXPECT_EQ(10, dims[2]);
+  for (VField::index_type idx = 0; idx < output->vfield()->num_values(); idx++)
+  {
+    int value;
+    output->vfield()->get_value(value, idx);
+    EXPECT_EQ(200, value);
+  }
+}
+
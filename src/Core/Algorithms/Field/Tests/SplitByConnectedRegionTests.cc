@@ -35,9 +35,11 @@ last change: 09/01/2014
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/SplitByConnectedRegion.h>
+#include <Testing/Utils/SCIRunUnitTests.h>
 
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
  
 TEST(SplitByConnectedRegionTest, SplitFieldByConnectedRegionAlgoTetTests)
 {
@@ -422,3 +424,94 @@ TEST(SplitByConnectedRegionTest, SplitFieldByConnectedRegionAlgoTriTests4)
   EXPECT_EQ(result8->vmesh()->num_nodes(), 895); 
      
 }
+
+namespace
+{
+  // Chains of tets along x: tet i shares a node with tet i+1, except that every
+  // chain is broken after 'length' tets. Regions are chains in increasing order.
+  FieldHandle CreateTetChains(int chains, int length)
+  {
+    FieldInformation fi("TetVolMesh", 0, "double");
+    FieldHandle field = CreateField(fi);
+    VMesh* mesh = field->vmesh();
+    VMesh::Node::array_type nodes(4);
+    for (int c = 0; c < chains; c++)
+    {
+      VMesh::Node::index_type last = mesh->add_point(Point(0.0, 2.0*c, 0.0));
+      for (int t = 0; t < length; t++)
+      {
+        nodes[0] = last;
+        nodes[1] = mesh->add_point(Point(t + 1.0, 2.0*c, 0.0));
+        nodes[2] = mesh->add_point(Point(t + 0.5, 2.0*c + 1.0, 0.0));
+        nodes[3] = mesh->add_point(Point(t + 0.5, 2.0*c + 0.5, 1.0));
+        mesh->add_elem(nodes);
+        last = nodes[1];
+      }
+    }
+    field->vfield()->resize_values();
+    for (VMesh::index_type i = 0; i < mesh->num_elems(); i++)
+      field->vfield()->set_value(static_cast<double>(i), i);
+    return field;
+  }
+}
+
+TEST(SplitByConnectedRegionTest, SplitsChainsInOrderOfFirstElement)
+{
+  SplitFieldByConnectedRegionAlgo algo;
+  FieldHandle input = CreateTetChains(40, 25);
+
+  std::vector<FieldHandle> result = algo.run(input);
+
+  ASSERT_EQ(40, result.size());
+  for (size_t c = 0; c < result.size(); c++)
+  {
+    EXPECT_EQ(25, result[c]->vmesh()->num_elems());
+    EXPECT_EQ(1 + 3*25, result[c]->vmesh()->num_nodes());
+    double first;
+    result[c]->vfield()->get_value(first, 0);
+    EXPECT_EQ(25.0*c, first);
+  }
+}
+
+TEST(SplitByConnectedRegionTest, OutputsLabelFieldOnInputMesh)
+{
+  SplitFieldByConnectedRegionAlgo algo;
+  algo.set(SplitFieldByConnectedRegionAlgo::OutputLabelField(), true);
+  FieldHandle input = CreateTetChains(12, 7);
+
+  std::vector<FieldHandle> result = algo.run(input);
+
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(input->vmesh()->num_elems(), result[0]->vmesh()->num_elems());
+  EXPECT_EQ(0, result[0]->vfield()->basis_order());
+  for (VMesh::index_type i = 0; i < input->vmesh()->num_elems(); i++)
+  {
+    int label;
+    result[0]->vfield()->get_value(label, i);
+    EXPECT_EQ(i / 7 + 1, label);
+  }
+}
+
+TEST(SplitByConnectedRegionTest, ResultDoesNotDependOnCoreCount)
+{
+  SplitFieldByConnectedRegionAlgo algo;
+  algo.set(SplitFieldByConnectedRegionAlgo::SortDomainBySize(), true);
+  FieldHandle input = CreateTetChains(300, 30);
+
+  auto results = runOnOneAndAllCores([&]() { return algo.run(input); });
+  const std::vector<FieldHandle>& serial = results.first;
+  const std::vector<FieldHandle>& parallel = results.second;
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t c = 0; c < serial.size(); c++)
+  {
+    ASSERT_EQ(serial[c]->vmesh()->num_elems(), parallel[c]->vmesh()->num_elems());
+    for (VMesh::index_type i = 0; i < serial[c]->vmesh()->num_elems(); i++)
+    {
+      double a, b;
+      serial[c]->vfield()->get_value(a, i);
+      parallel[c]->vfield()->get_value(b, i);
+      EXPECT_EQ(a, b);
+    }
+  }
+}
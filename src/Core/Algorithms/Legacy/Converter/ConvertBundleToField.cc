@@ -244,7 +244,7 @@ ConvertBundleToFieldAlgo::run(BundleHandle& input, FieldHandle& output)
   size_type elems_count = 0;  
 
   Point P;
-  Point* points = 0;
+  const Point* points = 0;
   std::vector<int> values;
   int curval;
   if (match_node_values)
@@ -381,7 +381,7 @@ ConvertBundleToFieldAlgo::run(BundleHandle& input, FieldHandle& output)
             else
             {
               index_type nidx = omesh->add_point(P);
-              points = omesh->get_points_pointer();
+              points = omesh->get_const_points_pointer();
               nodes_count++;
               newnodes[q] = nidx;
               local_to_global[nodeq] = nidx;
@@ -398,7 +398,7 @@ ConvertBundleToFieldAlgo::run(BundleHandle& input, FieldHandle& output)
             imesh->get_center(P,nodeq);
           
             index_type nidx = omesh->add_point(P); 
-            points = omesh->get_points_pointer();
+            points = omesh->get_const_points_pointer();
             nodes_count++;
             newnodes[q] = nidx;
             local_to_global[nodeq] = nidx;
@@ -35,9 +35,11 @@
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/SparseRowMatrixFromMap.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Thread/Parallel.h>
 #include <boost/unordered_map.hpp>
 
 #include <algorithm>
+#include <numeric>
 #include <set>
 
 
@@ -46,6 +48,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
 
 int tet_permute_table[15][4] = {
   { 0, 0, 0, 0 }, // 0x0
@@ -78,62 +81,204 @@ int tri_permute_table[7][3] = {
 
 namespace detail
 {
-  struct edgepair_t
+  // A node of the clipped mesh, named by the input nodes it derives from: (n, -1, -1) for a
+  // kept input node, the sorted end points of a cut edge, or the sorted corners of a cut face.
+  struct ClipNodeKey
   {
-    VField::index_type first;
-    VField::index_type second;
-    double dfirst;
-  };
+    VMesh::index_type a, b, c;
 
-  struct edgepairhash
-  {
-    size_t operator()(const edgepair_t &a) const
+    bool operator<(const ClipNodeKey& k) const
+    {
+      return a < k.a || (a == k.a && (b < k.b || (b == k.b && c < k.c)));
+    }
+    bool operator==(const ClipNodeKey& k) const
     {
-      std::hash<size_t> h;
-      return h(a.first ^ a.second);
+      return a == k.a && b == k.b && c == k.c;
     }
   };
 
-  typedef boost::unordered_map<VField::index_type, VMesh::Node::index_type> node_hash_type;
-  typedef boost::unordered_map<edgepair_t, VMesh::Node::index_type, edgepairhash> edge_hash_type;
-
-  bool operator==(const edgepair_t &a, const edgepair_t &b)
+  struct ClipNodeRequest
   {
-    return a.first == b.first && a.second == b.second;
-  }
+    ClipNodeKey key;
+    Point p;
+  };
 
-  bool operator!=(const edgepair_t &a, const edgepair_t &b)
+  struct SortedClipNodeRequest
   {
-    return !(a == b);
-  }
+    ClipNodeKey key;
+    VMesh::index_type request;
 
-  struct facetriple_t
-  {
-    VField::index_type first, second, third;
-    double dsecond, dthird;
+    bool operator<(const SortedClipNodeRequest& s) const
+    {
+      return key < s.key || (key == s.key && request < s.request);
+    }
   };
 
-  bool operator==(const facetriple_t &a, const facetriple_t &b)
+  // Assembles a clipped mesh in three passes: the elements are classified and counted, a prefix
+  // sum assigns each element its slots for node requests and cells, and the elements then fill
+  // their slots independently. Requests for the same node are resolved by sorting their keys.
+  // Nodes are numbered in the order of their first request and take the point computed by that
+  // request, so the result is identical to inserting the elements one by one.
+  class ClippedMeshAssembler
   {
-    return a.first == b.first && a.second == b.second && a.third == b.third;
-  }
+  public:
+    ClippedMeshAssembler(VMesh::size_type num_elems, size_t nodes_per_cell) :
+      nodesPerCell_(nodes_per_cell), requestOffsets_(num_elems + 1, 0), cellOffsets_(num_elems + 1, 0) {}
 
-  bool operator!=(const facetriple_t &a, const facetriple_t &b)
-  {
-    return !(a == b);
-  }
+    void set_counts(VMesh::index_type elem, VMesh::size_type requests, VMesh::size_type cells)
+    {
+      requestOffsets_[elem + 1] = requests;
+      cellOffsets_[elem + 1] = cells;
+    }
 
-  struct facetriplehash
-  {
-    size_t operator()(const facetriple_t &a) const
+    void allocate()
+    {
+      std::partial_sum(requestOffsets_.begin(), requestOffsets_.end(), requestOffsets_.begin());
+      std::partial_sum(cellOffsets_.begin(), cellOffsets_.end(), cellOffsets_.begin());
+      requests_.resize(requestOffsets_.back());
+      cells_.resize(cellOffsets_.back() * nodesPerCell_);
+    }
+
+    // Writes the requests and cells of one element into its slots.
+    class ElementWriter
     {
-      std::hash<size_t> h;
-      return h(a.first ^ a.second ^ a.third);
+    public:
+      ElementWriter(ClippedMeshAssembler& assembler, VMesh::index_type elem) :
+        assembler_(assembler), request_(assembler.requestOffsets_[elem]),
+        cell_(assembler.cellOffsets_[elem] * assembler.nodesPerCell_) {}
+
+      VMesh::index_type node(VMesh::index_type u, const Point& p)
+      {
+        ClipNodeKey key = { u, -1, -1 };
+        return add(key, p);
+      }
+
+      VMesh::index_type edge(VMesh::index_type u0, VMesh::index_type u1, const Point& p)
+      {
+        ClipNodeKey key = { std::min(u0, u1), std::max(u0, u1), -1 };
+        return add(key, p);
+      }
+
+      VMesh::index_type face(VMesh::index_type u0, VMesh::index_type u1, VMesh::index_type u2, const Point& p)
+      {
+        VMesh::index_type s[3] = { u0, u1, u2 };
+        std::sort(s, s + 3);
+        ClipNodeKey key = { s[0], s[1], s[2] };
+        return add(key, p);
+      }
+
+      void cell(const VMesh::index_type* nodes)
+      {
+        std::copy(nodes, nodes + assembler_.nodesPerCell_, assembler_.cells_.begin() + cell_);
+        cell_ += assembler_.nodesPerCell_;
+      }
+
+    private:
+      VMesh::index_type add(const ClipNodeKey& key, const Point& p)
+      {
+        ClipNodeRequest& r = assembler_.requests_[request_];
+        r.key = key;
+        r.p = p;
+        return request_++;
+      }
+
+      ClippedMeshAssembler& assembler_;
+      VMesh::index_type request_, cell_;
+    };
+
+    void build(VField* field, VMesh* clipped, VField* ofield, double isoval) const
+    {
+      const size_t num_requests = requests_.size();
+
+      std::vector<SortedClipNodeRequest> sorted(num_requests);
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+      {
+        for (size_t r = begin; r < end; r++)
+        {
+          sorted[r].key = requests_[r].key;
+          sorted[r].request = r;
+        }
+      }, num_requests);
+      Parallel::Sort(sorted.begin(), sorted.end());
+
+      // first[r] is the earliest request for the same node as request r. A group of equal
+      // keys is handled by the range holding its first entry, which sorts first.
+      std::vector<VMesh::index_type> first(num_requests);
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+      {
+        size_t i = begin;
+        while (i < end && i > 0 && sorted[i - 1].key == sorted[i].key) i++;
+        while (i < end)
+        {
+          size_t j = i + 1;
+          while (j < num_requests && sorted[j].key == sorted[i].key) j++;
+          for (size_t q = i; q < j; q++)
+            first[sorted[q].request] = sorted[i].request;
+          i = j;
+        }
+      }, num_requests);
+
+      std::vector<VMesh::index_type> nodeindex(num_requests);
+      VMesh::size_type num_nodes = 0;
+      for (size_t r = 0; r < num_requests; r++)
+        nodeindex[r] = (first[r] == static_cast<VMesh::index_type>(r)) ? num_nodes++ : nodeindex[first[r]];
+
+      clipped->node_reserve(num_nodes);
+      for (size_t r = 0; r < num_requests; r++)
+      {
+        if (first[r] == static_cast<VMesh::index_type>(r))
+          clipped->add_point(requests_[r].p);
+      }
+
+      const size_t num_cells = cells_.size() / nodesPerCell_;
+      clipped->elem_reserve(num_cells);
+      VMesh::Node::array_type nnodes(nodesPerCell_);
+      for (size_t c = 0; c < num_cells; c++)
+      {
+        for (size_t i = 0; i < nodesPerCell_; i++)
+          nnodes[i] = nodeindex[cells_[c * nodesPerCell_ + i]];
+        clipped->add_elem(nnodes);
+      }
+
+      // Kept nodes copy their data, the break points on edges and faces get the isovalue.
+      ofield->resize_values();
+      for (size_t r = 0; r < num_requests; r++)
+      {
+        if (first[r] != static_cast<VMesh::index_type>(r))
+          continue;
+        const ClipNodeKey& key = requests_[r].key;
+        if (key.b < 0)
+          ofield->copy_value(field, key.a, nodeindex[r]);
+        else
+          ofield->set_value(isoval, nodeindex[r]);
+      }
     }
+
+  private:
+    size_t nodesPerCell_;
+    std::vector<VMesh::index_type> requestOffsets_, cellOffsets_;
+    std::vector<ClipNodeRequest> requests_;
+    std::vector<VMesh::index_type> cells_;
   };
 
-  typedef boost::unordered_map<facetriple_t, VMesh::Node::index_type, facetriplehash> face_hash_type;
+  // Mask of the element nodes on the kept side of the isovalue, first node in the highest bit.
+  template <size_t N>
+  VMesh::index_type inside_mask(const std::vector<double>& v, double isoval, bool lte)
+  {
+    VMesh::index_type inside = 0;
+    for (size_t i = 0; i < N; i++)
+    {
+      inside = inside << 1;
+      if (v[i] > isoval)
+      {
+        inside |= 1;
+      }
+    }
 
+    // Invert the mask if we are doing less than.
+    if (lte) { inside = ~inside & ((1 << N) - 1); }
+    return inside;
+  }
 }
 
 ClipMeshByIsovalueAlgo::ClipMeshByIsovalueAlgo()
@@ -148,90 +293,153 @@ class ClipMeshByIsovalueAlgoTet {
     bool run(const AlgorithmBase* algo,FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const;
 
   private:
-    VMesh::Node::index_type
-    edge_lookup(VField::index_type u0, VField::index_type u1, double d0,
-          const Point &p, detail::edge_hash_type &edgemap,
-          VMesh *clipped) const;
-
-    VMesh::Node::index_type
-    face_lookup(VField::index_type u0, VField::index_type u1, VField::index_type u2,
-          double d1, double d2,
-          const Point &p, detail::face_hash_type &facemap,
-          VMesh *clipped) const;
+    static void count(VMesh::index_type inside, VMesh::size_type& requests, VMesh::size_type& cells);
 
+    static void clip_elem(detail::ClippedMeshAssembler::ElementWriter& out, VMesh::index_type inside,
+          const VMesh::Node::array_type& onodes, const std::vector<double>& v,
+          const std::vector<Point>& p, double isoval);
  };
 
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTet::edge_lookup(VField::index_type u0, VField::index_type u1, double d0, const Point &p, detail::edge_hash_type &edgemap, VMesh *clipped) const
+void ClipMeshByIsovalueAlgoTet::count(VMesh::index_type inside, VMesh::size_type& requests, VMesh::size_type& cells)
 {
-  using namespace detail;
-  edgepair_t np;
-  if (u0 < u1)  { np.first = u0; np.second = u1; np.dfirst = d0; }
-  else { np.first = u1; np.second = u0; np.dfirst = 1.0 - d0; }
-
-  auto loc = edgemap.find(np);
-
-  if (loc == edgemap.end())
+  if (inside == 0)
+  {
+    requests = 0; cells = 0;
+  }
+  else if (inside == 0xf || inside == 0x8 || inside == 0x4 || inside == 0x2 || inside == 0x1)
+  {
+    requests = 4; cells = 1;
+  }
+  else if (inside == 0x7 || inside == 0xb || inside == 0xd || inside == 0xe)
   {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    edgemap[np] = nodeindex;
-    return nodeindex;
+    requests = 9; cells = 7;
   }
   else
   {
-   return loc->second;
+    requests = 8; cells = 5;
   }
 }
 
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTet::face_lookup(VField::index_type u0, VField::index_type u1, VField::index_type u2, double d1, double d2, const Point &p, detail::face_hash_type &facemap, VMesh *clipped) const
+void ClipMeshByIsovalueAlgoTet::clip_elem(detail::ClippedMeshAssembler::ElementWriter& out, VMesh::index_type inside,
+  const VMesh::Node::array_type& onodes, const std::vector<double>& v, const std::vector<Point>& p, double isoval)
 {
-  using namespace detail;
-  facetriple_t nt;
-  if (u0 < u1)
+  if (inside == 0)
   {
-    if (u2 < u0)
-    {
-      nt.first = u2; nt.second = u0; nt.third = u1;
-      nt.dsecond = 1.0 - d1 - d2; nt.dthird = d1;
-    }
-    else if (u2 < u1)
-    {
-      nt.first = u0; nt.second = u2; nt.third = u1;
-      nt.dsecond = d2; nt.dthird = d1;
-    }
-    else
-    {
-      nt.first = u0; nt.second = u1; nt.third = u2;
-      nt.dsecond = d1; nt.dthird = d2;
-    }
+      // Discard outside elements.
   }
-  else
+  else if (inside == 0xf)
   {
-    if (u2 > u0)
-    {
-      nt.first = u1; nt.second = u0; nt.third = u2;
-      nt.dsecond = 1.0 - d1 - d2; nt.dthird = d2;
-    }
-    else if (u2 > u1)
-    {
-      nt.first = u1; nt.second = u2; nt.third = u0;
-      nt.dsecond = d2; nt.dthird = 1.0 - d1 - d2;
-    }
-    else
-    {
-      nt.first = u2; nt.second = u1; nt.third = u0;
-      nt.dsecond = d1; nt.dthird = 1.0 - d1 - d2;
-    }
+      // Add this element to the new mesh.
+    VMesh::index_type nnodes[4];
+    for (size_t i = 0; i < 4; i++)
+      nnodes[i] = out.node(onodes[i], p[i]);
+    out.cell(nnodes);
+  }
+  else if (inside == 0x8 || inside == 0x4 || inside == 0x2 || inside == 0x1)
+  {
+      // Lop off 3 points and add resulting tet to the new mesh.
+    const int *perm = tet_permute_table[inside];
+    VMesh::index_type nnodes[4];
+
+    nnodes[0] = out.node(onodes[perm[0]], p[perm[0]]);
+
+    const double imv = isoval - v[perm[0]];
+    const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+    const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+    const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+    const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+    const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
+    const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
+
+    nnodes[1] = out.edge(onodes[perm[0]], onodes[perm[1]], l1);
+    nnodes[2] = out.edge(onodes[perm[0]], onodes[perm[2]], l2);
+    nnodes[3] = out.edge(onodes[perm[0]], onodes[perm[3]], l3);
+
+    out.cell(nnodes);
   }
-  const face_hash_type::iterator loc = facemap.find(nt);
-  if (loc == facemap.end())
+  else if (inside == 0x7 || inside == 0xb || inside == 0xd || inside == 0xe)
   {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    facemap[nt] = nodeindex;
-    return nodeindex;
+      // Lop off 1 point, break up the resulting quads and add the
+      // resulting tets to the mesh.
+    const int *perm = tet_permute_table[inside];
+
+    VMesh::index_type inodes[9];
+    for (size_t i = 1; i < 4; i++)
+      inodes[i-1] = out.node(onodes[perm[i]], p[perm[i]]);
+
+    const double imv = isoval - v[perm[0]];
+    const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+    const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+    const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+    const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+    const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
+    const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
+
+    inodes[3] = out.edge(onodes[perm[0]], onodes[perm[1]], l1);
+    inodes[4] = out.edge(onodes[perm[0]], onodes[perm[2]], l2);
+    inodes[5] = out.edge(onodes[perm[0]], onodes[perm[3]], l3);
+
+    const Point c1 = Interpolate(l1, l2, 0.5);
+    const Point c2 = Interpolate(l2, l3, 0.5);
+    const Point c3 = Interpolate(l3, l1, 0.5);
+
+    inodes[6] = out.face(onodes[perm[0]], onodes[perm[1]], onodes[perm[2]], c1);
+    inodes[7] = out.face(onodes[perm[0]], onodes[perm[2]], onodes[perm[3]], c2);
+    inodes[8] = out.face(onodes[perm[0]], onodes[perm[3]], onodes[perm[1]], c3);
+
+    const VMesh::index_type cells[7][4] = {
+      { inodes[0], inodes[3], inodes[8], inodes[6] },
+      { inodes[1], inodes[4], inodes[6], inodes[7] },
+      { inodes[2], inodes[5], inodes[7], inodes[8] },
+      { inodes[0], inodes[6], inodes[8], inodes[7] },
+      { inodes[0], inodes[8], inodes[2], inodes[7] },
+      { inodes[0], inodes[6], inodes[7], inodes[1] },
+      { inodes[0], inodes[1], inodes[7], inodes[2] } };
+    for (size_t c = 0; c < 7; c++)
+      out.cell(cells[c]);
   }
-  else
+  else// if (inside == 0x3 || inside == 0x5 || inside == 0x6 ||
+        //     inside == 0x9 || inside == 0xa || inside == 0xc)
   {
-    return (*loc).second;
+      // Lop off two points, break the resulting quads, then add the
+      // new tets to the mesh.
+    const int *perm = tet_permute_table[inside];
+
+    VMesh::index_type inodes[8];
+    for (size_t i = 2; i < 4; i++)
+      inodes[i-2] = out.node(onodes[perm[i]], p[perm[i]]);
+
+    const double imv0 = isoval - v[perm[0]];
+    const double dl02 = imv0 / (v[perm[2]] - v[perm[0]]);
+    const Point l02 = Interpolate(p[perm[0]], p[perm[2]], dl02);
+    const double dl03 = imv0 / (v[perm[3]] - v[perm[0]]);
+    const Point l03 = Interpolate(p[perm[0]], p[perm[3]], dl03);
+
+    const double imv1 = isoval - v[perm[1]];
+    const double dl12 = imv1 / (v[perm[2]] - v[perm[1]]);
+    const Point l12 = Interpolate(p[perm[1]], p[perm[2]], dl12);
+    const double dl13 = imv1 / (v[perm[3]] - v[perm[1]]);
+    const Point l13 = Interpolate(p[perm[1]], p[perm[3]], dl13);
+
+    inodes[2] = out.edge(onodes[perm[0]], onodes[perm[2]], l02);
+    inodes[3] = out.edge(onodes[perm[0]], onodes[perm[3]], l03);
+    inodes[4] = out.edge(onodes[perm[1]], onodes[perm[2]], l12);
+    inodes[5] = out.edge(onodes[perm[1]], onodes[perm[3]], l13);
+
+    const Point c1 = Interpolate(l02, l03, 0.5);
+    const Point c2 = Interpolate(l12, l13, 0.5);
+
+    inodes[6] = out.face(onodes[perm[0]], onodes[perm[2]], onodes[perm[3]], c1);
+    inodes[7] = out.face(onodes[perm[1]], onodes[perm[2]], onodes[perm[3]], c2);
+
+    const VMesh::index_type cells[5][4] = {
+      { inodes[7], inodes[2], inodes[0], inodes[4] },
+      { inodes[1], inodes[5], inodes[3], inodes[7] },
+      { inodes[1], inodes[3], inodes[6], inodes[7] },
+      { inodes[0], inodes[7], inodes[6], inodes[2] },
+      { inodes[0], inodes[1], inodes[6], inodes[7] } };
+    for (size_t c = 0; c < 5; c++)
+      out.cell(cells[c]);
   }
 }
 
@@ -242,449 +450,146 @@ bool ClipMeshByIsovalueAlgoTet::run(const AlgorithmBase* algo, FieldHandle input
   VMesh*  clipped = output->vmesh();
 
   using namespace detail;
-  node_hash_type nodemap;
-  edge_hash_type edgemap;
-  face_hash_type facemap;
-
-  VMesh::Node::array_type onodes(4);
-  std::vector<double> v(4);
-  std::vector<Point> p(4);
 
   double isoval = algo->get(ClipMeshByIsovalueAlgo::ScalarIsoValue).toDouble();
 
   bool lte = !algo->get(ClipMeshByIsovalueAlgo::LessThanIsoValue).toBool();
 
   VMesh::size_type num_elems = mesh->num_elems();
+  ClippedMeshAssembler assembler(num_elems, 4);
+  std::vector<unsigned char> masks(num_elems);
 
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  // Classify the elements and count what each one adds.
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
   {
-    mesh->get_nodes(onodes, idx);
-
-      // Get the values and compute an inside/outside mask.
-    VField::index_type inside = 0;
-    mesh->get_centers(p, onodes);
-    field->get_values(v,onodes);
-    for (size_t i = 0; i < onodes.size(); i++)
+    VMesh::Node::array_type onodes(4);
+    std::vector<double> v(4);
+    for (VMesh::Elem::index_type idx = begin; idx < static_cast<VMesh::index_type>(end); idx++)
     {
-      inside = inside << 1;
-      if (v[i] > isoval)
-      {
-        inside |= 1;
-      }
-
+      mesh->get_nodes(onodes, idx);
+      field->get_values(v, onodes);
+      masks[idx] = static_cast<unsigned char>(inside_mask<4>(v, isoval, lte));
+      VMesh::size_type requests, cells;
+      count(masks[idx], requests, cells);
+      assembler.set_counts(idx, requests, cells);
     }
+  }, num_elems);
 
-      // Invert the mask if we are doing less than.
-    if (lte) { inside = ~inside & 0xf; }
+  assembler.allocate();
 
-    if (inside == 0)
-    {
-        // Discard outside elements.
-    }
-    else if (inside == 0xf)
-    {
-        // Add this element to the new mesh.
-      VMesh::Node::array_type nnodes(onodes.size());
-      for (size_t i = 0; i<onodes.size(); i++)
-      {
-        if (nodemap.find((VField::index_type)onodes[i]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[i]);
-          nodemap[(VField::index_type)onodes[i]] = nodeindex;
-          nnodes[i] = nodeindex;
-        }
-        else
-        {
-          nnodes[i] = nodemap[(VField::index_type)onodes[i]];
-        }
-      }
-
-      clipped->add_elem(nnodes);
-    }
-    else if (inside == 0x8 || inside == 0x4 || inside == 0x2 || inside == 0x1)
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type onodes(4);
+    std::vector<double> v(4);
+    std::vector<Point> p(4);
+    for (VMesh::Elem::index_type idx = begin; idx < static_cast<VMesh::index_type>(end); idx++)
     {
-        // Lop off 3 points and add resulting tet to the new mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
-
-      if (nodemap.find((VField::index_type)onodes[perm[0]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[0]]);
-        nodemap[(VField::index_type)onodes[perm[0]]] = nodeindex;
-        nnodes[0] = nodeindex;
-      }
-      else
-      {
-        nnodes[0] = nodemap[(VField::index_type)onodes[perm[0]]];
-      }
-
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-      const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
-      const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
-
-
-      nnodes[1] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[1]],
-                              dl1, l1, edgemap, clipped);
-
-      nnodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[2]],
-                              dl2, l2, edgemap, clipped);
-
-      nnodes[3] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[3]],
-                              dl3, l3, edgemap, clipped);
-
-      clipped->add_elem(nnodes);
+      if (masks[idx] == 0)
+        continue;
+      mesh->get_nodes(onodes, idx);
+      mesh->get_centers(p, onodes);
+      field->get_values(v, onodes);
+      ClippedMeshAssembler::ElementWriter out(assembler, idx);
+      clip_elem(out, masks[idx], onodes, v, p, isoval);
     }
-    else if (inside == 0x7 || inside == 0xb || inside == 0xd || inside == 0xe)
-    {
-        // Lop off 1 point, break up the resulting quads and add the
-        // resulting tets to the mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
+  }, num_elems);
 
-      VMesh::Node::index_type inodes[9];
-      for (size_t i = 1; i < 4; i++)
-      {
-        if (nodemap.find((VField::index_type)onodes[perm[i]]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[i]]);
-          nodemap[(VField::index_type)onodes[perm[i]]] = nodeindex;
-          inodes[i-1] = nodeindex;
-        }
-        else
-        {
-          inodes[i-1] = nodemap[(VField::index_type)onodes[perm[i]]];
-        }
-      }
-
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-      const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
-      const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
-
-
-      inodes[3] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[1]],
-                              dl1, l1, edgemap, clipped);
-
-      inodes[4] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              dl2, l2, edgemap, clipped);
-
-      inodes[5] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              dl3, l3, edgemap, clipped);
-
-      const Point c1 = Interpolate(l1, l2, 0.5);
-      const Point c2 = Interpolate(l2, l3, 0.5);
-      const Point c3 = Interpolate(l3, l1, 0.5);
-
-      inodes[6] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              dl1*0.5, dl2*0.5,
-                              c1, facemap, clipped);
-      inodes[7] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl2*0.5, dl3*0.5,
-                              c2, facemap, clipped);
-      inodes[8] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              (index_type)onodes[perm[1]],
-                              dl3*0.5, dl1*0.5,
-                              c3, facemap, clipped);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[8];
-      nnodes[3] = inodes[6];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[4];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[2];
-      nnodes[1] = inodes[5];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[8];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[6];
-      nnodes[2] = inodes[8];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[8];
-      nnodes[2] = inodes[2];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[6];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[1];
-      clipped->add_elem(nnodes);
+  VField* ofield = output->vfield();
+  assembler.build(field, clipped, ofield, isoval);
+  CopyProperties(*input, *output);
 
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[2];
-      clipped->add_elem(nnodes);
-    }
-    else// if (inside == 0x3 || inside == 0x5 || inside == 0x6 ||
-          //     inside == 0x9 || inside == 0xa || inside == 0xc)
-    {
-        // Lop off two points, break the resulting quads, then add the
-        // new tets to the mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
+  return (true);
+}
 
-      VMesh::Node::index_type inodes[8];
-      for (size_t i = 2; i < 4; i++)
-      {
-        if (nodemap.find((VField::index_type)onodes[perm[i]]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[i]]);
-          nodemap[(VField::index_type)onodes[perm[i]]] = nodeindex;
-          inodes[i-2] = nodeindex;
-        }
-        else
-        {
-          inodes[i-2] = nodemap[(VField::index_type)onodes[perm[i]]];
-        }
-      }
-      const double imv0 = isoval - v[perm[0]];
-      const double dl02 = imv0 / (v[perm[2]] - v[perm[0]]);
-      const Point l02 = Interpolate(p[perm[0]], p[perm[2]], dl02);
-      const double dl03 = imv0 / (v[perm[3]] - v[perm[0]]);
-      const Point l03 = Interpolate(p[perm[0]], p[perm[3]], dl03);
-
-      const double imv1 = isoval - v[perm[1]];
-      const double dl12 = imv1 / (v[perm[2]] - v[perm[1]]);
-      const Point l12 = Interpolate(p[perm[1]], p[perm[2]], dl12);
-      const double dl13 = imv1 / (v[perm[3]] - v[perm[1]]);
-      const Point l13 = Interpolate(p[perm[1]], p[perm[3]], dl13);
-
-
-      inodes[2] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              dl02, l02, edgemap, clipped);
-      inodes[3] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              dl03, l03, edgemap, clipped);
-      inodes[4] = edge_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              dl12, l12, edgemap, clipped);
-      inodes[5] = edge_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[3]],
-                              dl13, l13, edgemap, clipped);
-
-      const Point c1 = Interpolate(l02, l03, 0.5);
-      const Point c2 = Interpolate(l12, l13, 0.5);
-
-      inodes[6] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl02*0.5,
-                              dl03*0.5,
-                              c1, facemap, clipped);
-      inodes[7] = face_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl12*0.5,
-                              dl13*0.5,
-                              c2, facemap, clipped);
-
-      nnodes[0] = inodes[7];
-      nnodes[1] = inodes[2];
-      nnodes[2] = inodes[0];
-      nnodes[3] = inodes[4];
-      clipped->add_elem(nnodes);
+// Algorithm for tri meshes
 
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[5];
-      nnodes[2] = inodes[3];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
+class ClipMeshByIsovalueAlgoTri
+{
+  public:
+    bool run(const AlgorithmBase* algo,FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const;
 
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
+  private:
+    static void count(VMesh::index_type inside, VMesh::size_type& requests, VMesh::size_type& cells);
 
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[7];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[2];
-      clipped->add_elem(nnodes);
+    static void clip_elem(detail::ClippedMeshAssembler::ElementWriter& out, VMesh::index_type inside,
+          const VMesh::Node::array_type& onodes, const std::vector<double>& v,
+          const std::vector<Point>& p, double isoval);
+};
 
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-    }
+void ClipMeshByIsovalueAlgoTri::count(VMesh::index_type inside, VMesh::size_type& requests, VMesh::size_type& cells)
+{
+  if (inside == 0)
+  {
+    requests = 0; cells = 0;
   }
-
-  VField* ofield = output->vfield();
-  ofield->resize_values();
-  CopyProperties(*input, *output);
-
-    // Add the data values from the old field to the new field.
-  node_hash_type::iterator nmitr = nodemap.begin();
-  while (nmitr != nodemap.end())
+  else if (inside == 0x7 || inside == 0x1 || inside == 0x2 || inside == 0x4)
   {
-    ofield->copy_value(field,((*nmitr).first),((*nmitr).second));
-    ++nmitr;
+    requests = 3; cells = 1;
   }
-
-    // Put the isovalue at the edge break points.
-  edge_hash_type::iterator emitr = edgemap.begin();
-  while (emitr != edgemap.end())
+  else
   {
-    ofield->set_value(isoval,((*emitr).second));
-    ++emitr;
+    requests = 4; cells = 2;
   }
+}
 
-    // Put the isovalue at the face break points.  Assumes linear
-    // interpolation across the faces (which seems safe, this is what we
-    // used to cut with.)
-  face_hash_type::iterator fmitr = facemap.begin();
-  while (fmitr != facemap.end())
+void ClipMeshByIsovalueAlgoTri::clip_elem(detail::ClippedMeshAssembler::ElementWriter& out, VMesh::index_type inside,
+  const VMesh::Node::array_type& onodes, const std::vector<double>& v, const std::vector<Point>& p, double isoval)
+{
+  if (inside == 0)
   {
-    ofield->set_value(isoval,((*fmitr).second));
-    ++fmitr;
+    // Discard outside elements.
   }
-
-  #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-  if (algo->get_bool("build_mapping"))
+  else if (inside == 0x7)
   {
-      // Create the interpolant matrix.
-    const size_type nrows = clipped->num_nodes();
-    const size_type ncols = mesh->num_nodes();
-
-    std::vector<index_type> cctmp(nrows*3);
-    std::vector<double> dtmp(nrows*3);
-    SparseRowMatrix::Builder sparseBuilder;
-    const SparseRowMatrix::Rows& rr = sparseBuilder.allocate_rows(nrows + 1);
-
-    for (index_type i = 0; i < nrows * 3; i++)
-    {
-      cctmp[i] = -1;
-    }
-
-    size_type nnz = 0;
-
-      // Add the data values from the old field to the new field.
-    nmitr = nodemap.begin();
-    while (nmitr != nodemap.end())
-    {
-      cctmp[(*nmitr).second * 3] = (*nmitr).first;
-      dtmp[(*nmitr).second * 3 + 0] = 1.0;
-      nnz++;
-      ++nmitr;
-    }
-
-      // Insert the double hits into cc.
-      // Put the isovalue at the edge break points.
-    emitr = edgemap.begin();
-    while (emitr != edgemap.end())
-    {
-      cctmp[(*emitr).second * 3 + 0] = (*emitr).first.first;
-      cctmp[(*emitr).second * 3 + 1] = (*emitr).first.second;
-      dtmp[(*emitr).second * 3 + 0] = 1.0 - (*emitr).first.dfirst;
-      dtmp[(*emitr).second * 3 + 1] = (*emitr).first.dfirst;
-      nnz+=2;
-      ++emitr;
-    }
-
-      // Insert the double hits into cc.
-      // Put the isovalue at the edge break points.
-    fmitr = facemap.begin();
-    while (fmitr != facemap.end())
-    {
-      cctmp[(*fmitr).second * 3 + 0] = (*fmitr).first.first;
-      cctmp[(*fmitr).second * 3 + 1] = (*fmitr).first.second;
-      cctmp[(*fmitr).second * 3 + 2] = (*fmitr).first.third;
-      dtmp[(*fmitr).second * 3 + 0] =
-          1.0 - (*fmitr).first.dsecond - (*fmitr).first.dthird;;
-      dtmp[(*fmitr).second * 3 + 1] = (*fmitr).first.dsecond;
-      dtmp[(*fmitr).second * 3 + 2] = (*fmitr).first.dthird;
-      nnz+=3;
-
-      ++fmitr;
-    }
-
-    const SparseRowMatrix::Columns& cc = sparseBuilder.allocate_columns(nnz);
-    const SparseRowMatrix::Storage& d = sparseBuilder.allocate_data(nnz);
-
-    index_type j;
-    index_type counter = 0;
-    rr[0] = 0;
-    for (j = 0; j < nrows*3; j++)
-    {
-      if (j%3 == 0) { rr[j/3 + 1] = rr[j/3]; }
-      if (cctmp[j] != -1)
-      {
-        cc[counter] = cctmp[j];
-        d[counter] = dtmp[j];
-        rr[j/3 + 1]++;
-        counter++;
-      }
-    }
-    mapping = new SparseRowMatrix(nrows, ncols, sparseBuilder.build(), nnz);
+    // Add this element to the new mesh.
+    VMesh::index_type nnodes[3];
+    for (size_t i = 0; i < 3; i++)
+      nnodes[i] = out.node(onodes[i], p[i]);
+    out.cell(nnodes);
   }
-  #endif
+  else if (inside == 0x1 || inside == 0x2 || inside == 0x4)
+  {
+    // Add the corner containing the inside point to the mesh.
+    const int *perm = tri_permute_table[inside];
+    VMesh::index_type nnodes[3];
+    nnodes[0] = out.node(onodes[perm[0]], p[perm[0]]);
 
-  return (true);
-}
+    const double imv = isoval - v[perm[0]];
 
-// Algorithm for tri meshes
-
-class ClipMeshByIsovalueAlgoTri
-{
-  public:
-    bool run(const AlgorithmBase* algo,FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const;
+    const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+    const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+    const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+    const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
 
-private:
-    VMesh::Node::index_type
-    edge_lookup(VField::index_type u0, VField::index_type u1, double d0,
-          const Point &p, detail::edge_hash_type &edgemap,
-          VMesh *clipped) const;
-};
+    nnodes[1] = out.edge(onodes[perm[0]], onodes[perm[1]], l1);
+    nnodes[2] = out.edge(onodes[perm[0]], onodes[perm[2]], l2);
 
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTri::edge_lookup(VField::index_type u0, VField::index_type u1, double d0, const Point &p, detail::edge_hash_type &edgemap, VMesh *clipped) const
-{
-  using namespace detail;
-  edgepair_t np;
-  if (u0 < u1)  { np.first = u0; np.second = u1; np.dfirst = d0; }
-  else { np.first = u1; np.second = u0; np.dfirst = 1.0 - d0; }
-  const auto loc = edgemap.find(np);
-  if (loc == edgemap.end())
-  {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    edgemap[np] = nodeindex;
-    return nodeindex;
+    out.cell(nnodes);
   }
   else
   {
-    return loc->second;
+    // Lop off the one point that is outside of the mesh, then add
+    // the remaining quad to the mesh by dicing it into two
+    // triangles.
+    const int *perm = tri_permute_table[inside];
+    VMesh::index_type inodes[4];
+    inodes[0] = out.node(onodes[perm[1]], p[perm[1]]);
+    inodes[1] = out.node(onodes[perm[2]], p[perm[2]]);
+
+    const double imv = isoval - v[perm[0]];
+    const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+    const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+    const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+    const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+
+    inodes[2] = out.edge(onodes[perm[0]], onodes[perm[1]], l1);
+    inodes[3] = out.edge(onodes[perm[0]], onodes[perm[2]], l2);
+
+    const VMesh::index_type cells[2][3] = {
+      { inodes[0], inodes[1], inodes[3] },
+      { inodes[0], inodes[3], inodes[2] } };
+    out.cell(cells[0]);
+    out.cell(cells[1]);
   }
 }
 
@@ -696,241 +601,55 @@ bool ClipMeshByIsovalueAlgoTri::run(const AlgorithmBase* algo, FieldHandle input
 
   using namespace detail;
 
-  node_hash_type nodemap;
-  edge_hash_type edgemap;
-
-  VMesh::Node::array_type onodes(3);
-  std::vector<double> v(3);
-  std::vector<Point>  p(3);
-
   double isoval = algo->get(ClipMeshByIsovalueAlgo::ScalarIsoValue).toDouble();
 
   bool lte = !algo->get(ClipMeshByIsovalueAlgo::LessThanIsoValue).toBool();
 
   VMesh::size_type num_elems = mesh->num_elems();
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
-  {
-    mesh->get_nodes(onodes, idx);
-
-    // Get the values and compute an inside/outside mask.
-    VField::index_type inside = 0;
-    mesh->get_centers(p, onodes);
-    field->get_values(v, onodes);
-
-    for (size_t i = 0; i < onodes.size(); i++)
-    {
-      inside = inside << 1;
-      if (v[i] > isoval)
-      {
-        inside |= 1;
-      }
-    }
+  ClippedMeshAssembler assembler(num_elems, 3);
+  std::vector<unsigned char> masks(num_elems);
 
-    // Invert the mask if we are doing less than.
-    if (lte) { inside = ~inside & 0x7; }
-
-    if (inside == 0)
-    {
-      // Discard outside elements.
-    }
-    else if (inside == 0x7)
+  // Classify the elements and count what each one adds.
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type onodes(3);
+    std::vector<double> v(3);
+    for (VMesh::Elem::index_type idx = begin; idx < static_cast<VMesh::index_type>(end); idx++)
     {
-      // Add this element to the new mesh.
-      VMesh::Node::array_type nnodes(onodes.size());
-
-      for (size_t i = 0; i<onodes.size(); i++)
-      {
-        if (nodemap.find((VField::index_type)onodes[i]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[i]);
-          nodemap[(VField::index_type)onodes[i]] = nodeindex;
-          nnodes[i] = nodeindex;
-        }
-        else
-        {
-          nnodes[i] = nodemap[(VField::index_type)onodes[i]];
-        }
-      }
-
-      clipped->add_elem(nnodes);
+      mesh->get_nodes(onodes, idx);
+      field->get_values(v, onodes);
+      masks[idx] = static_cast<unsigned char>(inside_mask<3>(v, isoval, lte));
+      VMesh::size_type requests, cells;
+      count(masks[idx], requests, cells);
+      assembler.set_counts(idx, requests, cells);
     }
-    else if (inside == 0x1 || inside == 0x2 || inside == 0x4)
-    {
-      // Add the corner containing the inside point to the mesh.
-      const int *perm = tri_permute_table[inside];
-      VMesh::Node::array_type nnodes(onodes.size());
-      if (nodemap.find((VField::index_type)onodes[perm[0]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex =
-            clipped->add_point(p[perm[0]]);
-        nodemap[(VField::index_type)onodes[perm[0]]] = nodeindex;
-        nnodes[0] = nodeindex;
-      }
-      else
-      {
-        nnodes[0] = nodemap[(VField::index_type)onodes[perm[0]]];
-      }
+  }, num_elems);
 
-      const double imv = isoval - v[perm[0]];
+  assembler.allocate();
 
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-
-
-      nnodes[1] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (index_type)onodes[perm[1]],
-			      dl1, l1, edgemap, clipped);
-
-      nnodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (index_type)onodes[perm[2]],
-			      dl2, l2, edgemap, clipped);
-
-      clipped->add_elem(nnodes);
-    }
-    else
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type onodes(3);
+    std::vector<double> v(3);
+    std::vector<Point> p(3);
+    for (VMesh::Elem::index_type idx = begin; idx < static_cast<VMesh::index_type>(end); idx++)
     {
-      // Lop off the one point that is outside of the mesh, then add
-      // the remaining quad to the mesh by dicing it into two
-      // triangles.
-      const int *perm = tri_permute_table[inside];
-      VMesh::Node::array_type inodes(4);
-      if (nodemap.find((index_type)onodes[perm[1]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[1]]);
-        nodemap[(VField::index_type)onodes[perm[1]]] = nodeindex;
-        inodes[0] = nodeindex;
-      }
-      else
-      {
-        inodes[0] = nodemap[(VField::index_type)onodes[perm[1]]];
-      }
-
-      if (nodemap.find((VField::index_type)onodes[perm[2]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[2]]);
-        nodemap[(VField::index_type)onodes[perm[2]]] = nodeindex;
-        inodes[1] = nodeindex;
-      }
-      else
-      {
-        inodes[1] = nodemap[(VField::index_type)onodes[perm[2]]];
-      }
-
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-
-      inodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (VField::index_type)onodes[perm[1]],
-			      dl1, l1, edgemap, clipped);
-
-      inodes[3] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (VField::index_type)onodes[perm[2]],
-			      dl2, l2, edgemap, clipped);
-
-      VMesh::Node::array_type nnodes(onodes.size());
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[3];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[2];
-      clipped->add_elem(nnodes);
+      if (masks[idx] == 0)
+        continue;
+      mesh->get_nodes(onodes, idx);
+      mesh->get_centers(p, onodes);
+      field->get_values(v, onodes);
+      ClippedMeshAssembler::ElementWriter out(assembler, idx);
+      clip_elem(out, masks[idx], onodes, v, p, isoval);
     }
-  }
+  }, num_elems);
 
   VField* ofield = output->vfield();
-  ofield->resize_values();
+  assembler.build(field, clipped, ofield, isoval);
   #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
    ofield->copy_properties(field);
   #endif
 
-  // Add the data values from the old field to the new field.
-  node_hash_type::iterator nmitr = nodemap.begin();
-  while (nmitr != nodemap.end())
-  {
-    ofield->copy_value(field,((*nmitr).first),((*nmitr).second));
-    ++nmitr;
-  }
-
-  // Put the isovalue at the edge break points.
-  edge_hash_type::iterator emitr = edgemap.begin();
-  while (emitr != edgemap.end())
-  {
-    ofield->set_value(isoval, ((*emitr).second));
-    ++emitr;
-  }
-
-  #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-  if(algo->get_bool("build_mapping"))
-  {
-    // Create the interpolant matrix.
-
-    const size_type nrows = clipped->num_nodes();
-    const size_type ncols = mesh->num_nodes();
-    std::vector<index_type> cctmp(nrows*2);
-    std::vector<double> dtmp(nrows*2);
-    SparseRowMatrix::Builder sparseBuilder;
-    const SparseRowMatrix::Rows& rr = sparseBuilder.allocate_rows(nrows + 1);
-
-    for (index_type i = 0; i < nrows * 2; i++)
-    {
-      cctmp[i] = -1;
-    }
-
-    size_type nnz = 0;
-
-    // Add the data values from the old field to the new field.
-    nmitr = nodemap.begin();
-    while (nmitr != nodemap.end())
-    {
-      cctmp[(*nmitr).second * 2] = (*nmitr).first;
-      dtmp[(*nmitr).second * 2 + 0] = 1.0;
-      nnz++;
-      ++nmitr;
-    }
-
-    // Insert the double hits into cc.
-    // Put the isovalue at the edge break points.
-    emitr = edgemap.begin();
-    while (emitr != edgemap.end())
-    {
-      cctmp[(*emitr).second * 2 + 0] = (*emitr).first.first;
-      cctmp[(*emitr).second * 2 + 1] = (*emitr).first.second;
-      dtmp[(*emitr).second * 2 + 0] = 1.0 - (*emitr).first.dfirst;
-      dtmp[(*emitr).second * 2 + 1] = (*emitr).first.dfirst;
-      nnz+=2;
-      ++emitr;
-    }
-
-    const SparseRowMatrix::Columns& cc = sparseBuilder.allocate_columns(nnz);
-    const SparseRowMatrix::Storage& d = sparseBuilder.allocate_data(nnz);
-
-    index_type j;
-    index_type counter = 0;
-    rr[0] = 0;
-    for (j = 0; j < nrows*2; j++)
-    {
-      if (j%2 == 0) { rr[j/2 + 1] = rr[j/2]; }
-      if (cctmp[j] != -1)
-      {
-        cc[counter] = cctmp[j];
-        d[counter] = dtmp[j];
-        rr[j/2 + 1]++;
-        counter++;
-      }
-    }
-    mapping = new SparseRowMatrix(nrows, ncols, sparseBuilder.build(), nnz);
-  }
-  #endif
-
   return (true);
 }
 
@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/DistanceFieldSweep.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
@@ -48,6 +49,7 @@ ALGORITHM_PARAMETER_DEF(Fields, Truncate);
 ALGORITHM_PARAMETER_DEF(Fields, TruncateDistance);
 ALGORITHM_PARAMETER_DEF(Fields, OutputFieldDatatype);
 ALGORITHM_PARAMETER_DEF(Fields, OutputValueField);
+ALGORITHM_PARAMETER_DEF(Fields, DistanceMethod);
 
 CalculateDistanceFieldAlgo::CalculateDistanceFieldAlgo()
 {
@@ -57,6 +59,7 @@ CalculateDistanceFieldAlgo::CalculateDistanceFieldAlgo()
   addParameter(OutputValueField, false);
   addOption(BasisType, "same as input","same as input|constant|linear");
   addOption(OutputFieldDatatype, "double","char|unsigned char|short|unsigned short|int|unsigned int|float|double");
+  addOption(DistanceMethod, "exact", "exact|fast sweeping (approximate)");
 }
 
 namespace detail
@@ -396,6 +399,28 @@ CalculateDistanceFieldAlgo::runImpl(FieldHandle input, FieldHandle object, Field
     return (true);
   }
 
+  // On a LatVol the distances can be swept through the grid from a band around the
+  // object instead of searching the closest element of every sample. This is an
+  // approximation outside the band, see DistanceFieldSweep.
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping (approximate)"))
+  {
+    if (DistanceFieldSweep::supports(imesh, objmesh, ofield->basis_order()))
+    {
+      double max = DBL_MAX;
+      if (get(Parameters::Truncate).toBool())
+        max = get(Parameters::TruncateDistance).toDouble();
+
+      DistanceFieldSweep sweep(imesh, objmesh, ofield->basis_order());
+      if (sweep.run(reinterpret_cast<double*>(ofield->get_values_pointer()), false, max))
+        return (true);
+      remark("Object does not come near enough to the grid for fast sweeping, computing exact distances.");
+    }
+    else
+    {
+      remark("Fast sweeping needs a LatVol with data on the nodes or cells and a linear triangle or quad surface, computing exact distances.");
+    }
+  }
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E);
 
   if (ofield->basis_order() > 2)
@@ -481,6 +506,9 @@ CalculateDistanceFieldAlgo::runImpl(FieldHandle input, FieldHandle object, Field
     return (true);
   }
 
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping (approximate)"))
+    remark("Closest values are only found by the exact method, computing exact distances.");
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E);
 
   if (distance->basis_order() > 2)
@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/DistanceFieldSweep.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
@@ -661,6 +662,7 @@ class CalculateSignedDistanceFieldP : public Interruptible
 CalculateSignedDistanceFieldAlgo::CalculateSignedDistanceFieldAlgo()
 {
   addParameter(OutputValueField, false);
+  addOption(DistanceMethod, "exact", "exact|fast sweeping (approximate)");
 }
 
 bool
@@ -718,6 +720,22 @@ CalculateSignedDistanceFieldAlgo::run(FieldHandle input, FieldHandle object, Fie
     return (true);
   }
 
+  if (checkOption(DistanceMethod, "fast sweeping (approximate)"))
+  {
+    if (DistanceFieldSweep::supports(imesh, objmesh, ofield->basis_order()))
+    {
+      objmesh->synchronize(Mesh::EDGES_E);
+      DistanceFieldSweep sweep(imesh, objmesh, ofield->basis_order());
+      if (sweep.run(reinterpret_cast<double*>(ofield->get_values_pointer()), true, DBL_MAX))
+        return (true);
+      remark("Object does not come near enough to the grid for fast sweeping, computing exact distances.");
+    }
+    else
+    {
+      remark("Fast sweeping needs a LatVol with data on the nodes or cells and a linear triangle or quad surface, computing exact distances.");
+    }
+  }
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E|Mesh::EDGES_E);
   CalculateSignedDistanceFieldP palgo(imesh, objmesh, ofield, this);
   const int numThreads = Parallel::NumCores();
@@ -800,6 +818,9 @@ CalculateSignedDistanceFieldAlgo::run(FieldHandle input, FieldHandle object, Fie
     return (true);
   }
 
+  if (checkOption(DistanceMethod, "fast sweeping (approximate)"))
+    remark("Closest values are only found by the exact method, computing exact distances.");
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E|Mesh::EDGES_E);
 
   if (distance->basis_order() > 2)
@@ -820,6 +841,7 @@ const AlgorithmInputName CalculateSignedDistanceFieldAlgo::ObjectField("ObjectFi
 const AlgorithmOutputName CalculateSignedDistanceFieldAlgo::SignedDistanceField("SignedDistanceField");
 const AlgorithmOutputName CalculateSignedDistanceFieldAlgo::ValueField("ValueField");
 const AlgorithmParameterName CalculateSignedDistanceFieldAlgo::OutputValueField("OutputValueField");
+const AlgorithmParameterName CalculateSignedDistanceFieldAlgo::DistanceMethod("DistanceMethod");
 
 AlgorithmOutput CalculateSignedDistanceFieldAlgo::run(const AlgorithmInput& input) const
 {
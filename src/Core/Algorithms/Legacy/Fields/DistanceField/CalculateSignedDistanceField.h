@@ -48,6 +48,7 @@ class SCISHARE CalculateSignedDistanceFieldAlgo : public AlgorithmBase, public T
     bool run(FieldHandle input, FieldHandle object, FieldHandle& distance, FieldHandle& value) const;
 
     static const AlgorithmParameterName OutputValueField;
+    static const AlgorithmParameterName DistanceMethod;
 
     static const AlgorithmInputName ObjectField;
     static const AlgorithmOutputName SignedDistanceField;
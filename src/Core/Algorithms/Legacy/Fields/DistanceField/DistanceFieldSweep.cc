@@ -0,0 +1,388 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Legacy/Fields/DistanceField/DistanceFieldSweep.h>
+#include <Core/GeometryPrimitives/CompGeom.h>
+#include <Core/Thread/Interruptible.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+const double DistanceFieldSweep::BandWidth = 2.0;
+
+bool DistanceFieldSweep::supports(VMesh* imesh, VMesh* objmesh, int basis_order)
+{
+  if (!imesh->is_latvolmesh() || (basis_order != 0 && basis_order != 1)) return (false);
+  if (!(objmesh->is_trisurfmesh() || objmesh->is_quadsurfmesh()) || !objmesh->is_linearmesh()) return (false);
+  if (objmesh->num_elems() >= INT_MAX) return (false);
+
+  VMesh::dimension_type dims;
+  imesh->get_dimensions(dims);
+  if (dims.size() != 3) return (false);
+  const VMesh::index_type cells = (basis_order == 0 ? 1 : 0);
+  for (size_t q = 0; q < 3; q++)
+    if (dims[q] - cells < 2) return (false);
+  return (true);
+}
+
+DistanceFieldSweep::DistanceFieldSweep(VMesh* imesh, VMesh* objmesh, int basis_order) :
+  objmesh_(objmesh)
+{
+  VMesh::dimension_type dims;
+  imesh->get_dimensions(dims);
+  const VMesh::index_type cells = (basis_order == 0 ? 1 : 0);
+  for (size_t q = 0; q < 3; q++)
+    dims_[q] = dims[q] - cells;
+
+  // The samples of a LatVol lie on an affine grid, spanned by the first sample along each axis.
+  const VMesh::index_type first[3] = { 1, dims_[0], dims_[0]*dims_[1] };
+  if (basis_order == 0)
+  {
+    imesh->get_center(origin_, VMesh::Elem::index_type(0));
+    for (size_t q = 0; q < 3; q++)
+    {
+      Point p;
+      imesh->get_center(p, VMesh::Elem::index_type(first[q]));
+      axis_[q] = p - origin_;
+    }
+  }
+  else
+  {
+    imesh->get_center(origin_, VMesh::Node::index_type(0));
+    for (size_t q = 0; q < 3; q++)
+    {
+      Point p;
+      imesh->get_center(p, VMesh::Node::index_type(first[q]));
+      axis_[q] = p - origin_;
+    }
+  }
+  spacing_ = std::min(axis_[0].length(), std::min(axis_[1].length(), axis_[2].length()));
+
+  const size_t num_nodes = objmesh->num_nodes();
+  const size_t num_elems = objmesh->num_elems();
+  nodesPerElem_ = (objmesh->is_trisurfmesh() ? 3 : 4);
+
+  points_.resize(num_nodes);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+      objmesh->get_point(points_[i], VMesh::Node::index_type(i));
+  }, num_nodes);
+
+  elems_.resize(num_elems * nodesPerElem_);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type nodes(nodesPerElem_);
+    for (size_t e = begin; e < end; e++)
+    {
+      objmesh->get_nodes(nodes, VMesh::Elem::index_type(e));
+      std::copy(nodes.begin(), nodes.end(), elems_.begin() + e * nodesPerElem_);
+    }
+  }, num_elems);
+
+  nodeElemOffsets_.assign(num_nodes + 1, 0);
+  for (auto node : elems_)
+    nodeElemOffsets_[node + 1]++;
+  for (size_t i = 0; i < num_nodes; i++)
+    nodeElemOffsets_[i + 1] += nodeElemOffsets_[i];
+  nodeElems_.resize(elems_.size());
+  std::vector<size_t> fill(nodeElemOffsets_.begin(), nodeElemOffsets_.end() - 1);
+  for (size_t i = 0; i < elems_.size(); i++)
+    nodeElems_[fill[elems_[i]]++] = static_cast<int>(i / nodesPerElem_);
+}
+
+double DistanceFieldSweep::distance(int elem, const Point& p, Point& closest) const
+{
+  const VMesh::index_type* nodes = &elems_[elem * nodesPerElem_];
+  if (nodesPerElem_ == 3)
+    closest_point_on_tri(closest, p, points_[nodes[0]], points_[nodes[1]], points_[nodes[2]]);
+  else
+    est_closest_point_on_quad(closest, p, points_[nodes[0]], points_[nodes[1]], points_[nodes[2]], points_[nodes[3]]);
+  return ((p - closest).length());
+}
+
+bool DistanceFieldSweep::negative_side(int elem, const Point& p, const Point& closest, double dist) const
+{
+  auto normal = [this](VMesh::index_type e)
+  {
+    const VMesh::index_type* nodes = &elems_[e * nodesPerElem_];
+    const Point& n0 = points_[nodes[0]];
+    const Point& n1 = points_[nodes[1]];
+    const Point& n2 = points_[nodes[2]];
+    return (Cross(Vector(n1 - n0), Vector(n2 - n1)));
+  };
+
+  Vector k = p - closest;
+  k.safe_normalize();
+  const double epsilon = objmesh_->get_epsilon();
+  const double angle = Dot(normal(elem), k);
+  if (angle < -epsilon) return (true);
+  if (angle > epsilon || dist == 0.0) return (false);
+
+  // The sample lies in the plane of the element, so the element that shares the
+  // closest edge decides.
+  VMesh::DElem::array_type delems;
+  VMesh::Node::array_type nodes;
+  objmesh_->get_delems(delems, VMesh::Elem::index_type(elem));
+  double mindist = DBL_MAX;
+  size_t edgeidx = 0;
+  for (size_t r = 0; r < delems.size(); r++)
+  {
+    objmesh_->get_nodes(nodes, delems[r]);
+    const Point& p1 = points_[nodes[0]];
+    const Point& p2 = points_[nodes[1]];
+    Vector v;
+    if (Dot(Vector(p - p2), Vector(p2 - p1)) >= 0.0) v = Vector(p - p2);
+    else if (Dot(Vector(p - p1), Vector(p1 - p2)) >= 0.0) v = Vector(p - p1);
+    else
+    {
+      Vector v1 = Vector(p1 - p2);
+      v = Vector(p - p2) - v1*(Dot(Vector(p - p2), v1) / Dot(v1, v1));
+    }
+    if (v.length2() < mindist) { mindist = v.length2(); edgeidx = r; }
+  }
+
+  VMesh::Elem::index_type neighbor;
+  if (delems.empty() || !objmesh_->get_neighbor(neighbor, VMesh::Elem::index_type(elem), delems[edgeidx]))
+    return (false);
+  return (Dot(normal(neighbor), k) < 0.0);
+}
+
+size_t DistanceFieldSweep::seed_band(double* values, std::vector<int>& closest, std::vector<char>& band) const
+{
+  const size_t num_elems = elems_.size() / nodesPerElem_;
+  const double width = BandWidth * spacing_;
+
+  // Every element covers the samples within the band width of its bounding box, found
+  // by mapping the corners of that box to grid coordinates.
+  Vector inverse[3];
+  const double det = Dot(axis_[0], Cross(axis_[1], axis_[2]));
+  for (size_t q = 0; q < 3; q++)
+    inverse[q] = Cross(axis_[(q + 1) % 3], axis_[(q + 2) % 3]) * (1.0 / det);
+
+  std::vector<VMesh::index_type> boxes(num_elems * 6);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t e = begin; e < end; e++)
+    {
+      Point lo = points_[elems_[e * nodesPerElem_]];
+      Point hi = lo;
+      for (size_t j = 1; j < nodesPerElem_; j++)
+      {
+        lo = Min(lo, points_[elems_[e * nodesPerElem_ + j]]);
+        hi = Max(hi, points_[elems_[e * nodesPerElem_ + j]]);
+      }
+      lo -= Vector(width, width, width);
+      hi += Vector(width, width, width);
+
+      VMesh::index_type* box = &boxes[e * 6];
+      for (size_t q = 0; q < 3; q++)
+      {
+        double umin = DBL_MAX, umax = -DBL_MAX;
+        for (int c = 0; c < 8; c++)
+        {
+          const Point corner((c & 1) ? hi.x() : lo.x(), (c & 2) ? hi.y() : lo.y(), (c & 4) ? hi.z() : lo.z());
+          const double u = Dot(inverse[q], corner - origin_);
+          umin = std::min(umin, u);
+          umax = std::max(umax, u);
+        }
+        // Clamped in floating point first, as far away elements may not fit an index.
+        umin = std::max(umin, -1.0);
+        umax = std::min(umax, static_cast<double>(dims_[q]));
+        box[q] = static_cast<VMesh::index_type>(std::ceil(umin));
+        box[q + 3] = static_cast<VMesh::index_type>(std::floor(umax));
+        box[q] = std::max<VMesh::index_type>(box[q], 0);
+        box[q + 3] = std::min<VMesh::index_type>(box[q + 3], dims_[q] - 1);
+      }
+    }
+  }, num_elems);
+
+  // Slabs of z-slices are seeded independently. Within a slab the elements are visited
+  // in order and only a strictly closer element replaces an earlier one, so ties go to
+  // the lowest element index however the slabs are cut.
+  const VMesh::index_type nx = dims_[0], ny = dims_[1], nz = dims_[2];
+  const int numSlabs = static_cast<int>(std::max<VMesh::index_type>(1, std::min<VMesh::index_type>(Parallel::NumCores(), nz)));
+  std::vector<size_t> band_size(numSlabs, 0);
+  Parallel::RunTasks([&](int s)
+  {
+    const VMesh::index_type k0 = nz * s / numSlabs;
+    const VMesh::index_type k1 = nz * (s + 1) / numSlabs;
+    Point c;
+    for (size_t e = 0; e < num_elems; e++)
+    {
+      const VMesh::index_type* box = &boxes[e * 6];
+      if (box[0] > box[3] || box[1] > box[4]) continue;
+      const VMesh::index_type kmin = std::max(box[2], k0), kmax = std::min(box[5], k1 - 1);
+      if (kmin > kmax) continue;
+
+      Interruptible::checkForInterruption();
+      for (VMesh::index_type k = kmin; k <= kmax; k++)
+        for (VMesh::index_type j = box[1]; j <= box[4]; j++)
+          for (VMesh::index_type i = box[0]; i <= box[3]; i++)
+          {
+            const VMesh::index_type v = (k*ny + j)*nx + i;
+            const double d = distance(static_cast<int>(e), sample(i, j, k), c);
+            if (d < values[v])
+            {
+              values[v] = d;
+              closest[v] = static_cast<int>(e);
+            }
+          }
+    }
+
+    for (VMesh::index_type v = k0*nx*ny; v < k1*nx*ny; v++)
+    {
+      band[v] = (closest[v] >= 0 && values[v] <= width);
+      band_size[s] += band[v];
+    }
+  }, numSlabs);
+
+  size_t total = 0;
+  for (auto n : band_size) total += n;
+  return (total);
+}
+
+void DistanceFieldSweep::sweep(int axis, bool forward, double* values, std::vector<int>& closest, const std::vector<char>& band) const
+{
+  const VMesh::index_type stride[3] = { 1, dims_[0], dims_[0]*dims_[1] };
+  const int b = (axis + 1) % 3, c = (axis + 2) % 3;
+  const VMesh::index_type n = dims_[axis];
+  const VMesh::index_type step = (forward ? stride[axis] : -stride[axis]);
+
+  // The lines along an axis do not share samples, so they are swept independently.
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    Point cp;
+    for (size_t line = begin; line < end; line++)
+    {
+      Interruptible::checkForInterruption();
+      const VMesh::index_type ib = static_cast<VMesh::index_type>(line) % dims_[b];
+      const VMesh::index_type ic = static_cast<VMesh::index_type>(line) / dims_[b];
+      const Point base = origin_ + axis_[b]*static_cast<double>(ib) + axis_[c]*static_cast<double>(ic);
+
+      VMesh::index_type t = (forward ? 0 : n - 1);
+      VMesh::index_type v = ib*stride[b] + ic*stride[c] + t*stride[axis];
+      for (VMesh::index_type q = 1; q < n; q++)
+      {
+        const VMesh::index_type prev = v;
+        v += step;
+        t += (forward ? 1 : -1);
+        const int e = closest[prev];
+        if (band[v] || e < 0 || e == closest[v]) continue;
+
+        const double d = distance(e, base + axis_[axis]*static_cast<double>(t), cp);
+        if (closest[v] < 0 || d < values[v])
+        {
+          values[v] = d;
+          closest[v] = e;
+        }
+      }
+    }
+  }, static_cast<size_t>(dims_[b] * dims_[c]));
+}
+
+bool DistanceFieldSweep::run(double* values, bool signed_distance, double max) const
+{
+  const size_t num_samples = static_cast<size_t>(dims_[0] * dims_[1] * dims_[2]);
+  std::vector<int> closest(num_samples, -1);
+  std::vector<char> band(num_samples, 0);
+  std::fill(values, values + num_samples, DBL_MAX);
+
+  if (seed_band(values, closest, band) == 0) return (false);
+
+  // Two rounds of sweeps in all six directions; the first one already reaches every sample.
+  for (int round = 0; round < 2; round++)
+    for (int axis = 0; axis < 3; axis++)
+    {
+      sweep(axis, true, values, closest, band);
+      sweep(axis, false, values, closest, band);
+    }
+
+  // Outside the band the element found by the sweeps is improved by moving to a closer
+  // element that shares a node with it, for as long as there is one.
+  const VMesh::index_type nx = dims_[0], ny = dims_[1];
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    Point c;
+    std::vector<int> visited;
+    for (size_t v = begin; v < end; v++)
+    {
+      if ((v - begin) % 4096 == 0) Interruptible::checkForInterruption();
+      const VMesh::index_type idx = static_cast<VMesh::index_type>(v);
+      const Point p = sample(idx % nx, (idx / nx) % ny, idx / (nx*ny));
+      if (!band[v])
+      {
+        bool moved = true;
+        while (moved)
+        {
+          moved = false;
+          const int e = closest[v];
+          visited.assign(1, e);
+          for (size_t j = 0; j < nodesPerElem_; j++)
+          {
+            const VMesh::index_type node = elems_[e * nodesPerElem_ + j];
+            for (size_t q = nodeElemOffsets_[node]; q < nodeElemOffsets_[node + 1]; q++)
+            {
+              const int f = nodeElems_[q];
+              if (std::find(visited.begin(), visited.end(), f) != visited.end()) continue;
+              visited.push_back(f);
+              const double d = distance(f, p, c);
+              if (d < values[v])
+              {
+                values[v] = d;
+                closest[v] = f;
+                moved = true;
+              }
+            }
+          }
+        }
+      }
+
+      if (signed_distance)
+      {
+        distance(closest[v], p, c);
+        if (negative_side(closest[v], p, c, values[v])) values[v] = -values[v];
+      }
+      else if (values[v] > max)
+      {
+        values[v] = max;
+      }
+    }
+  }, num_samples);
+
+  return (true);
+}
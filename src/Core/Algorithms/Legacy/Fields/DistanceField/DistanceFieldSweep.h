@@ -0,0 +1,103 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_DISTANCEFIELDSWEEP_H
+#define CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_DISTANCEFIELDSWEEP_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Point.h>
+
+#include <vector>
+
+// for Windows support
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun{
+  namespace Core{
+    namespace Algorithms{
+      namespace Fields{
+
+        // Approximate distance from the samples of a regular grid to a tri or quad surface,
+        // without a closest element search per sample. Samples within a narrow band around
+        // the surface get the exact distance to every element near them. The closest element
+        // is then passed on from sample to sample by sweeping the grid lines forward and
+        // backward along each axis, and every sample takes the element of a neighbor if
+        // that one is closer. Last, every sample outside the band moves on to a closer
+        // element sharing a node with its current one until there is none.
+        //
+        // Inside the band the distances are exact. Outside it, every value is the distance
+        // to an actual element and so never below the exact one, but the walk can stop in
+        // a local minimum. Near concave parts of the surface, or between two surfaces, a
+        // sample may then keep an element that is slightly farther than the closest one,
+        // and for a signed distance take its side.
+        class SCISHARE DistanceFieldSweep
+        {
+        public:
+          // The samples are the nodes (basis order 1) or the cell centers (basis order 0)
+          // of a LatVol that has at least two of them along every axis.
+          static bool supports(VMesh* imesh, VMesh* objmesh, int basis_order);
+
+          DistanceFieldSweep(VMesh* imesh, VMesh* objmesh, int basis_order);
+
+          // Fills values, one per sample in the order of the field data, with the distance
+          // of every sample truncated at max. For a signed distance the side of the surface
+          // follows from the normal of the closest element. Returns false if no sample lies
+          // in the band, the surface is then too far away from the grid to sweep from.
+          bool run(double* values, bool signed_distance, double max) const;
+
+          // Width of the band of exact distances, in grid spacings.
+          static const double BandWidth;
+
+        private:
+          Geometry::Point sample(VMesh::index_type i, VMesh::index_type j, VMesh::index_type k) const
+            { return (origin_ + axis_[0]*static_cast<double>(i) + axis_[1]*static_cast<double>(j) + axis_[2]*static_cast<double>(k)); }
+
+          double distance(int elem, const Geometry::Point& p, Geometry::Point& closest) const;
+          bool negative_side(int elem, const Geometry::Point& p, const Geometry::Point& closest, double dist) const;
+          size_t seed_band(double* values, std::vector<int>& closest, std::vector<char>& band) const;
+          void sweep(int axis, bool forward, double* values, std::vector<int>& closest, const std::vector<char>& band) const;
+
+          VMesh* objmesh_;
+          VMesh::index_type dims_[3];
+          Geometry::Point origin_;
+          Geometry::Vector axis_[3];
+          double spacing_;
+
+          size_t nodesPerElem_;
+          std::vector<Geometry::Point> points_;
+          std::vector<VMesh::index_type> elems_;
+          std::vector<size_t> nodeElemOffsets_;
+          std::vector<int> nodeElems_;
+        };
+      }
+    }
+  }
+}
+
+#endif
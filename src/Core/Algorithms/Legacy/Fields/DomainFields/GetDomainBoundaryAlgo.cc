@@ -25,8 +25,8 @@
    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
    DEALINGS IN THE SOFTWARE.
 */
-
 #include <Core/Algorithms/Legacy/Fields/DomainFields/GetDomainBoundaryAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ElementFaceTable.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
@@ -37,6 +37,7 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
 #include <Core/Logging/Log.h>
+#include <Core/Thread/Parallel.h>
 
 #include <boost/unordered_map.hpp>
 
@@ -46,6 +47,7 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields, MinRange);
 ALGORITHM_PARAMETER_DEF(Fields, MaxRange);
@@ -65,8 +67,163 @@ struct pointtype
   bool hasneighbor;
 };
 
+namespace
+{
+  /// Decides whether a face is part of the requested boundary and which value
+  /// it gets. val1 belongs to the element owning the face, val2 to its neighbor
+  /// and is not used for faces on the outside of the mesh.
+  struct DomainBoundaryRule
+  {
+    int minval;
+    int maxval;
+    bool userange;
+    bool addouterboundary;
+    bool innerboundaryonly;
+    bool noinnerboundary;
+
+    bool in_range(int val) const { return ((val >= minval)&&(val <= maxval)); }
+
+    bool include(bool neighborexist, int val1, int val2, int& newval) const
+    {
+      if (neighborexist)
+      {
+        if (!innerboundaryonly)
+        {
+          if (noinnerboundary)
+          {
+            if (in_range(val1) && !in_range(val2) && userange) { newval = val1; return true; }
+            if (in_range(val2) && !in_range(val1) && userange) { newval = val2; return true; }
+            return false;
+          }
+
+          if ((in_range(val1) || in_range(val2) || !userange) && (val1 != val2))
+          {
+            newval = in_range(val1) ? val1 : val2;
+            return true;
+          }
+          return false;
+        }
+
+        if (((in_range(val1) && in_range(val2)) || !userange) && (val1 != val2))
+        {
+          newval = std::min(val1, val2);
+          return true;
+        }
+        return false;
+      }
+
+      if (addouterboundary && !innerboundaryonly && (in_range(val1) || !userange))
+      {
+        newval = val1;
+        return true;
+      }
+      return false;
+    }
+  };
+
+  /// Boundary nodes are shared by all faces unless boundaries are disconnected;
+  /// then faces only share nodes with faces between the same two values.
+  typedef std::tuple<int, int, int> NodeSheet;
+
+  struct BoundaryFace
+  {
+    size_t slot;
+    int value;
+    NodeSheet sheet;
+  };
+
+  /// Finds the boundary of a tet or tri mesh by sorting the keys of all element
+  /// faces: every face appears once, owned by the lowest numbered element using
+  /// it, and the faces come out ordered by owner and local face.
+  void add_domain_boundary_by_sorting(VMesh* imesh, VField* ifield, VMesh* omesh,
+    const DomainBoundaryRule& rule, bool disconnect,
+    std::vector<int>& newvalues, std::vector<index_type>& newelems)
+  {
+    ElementFaceTable table(imesh);
+    const size_t num_slots = table.num_slots();
+    const size_t npf = table.nodes_per_face();
+
+    std::vector<int> values(table.num_elems());
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t e = begin; e < end; e++)
+        ifield->value(values[e], VMesh::Elem::index_type(e));
+    }, values.size());
+
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_slots / 1024));
+    std::vector<std::vector<BoundaryFace> > block_faces(numBlocks);
+    Parallel::RunTasks([&](int b)
+    {
+      for (size_t s = num_slots * b / numBlocks; s < num_slots * (b + 1) / numBlocks; s++)
+      {
+        const index_type ci = table.elem(s);
+        const index_type nci = table.neighbor(s);
+        if (nci >= 0 && nci < ci) continue;
+
+        const bool neighborexist = (nci >= 0);
+        const int val1 = values[ci];
+        const int val2 = neighborexist ? values[nci] : 0;
+        BoundaryFace face;
+        if (!rule.include(neighborexist, val1, val2, face.value)) continue;
+
+        face.slot = s;
+        if (neighborexist)
+          face.sheet = NodeSheet(std::min(val1, val2), std::max(val1, val2), 1);
+        else
+          face.sheet = NodeSheet(val1, 0, 0);
+        block_faces[b].push_back(face);
+      }
+    }, static_cast<int>(numBlocks));
+
+    std::vector<BoundaryFace> faces;
+    for (auto& block : block_faces)
+    {
+      faces.insert(faces.end(), block.begin(), block.end());
+      std::vector<BoundaryFace>().swap(block);
+    }
+
+    const size_t num_faces = faces.size();
+    std::vector<index_type> face_nodes(num_faces * npf);
+    newvalues.resize(num_faces);
+    newelems.resize(num_faces);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t f = begin; f < end; f++)
+      {
+        table.get_face_nodes(faces[f].slot, &face_nodes[f * npf]);
+        newvalues[f] = faces[f].value;
+        newelems[f] = table.elem(faces[f].slot);
+      }
+    }, num_faces);
+
+    std::vector<index_type> node_map;
+    compact_face_nodes(face_nodes, npf,
+      [&](size_t f) { return (disconnect ? faces[f].sheet : NodeSheet(0, 0, 0)); }, node_map);
+
+    std::vector<Point> points(node_map.size());
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+        imesh->get_center(points[i], VMesh::Node::index_type(node_map[i]));
+    }, points.size());
+
+    omesh->node_reserve(points.size());
+    for (const auto& p : points)
+      omesh->add_point(p);
+
+    omesh->elem_reserve(num_faces);
+    VMesh::Node::array_type onodes(npf);
+    for (size_t f = 0; f < num_faces; f++)
+    {
+      std::copy(face_nodes.begin() + f * npf, face_nodes.begin() + (f + 1) * npf, onodes.begin());
+      omesh->add_elem(onodes);
+    }
+  }
+}
+
 AlgorithmInputName GetDomainBoundaryAlgo::ElemLink("ElemLink");
 AlgorithmOutputName GetDomainBoundaryAlgo::BoundaryField("BoundaryField");
+AlgorithmOutputName GetDomainBoundaryAlgo::MappingMatrix("Mapping");
 
 GetDomainBoundaryAlgo::GetDomainBoundaryAlgo()
 {
@@ -83,6 +240,13 @@ GetDomainBoundaryAlgo::GetDomainBoundaryAlgo()
 
 bool
 GetDomainBoundaryAlgo::runImpl(FieldHandle input, SparseRowMatrixHandle domainlink, FieldHandle& output) const
+{
+  MatrixHandle mapping;
+  return runImpl(input, domainlink, output, mapping);
+}
+
+bool
+GetDomainBoundaryAlgo::runImpl(FieldHandle input, SparseRowMatrixHandle domainlink, FieldHandle& output, MatrixHandle& mapping) const
 {
   typedef boost::unordered_multimap<index_type,pointtype> pointhash_map_type;
 
@@ -112,6 +276,8 @@ GetDomainBoundaryAlgo::runImpl(FieldHandle input, SparseRowMatrixHandle domainli
     minval, maxval, domval, userange, addouterboundary, innerboundaryonly,
     noinnerboundary, disconnect);
 
+  const DomainBoundaryRule rule = { minval, maxval, userange, addouterboundary, innerboundaryonly, noinnerboundary };
+
   if (!input)
   {
     error("No input field");
@@ -177,368 +343,273 @@ GetDomainBoundaryAlgo::runImpl(FieldHandle input, SparseRowMatrixHandle domainli
   auto imesh =  input->vmesh();
   auto omesh =  output->vmesh();
 
-  imesh->synchronize(Mesh::DELEMS_E|Mesh::ELEM_NEIGHBORS_E|Mesh::NODE_NEIGHBORS_E);
-
-  VMesh::DElem::size_type numdelems = imesh->num_delems();
-
-  bool isdomlink = false;
-  const index_type* domlinkrr = nullptr;
-  const index_type* domlinkcc = nullptr;
-
   std::vector<int> newvalues;
+  /// The input element owning every boundary element
+  std::vector<index_type> newelems;
 
-  if (domainlink)
+  if (!domainlink && ElementFaceTable::supports(imesh))
   {
-    if ((numdelems != domainlink->nrows())&&(numdelems != domainlink->ncols()))
-    {
-      error("The Domain Link property is not of the right dimensions");
-      return false;
-    }
-    domlinkrr = domainlink->get_rows();
-    domlinkcc = domainlink->get_cols();
-    isdomlink = true;
+    add_domain_boundary_by_sorting(imesh, ifield, omesh, rule, disconnect, newvalues, newelems);
   }
-
-  if (disconnect)
+  else
   {
-    pointhash_map_type node_map;
+    imesh->synchronize(Mesh::DELEMS_E|Mesh::ELEM_NEIGHBORS_E|Mesh::NODE_NEIGHBORS_E);
 
-    VMesh::Elem::index_type nci, ci;
-    VMesh::Elem::array_type elements;
-    VMesh::DElem::array_type delems;
-    VMesh::Node::array_type inodes;
-    VMesh::Node::array_type onodes;
-    VMesh::Node::index_type a;
+    VMesh::DElem::size_type numdelems = imesh->num_delems();
 
-    int val1, val2, newval;
+    bool isdomlink = false;
+    const index_type* domlinkrr = nullptr;
+    const index_type* domlinkcc = nullptr;
 
-    Point point;
-
-    index_type cnt = 0;
+    if (domainlink)
+    {
+      if ((numdelems != domainlink->nrows())&&(numdelems != domainlink->ncols()))
+      {
+        error("The Domain Link property is not of the right dimensions");
+        return false;
+      }
+      domlinkrr = domainlink->get_rows();
+      domlinkcc = domainlink->get_cols();
+      isdomlink = true;
+    }
 
-    for(VMesh::DElem::index_type delem = 0; delem < numdelems; ++delem)
+    if (disconnect)
     {
-      checkForInterruption();
+      pointhash_map_type node_map;
 
-      bool neighborexist = false;
-      bool includeface = false;
+      VMesh::Elem::index_type nci, ci;
+      VMesh::Elem::array_type elements;
+      VMesh::DElem::array_type delems;
+      VMesh::Node::array_type inodes;
+      VMesh::Node::array_type onodes;
+      VMesh::Node::index_type a;
 
-      imesh->get_elems(elements,delem);
-      ci = elements[0];
-      if (elements.size() > 1)
-      {
-        neighborexist = true;
-        nci  = elements[1];
-      }
+      int val1, val2, newval;
+
+      Point point;
 
-      if ((!neighborexist)&&(isdomlink))
+      index_type cnt = 0;
+
+      for(VMesh::DElem::index_type delem = 0; delem < numdelems; ++delem)
       {
-        for (auto rr = domlinkrr[delem]; rr < domlinkrr[delem+1]; rr++)
-        {
-          VMesh::DElem::index_type idx = domlinkcc[rr];
-          VMesh::Node::array_type nodes;
-          VMesh::Elem::array_type elems;
-          VMesh::DElem::array_type delems2;
+        checkForInterruption();
+
+        bool neighborexist = false;
+        bool includeface = false;
 
-          imesh->get_nodes(nodes,idx);
-          imesh->get_elems(elems,nodes[0]);
+        imesh->get_elems(elements,delem);
+        ci = elements[0];
+        if (elements.size() > 1)
+        {
+          neighborexist = true;
+          nci  = elements[1];
+        }
 
-          for (size_t r=0; r<elems.size(); r++)
+        if ((!neighborexist)&&(isdomlink))
+        {
+          for (auto rr = domlinkrr[delem]; rr < domlinkrr[delem+1]; rr++)
           {
-            imesh->get_delems(delems2,elems[r]);
+            VMesh::DElem::index_type idx = domlinkcc[rr];
+            VMesh::Node::array_type nodes;
+            VMesh::Elem::array_type elems;
+            VMesh::DElem::array_type delems2;
+
+            imesh->get_nodes(nodes,idx);
+            imesh->get_elems(elems,nodes[0]);
 
-            for (size_t s=0; s<delems2.size(); s++)
+            for (size_t r=0; r<elems.size(); r++)
             {
-              if (delems2[s]==idx)
+              imesh->get_delems(delems2,elems[r]);
+
+              for (size_t s=0; s<delems2.size(); s++)
               {
-                nci = elems[r];
-                neighborexist = true;
-                break;
+                if (delems2[s]==idx)
+                {
+                  nci = elems[r];
+                  neighborexist = true;
+                  break;
+                }
               }
+              if (neighborexist) break;
             }
             if (neighborexist) break;
           }
-          if (neighborexist) break;
         }
-      }
 
-      if (neighborexist)
-      {
         ifield->value(val1,ci);
-        ifield->value(val2,nci);
-        if (!innerboundaryonly)
+        val2 = 0;
+        if (neighborexist) ifield->value(val2,nci);
+        includeface = rule.include(neighborexist, val1, val2, newval);
+
+        if (includeface)
         {
-          if (noinnerboundary)
+          imesh->get_nodes(inodes,delem);
+          onodes.resize(inodes.size());
+          for (size_t q=0; q< onodes.size(); q++)
           {
-            if ((((val1 >= minval)&&(val1 <= maxval)&&
-                (!((val2 >= minval)&&(val2 <= maxval))))&&
-                (userange)))
+            checkForInterruption();
+            a = inodes[q];
+
+            std::pair<pointhash_map_type::iterator,pointhash_map_type::iterator> lit;
+            lit = node_map.equal_range(a);
+
+            VMesh::Node::index_type nodci;
+            int v1, v2;
+            bool hasneighbor;
+
+            if (neighborexist)
             {
-              newval = val1;
-              includeface = true;
+              if (val1 < val2) { v1 = val1; v2 = val2; } else { v1 = val2; v2 = val1; }
+              hasneighbor = true;
             }
-            else if (((val2 >= minval)&&(val2 <= maxval)&&
-                (!((val1 >= minval)&&(val1 <= maxval))))&&
-                (userange))
+            else
             {
-              newval = val2;
-              includeface = true;
+              v1 = val1; v2 = 0;
+              hasneighbor = false;
             }
-          }
-          else
-          {
-            if ((((val1 >= minval)&&(val1 <= maxval))||
-                ((val2 >= minval)&&(val2 <= maxval)))||
-                (!userange))
+
+            while (lit.first != lit.second)
             {
-              if (!(val1 == val2))
+              if (((*(lit.first)).second.val1 == v1)&&
+                  ((*(lit.first)).second.val2 == v2)&&
+                  ((*(lit.first)).second.hasneighbor == hasneighbor))
               {
-                includeface = true;
-                if((val1 >= minval)&&(val1 <= maxval)) newval = val1;
-                else newval = val2;
+                nodci = (*(lit.first)).second.node;
+                break;
               }
+              ++(lit.first);
             }
-          }
-        }
-        else
-        {
-          if ((((val1 >= minval)&&(val2 >= minval))&&
-              ((val1 <= maxval)&&(val2 <= maxval)))||
-              (!userange))
-          {
-            if (!(val1 == val2))
+
+            if (lit.first == lit.second)
             {
-              includeface = true;
-              newval = val1;
-              if (val2 < newval) newval = val2;
+              pointtype newpoint;
+              imesh->get_center(point,a);
+              onodes[q] = omesh->add_point(point);
+              newpoint.node = onodes[q];
+              newpoint.val1 = v1;
+              newpoint.val2 = v2;
+              newpoint.hasneighbor = hasneighbor;
+              node_map.insert(pointhash_map_type::value_type(a,newpoint));
             }
-          }
-        }
-      }
-      else if ((addouterboundary)&&(!innerboundaryonly))
-      {
-        ifield->value(val1,ci);
-        if (((val1 >= minval)&&(val1 <= maxval))||(!userange))
-        {
-          newval = val1;
-          includeface = true;
-        }
-      }
-
-      if (includeface)
-      {
-        imesh->get_nodes(inodes,delem);
-        onodes.resize(inodes.size());
-        for (size_t q=0; q< onodes.size(); q++)
-        {
-          checkForInterruption();
-          a = inodes[q];
-
-          std::pair<pointhash_map_type::iterator,pointhash_map_type::iterator> lit;
-          lit = node_map.equal_range(a);
-
-          VMesh::Node::index_type nodci;
-          int v1, v2;
-          bool hasneighbor;
-
-          if (neighborexist)
-          {
-            if (val1 < val2) { v1 = val1; v2 = val2; } else { v1 = val2; v2 = val1; }
-            hasneighbor = true;
-          }
-          else
-          {
-            v1 = val1; v2 = 0;
-            hasneighbor = false;
-          }
-
-          while (lit.first != lit.second)
-          {
-            if (((*(lit.first)).second.val1 == v1)&&
-                ((*(lit.first)).second.val2 == v2)&&
-                ((*(lit.first)).second.hasneighbor == hasneighbor))
+            else
             {
-              nodci = (*(lit.first)).second.node;
-              break;
+              onodes[q] = nodci;
             }
-            ++(lit.first);
-          }
 
-          if (lit.first == lit.second)
-          {
-            pointtype newpoint;
-            imesh->get_center(point,a);
-            onodes[q] = omesh->add_point(point);
-            newpoint.node = onodes[q];
-            newpoint.val1 = v1;
-            newpoint.val2 = v2;
-            newpoint.hasneighbor = hasneighbor;
-            node_map.insert(pointhash_map_type::value_type(a,newpoint));
           }
-          else
-          {
-            onodes[q] = nodci;
-          }
-
+          omesh->add_elem(onodes);
+          newvalues.push_back(newval);
+          newelems.push_back(ci);
         }
-        omesh->add_elem(onodes);
-        newvalues.push_back(newval);
+        cnt++; if (cnt == 100) update_progress_max(delem,numdelems);
       }
-      cnt++; if (cnt == 100) update_progress_max(delem,numdelems);
     }
-  }
-  else
-  {
-    std::vector<VMesh::Node::index_type> node_map(imesh->num_nodes(),-1);
-
-    VMesh::Elem::index_type nci, ci;
-    VMesh::Elem::array_type elements;
-    VMesh::DElem::array_type delems;
-    VMesh::Node::array_type inodes;
-    VMesh::Node::array_type onodes;
-    VMesh::Node::index_type a;
-    int val1, val2, newval;
-
-    Point point;
+    else
+    {
+      std::vector<VMesh::Node::index_type> node_map(imesh->num_nodes(),-1);
 
-    index_type cnt = 0;
+      VMesh::Elem::index_type nci, ci;
+      VMesh::Elem::array_type elements;
+      VMesh::DElem::array_type delems;
+      VMesh::Node::array_type inodes;
+      VMesh::Node::array_type onodes;
+      VMesh::Node::index_type a;
+      int val1, val2, newval;
 
-    for(VMesh::DElem::index_type delem = 0; delem < numdelems; ++delem)
-    {
-      checkForInterruption();
+      Point point;
 
-      bool neighborexist = false;
-      bool includeface = false;
+      index_type cnt = 0;
 
-      imesh->get_elems(elements,delem);
-      ci = elements[0];
-      if (elements.size() > 1)
+      for(VMesh::DElem::index_type delem = 0; delem < numdelems; ++delem)
       {
-        neighborexist = true;
-        nci  = elements[1];
-      }
+        checkForInterruption();
 
-      if ((!neighborexist)&&(isdomlink))
-      {
-        for (auto rr = domlinkrr[delem]; rr < domlinkrr[delem+1]; rr++)
-        {
-          VMesh::DElem::index_type idx = domlinkcc[rr];
-          VMesh::Node::array_type nodes;
-          VMesh::Elem::array_type elems;
-          VMesh::DElem::array_type delems2;
+        bool neighborexist = false;
+        bool includeface = false;
 
-          imesh->get_nodes(nodes,idx);
-          imesh->get_elems(elems,nodes[0]);
+        imesh->get_elems(elements,delem);
+        ci = elements[0];
+        if (elements.size() > 1)
+        {
+          neighborexist = true;
+          nci  = elements[1];
+        }
 
-          for (size_t r=0; r<elems.size(); r++)
+        if ((!neighborexist)&&(isdomlink))
+        {
+          for (auto rr = domlinkrr[delem]; rr < domlinkrr[delem+1]; rr++)
           {
-            imesh->get_delems(delems2,elems[r]);
+            VMesh::DElem::index_type idx = domlinkcc[rr];
+            VMesh::Node::array_type nodes;
+            VMesh::Elem::array_type elems;
+            VMesh::DElem::array_type delems2;
+
+            imesh->get_nodes(nodes,idx);
+            imesh->get_elems(elems,nodes[0]);
 
-            for (size_t s=0; s<delems2.size(); s++)
+            for (size_t r=0; r<elems.size(); r++)
             {
-              if (delems2[s]==idx) { nci = elems[r]; neighborexist = true; break; }
+              imesh->get_delems(delems2,elems[r]);
+
+              for (size_t s=0; s<delems2.size(); s++)
+              {
+                if (delems2[s]==idx) { nci = elems[r]; neighborexist = true; break; }
+              }
+              if (neighborexist) break;
             }
             if (neighborexist) break;
           }
-          if (neighborexist) break;
         }
-      }
 
-      if (neighborexist)
-      {
         ifield->value(val1,ci);
-        ifield->value(val2,nci);
-        if (!innerboundaryonly)
+        val2 = 0;
+        if (neighborexist) ifield->value(val2,nci);
+        includeface = rule.include(neighborexist, val1, val2, newval);
+
+        if (includeface)
         {
-          if (noinnerboundary)
+          imesh->get_nodes(inodes,delem);
+          onodes.resize(inodes.size());
+
+          for (size_t q=0; q< onodes.size(); q++)
           {
-            if (((val1 >= minval)&&(val1 <= maxval)&&
-                (!((val2 >= minval)&&(val2 <= maxval))))&&
-                (userange))
+            checkForInterruption();
+            a = inodes[q];
+            if (node_map[a] == -1)
             {
-              newval = val1;
-              includeface = true;
+              imesh->get_center(point,a);
+              onodes[q] = omesh->add_point(point);
+              node_map[a] = onodes[q];
             }
-            else if(((val2 >= minval)&&(val2 <= maxval)&&
-                (!((val1 >= minval)&&(val1 <= maxval))))&&
-                (userange))
+            else
             {
-              newval = val2;
-              includeface = true;
+              onodes[q] = node_map[a];
             }
-          }
-          else
-          {
-            if ((((val1 >= minval)&&(val1 <= maxval))||
-                ((val2 >= minval)&&(val2 <= maxval)))||
-                (!userange))
-            {
-              if (!(val1 == val2))
-              {
-                includeface = true;
-                if((val1 >= minval)&&(val1 <= maxval)) newval = val1;
-                else newval = val2;
-              }
-            }
-          }
-        }
-        else
-        {
-          if ((((val1 >= minval)&&(val2 >= minval))&&
-              ((val1 <= maxval)&&(val2 <= maxval)))||
-              (!userange))
-          {
-            if (!(val1 == val2))
-            {
-              includeface = true;
-              newval = val1;
-              if (val2 < newval) newval = val2;
-            }
-          }
-        }
-      }
-      else if ((addouterboundary)&&(!innerboundaryonly))
-      {
-        ifield->value(val1,ci);
-        if (((val1 >= minval)&&(val1 <= maxval))||
-            (!userange))
-        {
-          newval = val1;
-          includeface = true;
-        }
-      }
-
-      if (includeface)
-      {
-        imesh->get_nodes(inodes,delem);
-        onodes.resize(inodes.size());
 
-        for (size_t q=0; q< onodes.size(); q++)
-        {
-          checkForInterruption();
-          a = inodes[q];
-          if (node_map[a] == -1)
-          {
-            imesh->get_center(point,a);
-            onodes[q] = omesh->add_point(point);
-            node_map[a] = onodes[q];
           }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
-
+          omesh->add_elem(onodes);
+          newvalues.push_back(newval);
+          newelems.push_back(ci);
         }
-        omesh->add_elem(onodes);
-        newvalues.push_back(newval);
+        cnt++; if (cnt == 100) update_progress_max(delem,numdelems);
       }
-      cnt++; if (cnt == 100) update_progress_max(delem,numdelems);
     }
   }
 
   ofield->resize_values();
   ofield->set_values(newvalues);
 
+  /// Maps every boundary element to the input element owning it
+  typedef SparseRowMatrix::Triplet T;
+  std::vector<T> tripletList;
+  tripletList.reserve(newelems.size());
+  for (size_t i = 0; i < newelems.size(); i++)
+    tripletList.push_back(T(static_cast<index_type>(i), newelems[i], 1));
+
+  SparseRowMatrixHandle mat(new SparseRowMatrix(static_cast<size_type>(newelems.size()), imesh->num_elems()));
+  mat->setFromTriplets(tripletList.begin(), tripletList.end());
+  mapping = mat;
+
   CopyProperties(*input, *output);
   return true;
 }
@@ -549,10 +620,12 @@ AlgorithmOutput GetDomainBoundaryAlgo::run(const AlgorithmInput& input) const
   auto elemlink = input.get<SparseRowMatrix>(ElemLink);
 
   FieldHandle boundary;
-  if (!runImpl(field, elemlink, boundary))
+  MatrixHandle mapping;
+  if (!runImpl(field, elemlink, boundary, mapping))
     THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
 
   AlgorithmOutput output;
   output[BoundaryField] = boundary;
+  output[MappingMatrix] = mapping;
   return output;
 }
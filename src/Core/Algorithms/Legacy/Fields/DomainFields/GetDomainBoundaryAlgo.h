@@ -57,10 +57,13 @@ class SCISHARE GetDomainBoundaryAlgo : public AlgorithmBase, public Core::Thread
 
     static AlgorithmInputName ElemLink;
     static AlgorithmOutputName BoundaryField;
+    static AlgorithmOutputName MappingMatrix;
 
     virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
 
     bool runImpl(FieldHandle input, Datatypes::SparseRowMatrixHandle domainlink, FieldHandle& output) const;
+    /// mapping maps every boundary element to the input element it is a face of
+    bool runImpl(FieldHandle input, Datatypes::SparseRowMatrixHandle domainlink, FieldHandle& output, Datatypes::MatrixHandle& mapping) const;
 };
 
 }}}}
@@ -0,0 +1,78 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/ApplyFilterToFieldData.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+ALGORITHM_PARAMETER_DEF(Fields, MorphologicalMethod);
+
+ApplyFilterToFieldDataAlgo::ApplyFilterToFieldDataAlgo()
+{
+  /// Filter to apply: erode, dilate, or erode followed by dilate
+  addOption(Parameters::MorphologicalMethod, "erodedilate", "erode|dilate|erodedilate");
+  /// Number of iterations to perform
+  addParameter(Parameters::FilterIterations, 2);
+}
+
+bool ApplyFilterToFieldDataAlgo::runImpl(FieldHandle input, FieldHandle& output) const
+{
+  ScopedAlgorithmStatusReporter asr(this, "ApplyFilterToFieldData");
+
+  const std::string method = getOption(Parameters::MorphologicalMethod);
+  const int num_iter = get(Parameters::FilterIterations).toInt();
+
+  if (method == "dilate")
+    return (applyMorphologicalFilter(this, MORPHOLOGY_DILATE, num_iter, input, output));
+  if (method == "erode")
+    return (applyMorphologicalFilter(this, MORPHOLOGY_ERODE, num_iter, input, output));
+
+  FieldHandle eroded;
+  if (!applyMorphologicalFilter(this, MORPHOLOGY_ERODE, num_iter, input, eroded))
+    return (false);
+  return (applyMorphologicalFilter(this, MORPHOLOGY_DILATE, num_iter, eroded, output));
+}
+
+AlgorithmOutput ApplyFilterToFieldDataAlgo::run(const AlgorithmInput& input) const
+{
+  auto field = input.get<Field>(Variables::InputField);
+
+  FieldHandle outputField;
+  if (!runImpl(field, outputField))
+    THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
+
+  AlgorithmOutput output;
+  output[Variables::OutputField] = outputField;
+  return output;
+}
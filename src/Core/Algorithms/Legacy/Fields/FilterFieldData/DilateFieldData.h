@@ -30,36 +30,33 @@
 #ifndef CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_DILATEFIELDDATA_H
 #define CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_DILATEFIELDDATA_H 1
 
-// Datatypes that the algorithm uses
-#include <Core/Datatypes/Mesh.h>
-#include <Core/Datatypes/Field.h>
-
 // Base class for algorithm
-#include <Core/Algorithms/Util/AlgoBase.h>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/MorphologicalFilter.h>
 
 // for Windows support
-#include <Core/Algorithms/Fields/share.h>
-
-namespace SCIRunAlgo {
+#include <Core/Algorithms/Legacy/Fields/share.h>
 
-using namespace SCIRun;
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
 
-class SCISHARE DilateFieldDataAlgo : public AlgoBase
-{
-  public:
-    /// Set defaults
-    DilateFieldDataAlgo()
-    {
-      /// Number of iterations to perform
-      add_int("num_iterations",2);
-    }
-  
-    /// run the algorithm
-    bool run(FieldHandle input, FieldHandle& output);
-};
+        class SCISHARE DilateFieldDataAlgo : public AlgorithmBase
+        {
+        public:
+          /// Set defaults
+          DilateFieldDataAlgo();
 
-} // end namespace SCIRunAlgo
+          /// run the algorithm
+          bool runImpl(FieldHandle input, FieldHandle& output) const;
 
-#endif 
+          virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+        };
 
+      }
+    }
+  }
+}
 
+#endif
@@ -27,39 +27,36 @@
 */
 
 
-#ifndef CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_ERODEFILTER_H
-#define CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_ERODEFILTER_H 1
-
-// Datatypes that the algorithm uses
-#include <Core/Datatypes/Mesh.h>
-#include <Core/Datatypes/Field.h>
+#ifndef CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_ERODEFIELDDATA_H
+#define CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_ERODEFIELDDATA_H 1
 
 // Base class for algorithm
-#include <Core/Algorithms/Util/AlgoBase.h>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/MorphologicalFilter.h>
 
 // for Windows support
-#include <Core/Algorithms/Fields/share.h>
-
-namespace SCIRunAlgo {
+#include <Core/Algorithms/Legacy/Fields/share.h>
 
-using namespace SCIRun;
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
 
-class SCISHARE ErodeFieldDataAlgo : public AlgoBase
-{
-  public:
-    /// Set defaults
-    ErodeFieldDataAlgo()
-    {
-      /// Number of iterations to perform
-      add_int("num_iterations",2);
-    }
-  
-    /// run the algorithm
-    bool run(FieldHandle input, FieldHandle& output);
-};
+        class SCISHARE ErodeFieldDataAlgo : public AlgorithmBase
+        {
+        public:
+          /// Set defaults
+          ErodeFieldDataAlgo();
 
-} // end namespace SCIRunAlgo
+          /// run the algorithm
+          bool runImpl(FieldHandle input, FieldHandle& output) const;
 
-#endif 
+          virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+        };
 
+      }
+    }
+  }
+}
 
+#endif
@@ -0,0 +1,353 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/MorphologicalFilter.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+ALGORITHM_PARAMETER_DEF(Fields, FilterIterations);
+
+namespace
+{
+  // One pass through the mesh neighbor queries, for meshes without a grid.
+  template <class DATA, class BETTER>
+  void filter_mesh(VMesh* mesh, bool elem_data, size_t size, const DATA* idata, DATA* odata, BETTER better)
+  {
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      VMesh::Node::array_type nodes;
+      VMesh::Elem::array_type elems;
+      for (size_t idx = begin; idx < end; idx++)
+      {
+        DATA val = idata[idx];
+        if (elem_data)
+        {
+          mesh->get_neighbors(elems, VMesh::Elem::index_type(idx));
+          for (size_t j = 0; j < elems.size(); j++)
+          {
+            const DATA nval = idata[elems[j]];
+            if (better(nval, val)) val = nval;
+          }
+        }
+        else
+        {
+          mesh->get_neighbors(nodes, VMesh::Node::index_type(idx));
+          for (size_t j = 0; j < nodes.size(); j++)
+          {
+            const DATA nval = idata[nodes[j]];
+            if (better(nval, val)) val = nval;
+          }
+        }
+        odata[idx] = val;
+      }
+    }, size);
+  }
+
+  // One pass over values on a grid with i running fastest. Neighbors are taken in the
+  // order the LatVol mesh lists them; a missing neighbor is replaced by the value itself,
+  // which never wins. Every task handles a range of rows.
+  template <class DATA, class BETTER>
+  void filter_grid(const size_t* dims, const DATA* idata, DATA* odata, BETTER better)
+  {
+    const size_t ni = dims[0], nj = dims[1], nk = dims[2];
+    const size_t slice = ni*nj;
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t row = begin; row < end; row++)
+      {
+        const size_t j = row % nj;
+        const size_t k = row / nj;
+        const DATA* in = idata + row*ni;
+        const DATA* jm = (j > 0 ? in - ni : in);
+        const DATA* jp = (j + 1 < nj ? in + ni : in);
+        const DATA* km = (k > 0 ? in - slice : in);
+        const DATA* kp = (k + 1 < nk ? in + slice : in);
+        DATA* out = odata + row*ni;
+
+        auto value = [&](size_t i, size_t left, size_t right)
+        {
+          DATA val = in[i];
+          if (better(in[left], val)) val = in[left];
+          if (better(in[right], val)) val = in[right];
+          if (better(jm[i], val)) val = jm[i];
+          if (better(jp[i], val)) val = jp[i];
+          if (better(km[i], val)) val = km[i];
+          if (better(kp[i], val)) val = kp[i];
+          return (val);
+        };
+
+        out[0] = value(0, 0, (ni > 1 ? 1 : 0));
+        for (size_t i = 1; i + 1 < ni; i++)
+          out[i] = value(i, i - 1, i + 1);
+        if (ni > 1) out[ni - 1] = value(ni - 1, ni - 2, ni - 1);
+      }
+    }, nj*nk);
+  }
+
+  // Finds the values of a field that holds no more than two distinct ones. Values are
+  // told apart by their bits, so a NaN or a negative zero never counts as a mask value.
+  template <class DATA>
+  bool find_mask_values(const DATA* data, size_t size, DATA& lo, DATA& hi)
+  {
+    auto same = [](const DATA& a, const DATA& b) { return (std::memcmp(&a, &b, sizeof(DATA)) == 0); };
+    auto add = [&](std::vector<DATA>& values, const DATA& v)
+    {
+      for (const auto& w : values)
+        if (same(v, w)) return;
+      values.push_back(v);
+    };
+
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), size / 4096));
+    std::vector<std::vector<DATA> > found(numBlocks);
+    Parallel::RunTasks([&](int b)
+    {
+      for (size_t i = size * b / numBlocks; i < size * (b + 1) / numBlocks && found[b].size() < 3; i++)
+        add(found[b], data[i]);
+    }, static_cast<int>(numBlocks));
+
+    std::vector<DATA> values;
+    for (const auto& block : found)
+      for (const auto& v : block)
+        add(values, v);
+
+    if (values.empty() || values.size() > 2) return (false);
+    lo = values[0];
+    hi = values.back();
+    if (values.size() == 2)
+    {
+      if (values[1] < values[0]) std::swap(lo, hi);
+      if (!(lo < hi)) return (false);
+    }
+    return (true);
+  }
+
+  // One pass over a grid of bits, each row of ni bits packed into words along i. A bit
+  // gets set if it or one of its neighbors is set.
+  void spread_bits(const size_t* dims, size_t words, const uint64_t* idata, uint64_t* odata)
+  {
+    const size_t ni = dims[0], nj = dims[1], nk = dims[2];
+    const size_t slice = words*nj;
+    const uint64_t last = ((ni % 64) == 0 ? ~uint64_t(0) : (uint64_t(1) << (ni % 64)) - 1);
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t row = begin; row < end; row++)
+      {
+        const size_t j = row % nj;
+        const size_t k = row / nj;
+        const uint64_t* in = idata + row*words;
+        const uint64_t* jm = (j > 0 ? in - words : in);
+        const uint64_t* jp = (j + 1 < nj ? in + words : in);
+        const uint64_t* km = (k > 0 ? in - slice : in);
+        const uint64_t* kp = (k + 1 < nk ? in + slice : in);
+        uint64_t* out = odata + row*words;
+
+        for (size_t w = 0; w < words; w++)
+        {
+          uint64_t v = in[w] | (in[w] << 1) | (in[w] >> 1) | jm[w] | jp[w] | km[w] | kp[w];
+          if (w > 0) v |= in[w - 1] >> 63;
+          if (w + 1 < words) v |= in[w + 1] << 63;
+          out[w] = v;
+        }
+        out[words - 1] &= last;
+      }
+    }, nj*nk);
+  }
+
+  // A mask only ever changes where the value that wins, the larger one when dilating and
+  // the smaller one when eroding, spreads into its neighbors. That is a bitwise or of the
+  // neighboring rows, 64 values at a time.
+  template <class DATA>
+  void filter_mask(const AlgorithmBase* algo, const size_t* dims, int num_iter, DATA spread, DATA other, DATA* data)
+  {
+    const size_t ni = dims[0];
+    const size_t rows = dims[1]*dims[2];
+    const size_t words = (ni + 63) / 64;
+    std::vector<uint64_t> bits(rows*words, 0), buffer(rows*words);
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t row = begin; row < end; row++)
+        for (size_t i = 0; i < ni; i++)
+          if (data[row*ni + i] == spread) bits[row*words + i / 64] |= (uint64_t(1) << (i % 64));
+    }, rows);
+
+    for (int it = 0; it < num_iter; it++)
+    {
+      spread_bits(dims, words, &bits[0], &buffer[0]);
+      bits.swap(buffer);
+      algo->update_progress_max(it, num_iter);
+    }
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t row = begin; row < end; row++)
+        for (size_t i = 0; i < ni; i++)
+          data[row*ni + i] = ((bits[row*words + i / 64] >> (i % 64)) & 1) ? spread : other;
+    }, rows);
+  }
+
+  template <class DATA, class BETTER>
+  bool filter_values(const AlgorithmBase* algo, bool dilate, int num_iter, FieldHandle output, BETTER better)
+  {
+    VField* vfield = output->vfield();
+    VMesh* vmesh = output->vmesh();
+    const bool elem_data = (vfield->basis_order() == 0);
+    const size_t size = vfield->num_values();
+    DATA* data = reinterpret_cast<DATA*>(vfield->fdata_pointer());
+
+    if (num_iter < 1 || size == 0) return (true);
+
+    std::vector<DATA> buffer(size);
+    DATA* src = data;
+    DATA* dst = &buffer[0];
+
+    if (vmesh->is_latvolmesh())
+    {
+      VMesh::dimension_type dim;
+      vmesh->get_dimensions(dim);
+      const size_t offset = (elem_data ? 1 : 0);
+      const size_t dims[3] = { dim[0] - offset, dim[1] - offset, dim[2] - offset };
+
+      DATA lo, hi;
+      if (find_mask_values(data, size, lo, hi))
+      {
+        filter_mask(algo, dims, num_iter, (dilate ? hi : lo), (dilate ? lo : hi), data);
+        return (true);
+      }
+
+      for (int it = 0; it < num_iter; it++)
+      {
+        filter_grid(dims, src, dst, better);
+        std::swap(src, dst);
+        algo->update_progress_max(it, num_iter);
+      }
+    }
+    else
+    {
+      vmesh->synchronize(elem_data ? Mesh::ELEM_NEIGHBORS_E : Mesh::NODE_NEIGHBORS_E);
+      for (int it = 0; it < num_iter; it++)
+      {
+        filter_mesh(vmesh, elem_data, size, src, dst, better);
+        std::swap(src, dst);
+        algo->update_progress_max(it, num_iter);
+      }
+    }
+
+    if (src != data)
+      std::copy(src, src + size, data);
+    return (true);
+  }
+
+  template <class DATA>
+  bool filter_field(const AlgorithmBase* algo, MorphologicalOperation operation, int num_iter, FieldHandle output)
+  {
+    if (operation == MORPHOLOGY_DILATE)
+      return (filter_values<DATA>(algo, true, num_iter, output, std::greater<DATA>()));
+    return (filter_values<DATA>(algo, false, num_iter, output, std::less<DATA>()));
+  }
+}
+
+bool SCIRun::Core::Algorithms::Fields::applyMorphologicalFilter(const AlgorithmBase* algo,
+  MorphologicalOperation operation, int num_iter, FieldHandle input, FieldHandle& output)
+{
+  // Check whether we have an input field
+  if (!input)
+  {
+    algo->error("No input field");
+    return (false);
+  }
+
+  // Figure out what the input type and output type have to be
+  FieldInformation fi(input);
+
+  if (fi.is_nonlinear())
+  {
+    algo->error("This function has not yet been defined for non-linear elements");
+    return (false);
+  }
+
+  if (fi.is_nodata())
+  {
+    algo->error("There is no data defined in the input field");
+    return (false);
+  }
+
+  if (!fi.is_scalar())
+  {
+    algo->error("The field data is not scalar data");
+    return (false);
+  }
+
+  if (!fi.is_constantdata() && !fi.is_lineardata())
+  {
+    algo->error("The field data needs to be on the nodes or on the elements");
+    return (false);
+  }
+
+  /// Create output field
+  output.reset(input->clone());
+
+  if (!output)
+  {
+    algo->error("Could not allocate output field");
+    return (false);
+  }
+
+  if (fi.is_char()) return (filter_field<char>(algo, operation, num_iter, output));
+  if (fi.is_unsigned_char()) return (filter_field<unsigned char>(algo, operation, num_iter, output));
+  if (fi.is_short()) return (filter_field<short>(algo, operation, num_iter, output));
+  if (fi.is_unsigned_short()) return (filter_field<unsigned short>(algo, operation, num_iter, output));
+  if (fi.is_int()) return (filter_field<int>(algo, operation, num_iter, output));
+  if (fi.is_unsigned_int()) return (filter_field<unsigned int>(algo, operation, num_iter, output));
+  if (fi.is_longlong()) return (filter_field<long long>(algo, operation, num_iter, output));
+  if (fi.is_unsigned_longlong()) return (filter_field<unsigned long long>(algo, operation, num_iter, output));
+  if (fi.is_float()) return (filter_field<float>(algo, operation, num_iter, output));
+  if (fi.is_double()) return (filter_field<double>(algo, operation, num_iter, output));
+
+  algo->error("Unsupported data type");
+  return (false);
+}
@@ -0,0 +1,60 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_MORPHOLOGICALFILTER_H
+#define CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_MORPHOLOGICALFILTER_H 1
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+
+// for Windows support
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun{
+  namespace Core{
+    namespace Algorithms{
+      namespace Fields{
+
+        ALGORITHM_PARAMETER_DECL(FilterIterations);
+
+        enum MorphologicalOperation { MORPHOLOGY_DILATE, MORPHOLOGY_ERODE };
+
+        // Replaces every value of a scalar field by the maximum (dilate) or minimum (erode)
+        // of itself and its node or element neighbors, num_iter times over. LatVol fields
+        // are filtered on the grid directly, one slab of rows per task, and fields holding
+        // only two values are packed into bits first. Other meshes go through the mesh
+        // neighbor queries. All paths give the same values.
+        SCISHARE bool applyMorphologicalFilter(const AlgorithmBase* algo, MorphologicalOperation operation,
+          int num_iter, FieldHandle input, FieldHandle& output);
+      }
+    }
+  }
+}
+
+#endif
@@ -37,8 +37,7 @@
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
-#include <Core/GeometryPrimitives/SearchGridT.h>
-#include <boost/scoped_ptr.hpp>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -46,6 +45,7 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmParameterName JoinFieldsAlgo::MergeNodes("merge_nodes");
 AlgorithmParameterName JoinFieldsAlgo::MergeElems("merge_elems");
@@ -53,6 +53,145 @@ AlgorithmParameterName JoinFieldsAlgo::Tolerance("tolerance");
 AlgorithmParameterName JoinFieldsAlgo::MatchNodeValues("match_node_values");
 AlgorithmParameterName JoinFieldsAlgo::MakeNoData("make_no_data");
 
+namespace
+{
+  // Cube of the tolerance grid that contains a point.
+  struct ToleranceCell
+  {
+    long long i, j, k;
+
+    bool operator<(const ToleranceCell& c) const
+    {
+      return i < c.i || (i == c.i && (j < c.j || (j == c.j && k < c.k)));
+    }
+    bool operator==(const ToleranceCell& c) const { return i == c.i && j == c.j && k == c.k; }
+  };
+
+  struct ToleranceCellEntry
+  {
+    ToleranceCell cell;
+    index_type point;
+
+    bool operator<(const ToleranceCellEntry& e) const
+    {
+      return cell < e.cell || (cell == e.cell && point < e.point);
+    }
+  };
+
+  long long cell_coordinate(double x, double origin, double size)
+  {
+    const double c = std::floor((x - origin) / size);
+    // Points that far out share the outermost cube, which only costs extra distance tests.
+    return static_cast<long long>(std::min(std::max(c, 0.0), 1e18));
+  }
+
+  // Lists for every point the earlier points that are closer than the tolerance and,
+  // if values are given, have the same value. The lists are stored back to back, the
+  // ones of point i in neighbors[offset[i]] to neighbors[offset[i+1]]. Points are
+  // bucketed in cubes with the tolerance as size and the sorted cubes are searched
+  // around each point, so every point only looks at the 27 cubes around it.
+  void find_close_candidates(const std::vector<Point>& points, const std::vector<int>& values, double tol,
+    std::vector<index_type>& offset, std::vector<index_type>& neighbors)
+  {
+    const size_t num_points = points.size();
+    const double tol2 = tol*tol;
+
+    Point origin;
+    if (num_points > 0)
+    {
+      origin = points[0];
+      for (const auto& p : points) origin = Min(origin, p);
+    }
+
+    std::vector<ToleranceCellEntry> entries(num_points);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+      {
+        ToleranceCell& cell = entries[i].cell;
+        cell.i = cell_coordinate(points[i].x(), origin.x(), tol);
+        cell.j = cell_coordinate(points[i].y(), origin.y(), tol);
+        cell.k = cell_coordinate(points[i].z(), origin.z(), tol);
+        entries[i].point = static_cast<index_type>(i);
+      }
+    }, num_points);
+
+    Parallel::Sort(entries.begin(), entries.end());
+
+    // The occupied cubes in sorted order, the points of cube c are
+    // entries[cell_start[c]] to entries[cell_start[c+1]].
+    std::vector<ToleranceCell> cells;
+    std::vector<size_t> cell_start;
+    for (size_t e = 0; e < num_points; e++)
+    {
+      if (e == 0 || !(entries[e].cell == entries[e - 1].cell))
+      {
+        cells.push_back(entries[e].cell);
+        cell_start.push_back(e);
+      }
+    }
+    cell_start.push_back(num_points);
+
+    // Cubes that differ in k only are adjacent in sorted order, so the neighbors of a cube
+    // are found in nine rows. Cubes are visited in sorted order, hence the start of every
+    // row only moves forward. Blocks of cubes collect the close pairs separately.
+    const size_t num_cells = cells.size();
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_cells / 1024));
+    std::vector<std::vector<std::pair<index_type, index_type> > > block_pairs(numBlocks);
+
+    Parallel::RunTasks([&](int b)
+    {
+      const size_t cbegin = num_cells * b / numBlocks;
+      const size_t cend = num_cells * (b + 1) / numBlocks;
+      if (cbegin == cend) return;
+
+      auto row_start = [](const ToleranceCell& cell, int r)
+      {
+        return ToleranceCell{ cell.i + r / 3 - 1, cell.j + r % 3 - 1, cell.k - 1 };
+      };
+
+      size_t cursor[9];
+      for (int r = 0; r < 9; r++)
+        cursor[r] = std::lower_bound(cells.begin(), cells.end(), row_start(cells[cbegin], r)) - cells.begin();
+
+      std::vector<std::pair<index_type, index_type> >& pairs = block_pairs[b];
+      for (size_t c = cbegin; c < cend; c++)
+      {
+        for (int r = 0; r < 9; r++)
+        {
+          const ToleranceCell low = row_start(cells[c], r);
+          const ToleranceCell high = { low.i, low.j, low.k + 2 };
+          while (cursor[r] < num_cells && cells[cursor[r]] < low) cursor[r]++;
+
+          for (size_t n = cursor[r]; n < num_cells && !(high < cells[n]); n++)
+          {
+            for (size_t e = cell_start[c]; e < cell_start[c + 1]; e++)
+            {
+              const index_type i = entries[e].point;
+              for (size_t f = cell_start[n]; f < cell_start[n + 1] && entries[f].point < i; f++)
+              {
+                const index_type j = entries[f].point;
+                if ((points[i] - points[j]).length2() < tol2 && (values.empty() || values[i] == values[j]))
+                  pairs.push_back(std::make_pair(i, j));
+              }
+            }
+          }
+        }
+      }
+    }, static_cast<int>(numBlocks));
+
+    offset.assign(num_points + 1, 0);
+    for (const auto& pairs : block_pairs)
+      for (const auto& pair : pairs) offset[pair.first + 1]++;
+    for (size_t i = 0; i < num_points; i++) offset[i + 1] += offset[i];
+
+    neighbors.resize(offset[num_points]);
+    std::vector<index_type> fill(offset.begin(), offset.end() - 1);
+    for (const auto& pairs : block_pairs)
+      for (const auto& pair : pairs) neighbors[fill[pair.first]++] = pair.second;
+  }
+}
+
 JoinFieldsAlgo::JoinFieldsAlgo()
 {
   /// Merge duplicate nodes?
@@ -168,79 +307,168 @@ JoinFieldsAlgo::runImpl(const FieldList& input, FieldHandle& output) const
     }
   }
   
-  BBox box;
-  boost::scoped_ptr<SearchGridT<index_type> > node_grid;
-  boost::scoped_ptr<SearchGridT<index_type> > elem_grid;
-
-  size_type ni = 0, nj = 0, nk = 0;    
-        
-  size_type tot_num_nodes = 0;
-  size_type tot_num_elems = 0;
-  
   if (merge_elems) merge_nodes = true;
-  
-  // Compute bounding box and number of nodes
-  // and elements
+
   for (size_t p = 0; p < inputs.size(); p++)
   {
-    VMesh* imesh = inputs[p]->vmesh();
-    if (merge_nodes)
+    if (inputs[p]->vmesh()->is_pointcloudmesh())
     {
-      box.extend(imesh->get_bounding_box());
+      merge_elems = false;
     }
-    tot_num_nodes += imesh->num_nodes();
-    tot_num_elems += imesh->num_elems();
   }
 
-//  if (merge_elems) merge_nodes = true;
-
-  // Add an epsilon so all nodes will be inside
-  if (merge_nodes)
-  {    
-    if (!box.valid())
-      THROW_ALGORITHM_PROCESSING_ERROR("Merging nodes will fail: BBox is empty or invalid, diagonal not provided.");
-    box.extend(1e-5*box.diagonal().length()); 
-
-    const size_type s =  3*static_cast<size_type>
-      ((ceil(pow(static_cast<double>(tot_num_nodes) , (1.0/3.0))))/2.0 + 1.0);
-
-    Vector diag  = box.diagonal();
-    double trace = (diag.x()+diag.y()+diag.z());
-    size_type sx = static_cast<size_type>(ceil(diag.x()/trace*s));
-    size_type sy = static_cast<size_type>(ceil(diag.y()/trace*s));
-    size_type sz = static_cast<size_type>(ceil(diag.z()/trace*s));
-    
-    node_grid.reset(new SearchGridT<index_type>(sx, sy, sz, box.get_min(), box.get_max()));
-
-    if (sx == 0) sx = 1;
-    if (sy == 0) sy = 1;
-    if (sz == 0) sz = 1;
-    
-    ni = node_grid->get_ni()-1;
-    nj = node_grid->get_nj()-1;
-    nk = node_grid->get_nk()-1;    
+  const size_t num_inputs = inputs.size();
+  const size_type npe = inputs[0]->vmesh()->num_nodes_per_elem();
+
+  // Copy the connectivity of all inputs, elements numbered consecutively over the inputs.
+  std::vector<size_type> elems_offset(num_inputs + 1, 0);
+  for (size_t p = 0; p < num_inputs; p++)
+    elems_offset[p + 1] = elems_offset[p] + inputs[p]->vmesh()->num_elems();
+  const size_type tot_num_elems = elems_offset[num_inputs];
+
+  // Input that holds element e.
+  auto input_of_elem = [&](size_type e)
+  {
+    return static_cast<size_t>(std::upper_bound(elems_offset.begin(), elems_offset.end(), e) - elems_offset.begin()) - 1;
+  };
+
+  std::vector<index_type> cells(tot_num_elems * npe);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type nodes;
+    for (size_t p = input_of_elem(begin), e = begin; e < end; e++)
+    {
+      while (e >= static_cast<size_t>(elems_offset[p + 1])) p++;
+      inputs[p]->vmesh()->get_nodes(nodes, VMesh::Elem::index_type(e - elems_offset[p]));
+      std::copy(nodes.begin(), nodes.end(), cells.begin() + e * npe);
+    }
+  }, tot_num_elems);
+
+  // Every node used by an element is a candidate output node, numbered in the
+  // order in which the elements first use it.
+  std::vector<std::vector<index_type> > local_to_candidate(num_inputs);
+  std::vector<size_t> candidate_input;
+  std::vector<index_type> candidate_node;
+  for (size_t p = 0; p < num_inputs; p++)
+  {
+    local_to_candidate[p].assign(inputs[p]->vmesh()->num_nodes(), -1);
+    for (index_type c = elems_offset[p] * npe; c < elems_offset[p + 1] * npe; c++)
+    {
+      index_type& candidate = local_to_candidate[p][cells[c]];
+      if (candidate < 0)
+      {
+        candidate = static_cast<index_type>(candidate_node.size());
+        candidate_input.push_back(p);
+        candidate_node.push_back(cells[c]);
+      }
+    }
+  }
+
+  const size_type num_candidates = static_cast<size_type>(candidate_node.size());
+  std::vector<Point> points(num_candidates);
+  std::vector<int> values;
+  if (match_node_values) values.resize(num_candidates);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t c = begin; c < end; c++)
+    {
+      inputs[candidate_input[c]]->vmesh()->get_center(points[c], VMesh::Node::index_type(candidate_node[c]));
+      if (match_node_values) inputs[candidate_input[c]]->vfield()->get_value(values[c], candidate_node[c]);
+    }
+  }, num_candidates);
+
+  // Output index of every candidate. A candidate merges with the closest earlier
+  // candidate that became an output node itself and is closer than the tolerance.
+  std::vector<index_type> candidate_to_global(num_candidates);
+  size_type tot_num_nodes = 0;
+  if (merge_nodes && tol > 0.0)
+  {
+    std::vector<index_type> neighbor_offset, neighbors;
+    find_close_candidates(points, values, tol, neighbor_offset, neighbors);
+
+    std::vector<index_type> global_to_candidate;
+    for (index_type c = 0; c < num_candidates; c++)
+    {
+      index_type cidx = -1;
+      double dmin = tol2;
+      for (index_type n = neighbor_offset[c]; n < neighbor_offset[c + 1]; n++)
+      {
+        const index_type other = neighbors[n];
+        const index_type g = candidate_to_global[other];
+        if (global_to_candidate[g] != other) continue;
+        const double dist = (points[c] - points[other]).length2();
+        if (dist < dmin || (dist == dmin && cidx >= 0 && g < cidx))
+        {
+          cidx = g;
+          dmin = dist;
+        }
+      }
+
+      if (cidx >= 0)
+      {
+        candidate_to_global[c] = cidx;
+      }
+      else
+      {
+        candidate_to_global[c] = tot_num_nodes++;
+        global_to_candidate.push_back(c);
+      }
+    }
   }
+  else
+  {
+    for (index_type c = 0; c < num_candidates; c++) candidate_to_global[c] = c;
+    tot_num_nodes = num_candidates;
+  }
+
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t p = input_of_elem(begin), e = begin; e < end; e++)
+    {
+      while (e >= static_cast<size_t>(elems_offset[p + 1])) p++;
+      for (size_t c = e * npe; c < (e + 1) * npe; c++)
+        cells[c] = candidate_to_global[local_to_candidate[p][cells[c]]];
+    }
+  }, tot_num_elems);
 
+  // An element that uses the same nodes as an earlier element is dropped.
+  std::vector<index_type> elem_to_global(tot_num_elems);
+  size_type num_output_elems = 0;
   if (merge_elems)
   {
-    const size_type s =  3*static_cast<size_type>
-      ((ceil(pow(static_cast<double>(tot_num_nodes) , (1.0/3.0))))/2.0 + 1.0);
-
-    Vector diag  = box.diagonal();
-    double trace = (diag.x()+diag.y()+diag.z());
-    size_type sx = static_cast<size_type>(ceil(diag.x()/trace*s));
-    size_type sy = static_cast<size_type>(ceil(diag.y()/trace*s));
-    size_type sz = static_cast<size_type>(ceil(diag.z()/trace*s));
-    
-    if (sx == 0) sx = 1;
-    if (sy == 0) sy = 1;
-    if (sz == 0) sz = 1;
-    
-    elem_grid.reset(new SearchGridT<index_type>(sx, sy, sz, box.get_min(), box.get_max()));
-    
-    ni = node_grid->get_ni()-1;
-    nj = node_grid->get_nj()-1;
-    nk = node_grid->get_nk()-1;    
+    std::vector<index_type> sorted_cells(cells);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t e = begin; e < end; e++)
+        std::sort(sorted_cells.begin() + e * npe, sorted_cells.begin() + (e + 1) * npe);
+    }, tot_num_elems);
+
+    std::vector<index_type> order(tot_num_elems);
+    for (index_type e = 0; e < tot_num_elems; e++) order[e] = e;
+    Parallel::Sort(order.begin(), order.end(), [&](index_type e1, index_type e2)
+    {
+      const auto n1 = sorted_cells.begin() + e1 * npe;
+      const auto n2 = sorted_cells.begin() + e2 * npe;
+      const auto diff = std::mismatch(n1, n1 + npe, n2);
+      if (diff.first != n1 + npe) return *diff.first < *diff.second;
+      return e1 < e2;
+    });
+
+    std::vector<char> keep(tot_num_elems, 1);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t r = std::max<size_t>(begin, 1); r < end; r++)
+        keep[order[r]] = !std::equal(sorted_cells.begin() + order[r] * npe, sorted_cells.begin() + (order[r] + 1) * npe,
+          sorted_cells.begin() + order[r - 1] * npe);
+    }, tot_num_elems);
+
+    for (index_type e = 0; e < tot_num_elems; e++)
+      elem_to_global[e] = keep[e] ? num_output_elems++ : -1;
+  }
+  else
+  {
+    for (index_type e = 0; e < tot_num_elems; e++) elem_to_global[e] = e;
+    num_output_elems = tot_num_elems;
   }
 
   MeshHandle mesh = CreateMesh(first);
@@ -249,7 +477,7 @@ JoinFieldsAlgo::runImpl(const FieldList& input, FieldHandle& output) const
     error("Could not create output mesh");
     return (false);
   }
-  
+
   output = CreateField(first,mesh);
   if (!output)
   {
@@ -259,289 +487,66 @@ JoinFieldsAlgo::runImpl(const FieldList& input, FieldHandle& output) const
 
   VMesh* omesh = output->vmesh();
   VField* ofield = output->vfield();
-  
-  omesh->node_reserve(tot_num_nodes);
-  omesh->elem_reserve(tot_num_elems);
-
-  size_type nodes_offset = 0;      
-  size_type elems_offset = 0;  
-  size_type nodes_count = 0;      
-  size_type elems_count = 0;  
 
-  Point P;
-  std::vector<int> values;
-  int curval;
-  if (match_node_values) values.resize(tot_num_nodes);
+  omesh->node_reserve(tot_num_nodes);
+  omesh->elem_reserve(num_output_elems);
 
-  for (size_t p = 0; p < inputs.size(); p++)
+  for (index_type c = 0, next = 0; c < num_candidates; c++)
   {
-    if (inputs[p]->vmesh()->is_pointcloudmesh())
+    if (candidate_to_global[c] == next)
     {
-      merge_elems = false;
+      omesh->add_point(points[c]);
+      next++;
     }
   }
 
-  for (size_t p = 0; p < inputs.size(); p++)
+  VMesh::Node::array_type newnodes(npe);
+  for (index_type e = 0; e < tot_num_elems; e++)
   {
-    elems_count = 0;
-    nodes_count = 0;
-    
-    VMesh* imesh = inputs[p]->vmesh();
-    VField* ifield = inputs[p]->vfield();
-    
-    VMesh::Node::array_type nodes, newnodes, nodes2;
-    std::vector<index_type> newnodes_sorted;
-
-    size_type num_elems = imesh->num_elems();
-    size_type num_nodes = imesh->num_nodes();
-    std::vector<VMesh::Node::index_type> local_to_global(num_nodes,-1);
-    std::vector<VMesh::Elem::index_type> local_to_global_elem;
-    
-    if (merge_elems)
-    {
-      local_to_global_elem.resize(num_elems,-1);
-    }
-    
-    for (VMesh::Elem::index_type idx=0; idx<num_elems;idx++)
-    {
-      imesh->get_nodes(nodes,idx);
-      
-      newnodes.resize(nodes.size());
-      for(size_t q=0; q< nodes.size(); q++)
-      {
-        VMesh::Node::index_type nodeq = nodes[q];
-
-        ASSERT(nodeq<local_to_global.size())
-        ASSERT(q<newnodes.size())
-
-        if (local_to_global[nodeq] >= 0)
-        {
-          newnodes[q] = local_to_global[nodeq];
-        }
-        else
-        {
-          if (merge_nodes)
-          {
-            imesh->get_center(P,nodeq);
-
-            if (match_node_values) ifield->get_value(curval,nodeq);
-             
-            // Convert to grid coordinates.
-            index_type bi, bj, bk, ei, ej, ek;
-            node_grid->unsafe_locate(bi, bj, bk, P);
-
-            // Clamp to closest point on the grid.
-            if (bi > ni) bi = ni;
-            if (bi < 0) bi = 0;
-
-            if (bj > nj) bj = nj;
-            if (bj < 0) bj = 0;
-
-            if (bk > nk) bk = nk;
-            if (bk < 0) bk = 0;
-
-            ei = bi; ej = bj; ek = bk;          
-
-            index_type cidx = -1;
-            double dmin = tol2;
-            bool found = true;
-            
-            do 
-            {
-              found = true; 
-              for (index_type i = bi; i <= ei; i++)
-              {
-                if (i < 0 || i > ni) continue;
-                for (index_type j = bj; j <= ej; j++)
-                {
-                if (j < 0 || j > nj) continue;
-                  for (index_type k = bk; k <= ek; k++)
-                  {
-                    if (k < 0 || k > nk) continue;
-                    if (i == bi || i == ei || j == bj || j == ej || k == bk || k == ek)
-                    {
-                      if (node_grid->min_distance_squared(P, i, j, k) < dmin)
-                      {
-                        found = false;
-                        SearchGridT<index_type>::iterator it, eit;
-                        node_grid->lookup_ijk(it, eit, i, j, k);
-
-                        if (match_node_values) 
-                        {
-                          while (it != eit)
-                          {
-                            if (values[*it] == curval)
-                            {
-                              Point point;
-                              omesh->get_center(point,VMesh::Node::index_type(*it));
-                              const double dist  = (P-point).length2();
-
-                              if (dist < dmin) 
-                              { 
-                                cidx = *it; 
-                                dmin = dist; 
-                              }
-                            }
-                            ++it;
-                          }                        
-                        }
-                        else
-                        {
-                          while (it != eit)
-                          {
-                            Point point;
-                            omesh->get_center(point,VMesh::Node::index_type(*it));
-                            const double dist  = (P-point).length2();
-
-                            if (dist < dmin) 
-                            { 
-                              cidx = *it; 
-                              dmin = dist; 
-                            }
-                            ++it;
-                          }
-                        }
-                      }
-                    }
-                  }
-                }
-              }
-              bi--;ei++;
-              bj--;ej++;
-              bk--;ek++;
-            } 
-            while (!found);
+    if (elem_to_global[e] < 0) continue;
+    std::copy(cells.begin() + e * npe, cells.begin() + (e + 1) * npe, newnodes.begin());
+    omesh->add_elem(newnodes);
+  }
 
-            if (cidx >= 0)
-            {
-              newnodes[q] = cidx;
-              local_to_global[nodeq] = cidx;
-            }
-            else
-            {
-              index_type nidx = omesh->add_point(P);
-              nodes_count++;
-              newnodes[q] = nidx;
-              local_to_global[nodeq] = nidx;
-              node_grid->insert(nidx,P);
-              if (match_node_values)
-              {
-                values[nidx] = curval;
-              }
-            }
-          }
-          else
-          {
-            Point P;
-            imesh->get_center(P,nodeq);
-          
-            index_type nidx = omesh->add_point(P); 
-            nodes_count++;
-            newnodes[q] = nidx;
-            local_to_global[nodeq] = nidx;
-          }
-        }
-      }
-      
-      if (merge_elems)
-      {
-        newnodes_sorted.resize(newnodes.size());
-        for (size_t r=0; r<newnodes.size();r++)
-        {
-          newnodes_sorted[r] = newnodes[r];
-        }
-        std::sort(newnodes_sorted.begin(),newnodes_sorted.end());
-        
-        Point p(0.0,0.0,0.0);
-        for (size_t r=0; r< newnodes_sorted.size(); r++)
-        {
-          Point q;
-          omesh->get_center(q,VMesh::Node::index_type(newnodes_sorted[r]));
-          p = (p + q).asPoint();
-        }
-        p = p*(1.0/newnodes_sorted.size());
-        
-        // Convert to grid coordinates.
-        index_type i, j, k;
-        elem_grid->unsafe_locate(i, j, k, p);
-
-        SearchGridT<index_type>::iterator it, eit;
-        elem_grid->lookup_ijk(it, eit, i, j, k);
-
-        bool found = false;
-        VMesh::Elem::index_type oelem = -1;
-        while (it != eit)
-        {
-          omesh->get_nodes(nodes2,VMesh::Elem::index_type(*it));
-          std::sort(nodes2.begin(),nodes2.end());
-          
-          // compare
-          
-          bool similar = true;
-          for (size_t h=0;h<nodes2.size();h++)
-          {
-            if (nodes2[h] != newnodes_sorted[h]) { similar = false; break;}
-          }
-          
-          if (similar) { found = true; oelem = VMesh::Elem::index_type(*it); break; }
-          ++it;
-        }  
-      
-        if (!found)
-        {
-          oelem = omesh->add_elem(newnodes);          
-          elem_grid->insert(oelem,p);
-          elems_count++;
-          local_to_global_elem[idx] = oelem;
-        }
-        
-      }
-      else
-      {
-        omesh->add_elem(newnodes);          
-        elems_count++;
-      }
-    }
- 
+  ofield->resize_values();
+  for (size_t p = 0; p < num_inputs; p++)
+  {
+    VField* ifield = inputs[p]->vfield();
     if (ifield->num_values() > 0)
     {
       if (ofield->basis_order() == 0 && ifield->basis_order() == 0)
       {
-        ofield->resize_values();
+        const size_type num_elems = inputs[p]->vmesh()->num_elems();
         if (merge_elems)
         {
           for (VMesh::Elem::index_type j=0;j<num_elems;j++)
           {
-            if (local_to_global_elem[j] >= 0)
+            if (elem_to_global[elems_offset[p] + j] >= 0)
             {
-              ofield->copy_value(ifield,j,local_to_global_elem[j]);
+              ofield->copy_value(ifield,j,elem_to_global[elems_offset[p] + j]);
             }
-          }      
+          }
         }
         else
         {
-          ofield->copy_values(ifield,0,elems_offset,num_elems);
+          ofield->copy_values(ifield,0,elems_offset[p],num_elems);
         }
       }
       else if (ofield->basis_order() == 1 && ifield->basis_order() == 1)
       {
-        ofield->resize_values();
+        const size_type num_nodes = inputs[p]->vmesh()->num_nodes();
         for (VMesh::Node::index_type j=0;j<num_nodes;j++)
         {
-          if (local_to_global[j] >= 0)
+          if (local_to_candidate[p][j] >= 0)
           {
-            ofield->copy_value(ifield,j,local_to_global[j]);
+            ofield->copy_value(ifield,j,candidate_to_global[local_to_candidate[p][j]]);
           }
         }
       }
     }
-    
-    elems_offset += elems_count;
-    nodes_offset += nodes_count;
-    
+
     update_progress_max(p+1, inputs.size());
   }
-  
 
   return (true);
 }
@@ -86,7 +86,7 @@ bool GetMeshNodesAlgo::run(FieldHandle& input, DenseMatrixHandle& output) const
   }
   else
   {
-    Point*  points  = vmesh->get_points_pointer();
+    const Point* points = vmesh->get_const_points_pointer();
 
     Point p;
     int cnt = 0;
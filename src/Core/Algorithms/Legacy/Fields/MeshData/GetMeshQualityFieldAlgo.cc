@@ -30,40 +30,228 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 
 ALGORITHM_PARAMETER_DEF(Fields,Metric);
+ALGORITHM_PARAMETER_DEF(Fields,HistogramBins);
 
 GetMeshQualityFieldAlgo::GetMeshQualityFieldAlgo()
 {
-    addOption(Parameters::Metric,"scaled_jacobian","scaled_jacobian|jacobian|volume|insc_circ_ratio");
+    addOption(Parameters::Metric,"scaled_jacobian","scaled_jacobian|jacobian|volume|insc_circ_ratio|condition_number|aspect_ratio");
+    addParameter(Parameters::HistogramBins,50);
 }
 
+const AlgorithmOutputName GetMeshQualityFieldAlgo::Histogram("Histogram");
+const AlgorithmOutputName GetMeshQualityFieldAlgo::Statistics("Statistics");
+
 AlgorithmOutput GetMeshQualityFieldAlgo::run(const AlgorithmInput& input) const
 {
     auto input_field = input.get<Field>(Variables::InputField);
     
     FieldHandle output_field;
+    DenseMatrixHandle histogram, statistics;
     
-    if (!run(input_field, output_field))
+    if (!run(input_field, output_field, histogram, statistics))
         THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
     
     AlgorithmOutput output;
     output[Variables::OutputField] = output_field;
+    output[Histogram] = histogram;
+    output[Statistics] = statistics;
     
     return output;
 }
 
+namespace
+{
+  enum QualityMetric { SCALED_JACOBIAN, JACOBIAN, VOLUME, INSC_CIRC_RATIO, CONDITION_NUMBER, ASPECT_RATIO };
+
+  // Condition number of the element Jacobian relative to the equilateral element,
+  // |T| |T^-1| / d with T the Jacobian mapped onto the reference. It is 1 for a regular
+  // element and grows with distortion; inverted tets get a negative value.
+  double condition_number(const Core::Geometry::Point* p, size_t num_nodes)
+  {
+    const Core::Geometry::Vector e1 = p[1] - p[0];
+    const Core::Geometry::Vector e2 = p[2] - p[0];
+    if (num_nodes == 3)
+    {
+      const double area2 = Cross(e1, e2).length();
+      return ((Dot(e1, e1) + Dot(e2, e2) - Dot(e1, e2)) / (area2 * std::sqrt(3.0)));
+    }
+
+    const Core::Geometry::Vector e3 = p[3] - p[0];
+    const Core::Geometry::Vector c1 = e1;
+    const Core::Geometry::Vector c2 = (2.0 * e2 - e1) / std::sqrt(3.0);
+    const Core::Geometry::Vector c3 = (3.0 * e3 - e2 - e1) / std::sqrt(6.0);
+    const double det = Dot(c1, Cross(c2, c3));
+    const double frobenius = c1.length2() + c2.length2() + c3.length2();
+    const double adjoint = Cross(c1, c2).length2() + Cross(c2, c3).length2() + Cross(c1, c3).length2();
+    return (std::sqrt(frobenius * adjoint) / (3.0 * det));
+  }
+
+  // Longest edge over the inradius, normalized to 1 for a regular element:
+  // h_max / (2 sqrt(3) r) for triangles and h_max / (2 sqrt(6) r) for tets.
+  // Inverted tets get a negative value.
+  double aspect_ratio(const Core::Geometry::Point* p, size_t num_nodes)
+  {
+    double longest = 0.0;
+    for (size_t a = 0; a < num_nodes; a++)
+      for (size_t b = a + 1; b < num_nodes; b++)
+        longest = std::max(longest, (p[b] - p[a]).length2());
+    longest = std::sqrt(longest);
+
+    if (num_nodes == 3)
+    {
+      const double perimeter = (p[1] - p[0]).length() + (p[2] - p[1]).length() + (p[0] - p[2]).length();
+      const double area = 0.5 * Cross(p[1] - p[0], p[2] - p[0]).length();
+      return (longest * perimeter / (4.0 * std::sqrt(3.0) * area));
+    }
+
+    const int faces[4][3] = { {1,2,3}, {0,3,2}, {0,1,3}, {0,2,1} };
+    double surface = 0.0;
+    for (int f = 0; f < 4; f++)
+      surface += 0.5 * Cross(p[faces[f][1]] - p[faces[f][0]], p[faces[f][2]] - p[faces[f][0]]).length();
+    const double volume = Dot(p[1] - p[0], Cross(p[2] - p[0], p[3] - p[0])) / 6.0;
+    return (longest * surface / (6.0 * std::sqrt(6.0) * volume));
+  }
+
+  double element_metric(VMesh* mesh, QualityMetric metric, VMesh::Elem::index_type idx)
+  {
+    switch (metric)
+    {
+      case SCALED_JACOBIAN: return (mesh->scaled_jacobian_metric(idx));
+      case JACOBIAN: return (mesh->jacobian_metric(idx));
+      case VOLUME: return (mesh->volume_metric(idx));
+      case INSC_CIRC_RATIO: return (mesh->inscribed_circumscribed_radius_metric(idx));
+      default: break;
+    }
+
+    VMesh::Node::array_type nodes;
+    mesh->get_nodes(nodes, idx);
+    Core::Geometry::Point p[4];
+    for (size_t q = 0; q < nodes.size(); q++)
+      mesh->get_center(p[q], nodes[q]);
+    if (metric == CONDITION_NUMBER)
+      return (condition_number(p, nodes.size()));
+    return (aspect_ratio(p, nodes.size()));
+  }
+
+  struct QualityStatistics
+  {
+    QualityStatistics() : min(DBL_MAX), max(-DBL_MAX), sum(0.0), count(0), negative(0) {}
+
+    void add(double value)
+    {
+      // Degenerate elements can have an undefined metric, they are left out.
+      if (!std::isfinite(value)) return;
+      min = std::min(min, value);
+      max = std::max(max, value);
+      sum += value;
+      count++;
+      if (value < 0.0) negative++;
+    }
+
+    void add(const QualityStatistics& other)
+    {
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+      sum += other.sum;
+      count += other.count;
+      negative += other.negative;
+    }
+
+    double min, max, sum;
+    size_t count, negative;
+  };
+
+  // Evaluates the metric of every element into values. The mesh metrics only read the
+  // mesh, so elements are evaluated in parallel, in fixed chunks whose statistics are
+  // merged in order; the sum and with it the mean do not depend on the number of cores.
+  QualityStatistics evaluate_quality(VMesh* mesh, QualityMetric metric, double* values)
+  {
+    const size_t num_elems = mesh->num_elems();
+    const size_t chunk = 4096;
+    const size_t num_chunks = (num_elems + chunk - 1) / chunk;
+    std::vector<QualityStatistics> partial(num_chunks);
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t c = begin; c < end; c++)
+      {
+        for (size_t e = c * chunk; e < std::min(num_elems, (c + 1) * chunk); e++)
+        {
+          values[e] = element_metric(mesh, metric, VMesh::Elem::index_type(e));
+          partial[c].add(values[e]);
+        }
+      }
+    }, num_chunks);
+
+    QualityStatistics stats;
+    for (const auto& p : partial)
+      stats.add(p);
+    return (stats);
+  }
+
+  // Counts the values in equal bins between the minimum and the maximum.
+  DenseMatrixHandle quality_histogram(const double* values, size_t num_values, const QualityStatistics& stats, int bins)
+  {
+    const double lower = (stats.count > 0 ? stats.min : 0.0);
+    const double upper = (stats.count > 0 ? stats.max : 0.0);
+    const double width = (upper - lower) / bins;
+
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_values / 4096));
+    std::vector<std::vector<size_t> > counts(numBlocks, std::vector<size_t>(bins, 0));
+    Parallel::RunTasks([&](int b)
+    {
+      for (size_t i = num_values * b / numBlocks; i < num_values * (b + 1) / numBlocks; i++)
+      {
+        if (!std::isfinite(values[i])) continue;
+        int bin = (width > 0.0 ? static_cast<int>((values[i] - lower) / width) : 0);
+        counts[b][std::min(std::max(bin, 0), bins - 1)]++;
+      }
+    }, static_cast<int>(numBlocks));
+
+    DenseMatrixHandle histogram(new DenseMatrix(bins, 3));
+    for (int k = 0; k < bins; k++)
+    {
+      size_t count = 0;
+      for (const auto& block : counts)
+        count += block[k];
+      (*histogram)(k, 0) = lower + k * width;
+      (*histogram)(k, 1) = (k == bins - 1 ? upper : lower + (k + 1) * width);
+      (*histogram)(k, 2) = static_cast<double>(count);
+    }
+    return (histogram);
+  }
+}
+
 bool
 GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
 {
-    std::string Metric = getOption(Parameters::Metric);
+  DenseMatrixHandle histogram, statistics;
+  return (run(input, output, histogram, statistics));
+}
+
+bool
+GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output,
+  DenseMatrixHandle& histogram, DenseMatrixHandle& statistics) const
+{
+  std::string Metric = getOption(Parameters::Metric);
+  const int bins = get(Parameters::HistogramBins).toInt();
   
   if (!input)
   {
@@ -71,6 +259,33 @@ GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
     return false;
   }
 
+  if (bins < 1)
+  {
+    error("The histogram needs at least one bin");
+    return false;
+  }
+
+  QualityMetric metric;
+  if (Metric == "scaled_jacobian") metric = SCALED_JACOBIAN;
+  else if (Metric == "jacobian") metric = JACOBIAN;
+  else if (Metric == "volume") metric = VOLUME;
+  else if (Metric == "insc_circ_ratio") metric = INSC_CIRC_RATIO;
+  else if (Metric == "condition_number") metric = CONDITION_NUMBER;
+  else if (Metric == "aspect_ratio") metric = ASPECT_RATIO;
+  else
+  {
+    error("Unknown quality metric");
+    return false;
+  }
+
+  VMesh* imesh = input->vmesh();
+  if ((metric == CONDITION_NUMBER || metric == ASPECT_RATIO) &&
+      !((imesh->is_tetvolmesh() || imesh->is_trisurfmesh()) && imesh->is_linearmesh()))
+  {
+    error("The condition number and aspect ratio metrics need a linear TetVol or TriSurf mesh");
+    return false;
+  }
+
   FieldInformation fi(input);
   fi.make_double();
   fi.make_constantdata();
@@ -84,41 +299,24 @@ GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
   }
   
   VField* ofield = output->vfield();
-  VMesh*  imesh  = input->vmesh();
+  ofield->resize_values();
   
-  if (Metric == "scaled_jacobian")
-  {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->scaled_jacobian_metric(j),j);
-    }
-  }
-  else if (Metric == "jacobian")
-  {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->jacobian_metric(j),j);
-    }  
-  }
-  else if (Metric == "volume")
-  {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->volume_metric(j),j);
-    }  
-  }
-  else if (Metric == "insc_circ_ratio")
-  {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->inscribed_circumscribed_radius_metric(j),j);
-    }  
-  }  
+  double* values = reinterpret_cast<double*>(ofield->get_values_pointer());
+  const size_t num_values = imesh->num_elems();
+  const QualityStatistics stats = evaluate_quality(imesh, metric, values);
 
-    return true;
-}
+  histogram = quality_histogram(values, num_values, stats, bins);
+
+  statistics.reset(new DenseMatrix(1, 4));
+  (*statistics)(0, 0) = (stats.count > 0 ? stats.min : 0.0);
+  (*statistics)(0, 1) = (stats.count > 0 ? stats.max : 0.0);
+  (*statistics)(0, 2) = (stats.count > 0 ? stats.sum / stats.count : 0.0);
+  (*statistics)(0, 3) = static_cast<double>(stats.negative);
 
+  std::ostringstream oss;
+  oss << "Element quality (" << Metric << "): min " << (*statistics)(0, 0) << ", max " << (*statistics)(0, 1)
+      << ", mean " << (*statistics)(0, 2) << ", " << stats.negative << " of " << num_values << " elements negative";
+  remark(oss.str());
+
+  return true;
+}
@@ -32,6 +32,7 @@
 //Base class for algorithm
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/MatrixFwd.h>
 
 //For Windows support
 #include <Core/Algorithms/Legacy/Fields/share.h>
@@ -42,6 +43,7 @@ namespace SCIRun {
             namespace Fields {
                 
 ALGORITHM_PARAMETER_DECL(Metric);
+ALGORITHM_PARAMETER_DECL(HistogramBins);
 
 class SCISHARE GetMeshQualityFieldAlgo : public AlgorithmBase
 {
@@ -51,6 +53,16 @@ class SCISHARE GetMeshQualityFieldAlgo : public AlgorithmBase
     
     ///Run the algorithm
     bool run(FieldHandle input, FieldHandle& output) const;
+
+    /// Also returns a histogram of the metric, one row per bin holding the lower and
+    /// upper bound of the bin and the number of elements in it, and the statistics
+    /// min, max, mean and number of elements with a negative metric as one row.
+    bool run(FieldHandle input, FieldHandle& output,
+      Datatypes::DenseMatrixHandle& histogram, Datatypes::DenseMatrixHandle& statistics) const;
+
+    static const AlgorithmOutputName Histogram;
+    static const AlgorithmOutputName Statistics;
+
     virtual AlgorithmOutput run(const AlgorithmInput& input) const;
 };
 
@@ -0,0 +1,145 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ElementFaceTable.h>
+
+#include <algorithm>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  // A face is keyed by its sorted nodes; the edges of triangles leave the last node at -1.
+  struct FaceKey
+  {
+    VMesh::index_type nodes[3];
+    size_t slot;
+
+    bool same_face(const FaceKey& other) const
+    {
+      return (nodes[0] == other.nodes[0] && nodes[1] == other.nodes[1] && nodes[2] == other.nodes[2]);
+    }
+
+    bool operator<(const FaceKey& other) const
+    {
+      if (nodes[0] != other.nodes[0]) return (nodes[0] < other.nodes[0]);
+      if (nodes[1] != other.nodes[1]) return (nodes[1] < other.nodes[1]);
+      if (nodes[2] != other.nodes[2]) return (nodes[2] < other.nodes[2]);
+      return (slot < other.slot);
+    }
+  };
+}
+
+bool ElementFaceTable::supports(VMesh* mesh)
+{
+  return ((mesh->is_tetvolmesh() || mesh->is_trisurfmesh()) && mesh->is_linearmesh());
+}
+
+ElementFaceTable::ElementFaceTable(VMesh* mesh) :
+  num_elems_(mesh->num_elems())
+{
+  // Tet faces follow the TetVolMesh face table in the order get_faces_from_cell
+  // visits them, triangle edges the half edges of the face.
+  if (mesh->is_tetvolmesh())
+  {
+    nodes_per_elem_ = 4;
+    local_faces_ = { {1,2,3}, {0,3,2}, {0,1,3}, {0,2,1} };
+  }
+  else
+  {
+    nodes_per_elem_ = 3;
+    local_faces_ = { {0,1}, {1,2}, {2,0} };
+  }
+
+  const size_t fpe = local_faces_.size();
+  const size_t npf = local_faces_[0].size();
+
+  cells_.resize(num_elems_ * nodes_per_elem_);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type nodes(nodes_per_elem_);
+    for (size_t e = begin; e < end; e++)
+    {
+      mesh->get_nodes(nodes, VMesh::Elem::index_type(e));
+      std::copy(nodes.begin(), nodes.end(), cells_.begin() + e * nodes_per_elem_);
+    }
+  }, num_elems_);
+
+  std::vector<FaceKey> keys(num_elems_ * fpe);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t slot = begin; slot < end; slot++)
+    {
+      FaceKey& key = keys[slot];
+      key.nodes[2] = -1;
+      get_face_nodes(slot, key.nodes);
+      std::sort(key.nodes, key.nodes + npf);
+      key.slot = slot;
+    }
+  }, keys.size());
+  Parallel::Sort(keys.begin(), keys.end());
+
+  // A group of equal keys is handled by the range holding its first entry. The first
+  // two faces of a group are each other's neighbor; a face shared by more than two
+  // elements is only paired with the first one.
+  neighbors_.resize(keys.size());
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    size_t i = begin;
+    while (i < end && i > 0 && keys[i - 1].same_face(keys[i])) i++;
+    while (i < end)
+    {
+      size_t j = i + 1;
+      while (j < keys.size() && keys[i].same_face(keys[j])) j++;
+
+      if (j - i == 1)
+      {
+        neighbors_[keys[i].slot] = -1;
+      }
+      else
+      {
+        neighbors_[keys[i].slot] = elem(keys[i + 1].slot);
+        for (size_t q = i + 1; q < j; q++)
+          neighbors_[keys[q].slot] = elem(keys[i].slot);
+      }
+      i = j;
+    }
+  }, keys.size());
+}
+
+void ElementFaceTable::get_face_nodes(size_t slot, VMesh::index_type* nodes) const
+{
+  const size_t fpe = local_faces_.size();
+  const std::vector<int>& face = local_faces_[slot % fpe];
+  const VMesh::index_type* cell = &cells_[(slot / fpe) * nodes_per_elem_];
+  for (size_t q = 0; q < face.size(); q++)
+    nodes[q] = cell[face[q]];
+}
@@ -0,0 +1,146 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_ELEMENTFACETABLE_H
+#define CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_ELEMENTFACETABLE_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
+
+#include <tuple>
+#include <vector>
+
+// for Windows support
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun{
+  namespace Core{
+    namespace Algorithms{
+      namespace Fields{
+
+        // The faces of an unstructured tet mesh, or the edges of a tri mesh, paired by
+        // sorting their node keys rather than by asking the mesh for face neighbors.
+        // Face slot e*faces_per_elem() + k is the k-th face of element e in the order of
+        // VMesh::get_delems, and its nodes are ordered the way VMesh::get_nodes returns
+        // them for a face owned by element e.
+        class SCISHARE ElementFaceTable
+        {
+        public:
+          // Only the linear unstructured tet and tri meshes have a local face table.
+          static bool supports(VMesh* mesh);
+
+          explicit ElementFaceTable(VMesh* mesh);
+
+          size_t num_elems() const { return num_elems_; }
+          size_t num_slots() const { return neighbors_.size(); }
+          size_t faces_per_elem() const { return local_faces_.size(); }
+          size_t nodes_per_face() const { return local_faces_[0].size(); }
+
+          VMesh::index_type elem(size_t slot) const
+            { return static_cast<VMesh::index_type>(slot / local_faces_.size()); }
+
+          // Element on the other side of a face slot, or -1 for a face on the boundary.
+          VMesh::index_type neighbor(size_t slot) const { return neighbors_[slot]; }
+
+          void get_face_nodes(size_t slot, VMesh::index_type* nodes) const;
+
+        private:
+          size_t num_elems_;
+          size_t nodes_per_elem_;
+          std::vector<std::vector<int> > local_faces_;
+          std::vector<VMesh::index_type> cells_;
+          std::vector<VMesh::index_type> neighbors_;
+        };
+
+        // Renumbers the nodes of a flat list of faces in order of first use, which is
+        // the numbering they get when the faces are added to a new mesh one at a time.
+        // Nodes of faces on different sheets are kept apart, sheet(f) returns the sheet
+        // of face f. On return face_nodes holds the new node numbers and used_nodes the
+        // old node of every new node.
+        template <class SHEET>
+        void compact_face_nodes(std::vector<VMesh::index_type>& face_nodes, size_t nodes_per_face,
+          SHEET sheet, std::vector<VMesh::index_type>& used_nodes)
+        {
+          typedef std::tuple<VMesh::index_type, decltype(sheet(size_t(0))), size_t> entry_type;
+          const size_t num_entries = face_nodes.size();
+
+          std::vector<entry_type> entries(num_entries);
+          Thread::Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+          {
+            for (size_t i = begin; i < end; i++)
+              entries[i] = entry_type(face_nodes[i], sheet(i / nodes_per_face), i);
+          }, num_entries);
+          Thread::Parallel::Sort(entries.begin(), entries.end());
+
+          // Every entry points at the first use of its node, which is the first entry of its group.
+          auto same_node = [&](size_t i, size_t j)
+          {
+            return (std::get<0>(entries[i]) == std::get<0>(entries[j]) && std::get<1>(entries[i]) == std::get<1>(entries[j]));
+          };
+          std::vector<size_t> first_use(num_entries);
+          std::vector<char> is_first(num_entries, 0);
+          Thread::Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+          {
+            size_t i = begin;
+            while (i < end && i > 0 && same_node(i - 1, i)) i++;
+            while (i < end)
+            {
+              const size_t first = std::get<2>(entries[i]);
+              is_first[first] = 1;
+              size_t j = i;
+              for (; j < num_entries && same_node(i, j); j++)
+                first_use[std::get<2>(entries[j])] = first;
+              i = j;
+            }
+          }, num_entries);
+          std::vector<entry_type>().swap(entries);
+
+          std::vector<VMesh::index_type> new_node(num_entries, -1);
+          used_nodes.clear();
+          for (size_t i = 0; i < num_entries; i++)
+          {
+            if (is_first[i])
+            {
+              new_node[i] = static_cast<VMesh::index_type>(used_nodes.size());
+              used_nodes.push_back(face_nodes[i]);
+            }
+          }
+
+          Thread::Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+          {
+            for (size_t i = begin; i < end; i++)
+              face_nodes[i] = new_node[first_use[i]];
+          }, num_entries);
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -25,8 +25,8 @@
    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
    DEALINGS IN THE SOFTWARE.
 */
-
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/GetFieldBoundaryAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ElementFaceTable.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
@@ -36,14 +36,14 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
-
-#include <boost/unordered_map.hpp>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmOutputName GetFieldBoundaryAlgo::BoundaryField("BoundaryField");
 AlgorithmOutputName GetFieldBoundaryAlgo::MappingMatrix("Mapping");
@@ -53,266 +53,143 @@ GetFieldBoundaryAlgo::GetFieldBoundaryAlgo()
   addOption(AlgorithmParameterName("mapping"),"auto","auto|node|elem|none");
 }
 
-struct IndexHash 
-{
-  size_t operator()(const index_type &idx) const
-    { return (static_cast<size_t>(idx)); }
-};
-
-bool 
-GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const
+namespace
 {
-  ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
-
-  /// Define types we need for mapping
-  using hash_map_type = boost::unordered_map<index_type,index_type,IndexHash>;
-
-  hash_map_type node_map;
-  hash_map_type elem_map;
-  
-  /// Check whether we have an input field
-  if (!input)
-  {
-    error("No input field");
-    return (false);
-  }
-
-  /// Figure out what the input type and output type have to be
-  FieldInformation fi(input);
-  FieldInformation fo(input);
-  
-  /// We do not yet support Quadratic and Cubic Meshes here
-  if (fi.is_nonlinear())
-  {
-    error("This function has not yet been defined for non-linear elements");
-    return (false);
-  }
-  
-  /// Figure out which type of field the output is:
-  auto found_method = false;
-  if (fi.is_hex_element())    { fo.make_quadsurfmesh(); found_method = true; }
-  if (fi.is_prism_element())  { fo.make_quadsurfmesh(); found_method = true; }
-  if (fi.is_tet_element())    { fo.make_trisurfmesh(); found_method = true; }
-  if (fi.is_quad_element())   { fo.make_curvemesh(); found_method = true; }
-  if (fi.is_tri_element())    { fo.make_curvemesh(); found_method = true; }
-  if (fi.is_pnt_element())
-  {
-    remark("The field boundary of a point cloud is the same point cloud");
-    output = input;
-    return (true);
-  }
-  
-  /// Check whether we could make a conversion
-  if (!found_method)
-  {
-    error("No method available for mesh of type: " + fi.get_mesh_type());
-    return (false);
-  }
+  /// Both boundary finders add the boundary faces to omesh and record the input
+  /// element of every new element and the input node of every new node.
 
-  /// Create the output field
-  output = CreateField(fo);
-  if (!output)
+  /// This algorithm was copy from the original dynamic compiled version
+  /// and was slightly adapted to work here. It asks the mesh for the neighbor
+  /// across every face and is used for the structured meshes and for the
+  /// element types that have no local face table.
+  void add_boundary_by_neighbors(VMesh* imesh, VMesh* omesh,
+    std::vector<index_type>& elem_map, std::vector<index_type>& node_map)
   {
-    error("Could not create output field");
-    return (false);
-  }
-  
-  /// Get the virtual interfaces:
-  auto imesh = input->vmesh();
-  auto omesh = output->vmesh();
-  auto ifield = input->vfield();
-  auto ofield = output->vfield();
-
-  imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
+    imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
 
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems; 
-  VMesh::Node::array_type inodes; 
-  VMesh::Node::array_type onodes; 
-  VMesh::Node::index_type a;
+    std::vector<index_type> new_node(imesh->num_nodes(), -1);
 
-  inodes.clear();
-  onodes.clear();  
-  Point point;
+    VMesh::Elem::iterator be, ee;
+    VMesh::Elem::index_type nci, ci;
+    VMesh::DElem::array_type delems;
+    VMesh::Node::array_type inodes;
+    VMesh::Node::array_type onodes;
+    Point point;
 
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-  
-  imesh->begin(be); 
-  imesh->end(ee);
+    imesh->begin(be);
+    imesh->end(ee);
 
-  while (be != ee)
-  {
-    checkForInterruption();
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
+    while (be != ee)
     {
-      auto includeface = false;
-
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
-
-      if (includeface)
+      Interruptible::checkForInterruption();
+      ci = *be;
+      imesh->get_delems(delems, ci);
+      for (size_t p = 0; p < delems.size(); p++)
       {
+        if (imesh->get_neighbor(nci, ci, delems[p])) continue;
+
         imesh->get_nodes(inodes, delems[p]);
         onodes.resize(inodes.size());
-
         for (size_t q = 0; q < inodes.size(); q++)
         {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
+          const index_type a = inodes[q];
+          if (new_node[a] < 0)
           {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
+            imesh->get_center(point, inodes[q]);
+            new_node[a] = omesh->add_node(point);
+            node_map.push_back(a);
           }
+          onodes[q] = new_node[a];
         }
-        elem_map[omesh->add_elem(onodes)] = ci;
+        omesh->add_elem(onodes);
+        elem_map.push_back(ci);
       }
+      ++be;
     }
-    ++be;
   }
 
-  mapping.reset();
-
-  ofield->resize_fdata();
-
-  if (
-    (
-    (ifield->basis_order() == 0)
-#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-      && checkOption("mapping","auto")
-      )
-      ||
-       checkOption("mapping","elem")
-#else
-    )
-#endif
-      )
+  /// The same boundary for tet and tri meshes, found by sorting the keys of all
+  /// element faces: a face whose key appears once is on the boundary. Faces and
+  /// nodes come out in the order the neighbor search above produces them.
+  void add_boundary_by_sorting(VMesh* imesh, VMesh* omesh,
+    std::vector<index_type>& elem_map, std::vector<index_type>& node_map)
   {
-    VMesh::Elem::size_type isize;
-    VMesh::Elem::size_type osize;
-    imesh->size(isize);
-    omesh->size(osize);
-
-    size_type nrows = osize;
-    size_type ncols = isize;
-
-    typedef SparseRowMatrix::Triplet T;
-    std::vector<T> tripletList;
-    tripletList.reserve(nrows);
-
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
+    ElementFaceTable table(imesh);
+    const size_t num_slots = table.num_slots();
+    const size_t npf = table.nodes_per_face();
+
+    // Boundary slots are collected per block and concatenated in slot order.
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_slots / 1024));
+    std::vector<std::vector<size_t> > block_slots(numBlocks);
+    Parallel::RunTasks([&](int b)
+    {
+      for (size_t s = num_slots * b / numBlocks; s < num_slots * (b + 1) / numBlocks; s++)
+        if (table.neighbor(s) < 0) block_slots[b].push_back(s);
+    }, static_cast<int>(numBlocks));
 
-    while (it != it_end)
+    std::vector<size_t> slots;
+    for (auto& block : block_slots)
     {
-      tripletList.push_back(T(it->first, it->second, 1));
-      ++it;
+      slots.insert(slots.end(), block.begin(), block.end());
+      std::vector<size_t>().swap(block);
     }
-    SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
-    mat->setFromTriplets(tripletList.begin(), tripletList.end());
-    mapping = mat;
-  }
-  else if (
-    ((ifield->basis_order() == 1) 
-#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-    && checkOption("mapping","auto"))
-    ||
-      checkOption("mapping","node")
-#else
-    )
-#endif
-      )
-  {
-    VMesh::Node::size_type isize;
-    VMesh::Node::size_type osize;
-    imesh->size(isize);
-    omesh->size(osize);
-
-    size_type nrows = osize;
-    size_type ncols = isize;
 
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> tripletList;
-    tripletList.reserve(nrows);
+    const size_t num_faces = slots.size();
+    std::vector<index_type> face_nodes(num_faces * npf);
+    elem_map.resize(num_faces);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t f = begin; f < end; f++)
+      {
+        table.get_face_nodes(slots[f], &face_nodes[f * npf]);
+        elem_map[f] = table.elem(slots[f]);
+      }
+    }, num_faces);
 
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
+    compact_face_nodes(face_nodes, npf, [](size_t) { return 0; }, node_map);
 
-    while (it != it_end)
+    std::vector<Point> points(node_map.size());
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
     {
-      tripletList.push_back(T(it->second, it->first, 1));
-      ++it;
-    }
-    SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
-    mat->setFromTriplets(tripletList.begin(), tripletList.end());
-    mapping = mat;
-  }
-  
-  if (ifield->basis_order() == 0)
-  {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
-    {      
-      checkForInterruption();
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);  
-      
-      /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
-    }
-  }
-  else if (input->basis_order() == 1)
-  {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-    
-    while (it != it_end)
+      for (size_t i = begin; i < end; i++)
+        imesh->get_center(points[i], VMesh::Node::index_type(node_map[i]));
+    }, points.size());
+
+    omesh->node_reserve(points.size());
+    for (const auto& p : points)
+      omesh->add_node(p);
+
+    omesh->elem_reserve(num_faces);
+    VMesh::Node::array_type onodes(npf);
+    for (size_t f = 0; f < num_faces; f++)
     {
-      checkForInterruption();
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      std::copy(face_nodes.begin() + f * npf, face_nodes.begin() + (f + 1) * npf, onodes.begin());
+      omesh->add_elem(onodes);
     }
   }
-  
-  CopyProperties(*input, *output);
-  
-  return (true);
 }
 
+bool 
+GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const
+{
+  return (runImpl(input, output, &mapping));
+}
 
-/// A copy of the algorithm without creating the mapping matrix. 
+/// A version of the algorithm without creating the mapping matrix. 
 /// Need this for the various algorithms that only use the boundary to
 /// project nodes on.
 
 bool 
 GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
+{
+  return (runImpl(input, output, nullptr));
+}
+
+bool
+GetFieldBoundaryAlgo::runImpl(FieldHandle input, FieldHandle& output, MatrixHandle* mapping) const
 {
   ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
 
-  /// Define types we need for mapping
-  using hash_map_type = boost::unordered_map<index_type,index_type,IndexHash>;
-  
-  hash_map_type node_map;
-  hash_map_type elem_map;
-  
   /// Check whether we have an input field
   if (!input)
   {
@@ -365,94 +242,97 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
   auto omesh = output->vmesh();
   auto ifield = input->vfield();
   auto ofield = output->vfield();
-  
-  imesh->synchronize(Mesh::DELEMS_E|Mesh::ELEM_NEIGHBORS_E);
-  
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems; 
-  VMesh::Node::array_type inodes; 
-  VMesh::Node::array_type onodes; 
-  VMesh::Node::index_type a;
-
-  inodes.clear();
-  onodes.clear();  
-  Point point;
 
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-  
-  imesh->begin(be); 
-  imesh->end(ee);
+  /// elem_map[i] is the input element of boundary element i,
+  /// node_map[i] the input node of boundary node i.
+  std::vector<index_type> elem_map;
+  std::vector<index_type> node_map;
 
-  while (be != ee)
+  if (ElementFaceTable::supports(imesh))
+    add_boundary_by_sorting(imesh, omesh, elem_map, node_map);
+  else
+    add_boundary_by_neighbors(imesh, omesh, elem_map, node_map);
+
+  if (mapping)
   {
-    checkForInterruption();
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
+    mapping->reset();
+
+    if (
+      (
+      (ifield->basis_order() == 0)
+#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
+        && checkOption("mapping","auto")
+        )
+        ||
+         checkOption("mapping","elem")
+#else
+      )
+#endif
+        )
     {
-      auto includeface = false;
+      VMesh::Elem::size_type isize;
+      imesh->size(isize);
 
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
+      size_type nrows = static_cast<size_type>(elem_map.size());
+      size_type ncols = isize;
 
-      if (includeface)
-      {
-        imesh->get_nodes(inodes, delems[p]);
-        if (onodes.size() == 0) onodes.resize(inodes.size());
-        for (size_t q = 0; q < onodes.size(); q++)
-        {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
-          {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
-        }
-        elem_map[omesh->add_elem(onodes)] = ci;
-      }
+      typedef SparseRowMatrix::Triplet T;
+      std::vector<T> tripletList;
+      tripletList.reserve(nrows);
+      for (size_t i = 0; i < elem_map.size(); i++)
+        tripletList.push_back(T(static_cast<index_type>(i), elem_map[i], 1));
+
+      SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
+      mat->setFromTriplets(tripletList.begin(), tripletList.end());
+      *mapping = mat;
+    }
+    else if (
+      ((ifield->basis_order() == 1) 
+#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
+      && checkOption("mapping","auto"))
+      ||
+        checkOption("mapping","node")
+#else
+      )
+#endif
+        )
+    {
+      VMesh::Node::size_type isize;
+      imesh->size(isize);
+
+      size_type nrows = static_cast<size_type>(node_map.size());
+      size_type ncols = isize;
+
+      typedef SparseRowMatrix::Triplet T;
+      std::vector<T> tripletList;
+      tripletList.reserve(nrows);
+      for (size_t i = 0; i < node_map.size(); i++)
+        tripletList.push_back(T(static_cast<index_type>(i), node_map[i], 1));
+
+      SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
+      mat->setFromTriplets(tripletList.begin(), tripletList.end());
+      *mapping = mat;
     }
-    ++be;
   }
-  
+
   ofield->resize_fdata();
-  
+
+  /// Copying values
   if (ifield->basis_order() == 0)
   {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-    
-    while (it != it_end)
-    {      
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);  
-      
-      /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
-    }
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+        ofield->copy_value(ifield, VMesh::Elem::index_type(elem_map[i]), VMesh::Elem::index_type(i));
+    }, elem_map.size());
   }
   else if (input->basis_order() == 1)
   {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-    
-    while (it != it_end)
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
     {
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
-    }
+      for (size_t i = begin; i < end; i++)
+        ofield->copy_value(ifield, VMesh::Node::index_type(node_map[i]), VMesh::Node::index_type(i));
+    }, node_map.size());
   }
   
   CopyProperties(*input, *output);
@@ -473,4 +353,4 @@ AlgorithmOutput GetFieldBoundaryAlgo::run(const AlgorithmInput& input) const
   output[BoundaryField] = boundary;
   output[MappingMatrix] = mapping;
   return output;
-}
\ No newline at end of file
+}
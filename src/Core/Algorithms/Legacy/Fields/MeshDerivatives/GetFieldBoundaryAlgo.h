@@ -55,6 +55,9 @@ public:
   bool run(FieldHandle input, FieldHandle& output) const;
 
   AlgorithmOutput run(const AlgorithmInput& input) const;
+
+private:
+  bool runImpl(FieldHandle input, FieldHandle& output, Datatypes::MatrixHandle* mapping) const;
 };
 
 }}}}
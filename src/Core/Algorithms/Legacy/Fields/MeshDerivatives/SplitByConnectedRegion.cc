@@ -33,12 +33,15 @@
 #include <Core/Datatypes/Legacy/Field/Mesh.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Thread/Parallel.h>
+#include <atomic>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmInputName SplitFieldByConnectedRegionAlgo::InputField("InputField");
 AlgorithmOutputName SplitFieldByConnectedRegionAlgo::OutputField1("OutputField1");
@@ -52,6 +55,7 @@ AlgorithmOutputName SplitFieldByConnectedRegionAlgo::OutputField8("OutputField8"
 
 AlgorithmParameterName SplitFieldByConnectedRegionAlgo::SortDomainBySize() { return AlgorithmParameterName("SortDomainBySize"); }
 AlgorithmParameterName SplitFieldByConnectedRegionAlgo::SortAscending() { return AlgorithmParameterName("SortAscending"); }
+AlgorithmParameterName SplitFieldByConnectedRegionAlgo::OutputLabelField() { return AlgorithmParameterName("OutputLabelField"); }
 
 /// TODO: These should be refactored to hold const std::vector<double>& rather than double*
 class SortSizes : public std::binary_function<index_type,index_type,bool>
@@ -86,107 +90,206 @@ SplitFieldByConnectedRegionAlgo::SplitFieldByConnectedRegionAlgo()
 {
   addParameter(SortDomainBySize(), false);
   addParameter(SortAscending(), false);
+  addParameter(OutputLabelField(), false);
+}
+
+namespace
+{
+  // Union-find over the mesh nodes that can be updated from several threads. A root
+  // is always linked below a smaller root, so every set ends up rooted at its lowest
+  // node regardless of the order in which the threads unite them.
+  class ConcurrentNodeSets
+  {
+  public:
+    explicit ConcurrentNodeSets(size_type size) : parent_(size)
+    {
+      Parallel::RunTasksOverRange([this](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; i++) parent_[i].store(static_cast<index_type>(i), std::memory_order_relaxed);
+      }, static_cast<size_t>(size));
+    }
+
+    index_type find(index_type x)
+    {
+      // path halving: every visited node is pointed to its grandparent
+      index_type p = parent_[x].load(std::memory_order_relaxed);
+      while (p != x)
+      {
+        index_type gp = parent_[p].load(std::memory_order_relaxed);
+        if (gp != p) parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        x = gp;
+        p = parent_[x].load(std::memory_order_relaxed);
+      }
+      return x;
+    }
+
+    void unite(index_type a, index_type b)
+    {
+      while (true)
+      {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);
+        // a is the larger root; retry if another thread linked it in the meantime
+        index_type expected = a;
+        if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return;
+      }
+    }
+
+  private:
+    std::vector<std::atomic<index_type> > parent_;
+  };
 }
 
 std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input) const
 {
  bool sortDomainBySize = get(SortDomainBySize()).toBool();
  bool sortAscending = get(SortAscending()).toBool();
- 
+ bool outputLabelField = get(OutputLabelField()).toBool();
+
  if (!input)
  {
       THROW_ALGORITHM_INPUT_ERROR("Input mesh is empty.");
  }
-  
+
  std::vector<FieldHandle> output;
- 
+
    /// Figure out what the input type and output type have to be
   FieldInformation fi(input);
-    
+
   /// We do not yet support Quadratic and Cubic Meshes here
   if (fi.is_nonlinear())
   {
-    THROW_ALGORITHM_INPUT_ERROR("This function has not yet been defined for non-linear elements.");    
+    THROW_ALGORITHM_INPUT_ERROR("This function has not yet been defined for non-linear elements.");
   }
-  
+
   if (!(fi.is_unstructuredmesh()))
   {
     output.push_back(input);
-    remark("Structured meshes consist always of one piece. Hence there is no algorithm to perform."); 
-  }  
-  
+    remark("Structured meshes consist always of one piece. Hence there is no algorithm to perform.");
+    return output;
+  }
+
   if (fi.is_pointcloudmesh())
   {
     THROW_ALGORITHM_INPUT_ERROR("This algorithm has not yet been defined for point clouds.");
-  }  
- 
+  }
+
   VField* ifield = input->vfield();
   VMesh*  imesh  = input->vmesh();
 
-  VField::index_type k = 0;
+  VMesh::size_type num_nodes = imesh->num_nodes();
+  VMesh::size_type num_elems = imesh->num_elems();
 
-  VMesh::size_type num_nodes = imesh->num_nodes(); 
-  VMesh::size_type num_elems = imesh->num_elems(); 
-  
-  VField::size_type surfsize = static_cast<VField::size_type>(pow(num_elems, 2.0 / 3.0));
-  std::vector<VMesh::Elem::index_type> buffer;
-  buffer.reserve(surfsize);
-  
-  imesh->synchronize(Mesh::NODE_NEIGHBORS_E|Mesh::ELEM_NEIGHBORS_E|Mesh::DELEMS_E); 
-
-  std::vector<index_type> elemmap(num_elems, 0);
-  std::vector<index_type> nodemap(num_nodes, 0);
-  std::vector<index_type> renumber(num_nodes,0);
-  std::vector<short> visited(num_elems, 0);
-
-  VMesh::Node::array_type nnodes;
-  VMesh::Elem::array_type neighbors;
- 
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  // Elements sharing a node belong to the same region, so uniting the nodes of
+  // every element labels the regions without any neighbor tables.
+  ConcurrentNodeSets sets(num_nodes);
+  std::vector<index_type> elemroot(num_elems);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
   {
-    // if list of elements to process is empty ad the next one
-    if (buffer.size() == 0)
+    VMesh::Node::array_type nnodes;
+    for (size_t q = begin; q < end; q++)
     {
-      if(visited[idx] == 0) { buffer.push_back(idx); k++; }
+      imesh->get_nodes(nnodes, VMesh::Elem::index_type(q));
+      for (size_t r = 1; r < nnodes.size(); r++)
+        sets.unite(nnodes[0], nnodes[r]);
+      elemroot[q] = nnodes[0];
     }
-    
-    if (buffer.size() > 0)
+  }, num_elems);
+
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t q = begin; q < end; q++) elemroot[q] = sets.find(elemroot[q]);
+  }, num_elems);
+
+  // Regions are numbered in the order of their first element.
+  std::vector<index_type> region(num_nodes, -1);
+  std::vector<index_type> elemmap(num_elems);
+  size_type k = 0;
+  for (index_type q = 0; q < num_elems; q++)
+  {
+    if (region[elemroot[q]] < 0) region[elemroot[q]] = k++;
+    elemmap[q] = region[elemroot[q]];
+  }
+
+  // Nodes that are not used by any element do not belong to a region.
+  std::vector<index_type> nodemap(num_nodes);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t q = begin; q < end; q++) nodemap[q] = region[sets.find(q)];
+  }, num_nodes);
+
+  if (sortDomainBySize)
+  {
+    std::vector<double> sizes(k, 0.0);
+    std::vector<index_type> order(k);
+    for (index_type q = 0; q < num_elems; q++)
+      sizes[elemmap[q]] += imesh->get_size(VMesh::Elem::index_type(q));
+    for (index_type j = 0; j < k; j++) order[j] = j;
+
+    if (!sizes.empty())
     {
-      for (size_t i=0; i< buffer.size(); i++)
+      if (sortAscending)
       {
-        VField::index_type j = buffer[i];
-        if (visited[j] > 0) { continue; }
-        visited[j] = 1;
-        
-        imesh->get_nodes(nnodes,buffer[i]);
-        for (size_t q=0; q<nnodes.size(); q++)
-        {
-          imesh->get_elems(neighbors,nnodes[q]);
-          for (size_t p=0; p<neighbors.size(); p++)
-          {
-            if(visited[neighbors[p]] == 0)
-            {
-              buffer.push_back(neighbors[p]);
-              visited[neighbors[p]] = -1;            
-            }
-          }
-        }
-         
-        if (j >= static_cast<index_type>(elemmap.size())) elemmap.resize(j+1);
-        
-        elemmap[j] = k;
-        for (size_t p=0;p<nnodes.size();p++)
-        {
-          if (static_cast<size_t>(nnodes[p]) >= nodemap.size())
-            nodemap.resize(nnodes[p]+1);      
-          nodemap[nnodes[p]] = k;
-        }
+        std::sort(order.begin(), order.end(), AscSortSizes(&(sizes[0])));
+      }
+      else
+      {
+        std::sort(order.begin(), order.end(), SortSizes(&(sizes[0])));
       }
-      buffer.clear();
     }
+
+    std::vector<index_type> rank(k);
+    for (index_type j = 0; j < k; j++) rank[order[j]] = j;
+    for (auto& r : elemmap) r = rank[r];
+    for (auto& r : nodemap) if (r >= 0) r = rank[r];
   }
- 
- output.resize(k);
+
+  if (outputLabelField)
+  {
+    FieldInformation fo(input);
+    fo.make_constantdata();
+    fo.make_int();
+    FieldHandle field = CreateField(fo, input->mesh());
+    if (!field)
+    {
+      THROW_ALGORITHM_INPUT_ERROR("Could not create output field");
+    }
+    VField* ofield = field->vfield();
+    ofield->resize_values();
+    for (index_type q = 0; q < num_elems; q++)
+      ofield->set_value(static_cast<int>(elemmap[q] + 1), q);
+    output.push_back(field);
+    return output;
+  }
+
+  // Bucket the nodes and elements by region in one pass, keeping their order.
+  std::vector<index_type> nodeoffset(k + 1, 0), elemoffset(k + 1, 0);
+  for (index_type q = 0; q < num_nodes; q++) if (nodemap[q] >= 0) nodeoffset[nodemap[q] + 1]++;
+  for (index_type q = 0; q < num_elems; q++) elemoffset[elemmap[q] + 1]++;
+  for (index_type p = 0; p < k; p++)
+  {
+    nodeoffset[p + 1] += nodeoffset[p];
+    elemoffset[p + 1] += elemoffset[p];
+  }
+
+  std::vector<index_type> nodes(nodeoffset[k]), elems(num_elems), renumber(num_nodes, 0);
+  {
+    std::vector<index_type> nodefill(nodeoffset.begin(), nodeoffset.end() - 1);
+    std::vector<index_type> elemfill(elemoffset.begin(), elemoffset.end() - 1);
+    for (index_type q = 0; q < num_nodes; q++)
+    {
+      if (nodemap[q] < 0) continue;
+      const index_type slot = nodefill[nodemap[q]]++;
+      nodes[slot] = q;
+      renumber[q] = slot - nodeoffset[nodemap[q]];
+    }
+    for (index_type q = 0; q < num_elems; q++)
+      elems[elemfill[elemmap[q]]++] = q;
+  }
+
+  output.resize(k);
   for (size_type p=0; p<k; p++)
   {
     VField* ofield;
@@ -194,12 +297,6 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     MeshHandle mesh;
     FieldHandle field;
 
-    VField::size_type nn = 0;
-    VField::size_type ne = 0;
-    
-    for (VField::index_type q=0;q<num_nodes;q++) if (nodemap[q] == p+1) nn++;
-    for (VField::index_type q=0;q<num_elems;q++) if (elemmap[q] == p+1) ne++;
-    
     mesh = CreateMesh(fi);
     if (!mesh)
     {
@@ -207,111 +304,55 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     }
     omesh = mesh->vmesh();
 
-    omesh->node_reserve(nn);
-    omesh->elem_reserve(ne);
+    omesh->node_reserve(nodeoffset[p + 1] - nodeoffset[p]);
+    omesh->elem_reserve(elemoffset[p + 1] - elemoffset[p]);
 
     field = CreateField(fi,mesh);
     if (field == nullptr)
     {
       THROW_ALGORITHM_INPUT_ERROR("Could not create output field");
-    }      
-    
+    }
+
     ofield = field->vfield();
     output[p] = field;
 
     Point point;
-    for (index_type q=0;q<num_nodes;q++) 
-    {  
-      if (nodemap[q] == p+1) 
-      {
-        imesh->get_center(point,VMesh::Node::index_type(q));
-        renumber[q] = omesh->add_point(point);
-      }
+    for (index_type q = nodeoffset[p]; q < nodeoffset[p + 1]; q++)
+    {
+      imesh->get_center(point,VMesh::Node::index_type(nodes[q]));
+      omesh->add_point(point);
     }
-    
+
     VMesh::Node::array_type elemnodes;
-    for (index_type q=0;q<num_elems;q++) 
-    {  
-      if (elemmap[q] == p+1) 
-      {   
-        imesh->get_nodes(elemnodes,VMesh::Elem::index_type(q));
-        for (size_t r=0; r< elemnodes.size(); r++)
-        {
-          elemnodes[r] = VMesh::Node::index_type(renumber[elemnodes[r]]);
-        }
-        omesh->add_elem(elemnodes);
+    for (index_type q = elemoffset[p]; q < elemoffset[p + 1]; q++)
+    {
+      imesh->get_nodes(elemnodes,VMesh::Elem::index_type(elems[q]));
+      for (size_t r=0; r< elemnodes.size(); r++)
+      {
+        elemnodes[r] = VMesh::Node::index_type(renumber[elemnodes[r]]);
       }
+      omesh->add_elem(elemnodes);
     }
-    
+
     ofield->resize_fdata();
 
     if (ifield->basis_order() == 1)
     {
-      VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_nodes;q++) 
-      {  
-        if (nodemap[q] == p+1) 
-        {
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
-      }
+      for (index_type q = nodeoffset[p]; q < nodeoffset[p + 1]; q++)
+        ofield->copy_value(ifield, nodes[q], q - nodeoffset[p]);
     }
-    
+
     if (ifield->basis_order() == 0)
     {
-      VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_elems;q++) 
-      {  
-        if (elemmap[q] == p+1) 
-        {   
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
-      }    
+      for (index_type q = elemoffset[p]; q < elemoffset[p + 1]; q++)
+        ofield->copy_value(ifield, elems[q], q - elemoffset[p]);
     }
-   
+
    #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
     ofield->copy_properties(ifield);
    #endif
   }
 
-  if (sortDomainBySize)
-  {
-    std::vector<double> sizes(output.size());
-    std::vector<index_type> order(output.size());
-    std::vector<FieldHandle> temp(output.size());
-    
-    for (size_t j=0; j<output.size(); j++)
-    {
-      VMesh* mesh = output[j]->vmesh();
-      VMesh::Elem::size_type num_elems = mesh->num_elems();
-      double size = 0.0;
-      for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
-      {
-        size += mesh->get_size(idx);
-      }
-      sizes[j] = size;
-      order[j] = j;
-      temp[j] = output[j];
-    }
-  
-    if (!sizes.empty())
-    {
-      if (sortAscending)
-      {
-        std::sort(order.begin(), order.end(), AscSortSizes(&(sizes[0])));
-      }
-      else
-      {
-        std::sort(order.begin(), order.end(), SortSizes(&(sizes[0])));
-      }
-    }
-    
-    for (size_t j=0; j<output.size(); j++)
-    {
-      output[j] = temp[order[j]];
-    }
-  }
- 
  return output;
 }
 
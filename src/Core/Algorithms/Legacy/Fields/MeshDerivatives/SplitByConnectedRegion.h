@@ -36,7 +36,7 @@
 ///
 ///@details
 /// The module separates mesh elements that are not connected and outputs the first 8 fields (chosen based on element size or ordering) or 
-/// all sub fields stored as a bundle.
+/// all sub fields stored as a bundle. Alternatively a single field with the region label of every element is output.
 
 #ifndef CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_SPLITBYCONNECTEDREGION_H
 #define CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_SPLITBYCONNECTEDREGION_H 1
@@ -67,6 +67,8 @@ public:
   
   static AlgorithmParameterName SortDomainBySize();
   static AlgorithmParameterName SortAscending();
+  // Output a single field labeling the elements by region instead of splitting it.
+  static AlgorithmParameterName OutputLabelField();
   std::vector<FieldHandle> run(FieldHandle input) const;
 
   AlgorithmOutput run(const AlgorithmInput& input) const;
@@ -55,6 +55,7 @@ using namespace SCIRun::Core::Logging;
 ALGORITHM_PARAMETER_DEF(Fields, AddConstraints);
 ALGORITHM_PARAMETER_DEF(Fields, RefineMethod);
 ALGORITHM_PARAMETER_DEF(Fields, IsoValue);
+ALGORITHM_PARAMETER_DEF(Fields, RefineIterations);
 
 RefineMeshAlgo::RefineMeshAlgo()
 {
@@ -62,6 +63,7 @@ RefineMeshAlgo::RefineMeshAlgo()
 		addOption(AddConstraints,"all","all|greaterthan|unequal|lessthan|none");
 		addOption(RefineMethod,"Default","Default|Expand refinement volume to improve element quality");
 		addParameter(IsoValue,0.0);
+		addParameter(RefineIterations,1);
 }
 
 AlgorithmOutput RefineMeshAlgo::run(const AlgorithmInput& input) const
@@ -76,6 +78,22 @@ AlgorithmOutput RefineMeshAlgo::run(const AlgorithmInput& input) const
   return output;
 }
 
+namespace
+{
+  // The hex, quad and curve refinements work on a mesh directly and are simply run
+  // again on their own output; tets and triangles iterate on a flat copy instead.
+  template <class REFINE>
+  bool refineRepeatedly(REFINE refine, FieldHandle input, FieldHandle& output, int iterations)
+  {
+    for (int iter = 0; iter < iterations; iter++)
+    {
+      if (!refine(input, output)) return (false);
+      input = output;
+    }
+    return (true);
+  }
+}
+
 // General access function
 
 bool
@@ -93,6 +111,7 @@ RefineMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
 	const std::string rMethod = getOption(Parameters::RefineMethod);
 	const double isoVal = get(Parameters::IsoValue).toDouble();
 	const std::string addCon = getOption(Parameters::AddConstraints);
+	const int iterations = get(Parameters::RefineIterations).toInt();
 
   if (input->vfield()->num_values() == 0)
   {
@@ -100,6 +119,12 @@ RefineMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
     return (false);
   }
 
+  if (iterations < 1)
+  {
+    error("Number of refinement iterations needs to be at least one");
+    return (false);
+  }
+
   if (addCon == "none")
   {
     output = input;
@@ -122,7 +147,7 @@ RefineMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
   {
     RefineMeshQuadSurfAlgoV algo;
     algo.setUpdaterFunc(getUpdaterFunc());
-    return(algo.runImpl(input, output, addCon, isoVal));
+    return(refineRepeatedly([&](FieldHandle in, FieldHandle& out) { return algo.runImpl(in, out, addCon, isoVal); }, input, output, iterations));
   }
 
   if (fi.is_hex_element())
@@ -131,28 +156,28 @@ RefineMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
     convex = rMethod == "Expand refinement volume to improve element quality";
     RefineMeshHexVolAlgoV algo;
     algo.setUpdaterFunc(getUpdaterFunc());
-    return(algo.runImpl(input, output, convex, addCon, isoVal));
+    return(refineRepeatedly([&](FieldHandle in, FieldHandle& out) { return algo.runImpl(in, out, convex, addCon, isoVal); }, input, output, iterations));
   }
 
   if (fi.is_crv_element())
   {
     RefineMeshCurveAlgoV algo;
     algo.setUpdaterFunc(getUpdaterFunc());
-    return(algo.runImpl(input, output, addCon, isoVal));
+    return(refineRepeatedly([&](FieldHandle in, FieldHandle& out) { return algo.runImpl(in, out, addCon, isoVal); }, input, output, iterations));
   }
 
   if (fi.is_tri_element())
   {
     RefineMeshTriSurfAlgoV algo;
     algo.setUpdaterFunc(getUpdaterFunc());
-    return(algo.runImpl(input, output, addCon, isoVal));
+    return(algo.runImpl(input, output, addCon, isoVal, iterations));
   }
 
   if (fi.is_tet_element())
   {
     RefineMeshTetVolAlgoV algo;
     algo.setUpdaterFunc(getUpdaterFunc());
-    return(algo.runImpl(input, output, addCon, isoVal));
+    return(algo.runImpl(input, output, addCon, isoVal, iterations));
   }
 
   error("No refinement method has been implemented for this type of mesh");
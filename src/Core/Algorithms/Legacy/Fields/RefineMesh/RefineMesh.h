@@ -47,6 +47,7 @@ namespace SCIRun{
 ALGORITHM_PARAMETER_DECL(RefineMethod);
 ALGORITHM_PARAMETER_DECL(AddConstraints);
 ALGORITHM_PARAMETER_DECL(IsoValue);
+ALGORITHM_PARAMETER_DECL(RefineIterations);
 
 class SCISHARE RefineMeshAlgo : public AlgorithmBase
 {
@@ -50,7 +50,7 @@ namespace SCIRun{
         public:
           RefineMeshTetVolAlgoV();
 
-          bool runImpl(FieldHandle input, FieldHandle& output, const std::string& select, double isoval) const;
+          bool runImpl(FieldHandle input, FieldHandle& output, const std::string& select, double isoval, int iterations = 1) const;
           AlgorithmOutput run(const AlgorithmInput& input) const override;
         };
       }
@@ -0,0 +1,178 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/RefinementMesh.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+void RefinementMesh::load(const VMesh* mesh, const VField* field)
+{
+  const size_t num_nodes = mesh->num_nodes();
+  const size_t num_elems = mesh->num_elems();
+
+  points.resize(num_nodes);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+      mesh->get_point(points[i], VMesh::Node::index_type(i));
+  }, num_nodes);
+
+  cells.resize(num_elems * nodesPerElem);
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    VMesh::Node::array_type nodes(nodesPerElem);
+    for (size_t e = begin; e < end; e++)
+    {
+      mesh->get_nodes(nodes, VMesh::Elem::index_type(e));
+      std::copy(nodes.begin(), nodes.end(), cells.begin() + e * nodesPerElem);
+    }
+  }, num_elems);
+
+  values.clear();
+  if (basisOrder == 0 || basisOrder == 1)
+    field->get_values(values);
+}
+
+void RefinementMesh::store(VMesh* mesh, VField* field) const
+{
+  mesh->node_reserve(points.size());
+  for (const auto& p : points)
+    mesh->add_point(p);
+
+  const size_t num_cells = num_elems();
+  mesh->elem_reserve(num_cells);
+  VMesh::Node::array_type nodes(nodesPerElem);
+  for (size_t c = 0; c < num_cells; c++)
+  {
+    std::copy(cells.begin() + c * nodesPerElem, cells.begin() + (c + 1) * nodesPerElem, nodes.begin());
+    mesh->add_elem(nodes);
+  }
+
+  field->resize_values();
+  if (basisOrder == 0 || basisOrder == 1)
+    field->set_values(values);
+}
+
+bool RefinementMesh::select_nodes(const std::string& select, double isoval, std::vector<char>& selected) const
+{
+  selected.assign(num_nodes(), 0);
+
+  if (select == "all" || (basisOrder != 0 && basisOrder != 1))
+  {
+    std::fill(selected.begin(), selected.end(), 1);
+    return (true);
+  }
+
+  auto pass = [&](double v)
+  {
+    if (select == "equal") return (v == isoval);
+    if (select == "lessthan") return (v < isoval);
+    return (v > isoval);
+  };
+
+  if (select != "equal" && select != "lessthan" && select != "greaterthan")
+    return (false);
+
+  // If data is on the elements all nodes of a passing element get refined.
+  if (basisOrder == 0)
+  {
+    for (size_t e = 0; e < num_elems(); e++)
+    {
+      if (pass(values[e]))
+        for (size_t j = 0; j < nodesPerElem; j++)
+          selected[cells[e * nodesPerElem + j]] = 1;
+    }
+  }
+  else
+  {
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+        selected[i] = pass(values[i]);
+    }, num_nodes());
+  }
+  return (true);
+}
+
+MidpointEdgeTable::MidpointEdgeTable(const RefinementMesh& mesh, const LocalEdgeList& local_edges, const std::vector<char>& selected) :
+  firstNode_(static_cast<VMesh::index_type>(mesh.num_nodes()))
+{
+  const size_t npe = mesh.nodesPerElem;
+  const size_t num_elems = mesh.num_elems();
+  const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_elems / 256));
+  std::vector<std::vector<std::pair<VMesh::index_type, VMesh::index_type> > > keys(numBlocks);
+
+  Parallel::RunTasks([&](int b)
+  {
+    for (size_t e = num_elems * b / numBlocks; e < num_elems * (b + 1) / numBlocks; e++)
+    {
+      const VMesh::index_type* elem = &mesh.cells[e * npe];
+      for (const auto& edge : local_edges)
+      {
+        const VMesh::index_type n0 = elem[edge.first];
+        const VMesh::index_type n1 = elem[edge.second];
+        if (selected[n0] || selected[n1])
+          keys[b].push_back(std::make_pair(std::min(n0, n1), std::max(n0, n1)));
+      }
+    }
+  }, static_cast<int>(numBlocks));
+
+  for (auto& block : keys)
+  {
+    edges_.insert(edges_.end(), block.begin(), block.end());
+    std::vector<std::pair<VMesh::index_type, VMesh::index_type> >().swap(block);
+  }
+  Parallel::Sort(edges_.begin(), edges_.end());
+  edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+}
+
+void MidpointEdgeTable::add_midpoints(RefinementMesh& mesh) const
+{
+  const size_t num_edges = edges_.size();
+  const bool interpolate = (mesh.basisOrder == 1);
+  mesh.points.resize(firstNode_ + num_edges);
+  if (interpolate) mesh.values.resize(firstNode_ + num_edges);
+
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+  {
+    for (size_t k = begin; k < end; k++)
+    {
+      const VMesh::index_type n0 = edges_[k].first;
+      const VMesh::index_type n1 = edges_[k].second;
+      mesh.points[firstNode_ + k] = Point((mesh.points[n0] + mesh.points[n1])*0.5);
+      if (interpolate)
+        mesh.values[firstNode_ + k] = 0.5*(mesh.values[n0] + mesh.values[n1]);
+    }
+  }, num_edges);
+}
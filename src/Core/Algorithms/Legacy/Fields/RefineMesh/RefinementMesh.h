@@ -0,0 +1,166 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_REFINEMESH_REFINEMENTMESH_H
+#define CORE_ALGORITHMS_FIELDS_REFINEMESH_REFINEMENTMESH_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+// for Windows support
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun{
+  namespace Core{
+    namespace Algorithms{
+      namespace Fields{
+
+        // Local node pairs of the edges of one element type, in the order of VMesh::get_edges.
+        typedef std::vector<std::pair<int, int> > LocalEdgeList;
+
+        // Flat copy of an unstructured mesh with scalar data on the nodes (basis order 1)
+        // or on the elements (basis order 0). Refinement passes work on this copy, so
+        // repeated passes do not need any mesh synchronization in between.
+        struct SCISHARE RefinementMesh
+        {
+          RefinementMesh(size_t nodes_per_elem, int basis_order) :
+            nodesPerElem(nodes_per_elem), basisOrder(basis_order) {}
+
+          void load(const VMesh* mesh, const VField* field);
+          void store(VMesh* mesh, VField* field) const;
+
+          // Marks the nodes to refine around, returns false for an unknown selection method.
+          bool select_nodes(const std::string& select, double isoval, std::vector<char>& selected) const;
+
+          size_t num_nodes() const { return points.size(); }
+          size_t num_elems() const { return cells.size() / nodesPerElem; }
+
+          size_t nodesPerElem;
+          int basisOrder;
+          std::vector<Geometry::Point> points;
+          std::vector<VMesh::index_type> cells;
+          std::vector<double> values;
+        };
+
+        // The edges that get a midpoint node: every element edge with a selected node.
+        // Edge keys are gathered per element, sorted and made unique, and the midpoint of
+        // the k-th edge in key order becomes node first_node + k.
+        class SCISHARE MidpointEdgeTable
+        {
+        public:
+          MidpointEdgeTable(const RefinementMesh& mesh, const LocalEdgeList& local_edges, const std::vector<char>& selected);
+
+          size_t size() const { return edges_.size(); }
+
+          // Node index of the midpoint of edge (a,b), or 0 if the edge is not split.
+          VMesh::index_type midpoint(VMesh::index_type a, VMesh::index_type b) const
+          {
+            const std::pair<VMesh::index_type, VMesh::index_type> key(std::min(a, b), std::max(a, b));
+            auto it = std::lower_bound(edges_.begin(), edges_.end(), key);
+            if (it == edges_.end() || *it != key) return 0;
+            return firstNode_ + static_cast<VMesh::index_type>(it - edges_.begin());
+          }
+
+          // Appends the midpoint nodes, interpolating node data in the same pass.
+          void add_midpoints(RefinementMesh& mesh) const;
+
+        private:
+          VMesh::index_type firstNode_;
+          std::vector<std::pair<VMesh::index_type, VMesh::index_type> > edges_;
+        };
+
+        // Cells emitted while splitting one block of elements.
+        class RefinedCellBuffer
+        {
+        public:
+          void add(std::initializer_list<VMesh::index_type> nodes) { cells_.insert(cells_.end(), nodes); }
+          size_t size() const { return cells_.size(); }
+
+        private:
+          friend struct RefinementSplitter;
+          std::vector<VMesh::index_type> cells_;
+          std::vector<double> values_;
+        };
+
+        struct RefinementSplitter
+        {
+          // Replaces the cells of the mesh by calling split(nodes, cells) for every element,
+          // where nodes holds the element nodes followed by the midpoints of its local edges.
+          // Blocks of elements fill their own buffers, which are concatenated in element
+          // order so the result does not depend on the number of cores. Element data are
+          // copied to every cell an element is split into.
+          template <class SPLIT>
+          static void run(RefinementMesh& mesh, const MidpointEdgeTable& table, const LocalEdgeList& local_edges, SPLIT split)
+          {
+            const size_t npe = mesh.nodesPerElem;
+            const size_t num_elems = mesh.num_elems();
+            const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Thread::Parallel::NumCores(), num_elems / 256));
+            std::vector<RefinedCellBuffer> buffers(numBlocks);
+
+            Thread::Parallel::RunTasks([&](int b)
+            {
+              RefinedCellBuffer& buffer = buffers[b];
+              std::vector<VMesh::index_type> nodes(npe + local_edges.size());
+              for (size_t e = num_elems * b / numBlocks; e < num_elems * (b + 1) / numBlocks; e++)
+              {
+                const VMesh::index_type* elem = &mesh.cells[e * npe];
+                std::copy(elem, elem + npe, nodes.begin());
+                for (size_t k = 0; k < local_edges.size(); k++)
+                  nodes[npe + k] = table.midpoint(elem[local_edges[k].first], elem[local_edges[k].second]);
+
+                const size_t before = buffer.cells_.size();
+                split(nodes, buffer);
+                if (mesh.basisOrder == 0)
+                  buffer.values_.insert(buffer.values_.end(), (buffer.cells_.size() - before) / npe, mesh.values[e]);
+              }
+            }, static_cast<int>(numBlocks));
+
+            mesh.cells.clear();
+            if (mesh.basisOrder == 0) mesh.values.clear();
+            for (const auto& buffer : buffers)
+            {
+              mesh.cells.insert(mesh.cells.end(), buffer.cells_.begin(), buffer.cells_.end());
+              if (mesh.basisOrder == 0)
+                mesh.values.insert(mesh.values.end(), buffer.values_.begin(), buffer.values_.end());
+            }
+          }
+        };
+      }
+    }
+  }
+}
+
+#endif
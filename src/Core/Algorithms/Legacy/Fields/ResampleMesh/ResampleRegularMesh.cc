@@ -36,14 +36,22 @@
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 
+#include <Core/Thread/Parallel.h>
+
 #include <teem/nrrd.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields, ResampleMethod);
 ALGORITHM_PARAMETER_DEF(Fields, ResampleGaussianSigma);
@@ -73,8 +81,174 @@ ResampleRegularMeshAlgo::ResampleRegularMeshAlgo()
   addParameter(Parameters::ResampleZDimUseScalingFactor, true);
 }
 
+namespace
+{
+  // Input samples and weights of every output sample along one axis. They are computed
+  // the way teem's nrrdSpatialResample does for cell centered data, bleeding the
+  // boundary values and renormalizing the weights, with the kernel stretched out when
+  // downsampling.
+  struct AxisWeights
+  {
+    size_t sizeIn;
+    size_t sizeOut;
+    int dotLen;
+    std::vector<size_t> index;
+    std::vector<double> weight;
+  };
+
+  void compute_axis_weights(const NrrdKernel* kernel, const double* kparm, size_t sizeIn, size_t sizeOut,
+    double length, AxisWeights& w)
+  {
+    const double spcIn = length / sizeIn;
+    const double spcOut = length / sizeOut;
+    const double ratio = spcIn / spcOut;
+    const double support = kernel->support(kparm);
+    const double integral = kernel->integral(kparm);
+
+    w.sizeIn = sizeIn;
+    w.sizeOut = sizeOut;
+    w.dotLen = (ratio > 1) ? static_cast<int>(2*std::ceil(support)) : static_cast<int>(2*std::ceil(support/ratio));
+    w.index.resize(sizeOut * w.dotLen);
+    w.weight.resize(sizeOut * w.dotLen);
+
+    const int halfLen = w.dotLen / 2;
+    for (size_t i = 0; i < sizeOut; i++)
+    {
+      const double pos = length*(i + 0.5) / static_cast<double>(sizeOut);
+      const double idx = static_cast<double>(sizeIn)*pos / length - 0.5;
+      const int base = static_cast<int>(std::floor(idx)) - halfLen + 1;
+      for (int e = 0; e < w.dotLen; e++)
+      {
+        const int k = base + e;
+        w.weight[e + w.dotLen*i] = idx - k;
+        w.index[e + w.dotLen*i] = static_cast<size_t>(std::min(std::max(k, 0), static_cast<int>(sizeIn) - 1));
+      }
+    }
+
+    double parm[NRRD_KERNEL_PARMS_NUM];
+    std::copy(kparm, kparm + NRRD_KERNEL_PARMS_NUM, parm);
+    if (ratio < 1) parm[0] /= ratio;
+    kernel->evalN_d(&w.weight[0], &w.weight[0], w.weight.size(), parm);
+
+    if (integral)
+    {
+      for (size_t i = 0; i < sizeOut; i++)
+      {
+        double sum = 0.0;
+        for (int e = 0; e < w.dotLen; e++) sum += w.weight[e + w.dotLen*i];
+        if (sum)
+          for (int e = 0; e < w.dotLen; e++) w.weight[e + w.dotLen*i] *= 1.0/sum;
+      }
+    }
+  }
+
+  // Resamples the middle axis of an inner x sizeIn x outer array. Every output row is
+  // a weighted sum of whole input rows, so the innermost loop runs over consecutive
+  // samples. Rows are split in tiles to spread small grids over the cores as well.
+  // Along the first axis rows only hold the components of one sample, there every
+  // output sample is summed up in place instead.
+  template <class T>
+  void resample_axis(const T* in, double* out, size_t inner, size_t outer, const AxisWeights& w)
+  {
+    const size_t tile = 4096;
+    const size_t numTiles = (inner + tile - 1) / tile;
+    const int dotLen = w.dotLen;
+
+    if (inner < 8)
+    {
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+      {
+        for (size_t o = begin; o < end; o++)
+        {
+          const T* src = in + inner*w.sizeIn*o;
+          double* dst = out + inner*w.sizeOut*o;
+          for (size_t i = 0; i < w.sizeOut; i++)
+          {
+            const size_t* index = &w.index[dotLen*i];
+            const double* weight = &w.weight[dotLen*i];
+            for (size_t j = 0; j < inner; j++)
+            {
+              double sum = 0.0;
+              for (int s = 0; s < dotLen; s++) sum += static_cast<double>(src[inner*index[s] + j])*weight[s];
+              dst[inner*i + j] = sum;
+            }
+          }
+        }
+      }, outer);
+      return;
+    }
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t task = begin; task < end; task++)
+      {
+        const size_t o = task / numTiles;
+        const size_t j0 = (task % numTiles) * tile;
+        const size_t j1 = std::min(inner, j0 + tile);
+        for (size_t i = 0; i < w.sizeOut; i++)
+        {
+          double* dst = out + inner*(i + w.sizeOut*o);
+          for (size_t j = j0; j < j1; j++) dst[j] = 0.0;
+          for (int s = 0; s < dotLen; s++)
+          {
+            const T* src = in + inner*(w.index[s + dotLen*i] + w.sizeIn*o);
+            const double weight = w.weight[s + dotLen*i];
+            for (size_t j = j0; j < j1; j++) dst[j] += static_cast<double>(src[j])*weight;
+          }
+        }
+      }
+    }, outer*numTiles);
+  }
+
+  // Resamples all axes one after the other, the first one being the fastest running
+  // index. Values have num_comp interleaved components, which are not resampled.
+  template <class T>
+  void resample_grid(const T* in, std::vector<double>& result, size_t num_comp, const std::vector<AxisWeights>& axes)
+  {
+    std::vector<size_t> sizes(axes.size());
+    for (size_t a = 0; a < axes.size(); a++) sizes[a] = axes[a].sizeIn;
+
+    std::vector<double> previous;
+    for (size_t a = 0; a < axes.size(); a++)
+    {
+      size_t inner = num_comp, outer = 1;
+      for (size_t b = 0; b < a; b++) inner *= sizes[b];
+      for (size_t b = a + 1; b < axes.size(); b++) outer *= sizes[b];
+
+      std::vector<double> current(inner * axes[a].sizeOut * outer);
+      if (a == 0) resample_axis(in, &current[0], inner, outer, axes[a]);
+      else resample_axis(&previous[0], &current[0], inner, outer, axes[a]);
+      previous.swap(current);
+      sizes[a] = axes[a].sizeOut;
+    }
+    result.swap(previous);
+  }
+
+  // Integer results are rounded, and all results are clamped to the range of the type.
+  template <class T>
+  T to_value(double v)
+  {
+    if (std::numeric_limits<T>::is_integer) v = std::floor(v + 0.5);
+    v = std::min(std::max(v, static_cast<double>(std::numeric_limits<T>::lowest())), static_cast<double>(std::numeric_limits<T>::max()));
+    return static_cast<T>(v);
+  }
+
+  template <class T>
+  void resample_values(VField* ifield, VField* ofield, const std::vector<AxisWeights>& axes)
+  {
+    std::vector<double> result;
+    resample_grid(reinterpret_cast<const T*>(ifield->get_values_pointer()), result, 1, axes);
+
+    T* out = reinterpret_cast<T*>(ofield->get_values_pointer());
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t k = begin; k < end; k++) out[k] = to_value<T>(result[k]);
+    }, result.size());
+  }
+}
+
 ///////////////////////////////////////////////////////
-// Refine elements for a TetVol
+// Resample the data of a regular grid with a separable kernel
 
 bool
 ResampleRegularMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
@@ -95,135 +269,24 @@ ResampleRegularMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
     return (false);
   }
 
-  // Convert data to nrrd and run through teem resampler
-  Nrrd* nin;
-  Nrrd* nout;
-
-  VField::size_type num_values = input->vfield()->num_values();
-
-  nin = nrrdNew();
-  nout = nrrdNew();
-
-  // Determine dimensions
-  size_t nrrddims[NRRD_DIM_MAX];
-  int nrrddim = 0;
-  bool nrrdoffset = 0;
-
-  VMesh::dimension_type dims;
-
   VMesh*  vmesh  = input->vmesh();
   VField* vfield = input->vfield();
 
-  if (vfield->is_vector())
+  size_t num_comp = 1;
+  if (vfield->is_vector()) num_comp = 3;
+  else if (vfield->is_tensor()) num_comp = 6;
+  else if (!(vfield->is_char() || vfield->is_unsigned_char() || vfield->is_short() || vfield->is_unsigned_short() ||
+    vfield->is_int() || vfield->is_unsigned_int() || vfield->is_long() || vfield->is_unsigned_long() ||
+    vfield->is_longlong() || vfield->is_unsigned_longlong() || vfield->is_float() || vfield->is_double()))
   {
-    nrrddims[0] = 3; nrrddim = 1; nrrdoffset = 1;
-  }
-  else if (vfield->is_tensor())
-  {
-    nrrddims[0] = 6; nrrddim = 1; nrrdoffset = 1;
+    error("Unknown datatype.");
+    return (false);
   }
 
+  VMesh::dimension_type dims;
   if (fi.is_lineardata()) vmesh->get_dimensions(dims);
   else vmesh->get_elem_dimensions(dims);
 
-  int dimsSize = static_cast<int>(dims.size());
-  for (int k = nrrddim; k < nrrddim + dimsSize; k++)
-    nrrddims[k] = dims[k-nrrddim];
-  nrrddim += dimsSize;
-
-  if (vfield->is_char())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeChar,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<char *>(nin->data),num_values);
-  }
-  else if (vfield->is_unsigned_char())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeUChar,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<unsigned char *>(nin->data),num_values);
-  }
-  else if (vfield->is_short())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeShort,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<short *>(nin->data),num_values);
-  }
-  else if (vfield->is_unsigned_short())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeUShort,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<unsigned short *>(nin->data),num_values);
-  }
-  else if (vfield->is_int())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeInt,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<int *>(nin->data),num_values);
-  }
-  else if (vfield->is_unsigned_int())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeUInt,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<unsigned int *>(nin->data),num_values);
-  }
-  else if (vfield->is_long())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeLLong,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<long long *>(nin->data),num_values);
-  }
-  else if (vfield->is_unsigned_long())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeULLong,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<unsigned long long *>(nin->data),num_values);
-  }
-  else if (vfield->is_longlong())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeLLong,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<long long *>(nin->data),num_values);
-  }
-  else if (vfield->is_unsigned_longlong())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeULLong,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<unsigned long long *>(nin->data),num_values);
-  }
-  else if (vfield->is_float())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeFloat,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<float *>(nin->data),num_values);
-  }
-  else if (vfield->is_double())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeDouble,nrrddim,nrrddims);
-    vfield->get_values(reinterpret_cast<double *>(nin->data),num_values);
-  }
-  else if (vfield->is_vector())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeDouble,nrrddim,nrrddims);
-    double* ptr = reinterpret_cast<double *>(nin->data);
-    size_t k = 0;
-    for (VField::index_type idx=0; idx<num_values; idx++)
-    {
-      Vector v;
-      vfield->get_value(v,idx);
-      ptr[k] = v.x(); ptr[k+1] = v.y(); ptr[k+2] = v.z();
-      k += 3;
-    }
-  }
-  else if (vfield->is_tensor())
-  {
-    nrrdAlloc_nva(nin,nrrdTypeDouble,nrrddim,nrrddims);
-    double* ptr = reinterpret_cast<double *>(nin->data);
-    size_t k = 0;
-    for (VField::index_type idx=0; idx<num_values; idx++)
-    {
-      Tensor v;
-      vfield->get_value(v,idx);
-      ptr[k  ] = v.xx(); ptr[k+1] = v.xy(); ptr[k+2] = v.xz();
-      ptr[k+3] = v.yy(); ptr[k+4] = v.yz(); ptr[k+5] = v.zz();
-      k += 6;
-    }
-  }
-  else
-  {
-    error("Unknown datatype.");
-    return (false);
-  }
-
   NrrdKernel *kern = 0;
 
   double param[NRRD_KERNEL_PARMS_NUM]; param[0] =  1.0;
@@ -262,123 +325,66 @@ ResampleRegularMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
     param[1] = 0.0834; // most accurate as per Teem documentation
   }
 
-  NrrdResampleInfo *info = nrrdResampleInfoNew();
-
-  if (nrrdoffset)
-  {
-    info->kernel[0] = 0;
-    nin->axis[0].min = 0.0;
-    nin->axis[0].max = 1.0;
-    info->min[0] = 0.0;
-    info->max[0] = 1.0;
-  }
-
   Transform trans;
   vmesh->get_canonical_transform(trans);
 
   // Set the lengths along the axis
-  info->min[nrrdoffset] = 0.0;
-  nin->axis[nrrdoffset].min = 0.0;
-  info->max[nrrdoffset] = trans.project(Vector(1.0,0.0,0.0)).length();
-  nin->axis[nrrdoffset].max = info->max[nrrdoffset];
-  info->min[nrrdoffset+1] = 0.0;
-  nin->axis[nrrdoffset+1].min = 0.0;
-  info->max[nrrdoffset+1] = trans.project(Vector(0.0,1.0,0.0)).length();
-  nin->axis[nrrdoffset+1].max = info->max[nrrdoffset+1];
-  info->min[nrrdoffset+2] = 0.0;
-  nin->axis[nrrdoffset+2].min = 0.0;
-  info->max[nrrdoffset+2] = trans.project(Vector(0.0,0.0,1.0)).length();
-  nin->axis[nrrdoffset+2].max = info->max[nrrdoffset+2];
-
-
-  for (int a = nrrdoffset; a < nrrddim; a++)
-  {
-    info->kernel[a] = kern;
-    for (int b=0; b<NRRD_KERNEL_PARMS_NUM; b++) info->parm[a][b] = param[b];
-  }
+  const Vector axes[3] = { Vector(1.0,0.0,0.0), Vector(0.0,1.0,0.0), Vector(0.0,0.0,1.0) };
+  const AlgorithmParameterName* sizeParams[3] = { &Parameters::ResampleXDim, &Parameters::ResampleYDim, &Parameters::ResampleZDim };
+  const AlgorithmParameterName* factorParams[3] = { &Parameters::ResampleXDimUseScalingFactor,
+    &Parameters::ResampleYDimUseScalingFactor, &Parameters::ResampleZDimUseScalingFactor };
 
   // Set the resampling options
-  if (!get(Parameters::ResampleXDimUseScalingFactor).toBool())
+  std::vector<AxisWeights> weights(dims.size());
+  for (size_t a = 0; a < dims.size(); a++)
   {
-    info->kernel[nrrdoffset] = kern;
-    info->samples[nrrdoffset] = static_cast<size_t>(get(Parameters::ResampleXDim).toDouble());
-  }
-  else
-  {
-    info->kernel[nrrdoffset] = kern;
-    info->samples[nrrdoffset] = static_cast<size_t>(get(Parameters::ResampleXDim).toDouble() * nrrddims[nrrdoffset]);
-  }
-
-  if (nrrddim-nrrdoffset > 1)
-  {
-    if (!get(Parameters::ResampleYDimUseScalingFactor).toBool())
-    {
-      info->kernel[nrrdoffset+1] = kern;
-      info->samples[nrrdoffset+1] = static_cast<size_t>(get(Parameters::ResampleYDim).toDouble());
-    }
+    size_t samples;
+    if (!get(*factorParams[a]).toBool())
+      samples = static_cast<size_t>(get(*sizeParams[a]).toDouble());
     else
-    {
-      info->kernel[nrrdoffset+1] = kern;
-      info->samples[nrrdoffset+1] = static_cast<size_t>(get(Parameters::ResampleYDim).toDouble()*nrrddims[nrrdoffset+1]);
-    }
-  }
+      samples = static_cast<size_t>(get(*sizeParams[a]).toDouble() * dims[a]);
 
-  if (nrrddim-nrrdoffset > 2)
-  {
-    if (!get(Parameters::ResampleZDimUseScalingFactor).toBool())
+    if (samples < 1 || dims[a] < 1)
     {
-      info->kernel[nrrdoffset+2] = kern;
-      info->samples[nrrdoffset+2] = static_cast<size_t>(get(Parameters::ResampleZDim).toDouble());
+      error("Trouble resampling: the number of samples along each axis needs to be at least one");
+      return (false);
     }
-    else
-    {
-      info->kernel[nrrdoffset+2] = kern;
-      info->samples[nrrdoffset+2] = static_cast<size_t>(get(Parameters::ResampleZDim).toDouble()*nrrddims[nrrdoffset+2]);
-    }
-  }
 
-  if (nrrdSpatialResample(nout, nin, info))
-  {
-    char *err = biffGetDone(NRRD);
-    error(std::string("Trouble resampling: ") +  err);
-    free(err);
-    return (false);
+    compute_axis_weights(kern, param, dims[a], samples, trans.project(axes[a]).length(), weights[a]);
   }
 
-  nrrdNix(nin);
-
   MeshHandle mesh;
   if (dims.size() == 3)
   {
     if (fi.is_lineardata())
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset] ,info->samples[nrrdoffset+1],info->samples[nrrdoffset+2],Point(0.0,0.0,0.0),Point(1.0,1.0,1.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut ,weights[1].sizeOut,weights[2].sizeOut,Point(0.0,0.0,0.0),Point(1.0,1.0,1.0));
     }
     else
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset]+1 ,info->samples[nrrdoffset+1]+1,info->samples[nrrdoffset+2]+1,Point(0.0,0.0,0.0),Point(1.0,1.0,1.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut+1 ,weights[1].sizeOut+1,weights[2].sizeOut+1,Point(0.0,0.0,0.0),Point(1.0,1.0,1.0));
     }
   }
   else if (dims.size() == 2)
   {
     if (fi.is_lineardata())
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset] ,info->samples[nrrdoffset+1],Point(0.0,0.0,0.0),Point(1.0,1.0,0.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut ,weights[1].sizeOut,Point(0.0,0.0,0.0),Point(1.0,1.0,0.0));
     }
     else
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset]+1 ,info->samples[nrrdoffset+1]+1,Point(0.0,0.0,0.0),Point(1.0,1.0,0.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut+1 ,weights[1].sizeOut+1,Point(0.0,0.0,0.0),Point(1.0,1.0,0.0));
     }
   }
   else if (dims.size() == 1)
   {
     if (fi.is_lineardata())
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset] ,Point(0.0,0.0,0.0),Point(1.0,0.0,0.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut ,Point(0.0,0.0,0.0),Point(1.0,0.0,0.0));
     }
     else
     {
-      mesh = CreateMesh(fi,info->samples[nrrdoffset]+1 ,Point(0.0,0.0,0.0),Point(1.0,0.0,0.0));
+      mesh = CreateMesh(fi,weights[0].sizeOut+1 ,Point(0.0,0.0,0.0),Point(1.0,0.0,0.0));
     }
   }
 
@@ -396,81 +402,64 @@ ResampleRegularMeshAlgo::runImpl(FieldHandle input, FieldHandle& output) const
   }
   output->vmesh()->transform(trans);
 
-  vfield = output->vfield();
-  num_values = vfield->num_values();
-
-  if (vfield->is_char())
-  {
-    vfield->set_values(reinterpret_cast<char *>(nout->data),num_values);
-  }
-  else if (vfield->is_unsigned_char())
-  {
-    vfield->set_values(reinterpret_cast<unsigned char *>(nout->data),num_values);
-  }
-  else if (vfield->is_short())
-  {
-    vfield->set_values(reinterpret_cast<short *>(nout->data),num_values);
-  }
-  else if (vfield->is_unsigned_short())
-  {
-    vfield->set_values(reinterpret_cast<unsigned short *>(nout->data),num_values);
-  }
-  if (vfield->is_int())
-  {
-    vfield->set_values(reinterpret_cast<int *>(nout->data),num_values);
-  }
-  else if (vfield->is_unsigned_int())
-  {
-    vfield->set_values(reinterpret_cast<unsigned int *>(nout->data),num_values);
-  }
-  else if (vfield->is_long())
-  {
-    vfield->set_values(reinterpret_cast<long long *>(nout->data),num_values);
-  }
-  else if (vfield->is_unsigned_long())
-  {
-    vfield->set_values(reinterpret_cast<unsigned long long *>(nout->data),num_values);
-  }
-  else if (vfield->is_longlong())
-  {
-    vfield->set_values(reinterpret_cast<long long *>(nout->data),num_values);
-  }
-  else if (vfield->is_unsigned_longlong())
-  {
-    vfield->set_values(reinterpret_cast<unsigned long long *>(nout->data),num_values);
-  }
-  else if (vfield->is_float())
-  {
-    vfield->set_values(reinterpret_cast<float *>(nout->data),num_values);
-  }
-  else if (vfield->is_double())
-  {
-    vfield->set_values(reinterpret_cast<double *>(nout->data),num_values);
-  }
-  else if (vfield->is_vector())
+  VField* ofield = output->vfield();
+  ofield->resize_values();
+
+  if (vfield->is_char()) resample_values<char>(vfield, ofield, weights);
+  else if (vfield->is_unsigned_char()) resample_values<unsigned char>(vfield, ofield, weights);
+  else if (vfield->is_short()) resample_values<short>(vfield, ofield, weights);
+  else if (vfield->is_unsigned_short()) resample_values<unsigned short>(vfield, ofield, weights);
+  else if (vfield->is_int()) resample_values<int>(vfield, ofield, weights);
+  else if (vfield->is_unsigned_int()) resample_values<unsigned int>(vfield, ofield, weights);
+  else if (vfield->is_long()) resample_values<long>(vfield, ofield, weights);
+  else if (vfield->is_unsigned_long()) resample_values<unsigned long>(vfield, ofield, weights);
+  else if (vfield->is_longlong()) resample_values<long long>(vfield, ofield, weights);
+  else if (vfield->is_unsigned_longlong()) resample_values<unsigned long long>(vfield, ofield, weights);
+  else if (vfield->is_float()) resample_values<float>(vfield, ofield, weights);
+  else if (vfield->is_double()) resample_values<double>(vfield, ofield, weights);
+  else
   {
-    double* ptr = reinterpret_cast<double *>(nout->data);
-    size_t k = 0;
-    for (VField::index_type idx=0; idx<num_values; idx++)
+    // Vectors and tensors are resampled per component
+    const VField::size_type num_values = vfield->num_values();
+    std::vector<double> values(num_values * num_comp);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
     {
-      Vector v(ptr[k],ptr[k+1],ptr[k+2]); k+=3;
-      vfield->set_value(v,idx);
-    }
-  }
-  else if (vfield->is_tensor())
-  {
-    double* ptr = reinterpret_cast<double *>(nout->data);
-    size_t k = 0;
-    for (VField::index_type idx=0; idx<num_values; idx++)
+      for (size_t idx = begin; idx < end; idx++)
+      {
+        double* ptr = &values[idx * num_comp];
+        if (num_comp == 3)
+        {
+          Vector v;
+          vfield->get_value(v, static_cast<VField::index_type>(idx));
+          ptr[0] = v.x(); ptr[1] = v.y(); ptr[2] = v.z();
+        }
+        else
+        {
+          Tensor v;
+          vfield->get_value(v, static_cast<VField::index_type>(idx));
+          ptr[0] = v.xx(); ptr[1] = v.xy(); ptr[2] = v.xz();
+          ptr[3] = v.yy(); ptr[4] = v.yz(); ptr[5] = v.zz();
+        }
+      }
+    }, num_values);
+
+    std::vector<double> result;
+    resample_grid(&values[0], result, num_comp, weights);
+
+    const VField::size_type num_out = ofield->num_values();
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
     {
-      Tensor v(ptr[k],ptr[k+1],ptr[k+2],ptr[k+3],ptr[k+4],ptr[k+5]);
-      vfield->set_value(v,idx);
-      k += 6;
-    }
+      for (size_t idx = begin; idx < end; idx++)
+      {
+        const double* ptr = &result[idx * num_comp];
+        if (num_comp == 3)
+          ofield->set_value(Vector(ptr[0], ptr[1], ptr[2]), static_cast<VField::index_type>(idx));
+        else
+          ofield->set_value(Tensor(ptr[0], ptr[1], ptr[2], ptr[3], ptr[4], ptr[5]), static_cast<VField::index_type>(idx));
+      }
+    }, num_out);
   }
 
-  nrrdNix(nout);
-
   return (true);
 }
 
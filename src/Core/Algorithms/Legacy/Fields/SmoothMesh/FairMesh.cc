@@ -30,6 +30,10 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Thread/Parallel.h>
+
+#include <utility>
+#include <vector>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -37,18 +41,112 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields, FairMeshMethod);
 ALGORITHM_PARAMETER_DEF(Fields, NumIterations);
 ALGORITHM_PARAMETER_DEF(Fields, Lambda);
 ALGORITHM_PARAMETER_DEF(Fields, FilterCutoff);
+ALGORITHM_PARAMETER_DEF(Fields, HCAlpha);
+ALGORITHM_PARAMETER_DEF(Fields, HCBeta);
 
 FairMeshAlgo::FairMeshAlgo()
 {
-  addOption(Parameters::FairMeshMethod,"fast","fast|desbrun");
+  addOption(Parameters::FairMeshMethod,"fast","fast|desbrun|hc");
   addParameter(Parameters::NumIterations,50);
   addParameter(Parameters::Lambda,0.6307);
   addParameter(Parameters::FilterCutoff,0.1);
+  addParameter(Parameters::HCAlpha,0.1);
+  addParameter(Parameters::HCBeta,0.6);
+}
+
+namespace
+{
+  // Neighborhoods of all nodes in one flat array, the entries of node i are
+  // entries[offsets[i]] up to entries[offsets[i+1]].
+  template <class ENTRY>
+  struct Neighborhoods
+  {
+    std::vector<size_t> offsets;
+    std::vector<ENTRY> entries;
+
+    size_t size(size_t i) const { return (offsets[i + 1] - offsets[i]); }
+    const ENTRY* begin(size_t i) const { return (&entries[0] + offsets[i]); }
+    const ENTRY* end(size_t i) const { return (&entries[0] + offsets[i + 1]); }
+  };
+
+  // Fills the neighborhoods by calling gather(node, list) for every node, once to
+  // count the entries and once to store them. The mesh is only read, so the nodes
+  // are gathered in parallel.
+  template <class ENTRY, class GATHER>
+  void build_neighborhoods(size_t num_nodes, GATHER gather, Neighborhoods<ENTRY>& hoods)
+  {
+    hoods.offsets.assign(num_nodes + 1, 0);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      std::vector<ENTRY> list;
+      for (size_t i = begin; i < end; i++)
+      {
+        gather(i, list);
+        hoods.offsets[i + 1] = list.size();
+      }
+    }, num_nodes);
+
+    for (size_t i = 0; i < num_nodes; i++)
+      hoods.offsets[i + 1] += hoods.offsets[i];
+
+    hoods.entries.resize(hoods.offsets[num_nodes]);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      std::vector<ENTRY> list;
+      for (size_t i = begin; i < end; i++)
+      {
+        gather(i, list);
+        std::copy(list.begin(), list.end(), hoods.entries.begin() + hoods.offsets[i]);
+      }
+    }, num_nodes);
+  }
+
+  void gather_node_neighbors(VMesh* mesh, Neighborhoods<VMesh::index_type>& hoods)
+  {
+    mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+    build_neighborhoods(mesh->num_nodes(), [&](size_t idx, std::vector<VMesh::index_type>& list)
+    {
+      VMesh::Node::array_type neighbors;
+      mesh->get_neighbors(neighbors, VMesh::Node::index_type(idx));
+      list.assign(neighbors.begin(), neighbors.end());
+    }, hoods);
+  }
+
+  // The Taubin iterations alternate a step with lambda and a step with mu. Every
+  // step reads the points of the previous step and writes the next ones, so the nodes
+  // are updated in parallel; the buffers are swapped in between. The mesh may share
+  // its points with the input, so it is only written once at the end.
+  template <class STEP>
+  void taubin_iterations(const AlgorithmBase* algo, VMesh* mesh, size_t num_nodes, int num_iter,
+    double lambda, double mu, STEP step)
+  {
+    if (num_iter <= 0) return;
+
+    std::vector<Point> buffer1(num_nodes), buffer2(num_nodes);
+    const Point* src = mesh->get_const_points_pointer();
+    Point* dst = &buffer1[0];
+
+    for (int it = 0; it < num_iter; it++)
+    {
+      const double factor = (it % 2 == 0 ? lambda : mu);
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+      {
+        for (size_t idx = begin; idx < end; idx++)
+          dst[idx] = src[idx] + factor*step(src, idx);
+      }, num_nodes);
+      src = dst;
+      dst = (dst == &buffer1[0] ? &buffer2[0] : &buffer1[0]);
+      algo->update_progress_max(it, num_iter);
+    }
+
+    std::copy(src, src + num_nodes, mesh->get_points_pointer());
+  }
 }
 
 bool FairMeshAlgo::runImpl(FieldHandle input,FieldHandle& output) const
@@ -87,62 +185,93 @@ bool FairMeshAlgo::runImpl(FieldHandle input,FieldHandle& output) const
   VMesh* mesh = output->vmesh();
   VMesh::size_type num_nodes = mesh->num_nodes();
   mesh->unsynchronize(Mesh::NORMALS_E);
+  if (num_nodes == 0) return (true);
 
   if (method == "fast")
   {
     // Fast neighborhoods
-    std::vector<VMesh::Node::array_type > neighborhoods(num_nodes);
-    mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+    Neighborhoods<VMesh::index_type> neighborhoods;
+    gather_node_neighbors(mesh, neighborhoods);
 
-    for (VMesh::Node::index_type idx=0; idx<num_nodes; idx++)
+    taubin_iterations(this, mesh, num_nodes, num_iter, lambda, mu, [&](const Point* pts, size_t idx) -> Vector
     {
-      mesh->get_neighbors(neighborhoods[idx],idx);
-    }
+      const Point p0 = pts[idx];
+      Vector d(0.0,0.0,0.0);
+      double w = 1.0/(neighborhoods.size(idx));
+      for (const VMesh::index_type* j = neighborhoods.begin(idx); j != neighborhoods.end(idx); ++j)
+      {
+        d += w* (pts[*j]-p0);
+      }
+      return (d);
+    });
+  }
+  else if (method == "hc")
+  {
+    // HC smoothing (Vollmer et al.): every Laplacian step is followed by pushing the
+    // nodes back towards their original and previous positions, which keeps the
+    // surface from shrinking. Each iteration is a single step, so the number of
+    // steps is half that of the Taubin methods.
+    const double alpha = get(Parameters::HCAlpha).toDouble();
+    const double beta = get(Parameters::HCBeta).toDouble();
+    num_iter /= 2;
 
-    std::vector<Vector> disp(num_nodes);
-    Point*  point = mesh->get_points_pointer();
-    Point p0;
-    for (int it = 0; it<num_iter; it++)
+    Neighborhoods<VMesh::index_type> neighborhoods;
+    gather_node_neighbors(mesh, neighborhoods);
+
+    const Point* input_points = mesh->get_const_points_pointer();
+    const std::vector<Point> original(input_points, input_points + num_nodes);
+    std::vector<Point> point(original);
+    std::vector<Point> smoothed(num_nodes);
+    std::vector<Vector> back(num_nodes);
+
+    for (int it = 0; it < num_iter; it++)
     {
-      for (VMesh::index_type idx=0; idx<num_nodes;idx++)
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
       {
-        p0 = point[idx];
-        Vector d(0.0,0.0,0.0);
-        VMesh::Node::array_type &neighbors = neighborhoods[idx];
-        double w = 1.0/(neighbors.size());
-        for (size_t j=0; j<neighbors.size(); j++)
+        for (size_t idx = begin; idx < end; idx++)
         {
-          d += w* (point[neighbors[j]]-p0);
+          const size_t n = neighborhoods.size(idx);
+          Vector sum(0.0,0.0,0.0);
+          for (const VMesh::index_type* j = neighborhoods.begin(idx); j != neighborhoods.end(idx); ++j)
+            sum += Vector(point[*j]);
+          smoothed[idx] = (n > 0 ? Point(sum * (1.0 / n)) : point[idx]);
+          back[idx] = smoothed[idx] - Point(alpha*original[idx] + (1.0 - alpha)*point[idx]);
         }
-        disp[idx] = d;
-      }
+      }, num_nodes);
 
-      if (it % 2 == 0)
+      Parallel::RunTasksOverRange([&](size_t begin, size_t end)
       {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+ lambda*disp[idx];
-      }  
-      else
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+  mu*disp[idx];      
-      }
+        for (size_t idx = begin; idx < end; idx++)
+        {
+          const size_t n = neighborhoods.size(idx);
+          Vector sum(0.0,0.0,0.0);
+          for (const VMesh::index_type* j = neighborhoods.begin(idx); j != neighborhoods.end(idx); ++j)
+            sum += back[*j];
+          Vector correction = beta*back[idx];
+          if (n > 0) correction += ((1.0 - beta) / n)*sum;
+          point[idx] = smoothed[idx] - correction;
+        }
+      }, num_nodes);
       update_progress_max(it,num_iter);
     }
+
+    if (num_iter > 0)
+      std::copy(point.begin(), point.end(), mesh->get_points_pointer());
   }
   else
   {
     // desbrun method
-    std::vector<std::vector<std::pair<VMesh::index_type,VMesh::index_type> > > neighborhoods(num_nodes);
+    typedef std::pair<VMesh::index_type,VMesh::index_type> edge_type;
+    Neighborhoods<edge_type> neighborhoods;
     mesh->synchronize(Mesh::NODE_NEIGHBORS_E|Mesh::EPSILON_E);
 
-    VMesh::Elem::array_type elems;
-    VMesh::Node::array_type nodes;
-
-    for (VMesh::Node::index_type idx=0; idx<num_nodes; idx++)
+    build_neighborhoods(num_nodes, [&](size_t node, std::vector<edge_type>& neighborhood)
     {
-      std::vector<std::pair<VMesh::index_type,VMesh::index_type> > &neighborhood = neighborhoods[idx];
-      mesh->get_elems(elems,idx);
+      const VMesh::index_type idx = static_cast<VMesh::index_type>(node);
+      VMesh::Elem::array_type elems;
+      VMesh::Node::array_type nodes;
+      neighborhood.clear();
+      mesh->get_elems(elems,VMesh::Node::index_type(idx));
       for (size_t j = 0; j<elems.size(); j++)
       {
         mesh->get_nodes(nodes,elems[j]);
@@ -154,95 +283,76 @@ bool FairMeshAlgo::runImpl(FieldHandle input,FieldHandle& output) const
           // get all edges that are not connected to the node itself
           if(nodes[k-1] != idx && nodes[k] != idx)
           {
-            neighborhood.push_back(std::pair<VMesh::index_type,VMesh::index_type>(nodes[k-1],nodes[k]));
+            neighborhood.push_back(edge_type(nodes[k-1],nodes[k]));
           }
         }
       }
-    }
-    
-    std::vector<Vector> disp(num_nodes);
-    Point*  point = mesh->get_points_pointer();
-    Point p0;
+    }, neighborhoods);
 
+    // A node whose neighborhood gives no usable direction keeps the displacement
+    // of the previous iteration.
+    std::vector<Vector> disp(num_nodes);
     double epsilon = mesh->get_epsilon();
 
-    for (int it = 0; it<num_iter; it++)
+    taubin_iterations(this, mesh, num_nodes, num_iter, lambda, mu, [&](const Point* pts, size_t idx) -> Vector
     {
-    
-      for (VMesh::index_type idx=0; idx<num_nodes;idx++)
+      // Center location of this node
+      const Point p0 = pts[idx];
+      Vector d(0.0,0.0,0.0);
+      
+      // neighborhood points
+      Point p1, p2, p3;
+      Vector p12;
+      
+      // if no neighborhood continue
+      if (neighborhoods.size(idx) == 0) return (disp[idx]);
+
+      // total weight
+      double totw = 0.0;
+  
+      for (const edge_type* j = neighborhoods.begin(idx); j != neighborhoods.end(idx); ++j)
       {
-        // Center location of this node
-        p0 = point[idx];
-        Vector d(0.0,0.0,0.0);
+        p1 = pts[j->first];
+        p2 = pts[j->second];
+
+        // vectors pointing to the two neighbor nodes
+        Vector e1 = p2-p0;
+        Vector e2 = p1-p0;
         
-        // neighborhood points
-        Point p1, p2, p3;
-        Vector p12;
+        // Get vector between neighbors
+        p12 = p1-p2;
         
-        // get local neighborhood pairs
-        const std::vector<std::pair<VMesh::index_type,VMesh::index_type> > &neighborhood = neighborhoods[idx];
+        // Squared distance between neighbors
+        double e = Dot(p12,p12);
         
-        // if no neighborhood continue
-        if (neighborhood.empty()) continue;
-  
-        // total weight
-        double totw = 0.0;
-    
-        for (size_t j = 0; j < neighborhood.size(); j++) 
+        if (e > 0.0)
         {
-          p1 = point[neighborhood[j].first];
-          p2 = point[neighborhood[j].second];
-
-          // vectors pointing to the two neighbor nodes
-          Vector e1 = p2-p0;
-          Vector e2 = p1-p0;
+          double dot = Dot(p1-p0,p12)/e;
+          p3 = p1 - dot*p12;
           
-          // Get vector between neighbors
-          p12 = p1-p2;
+          double A = (p1-p3).length();
+          double B = (p0-p3).length();
+          double C = (p2-p3).length();
           
-          // Squared distance between neighbors
-          double e = Dot(p12,p12);
-          
-          if (e > 0.0)
+          // if B approaches zero, we have a flat
+          // triangle, hence we need to bounce back the node 
+          // towards the other side. Hence ignoring these
+          // directions
+          if (B >= 10*epsilon)
           {
-            double dot = Dot(p1-p0,p12)/e;
-            p3 = p1 - dot*p12;
-            
-            double A = (p1-p3).length();
-            double B = (p0-p3).length();
-            double C = (p2-p3).length();
-            
-            // if B approaches zero, we have a flat
-            // triangle, hence we need to bounce back the node 
-            // towards the other side. Hence ignoring these
-            // directions
-            if (B >= 10*epsilon)
-            {
-              if (dot < 0.0) A = -A;
-              if (dot > 1.0) C = -C;
-              totw += (A+C)/B;
-         
-              d += (A/B)*e1 + (C/B)*e2;
-            }
+            if (dot < 0.0) A = -A;
+            if (dot > 1.0) C = -C;
+            totw += (A+C)/B;
+       
+            d += (A/B)*e1 + (C/B)*e2;
           }
         }
-
-        /// set the displacement vector for this node.
-        if (totw != 0.0) disp[idx] = d * (1.0 / totw);
       }
 
-      if (it % 2 == 0)
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+ lambda*disp[idx];
-      }  
-      else
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+  mu*disp[idx];      
-      }
-      update_progress_max(it,num_iter);
-    }
+      /// set the displacement vector for this node.
+      if (totw != 0.0) disp[idx] = d * (1.0 / totw);
+      return (disp[idx]);
+    });
   }
   
   return (true);
@@ -42,6 +42,8 @@ namespace SCIRun {
         ALGORITHM_PARAMETER_DECL(NumIterations);
         ALGORITHM_PARAMETER_DECL(Lambda);
         ALGORITHM_PARAMETER_DECL(FilterCutoff);
+        ALGORITHM_PARAMETER_DECL(HCAlpha);
+        ALGORITHM_PARAMETER_DECL(HCBeta);
 
         class SCISHARE FairMeshAlgo : public AlgorithmBase
         {
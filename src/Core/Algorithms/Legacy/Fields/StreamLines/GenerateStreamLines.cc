@@ -32,7 +32,6 @@
 #include <Core/Algorithms/Legacy/Fields/StreamLines/GenerateStreamLines.h>
 #include <Core/Algorithms/Legacy/Fields/StreamLines/StreamLineIntegrators.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
-#include <Core/Algorithms/Legacy/Fields/MergeFields/JoinFieldsAlgo.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
@@ -162,6 +161,20 @@ namespace detail
     BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Unknown streamline value selected"));
   }
 
+  // Streamlines found by one thread, these are copied into the output
+  // field once all threads are done
+  struct StreamlineBuffer
+  {
+    std::vector<Point> nodes_;
+    std::vector<double> values_;
+    // seed index and number of nodes of each streamline
+    std::vector<std::pair<VMesh::Node::index_type, size_type> > lines_;
+    size_type num_edges_ {0};
+    // position of the first node and edge in the output
+    index_type node_offset_ {0};
+    index_type edge_offset_ {0};
+  };
+
   class GenerateStreamLinesAlgoImplBase : public Core::Thread::Interruptible
   {
   public:
@@ -183,9 +196,10 @@ namespace detail
 
   protected:
     void parallel(int proc);
-    virtual FieldHandle StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) = 0;
+    virtual void StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) = 0;
     double calcTotalStreamlineLength(const std::vector<Point>& nodes) const;
-    void setOutputData(FieldHandle out, const std::vector<Point>& nodes, VMesh::Node::index_type idx, int cc) const;
+    void addStreamline(StreamlineBuffer& buffer, const std::vector<Point>& nodes, VMesh::Node::index_type idx, int cc) const;
+    void writeOutput(int proc, VMesh* omesh, VField* ofield) const;
 
     const AlgorithmBase* algo_;
     int numprocessors_;
@@ -206,7 +220,7 @@ namespace detail
 
     FieldHandle input_;
     std::vector<bool> success_;
-    FieldList outputs_;
+    std::vector<StreamlineBuffer> buffers_;
     VMesh::Node::index_type global_dimension_ {0};
   };
 
@@ -233,21 +247,15 @@ namespace detail
     GenerateStreamLinesAlgoP(const AlgorithmBase* algo, IntegrationMethod method) : GenerateStreamLinesAlgoImplBase(algo, method)
     {}
   protected:
-    FieldHandle StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) override;
+    void StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) override;
   };
 
-  FieldHandle GenerateStreamLinesAlgoP::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
+  void GenerateStreamLinesAlgoP::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
   {
-    FieldHandle out;
     try
     {
       Vector test;
-      FieldInformation fi(input_);
-      fi.make_curvemesh();
-      fi.make_lineardata();
-      fi.make_linearmesh();
-      fi.make_double();
-      out = CreateField(fi);
+      StreamlineBuffer& out = buffers_[proc_num];
 
       StreamLineIntegrators BI;
       BI.nodes_.reserve(max_steps_);                  // storage for points
@@ -294,7 +302,7 @@ namespace detail
           BI.integrate(method_);
         }
 
-        setOutputData(out, BI.nodes_, idx, cc);
+        addStreamline(out, BI.nodes_, idx, cc);
 
         if (proc_num == 0)
           algo_->update_progress_max(idx, to);
@@ -320,70 +328,67 @@ namespace detail
       algo_->error(a);
       success_[proc_num] = false;
     }
-
-    return out;
   }
 
-  void GenerateStreamLinesAlgoImplBase::setOutputData(FieldHandle out, const std::vector<Point>& nodes, VMesh::Node::index_type idx, int cc) const
+  void GenerateStreamLinesAlgoImplBase::addStreamline(StreamlineBuffer& buffer, const std::vector<Point>& nodes, VMesh::Node::index_type idx, int cc) const
   {
-    auto ofield = out->vfield();
-    auto omesh = out->vmesh();
+    if (nodes.empty())
+      return;
+
     const auto totalLength = calcTotalStreamlineLength(nodes);
     double partialStreamlineLength = 0;
-    int nodeIndex = 0;
-    Point previousNode;
-    VMesh::Node::array_type newnodes(2);
-    VMesh::Node::index_type n1, n2;
+    Point previousNode = nodes[0];
 
     for (const auto& node : nodes)
     {
-      if (0 == nodeIndex)
+      double value = 0;
+      const double length = Vector(node - previousNode).length();
+
+      if (value_ == StreamlineValue::SeedIndex) value = static_cast<double>(idx);
+      else if (value_ == StreamlineValue::IntegrationIndex) value = abs(cc);
+      else if (value_ == StreamlineValue::IntegrationStep) value = length;
+      else if (value_ == StreamlineValue::DistanceFromSeed)
       {
-        n1 = omesh->add_point(node);
-        ofield->resize_values();
+        partialStreamlineLength += length;
+        value = partialStreamlineLength;
+      }
+      else if (value_ == StreamlineValue::StreamlineLength) value = totalLength;
 
-        if (value_ == StreamlineValue::SeedValue) ofield->copy_value(seed_field_, idx, n1);
-        else if (value_ == StreamlineValue::SeedIndex) ofield->set_value(index_type(idx), n1);
-        else if (value_ == StreamlineValue::IntegrationIndex) ofield->set_value(abs(cc), n1);
-        else if (value_ == StreamlineValue::IntegrationStep) ofield->set_value(0, n1);
-        else if (value_ == StreamlineValue::DistanceFromSeed) ofield->set_value(partialStreamlineLength, n1);
-        else if (value_ == StreamlineValue::StreamlineLength) ofield->set_value(totalLength, n1);
+      buffer.nodes_.push_back(node);
+      buffer.values_.push_back(value);
+      previousNode = node;
+      cc++;
+    }
 
-        cc++;
-      }
-      else
-      {
-        n2 = omesh->add_point(node);
-        ofield->resize_fdata();
+    buffer.lines_.push_back(std::make_pair(idx, static_cast<size_type>(nodes.size())));
+    buffer.num_edges_ += nodes.size() - 1;
+  }
 
-        if (value_ == StreamlineValue::SeedValue) ofield->copy_value(seed_field_, idx, n2);
-        else if (value_ == StreamlineValue::SeedIndex) ofield->set_value(index_type(idx), n2);
-        else if (value_ == StreamlineValue::IntegrationIndex) ofield->set_value(abs(cc), n2);
-        else if (value_ == StreamlineValue::IntegrationStep)
-        {
-          double length = Vector(node - previousNode).length();
-          ofield->set_value(length, n2);
-        }
-        else if (value_ == StreamlineValue::DistanceFromSeed)
-        {
-          partialStreamlineLength += Vector(node - previousNode).length();
-          ofield->set_value(partialStreamlineLength, n2);
-        }
-        else if (value_ == StreamlineValue::StreamlineLength)
-        {
-          ofield->set_value(totalLength, n2);
-        }
+  void GenerateStreamLinesAlgoImplBase::writeOutput(int proc, VMesh* omesh, VField* ofield) const
+  {
+    const StreamlineBuffer& buffer = buffers_[proc];
+    VMesh::Node::array_type newnodes(2);
+    VMesh::Node::index_type n = buffer.node_offset_;
+    VMesh::Elem::index_type e = buffer.edge_offset_;
+    size_t k = 0;
 
-        newnodes[0] = n1;
-        newnodes[1] = n2;
+    for (const auto& line : buffer.lines_)
+    {
+      for (size_type j = 0; j < line.second; ++j, ++k, ++n)
+      {
+        omesh->set_point(buffer.nodes_[k], n);
 
-        omesh->add_elem(newnodes);
-        n1 = n2;
+        if (value_ == StreamlineValue::SeedValue) ofield->copy_value(seed_field_, line.first, n);
+        else ofield->set_value(buffer.values_[k], n);
 
-        cc++;
+        if (j > 0)
+        {
+          newnodes[0] = VMesh::Node::index_type(n - 1);
+          newnodes[1] = n;
+          omesh->set_nodes(newnodes, e);
+          ++e;
+        }
       }
-      ++nodeIndex;
-      previousNode = node;
     }
   }
 
@@ -398,7 +403,7 @@ namespace detail
     }
 
     auto range = partitionNodes(proc_num);
-    outputs_[proc_num] = StreamLinesForCertainSeeds(range.first, range.second, proc_num);
+    StreamLinesForCertainSeeds(range.first, range.second, proc_num);
   }
 
   bool GenerateStreamLinesAlgoImplBase::run(FieldHandle input,
@@ -423,19 +428,33 @@ namespace detail
     if (!algo_->get(Parameters::UseMultithreading).toBool())
       numprocessors_ = 1;
     success_.resize(numprocessors_, true);
-    outputs_.resize(numprocessors_, nullptr);
+    buffers_.resize(numprocessors_);
 
     Parallel::RunTasks([this](int i) { parallel(i); }, numprocessors_);
     for (size_t j = 0; j < success_.size(); j++)
     {
       if (!success_[j]) return false;
-      if (!outputs_[j]) return false;
     }
-    JoinFieldsAlgo join;
-    join.set(JoinFieldsAlgo::MergeNodes, false);
-    if (IntegrationMethod::CellWalk == method_)
-      join.set(JoinFieldsAlgo::Tolerance, 1e-8);
-    join.runImpl(outputs_, output);
+
+    // The streamlines of each thread are stored consecutively in the output,
+    // hence the offsets of the threads follow from a prefix sum of the sizes.
+    index_type num_nodes = 0;
+    index_type num_edges = 0;
+    for (auto& buffer : buffers_)
+    {
+      buffer.node_offset_ = num_nodes;
+      buffer.edge_offset_ = num_edges;
+      num_nodes += buffer.nodes_.size();
+      num_edges += buffer.num_edges_;
+    }
+
+    VMesh* omesh = output->vmesh();
+    VField* ofield = output->vfield();
+    omesh->resize_nodes(num_nodes);
+    omesh->resize_elems(num_edges);
+    ofield->resize_values();
+
+    Parallel::RunTasks([this, omesh, ofield](int i) { writeOutput(i, omesh, ofield); }, numprocessors_);
 
     return true;
   }
@@ -448,22 +467,16 @@ namespace detail
     GenerateStreamLinesAccAlgo(const AlgorithmBase* algo, IntegrationMethod method) : GenerateStreamLinesAlgoImplBase(algo, method)
     {}
   protected:
-    FieldHandle StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) override;
+    void StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num) override;
   private:
     void find_nodes(std::vector<Point>& v, Point seed, bool back);
   };
 
-  FieldHandle GenerateStreamLinesAccAlgo::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
+  void GenerateStreamLinesAccAlgo::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
   {
-    FieldInformation fi(input_);
-    fi.make_curvemesh();
-    fi.make_lineardata();
-    fi.make_linearmesh();
-    fi.make_double();
-    FieldHandle out;
     try
     {
-      out = CreateField(fi);
+      StreamlineBuffer& out = buffers_[proc_num];
       Point seed;
       VMesh::Elem::index_type elem;
       std::vector<Point> nodes;
@@ -501,7 +514,7 @@ namespace detail
           find_nodes(nodes, seed, false);
         }
 
-        setOutputData(out, nodes, idx, cc);
+        addStreamline(out, nodes, idx, cc);
 
         if (proc_num == 0)
           algo_->update_progress_max(from, to);
@@ -527,8 +540,6 @@ namespace detail
       algo_->error(a);
       success_[proc_num] = false;
     }
-
-    return out;
   }
 
   void GenerateStreamLinesAccAlgo::find_nodes(std::vector<Point> &v, Point seed, bool back)
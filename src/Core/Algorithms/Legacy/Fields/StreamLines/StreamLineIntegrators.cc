@@ -42,6 +42,12 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms::Fields;
 
+StreamLineIntegrators::StreamLineIntegrators() :
+  tolerance2_(0.0), step_size_(0.0), max_steps_(0), vfield_(nullptr)
+{
+  ei_.elem_index = -1;
+}
+
 /// interpolate using the generic linear interpolator
 bool
 StreamLineIntegrators::interpolate( const Point &p,
@@ -52,7 +58,10 @@ StreamLineIntegrators::interpolate( const Point &p,
   //  vfield_->interpolate(v, p);
   //  return (v.safe_normalize() > 0.0);
 
-  return vfield_->interpolate(v, p);
+  // Consecutive points are close together, hence the element of the
+  // previous point and its neighbors are checked before the mesh is
+  // searched.
+  return vfield_->interpolate(v, p, Vector(0.0, 0.0, 0.0), ei_);
 }
 
 
@@ -36,6 +36,7 @@
 #define CORE_ALGORITHMS_FIELDS_STREAMLINES_STREAMLINEINTEGRATORS_H 1
 
 #include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/GeometryPrimitives/Point.h>
 #include <Core/GeometryPrimitives/Vector.h>
 
@@ -68,6 +69,8 @@ namespace SCIRun {
         class SCISHARE StreamLineIntegrators
         {
         public:
+          StreamLineIntegrators();
+
           void FindAdamsBashforth();
           void FindHeun();
           void FindRK4();
@@ -90,6 +93,10 @@ namespace SCIRun {
             double s);        // current step size
 
           bool interpolate(const Geometry::Point &p, Geometry::Vector &v);
+
+          // element of the last interpolation, used as the starting point
+          // of the next search
+          VMesh::ElemInterpolate ei_;
         };
 
       }
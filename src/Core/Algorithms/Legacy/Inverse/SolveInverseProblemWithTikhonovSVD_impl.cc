@@ -45,11 +45,11 @@
 
 // Tikhonov inverse libraries
 #include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
+#include <Core/Algorithms/Math/SingularValueDecomposition.h>
 #include <Core/Algorithms/Legacy/Inverse/SolveInverseProblemWithTikhonovSVD_impl.h>
 
 // EIGEN LIBRARY
 #include <Eigen/Eigen>
-#include <Eigen/SVD>
 
 
 using namespace SCIRun;
@@ -59,6 +59,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Logging;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Inverse;
+using namespace SCIRun::Core::Algorithms::Math;
 
 
 
@@ -84,15 +85,17 @@ void SolveInverseProblemWithTikhonovSVD_impl::preAlocateInverseMatrices(const SC
 		// Compute the projection of data y on the left singular vectors
 			Uy = svd_MatrixU.transpose() * (measuredData_);
 
-		// determine rank
-	        rank = svd_SingularValues.nrows();
+		// determine rank, truncated factors only hold the leading singular vectors
+	        rank = std::min( svd_SingularValues.nrows(), std::min( svd_MatrixU.ncols(), svd_MatrixV.ncols() ) );
 }
 
 void SolveInverseProblemWithTikhonovSVD_impl::preAlocateInverseMatrices(const SCIRun::Core::Datatypes::DenseMatrix& forwardMatrix_, const SCIRun::Core::Datatypes::DenseMatrix& measuredData_ , const SCIRun::Core::Datatypes::DenseMatrix& sourceWeighting_, const SCIRun::Core::Datatypes::DenseMatrix& sensorWeighting_)
 {
 
-	    // Compute the SVD of the forward matrix
-	        Eigen::JacobiSVD<SCIRun::Core::Datatypes::DenseMatrix::EigenBase> SVDdecomposition( forwardMatrix_, Eigen::ComputeFullU | Eigen::ComputeFullV);
+	    // Compute the thin SVD of the forward matrix, only the singular vectors
+	    // that belong to nonzero singular values enter the solution
+	        SingularValueDecomposition SVDdecomposition( SingularValueDecomposition::DIVIDE_AND_CONQUER, std::min(forwardMatrix_.nrows(), forwardMatrix_.ncols()) );
+	        SVDdecomposition.compute( forwardMatrix_ );
 
 		// alocate the left and right singular vectors and the singular values
 			svd_MatrixU = SVDdecomposition.matrixU();
@@ -100,7 +103,9 @@ void SolveInverseProblemWithTikhonovSVD_impl::preAlocateInverseMatrices(const SC
 			svd_SingularValues = SVDdecomposition.singularValues();
 
 	    // determine rank
-	        rank = SVDdecomposition.nonzeroSingularValues();
+	        rank = 0;
+	        while ( rank < svd_SingularValues.nrows() && svd_SingularValues[rank] > 0.0 )
+	            rank++;
 
 	    // Compute the projection of data y on the left singular vectors
 	        Uy = svd_MatrixU.transpose() * (measuredData_);
@@ -113,11 +118,13 @@ SCIRun::Core::Datatypes::DenseMatrix SolveInverseProblemWithTikhonovSVD_impl::co
 {
 
     // prealocate matrices
-        const int N = svd_MatrixV.cols();
+        const int N = svd_MatrixV.rows();
         const int M = svd_MatrixU.rows();
         const int numTimeSamples = Uy.ncols();
         DenseMatrix solution(DenseMatrix::Zero(N,numTimeSamples));
-        DenseMatrix tempInverse(DenseMatrix::Zero(N,M));
+        DenseMatrix tempInverse;
+        if (inverseCalculation)
+            tempInverse = DenseMatrix::Zero(N,M);
 
     // Compute inverse solution
         for (int rr=0; rr<rank ; rr++)
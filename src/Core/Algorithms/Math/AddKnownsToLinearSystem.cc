@@ -59,6 +59,16 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
   DenseMatrixHandle x,
   SparseRowMatrixHandle& output_stiff,
   DenseColumnMatrixHandle& output_rhs) const
+{
+  return run(stiff, rhs, x, &output_stiff, output_rhs);
+}
+
+// output_stiff is null when only the right-hand side needs to be computed
+bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
+  DenseMatrixHandle rhs,
+  DenseMatrixHandle x,
+  SparseRowMatrixHandle* output_stiff,
+  DenseColumnMatrixHandle& output_rhs) const
 {
   SparseRowMatrixFromMap::Values additionalData;
 
@@ -122,8 +132,11 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
         if (i!=p)
         {
           rhsColRef[i] += -it.value() * xCol_p;
-          additionalData[i][p] = 0.0;
-          additionalData[p][i] = 0.0;
+          if (output_stiff)
+          {
+            additionalData[i][p] = 0.0;
+            additionalData[p][i] = 0.0;
+          }
         }
       }
       cnt++;
@@ -135,10 +148,13 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
     }
   }
 
-  for (int i = 0; i < std::min(numRows, numCols); ++i)
+  if (output_stiff)
   {
-    if (IsFinite(xColRef[i]))
-      additionalData[i][i] = 1.0;
+    for (int i = 0; i < std::min(numRows, numCols); ++i)
+    {
+      if (IsFinite(xColRef[i]))
+        additionalData[i][i] = 1.0;
+    }
   }
 
   // assigns value for right hand side vector
@@ -160,7 +176,8 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
   if (just_copying_inputs)
     remark("X vector does not contain any knowns! Copying inputs to outputs.");
 
-  output_stiff = SparseRowMatrixFromMap::appendToSparseMatrix(numCols, numRows, *stiff, additionalData);
+  if (output_stiff)
+    *output_stiff = SparseRowMatrixFromMap::appendToSparseMatrix(numCols, numRows, *stiff, additionalData);
   output_rhs = rhsCol;
 
   return true;
@@ -184,9 +201,21 @@ AlgorithmOutput AddKnownsToLinearSystemAlgo::run(const AlgorithmInput & input) c
   SparseRowMatrixHandle output_lhs;
   DenseColumnMatrixHandle output_rhs;
 
-  if (!run(input_lhs,input_rhs,input_x,output_lhs,output_rhs))
+  const bool reuseLHS = cachedOutputStiff_ && input_lhs == cachedStiff_ && input_x == cachedX_;
+  if (!run(input_lhs, input_rhs, input_x, reuseLHS ? nullptr : &output_lhs, output_rhs))
     THROW_ALGORITHM_INPUT_ERROR("False returned on legacy run call.");
 
+  if (reuseLHS)
+  {
+    output_lhs = cachedOutputStiff_;
+  }
+  else
+  {
+    cachedStiff_ = input_lhs;
+    cachedX_ = input_x;
+    cachedOutputStiff_ = output_lhs;
+  }
+
   AlgorithmOutput output;
   output[OutPutLHSMatrix] = output_lhs;
   output[OutPutRHSVector] = output_rhs;
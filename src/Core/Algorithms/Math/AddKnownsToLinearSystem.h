@@ -50,6 +50,12 @@ namespace SCIRun {
           static const AlgorithmOutputName OutPutRHSVector;
           bool run(Datatypes::SparseRowMatrixHandle stiff, Datatypes::DenseMatrixHandle rhs, Datatypes::DenseMatrixHandle x, Datatypes::SparseRowMatrixHandle& output_stiff, Datatypes::DenseColumnMatrixHandle& output_rhs) const;
           virtual AlgorithmOutput run(const AlgorithmInput &) const;
+        private:
+          bool run(Datatypes::SparseRowMatrixHandle stiff, Datatypes::DenseMatrixHandle rhs, Datatypes::DenseMatrixHandle x, Datatypes::SparseRowMatrixHandle* output_stiff, Datatypes::DenseColumnMatrixHandle& output_rhs) const;
+          // The modified matrix only depends on the stiffness matrix and the knowns, so it is kept and
+          // re-sent when only the right-hand side changes; downstream solvers then see an unchanged matrix.
+          mutable Datatypes::SparseRowMatrixHandle cachedStiff_, cachedOutputStiff_;
+          mutable Datatypes::DenseMatrixHandle cachedX_;
         };
 
       }
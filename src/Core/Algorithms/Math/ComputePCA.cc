@@ -29,7 +29,6 @@
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
-#include <Eigen/SVD>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 
 using namespace SCIRun;
@@ -37,6 +36,14 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
 
+ComputePCAAlgo::ComputePCAAlgo()
+{
+    addOption(Parameters::SVDMethod, "DivideAndConquer", SingularValueDecomposition::methodOptions());
+    addParameter(Parameters::TruncationRank, 0);
+    addParameter(Parameters::Oversampling, 10);
+    addParameter(Parameters::PowerIterations, 2);
+}
+
 //Let's do some math.
 //Algorithm:
 void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, DenseMatrixHandle& PrinVals, DenseMatrixHandle& RightPrinMat) const{
@@ -50,12 +57,17 @@ void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, Den
     //Input matrix: nxm
     if (matrixIs::dense(input))
     {
-        //First, we have to center the data.
-        auto denseInputCentered = centerData(input);
-        
-        //After the data is centered, then we compute SVD on the centered matrix.
+        const auto method = SingularValueDecomposition::methodFromName(getOption(Parameters::SVDMethod));
+        const int rank = get(Parameters::TruncationRank).toInt();
+        if (rank < 0 || (method == SingularValueDecomposition::RANDOMIZED && rank == 0))
+            THROW_ALGORITHM_INPUT_ERROR("Truncation rank must be positive for the randomized SVD and non-negative otherwise.");
+
+        //The data is centered by subtracting the column means, then we compute SVD on the centered matrix.
         //Centered Matrix = U*S*Vt, Vt = V transpose
-        Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(denseInputCentered, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        SingularValueDecomposition svd_mat(method, rank);
+        svd_mat.setOversampling(get(Parameters::Oversampling).toInt());
+        svd_mat.setPowerIterations(get(Parameters::PowerIterations).toInt());
+        svd_mat.computeCentered(*castMatrix::toDense(input));
         
         //U: Left principal matrix, nxn, orthogonal
         LeftPrinMat = boost::make_shared<DenseMatrix>(svd_mat.matrixU());
@@ -80,15 +92,10 @@ DenseMatrix ComputePCAAlgo::centerData(MatrixHandle input_matrix)
     //Casts the matrix as dense.
     auto denseInput = castMatrix::toDense(input_matrix);
     
-    //Counts the number of rows in the input matrix.
-    auto rows = denseInput->rows();
-    
-    //Calulates the centering matrix (C).
-    // C = Identity(nxn) - 1/n * matrix of ones(nxn)
-    auto centerMatrix = Eigen::MatrixXd::Identity(rows,rows) - (1.0/rows)*Eigen::MatrixXd::Constant(rows,rows,1);
-    
-    //Multiplying the input matrix by the centering matrix.
-    auto denseInputCentered = centerMatrix * *denseInput;
+    //Subtracts the mean of each column, which equals multiplying by the
+    //centering matrix C = Identity(nxn) - 1/n * matrix of ones(nxn)
+    //without forming it.
+    DenseMatrix denseInputCentered = denseInput->rowwise() - denseInput->colwise().mean();
     
     return denseInputCentered;
 }
@@ -27,6 +27,7 @@
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/Math/SingularValueDecomposition.h>
 #include <Core/Algorithms/Math/share.h>
 
 namespace SCIRun {
@@ -37,7 +38,7 @@ namespace SCIRun {
                 class SCISHARE ComputePCAAlgo : public AlgorithmBase
                 {
                 public:
-                    ComputePCAAlgo() {}
+                    ComputePCAAlgo();
                     
                     static AlgorithmOutputName LeftPrincipalMatrix;
                     static AlgorithmOutputName PrincipalValues;
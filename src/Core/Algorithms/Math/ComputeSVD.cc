@@ -31,7 +31,6 @@
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
-#include <Eigen/SVD>
 
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 
@@ -40,6 +39,14 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
 
+ComputeSVDAlgo::ComputeSVDAlgo()
+{
+  addOption(Parameters::SVDMethod, "DivideAndConquer", SingularValueDecomposition::methodOptions());
+  addParameter(Parameters::TruncationRank, 0);
+  addParameter(Parameters::Oversampling, 10);
+  addParameter(Parameters::PowerIterations, 2);
+}
+
 void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat) const
 {
   if (input->nrows() == 0 || input->ncols() == 0){
@@ -50,7 +57,15 @@ void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, Den
   {
     auto denseInput = castMatrix::toDense(input);
 
-    Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(*denseInput, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const auto method = SingularValueDecomposition::methodFromName(getOption(Parameters::SVDMethod));
+    const int rank = get(Parameters::TruncationRank).toInt();
+    if (rank < 0 || (method == SingularValueDecomposition::RANDOMIZED && rank == 0))
+      THROW_ALGORITHM_INPUT_ERROR("Truncation rank must be positive for the randomized SVD and non-negative otherwise.");
+
+    SingularValueDecomposition svd_mat(method, rank);
+    svd_mat.setOversampling(get(Parameters::Oversampling).toInt());
+    svd_mat.setPowerIterations(get(Parameters::PowerIterations).toInt());
+    svd_mat.compute(*denseInput);
 
     LeftSingMat = boost::make_shared<DenseMatrix>(svd_mat.matrixU());
 
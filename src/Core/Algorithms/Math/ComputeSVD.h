@@ -28,6 +28,7 @@
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/Math/SingularValueDecomposition.h>
 #include <Core/Algorithms/Math/share.h>
 
 namespace SCIRun {
@@ -38,7 +39,7 @@ namespace SCIRun {
 			class SCISHARE ComputeSVDAlgo : public AlgorithmBase
 			{
 				public:
-					ComputeSVDAlgo() {}
+					ComputeSVDAlgo();
 					
 					static AlgorithmOutputName LeftSingularMatrix;
 					static AlgorithmOutputName SingularValues;
@@ -0,0 +1,89 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Math/LinearSystem/LinearSystemSession.h>
+#include <boost/functional/hash.hpp>
+
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Datatypes;
+
+LinearSystemSession::LinearSystemSession(SparseRowMatrixHandle A, size_t maxBasisSize) :
+  A_(A), fingerprint_(A ? fingerprint(*A) : 0), maxBasisSize_(maxBasisSize)
+{
+}
+
+bool LinearSystemSession::matches(const SparseRowMatrixHandle& A) const
+{
+  // One pass over the entries, which is small next to a solve.
+  return A && A == A_ && fingerprint(*A) == fingerprint_;
+}
+
+size_t LinearSystemSession::fingerprint(const SparseRowMatrix& A)
+{
+  size_t seed = 0;
+  boost::hash_combine(seed, A.rows());
+  boost::hash_combine(seed, A.cols());
+  for (int row = 0; row < A.outerSize(); ++row)
+    for (SparseRowMatrix::InnerIterator it(A, row); it; ++it)
+    {
+      boost::hash_combine(seed, it.index());
+      boost::hash_combine(seed, it.value());
+    }
+  return seed;
+}
+
+DenseColumnMatrixHandle LinearSystemSession::initialGuess(const DenseColumnMatrix& b) const
+{
+  auto x0(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Zero(b.nrows())));
+  for (const auto& q : basis_)
+    *x0 += q.dot(b) * q;
+  return x0;
+}
+
+bool LinearSystemSession::addSolution(const DenseColumnMatrix& x)
+{
+  if (maxBasisSize_ == 0 || x.nrows() != A_->ncols())
+    return false;
+
+  // Gram-Schmidt in the A inner product
+  DenseColumnMatrix Ax = *A_ * x;
+  DenseColumnMatrix v = x;
+  for (const auto& q : basis_)
+    v -= q.dot(Ax) * q;
+
+  DenseColumnMatrix Av = *A_ * v;
+  const double norm2 = v.dot(Av);
+  const double reference = x.dot(Ax);
+  if (!(norm2 > 1e-20 * reference) || !(reference > 0))
+    return false;
+
+  if (basis_.size() == maxBasisSize_)
+    basis_.erase(basis_.begin());
+  basis_.push_back(v / std::sqrt(norm2));
+  return true;
+}
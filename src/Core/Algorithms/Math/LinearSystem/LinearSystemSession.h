@@ -0,0 +1,74 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_MATH_LINEARSYSTEM_LINEARSYSTEMSESSION_H
+#define CORE_ALGORITHMS_MATH_LINEARSYSTEM_LINEARSYSTEMSESSION_H
+
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <vector>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+// Setup carried between solves of A*x = b with an unchanged matrix A and changing right-hand
+// sides, e.g. a sweep over tDCS electrode currents. Earlier solutions are kept A-orthonormal;
+// projecting a new right-hand side onto them gives the best initial guess in their span (in
+// the A-norm), so right-hand sides that are combinations of earlier ones converge without
+// iterating. A must be symmetric positive definite. The session holds on to the matrix handle
+// and a fingerprint of its entries, so a matrix edited in place no longer matches.
+
+class SCISHARE LinearSystemSession
+{
+  public:
+    explicit LinearSystemSession(Datatypes::SparseRowMatrixHandle A, size_t maxBasisSize = 16);
+
+    bool matches(const Datatypes::SparseRowMatrixHandle& A) const;
+    size_t basisSize() const { return basis_.size(); }
+
+    Datatypes::DenseColumnMatrixHandle initialGuess(const Datatypes::DenseColumnMatrix& b) const;
+
+    // Returns false if x adds nothing to the span of the earlier solutions. The oldest
+    // solution is dropped once maxBasisSize solutions are kept.
+    bool addSolution(const Datatypes::DenseColumnMatrix& x);
+
+  private:
+    static size_t fingerprint(const Datatypes::SparseRowMatrix& A);
+
+    Datatypes::SparseRowMatrixHandle A_;
+    size_t fingerprint_;
+    size_t maxBasisSize_;
+    std::vector<Datatypes::DenseColumnMatrix> basis_;
+};
+
+}}}}
+
+#endif
@@ -32,6 +32,8 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
+#include <Core/Algorithms/Math/LinearSystem/LinearSystemSession.h>
+#include <Core/Algorithms/Math/LinearSystem/SparseDirectSolver.h>
 #include <Core/Algorithms/Math/ParallelAlgebra/ParallelLinearAlgebra.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
@@ -47,7 +49,7 @@ using namespace SCIRun::Core::Datatypes;
 SolveLinearSystemAlgo::SolveLinearSystemAlgo()
 {
   // For solver
-  addOption(Variables::Method,"cg","jacobi|cg|bicg|minres");
+  addOption(Variables::Method,"cg","jacobi|cg|bicg|minres|ldlt");
   addOption(Variables::Preconditioner,"Jacobi","None|Jacobi");
 
   addParameter(Variables::TargetError, 1e-5);
@@ -1180,6 +1182,13 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
       BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("MINRES method failed"));
     }
   }
+  else if (method == "ldlt")
+  {
+    // the factorization is kept, so solving again with the same matrix only substitutes
+    if (!directSolver_)
+      directSolver_.reset(new SparseDirectSolver);
+    x = directSolver_->solve(*A, *b);
+  }
   else
     BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Unknown solver method"));
 
@@ -1205,13 +1214,26 @@ AlgorithmOutput SolveLinearSystemAlgo::run(const AlgorithmInput& input) const
   auto lhs = input.get<SparseRowMatrix>(Variables::LHS);
   auto rhs = input.get<DenseColumnMatrix>(Variables::RHS);
 
-  DenseColumnMatrixHandle solution;
+  DenseColumnMatrixHandle solution, x0;
+
+  // Re-executions with the same matrix (e.g. only the tDCS electrode currents changed upstream)
+  // keep the session; the projection is only valid for the symmetric positive definite systems CG solves.
+  const bool useSession = getOption(Variables::Method) == "cg" && lhs && rhs
+    && lhs->nrows() == lhs->ncols() && lhs->nrows() == rhs->nrows();
+  if (useSession)
+  {
+    if (!session_ || !session_->matches(lhs))
+      session_.reset(new LinearSystemSession(lhs));
+    x0 = session_->initialGuess(*rhs);
+  }
 
-  bool success = run(lhs, rhs, DenseColumnMatrixHandle(), solution);
+  bool success = run(lhs, rhs, x0, solution);
   if (!success)
   {
     BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("SolveLinearSystem Algo returned false--need to improve error conditions so it throws before returning."));
   }
+  if (useSession)
+    session_->addSolution(*solution);
   
   AlgorithmOutput output;
   output[Variables::Solution] = boost::make_shared<DenseMatrix>(solution->col(0));
@@ -42,7 +42,11 @@ namespace Core {
 namespace Algorithms {
 namespace Math {
 
-// Solve a linear system in parallel using a standard iterative method
+class LinearSystemSession;
+class SparseDirectSolver;
+
+// Solve a linear system in parallel using a standard iterative method, or with a cached
+// sparse LDL^T factorization (method "ldlt") for symmetric systems with many right-hand sides
 // Method solves A*x = b, with x0 being the initializer for the solution
 
 class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
@@ -62,6 +66,12 @@ class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
              Datatypes::DenseColumnMatrixHandle& x) const;
 
     AlgorithmOutput run(const AlgorithmInput& input) const;
+
+  private:
+    // CG solves through the AlgorithmInput interface start from the earlier solutions
+    // of the same matrix, see LinearSystemSession.
+    mutable SharedPointer<LinearSystemSession> session_;
+    mutable SharedPointer<SparseDirectSolver> directSolver_;
 };
 
 
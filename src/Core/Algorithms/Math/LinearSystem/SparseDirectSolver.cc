@@ -0,0 +1,130 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Math/LinearSystem/SparseDirectSolver.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Datatypes;
+using SCIRun::index_type;
+
+namespace
+{
+  const double symmetryTolerance = 1e-10;
+  const double residualTolerance = 1e-10;
+
+  // The row-major storage of A read as column-major is A^T, which equals A for the symmetric
+  // systems this solver is meant for; this avoids copying the matrix.
+  Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor, index_type>> transposedView(const SparseRowMatrix& A)
+  {
+    return Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor, index_type>>(A.ncols(), A.nrows(), A.nonZeros(),
+      A.outerIndexPtr(), A.innerIndexPtr(), A.valuePtr());
+  }
+}
+
+SparseDirectSolver::SparseDirectSolver() : analyzed_(false), factoredId_(-1), factoredNorm_(0), analyses_(0), factorizations_(0)
+{
+}
+
+void SparseDirectSolver::clear()
+{
+  analyzed_ = false;
+  factoredId_ = -1;
+  outer_.clear();
+  inner_.clear();
+  values_.clear();
+}
+
+bool SparseDirectSolver::samePattern(const SparseRowMatrix& A) const
+{
+  const auto n = A.outerSize();
+  if (outer_.size() != static_cast<size_t>(n + 1) || inner_.size() != static_cast<size_t>(A.nonZeros()))
+    return false;
+  return std::equal(A.outerIndexPtr(), A.outerIndexPtr() + n + 1, outer_.begin())
+    && std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), inner_.begin());
+}
+
+bool SparseDirectSolver::isFactored(const SparseRowMatrix& A) const
+{
+  // the id survives assignment and in-place edits, so the values are compared as well
+  return factoredId_ == A.id() && samePattern(A) && values_.size() == static_cast<size_t>(A.nonZeros())
+    && std::equal(A.valuePtr(), A.valuePtr() + A.nonZeros(), values_.begin());
+}
+
+void SparseDirectSolver::factorize(const SparseRowMatrix& A)
+{
+  if (!A.isCompressed())
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Sparse direct solver needs a compressed matrix"));
+
+  auto view = transposedView(A);
+  factoredId_ = -1;
+  const double norm = view.norm();
+  const FactorMatrix asymmetry = view - FactorMatrix(view.transpose());
+  if (asymmetry.norm() > symmetryTolerance * norm)
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Sparse LDLT factorization needs a symmetric matrix"));
+
+  if (!analyzed_ || !samePattern(A))
+  {
+    ldlt_.analyzePattern(view);
+    outer_.assign(A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1);
+    inner_.assign(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros());
+    analyzed_ = true;
+    ++analyses_;
+  }
+
+  ldlt_.factorize(view);
+  ++factorizations_;
+  if (ldlt_.info() != Eigen::Success)
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Sparse LDLT factorization failed, the matrix is singular"));
+  factoredId_ = A.id();
+  factoredNorm_ = norm;
+  values_.assign(A.valuePtr(), A.valuePtr() + A.nonZeros());
+}
+
+DenseColumnMatrixHandle SparseDirectSolver::solve(const SparseRowMatrix& A, const DenseColumnMatrix& b)
+{
+  if (A.nrows() != A.ncols())
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Matrix A is not square"));
+  if (A.nrows() != b.nrows())
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Matrix A and b do not have the same number of rows"));
+
+  if (!isFactored(A))
+    factorize(A);
+
+  auto x = boost::make_shared<DenseColumnMatrix>(ldlt_.solve(b));
+
+  // normwise backward error, which stays small for ill-conditioned but nonsingular systems
+  const DenseColumnMatrix residual = A * *x - b;
+  const double scale = factoredNorm_ * x->norm() + b.norm();
+  if (!std::isfinite(residual.norm()) || (scale > 0 && residual.norm() > residualTolerance * scale))
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Sparse LDLT solve did not converge, the matrix is singular or indefinite"));
+  return x;
+}
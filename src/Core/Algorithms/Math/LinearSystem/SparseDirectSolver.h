@@ -0,0 +1,81 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_MATH_LINEARSYSTEM_SPARSEDIRECTSOLVER_H
+#define CORE_ALGORITHMS_MATH_LINEARSYSTEM_SPARSEDIRECTSOLVER_H
+
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Eigen/SparseCholesky>
+#include <vector>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+// Direct solver for symmetric sparse systems: an LDL^T factorization with an approximate
+// minimum degree ordering. The numeric factor is kept for the matrix it was computed from
+// (by datatype id and values), so further right-hand sides only cost two triangular substitutions. The
+// ordering and symbolic analysis are kept for the sparsity pattern, so a new matrix with the
+// same pattern (e.g. updated conductivities on the same mesh) only refactorizes numerically.
+
+class SCISHARE SparseDirectSolver
+{
+  public:
+    SparseDirectSolver();
+
+    // Throws AlgorithmProcessingException if A is not square or not symmetric, if the
+    // factorization fails, or if the solution does not satisfy A*x = b.
+    Datatypes::DenseColumnMatrixHandle solve(const Datatypes::SparseRowMatrix& A, const Datatypes::DenseColumnMatrix& b);
+
+    void clear();
+
+    size_t symbolicAnalyses() const { return analyses_; }
+    size_t numericFactorizations() const { return factorizations_; }
+
+  private:
+    void factorize(const Datatypes::SparseRowMatrix& A);
+    bool samePattern(const Datatypes::SparseRowMatrix& A) const;
+    bool isFactored(const Datatypes::SparseRowMatrix& A) const;
+
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor, SCIRun::index_type> FactorMatrix;
+    Eigen::SimplicialLDLT<FactorMatrix, Eigen::Lower, Eigen::AMDOrdering<SCIRun::index_type>> ldlt_;
+
+    bool analyzed_;
+    Datatypes::Datatype::id_type factoredId_;
+    double factoredNorm_;
+    std::vector<SCIRun::index_type> outer_, inner_;
+    std::vector<double> values_;
+    size_t analyses_, factorizations_;
+};
+
+}}}}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Math/SingularValueDecomposition.h>
+#include <Eigen/SVD>
+#include <Eigen/QR>
+#include <random>
+
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Datatypes;
+
+ALGORITHM_PARAMETER_DEF(Math, SVDMethod);
+ALGORITHM_PARAMETER_DEF(Math, TruncationRank);
+ALGORITHM_PARAMETER_DEF(Math, Oversampling);
+ALGORITHM_PARAMETER_DEF(Math, PowerIterations);
+
+namespace
+{
+  typedef Eigen::MatrixXd Dense;
+
+  // Products with the input matrix, or with the input matrix minus its
+  // column means, without forming the centered matrix.
+  class CenteredProduct
+  {
+  public:
+    CenteredProduct(const DenseMatrix& matrix, const Eigen::VectorXd* columnMeans) :
+      matrix_(matrix), means_(columnMeans) {}
+
+    Dense apply(const Dense& x) const
+    {
+      Dense y = matrix_ * x;
+      if (means_)
+      {
+        Eigen::RowVectorXd shift = means_->transpose() * x;
+        y.rowwise() -= shift;
+      }
+      return y;
+    }
+
+    Dense applyTranspose(const Dense& y) const
+    {
+      Dense x = matrix_.transpose() * y;
+      if (means_)
+        x -= (*means_) * y.colwise().sum();
+      return x;
+    }
+
+  private:
+    const DenseMatrix& matrix_;
+    const Eigen::VectorXd* means_;
+  };
+
+  Dense orthonormalBasis(const Dense& y)
+  {
+    Eigen::HouseholderQR<Dense> qr(y);
+    return qr.householderQ() * Dense::Identity(y.rows(), y.cols());
+  }
+
+  template <class SVD>
+  void storeFactors(const SVD& svd, int rank, bool full, DenseMatrix& U, DenseMatrix& S, DenseMatrix& V)
+  {
+    if (full)
+    {
+      U = svd.matrixU();
+      S = svd.singularValues();
+      V = svd.matrixV();
+    }
+    else
+    {
+      U = svd.matrixU().leftCols(rank);
+      S = svd.singularValues().head(rank);
+      V = svd.matrixV().leftCols(rank);
+    }
+  }
+}
+
+SingularValueDecomposition::SingularValueDecomposition(Method method, int rank) :
+  method_(method), rank_(rank), oversampling_(10), powerIterations_(2)
+{
+}
+
+const std::string& SingularValueDecomposition::methodOptions()
+{
+  static const std::string options("Jacobi|DivideAndConquer|Randomized");
+  return options;
+}
+
+SingularValueDecomposition::Method SingularValueDecomposition::methodFromName(const std::string& name)
+{
+  if (name == "Jacobi")
+    return JACOBI;
+  if (name == "Randomized")
+    return RANDOMIZED;
+  return DIVIDE_AND_CONQUER;
+}
+
+void SingularValueDecomposition::compute(const DenseMatrix& matrix)
+{
+  run(matrix, nullptr);
+}
+
+void SingularValueDecomposition::computeCentered(const DenseMatrix& matrix)
+{
+  const Eigen::VectorXd columnMeans = matrix.colwise().mean().transpose();
+  run(matrix, &columnMeans);
+}
+
+void SingularValueDecomposition::run(const DenseMatrix& matrix, const Eigen::VectorXd* columnMeans)
+{
+  const int maxRank = static_cast<int>(std::min(matrix.rows(), matrix.cols()));
+  const bool full = rank_ <= 0;
+  const int rank = full ? maxRank : std::min(rank_, maxRank);
+
+  if (method_ == RANDOMIZED && !full && rank < maxRank)
+  {
+    // Sample the range of the matrix with a Gaussian test matrix, refine the
+    // basis with a few power iterations and decompose the small projected
+    // matrix B = Q^T A, which is computed here as its transpose A^T Q.
+    const int samples = std::min(rank + std::max(oversampling_, 0), maxRank);
+
+    std::mt19937 generator(5489u);
+    std::normal_distribution<double> normal;
+    Dense omega(matrix.cols(), samples);
+    for (int j = 0; j < samples; ++j)
+      for (int i = 0; i < omega.rows(); ++i)
+        omega(i, j) = normal(generator);
+
+    CenteredProduct product(matrix, columnMeans);
+    Dense Q = orthonormalBasis(product.apply(omega));
+    for (int it = 0; it < powerIterations_; ++it)
+      Q = orthonormalBasis(product.apply(orthonormalBasis(product.applyTranspose(Q))));
+
+    Eigen::BDCSVD<Dense> svd(product.applyTranspose(Q), Eigen::ComputeThinU | Eigen::ComputeThinV);
+
+    // A ~ Q B = (Q Vb) S Ub^T
+    U_ = (Q * svd.matrixV()).leftCols(rank);
+    S_ = svd.singularValues().head(rank);
+    V_ = svd.matrixU().leftCols(rank);
+    return;
+  }
+
+  Dense A = matrix;
+  if (columnMeans)
+    A.rowwise() -= columnMeans->transpose();
+
+  const unsigned int options = full ? (Eigen::ComputeFullU | Eigen::ComputeFullV) : (Eigen::ComputeThinU | Eigen::ComputeThinV);
+  if (method_ == JACOBI)
+    storeFactors(Eigen::JacobiSVD<Dense>(A, options), rank, full, U_, S_, V_);
+  else
+    storeFactors(Eigen::BDCSVD<Dense>(A, options), rank, full, U_, S_, V_);
+}
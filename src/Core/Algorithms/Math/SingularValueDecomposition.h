@@ -0,0 +1,99 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_MATH_SINGULARVALUEDECOMPOSITION_H
+#define CORE_ALGORITHMS_MATH_SINGULARVALUEDECOMPOSITION_H
+
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+  ALGORITHM_PARAMETER_DECL(SVDMethod);
+  ALGORITHM_PARAMETER_DECL(TruncationRank);
+  ALGORITHM_PARAMETER_DECL(Oversampling);
+  ALGORITHM_PARAMETER_DECL(PowerIterations);
+
+  /// Singular value decomposition of dense matrices with selectable backends.
+  ///
+  /// Jacobi:           one-sided Jacobi SVD, accurate but slow for large
+  ///                   matrices.
+  /// DivideAndConquer: bidiagonal divide and conquer SVD, the default.
+  /// Randomized:       randomized range finder followed by the SVD of the
+  ///                   projected matrix; only computes the leading singular
+  ///                   triplets and needs a truncation rank.
+  ///
+  /// A rank of zero requests all singular values and, for the first two
+  /// methods, full square bases. A positive rank returns thin bases with only
+  /// the leading rank singular vectors.
+  class SCISHARE SingularValueDecomposition
+  {
+  public:
+    enum Method { JACOBI, DIVIDE_AND_CONQUER, RANDOMIZED };
+
+    explicit SingularValueDecomposition(Method method = DIVIDE_AND_CONQUER, int rank = 0);
+
+    /// Option string and option name conversion for algorithm parameters
+    static const std::string& methodOptions();
+    static Method methodFromName(const std::string& name);
+
+    void setOversampling(int oversampling) { oversampling_ = oversampling; }
+    void setPowerIterations(int iterations) { powerIterations_ = iterations; }
+
+    /// Decompose the matrix.
+    void compute(const Datatypes::DenseMatrix& matrix);
+
+    /// Decompose the matrix after subtracting the mean of each column. The
+    /// randomized method applies the centering implicitly, the other methods
+    /// form the centered matrix once.
+    void computeCentered(const Datatypes::DenseMatrix& matrix);
+
+    const Datatypes::DenseMatrix& matrixU() const { return U_; }
+    const Datatypes::DenseMatrix& singularValues() const { return S_; }
+    const Datatypes::DenseMatrix& matrixV() const { return V_; }
+
+  private:
+    void run(const Datatypes::DenseMatrix& matrix, const Eigen::VectorXd* columnMeans);
+
+    Method method_;
+    int rank_;
+    int oversampling_;
+    int powerIterations_;
+
+    Datatypes::DenseMatrix U_;
+    Datatypes::DenseMatrix S_;
+    Datatypes::DenseMatrix V_;
+  };
+
+}}}}
+
+#endif
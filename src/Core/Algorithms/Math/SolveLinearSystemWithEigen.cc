@@ -34,6 +34,7 @@
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms::Math;
@@ -78,6 +79,47 @@ namespace
   private:
     SharedPointer<ColumnMatrixType> rhs_;
   };
+
+  // Direct LDL^T solve for symmetric (Hermitian) systems; tolerance_ reports the relative residual.
+  template <class ColumnMatrixType>
+  class SolveLinearSystemAlgorithmEigenLDLTImpl
+  {
+  public:
+    SolveLinearSystemAlgorithmEigenLDLTImpl(SharedPointer<ColumnMatrixType> rhs, double, int) :
+        tolerance_(0), maxIterations_(1), rhs_(rhs) {}
+
+    using SolutionType = ColumnMatrixType;
+
+    template <typename T>
+    typename ColumnMatrixType::EigenBase solveWithEigen(const DenseMatrixGeneric<T>& lhs)
+    {
+      return checked(lhs, lhs.ldlt().solve(*rhs_).eval());
+    }
+
+    template <typename T>
+    typename ColumnMatrixType::EigenBase solveWithEigen(const SparseRowMatrixGeneric<T>& lhs)
+    {
+      Eigen::SimplicialLDLT<Eigen::SparseMatrix<T>> solver(lhs);
+      if (solver.info() != Eigen::Success)
+        BOOST_THROW_EXCEPTION(AlgorithmInputException()
+          << LinearAlgebraErrorMessage("Eigen LDLT factorization was unsuccessful")
+          << EigenComputationInfo(solver.info()));
+      return checked(lhs, solver.solve(*rhs_).eval());
+    }
+
+    double tolerance_;
+    int maxIterations_;
+  private:
+    template <class MatrixType>
+    typename ColumnMatrixType::EigenBase checked(const MatrixType& lhs, const typename ColumnMatrixType::EigenBase& x)
+    {
+      const double norm = rhs_->norm();
+      tolerance_ = norm > 0 ? (lhs * x - *rhs_).norm() / norm : 0;
+      return x;
+    }
+
+    SharedPointer<ColumnMatrixType> rhs_;
+  };
 }
 
 SolveLinearSystemAlgorithm::Outputs SolveLinearSystemAlgorithm::run(const Inputs& input, const Parameters& params) const
@@ -118,11 +160,14 @@ Out SolveLinearSystemAlgorithm::runImpl(const In& input, const Parameters& param
   using SolutionType = DenseColumnMatrixGeneric<typename std::tuple_element<0, In>::type::element_type::value_type>;
   using AlgoTypeCG = SolveLinearSystemAlgorithmEigenCGImpl<SolutionType, CG>;
   using AlgoTypeBiCG = SolveLinearSystemAlgorithmEigenCGImpl<SolutionType, BiCG>;
+  using AlgoTypeLDLT = SolveLinearSystemAlgorithmEigenLDLTImpl<SolutionType>;
 
   if ("cg" == method)
     return solve<AlgoTypeCG, In, Out>(input, params);
   else if ("bicg" == method)
     return solve<AlgoTypeBiCG, In, Out>(input, params);
+  else if ("ldlt" == method)
+    return solve<AlgoTypeLDLT, In, Out>(input, params);
   else
   {
     BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Need to upgrade Eigen for LSCG."));
@@ -350,3 +350,32 @@ TEST (AddKnownsToLinearSystemTests, X_is_NaN)
   for (int r=0; r < ro->rows(); r++)
     EXPECT_EQ((*output_rhs)[r],(*ro)(r,0));
 }
+
+// a new RHS with the same LHS and knowns reuses the modified LHS, so the solver downstream sees an unchanged matrix
+TEST (AddKnownsToLinearSystemTests, New_RHS_Reuses_Output_LHS)
+{
+  AddKnownsToLinearSystemAlgo algo;
+  auto lhs = LHS();
+  auto x = x_one_nan();
+
+  AlgorithmInput input;
+  input[AddKnownsToLinearSystemAlgo::LHS_Matrix] = lhs;
+  input[AddKnownsToLinearSystemAlgo::RHS_Vector] = rhs_zero(3);
+  input[AddKnownsToLinearSystemAlgo::X_Vector] = x;
+  auto first = algo.run(input);
+
+  input[AddKnownsToLinearSystemAlgo::RHS_Vector] = rhs();
+  auto second = algo.run(input);
+  EXPECT_EQ(first.get<SparseRowMatrix>(AddKnownsToLinearSystemAlgo::OutPutLHSMatrix), second.get<SparseRowMatrix>(AddKnownsToLinearSystemAlgo::OutPutLHSMatrix));
+
+  SparseRowMatrixHandle output_stiff;
+  DenseColumnMatrixHandle output_rhs;
+  algo.run(lhs, rhs(), x, output_stiff, output_rhs);
+  auto cachedRhs = second.get<DenseColumnMatrix>(AddKnownsToLinearSystemAlgo::OutPutRHSVector);
+  for (int r = 0; r < output_rhs->nrows(); r++)
+    EXPECT_EQ((*output_rhs)[r], (*cachedRhs)[r]);
+
+  input[AddKnownsToLinearSystemAlgo::X_Vector] = x_two_nan();
+  auto third = algo.run(input);
+  EXPECT_NE(first.get<SparseRowMatrix>(AddKnownsToLinearSystemAlgo::OutPutLHSMatrix), third.get<SparseRowMatrix>(AddKnownsToLinearSystemAlgo::OutPutLHSMatrix));
+}
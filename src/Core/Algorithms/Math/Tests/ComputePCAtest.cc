@@ -159,4 +159,30 @@ TEST(ComputePCAtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m2,LeftPrinMat_U,PrinVals_S,RightPrinMat_V));
     EXPECT_ANY_THROW(algo.run(m3,LeftPrinMat_U,PrinVals_S,RightPrinMat_V));
 
-}
\ No newline at end of file
+}
+
+//The randomized backend centers the data implicitly and finds the leading principal component.
+TEST(ComputePCAtest, RandomizedLeadingComponentMatchesFullPCA)
+{
+    ComputePCAAlgo algo;
+    
+    DenseMatrixHandle m1(inputMatrix());
+    DenseMatrixHandle U, S, V;
+    algo.run(m1,U,S,V);
+    
+    algo.setOption(Parameters::SVDMethod, "Randomized");
+    algo.set(Parameters::TruncationRank, 1);
+    DenseMatrixHandle Ur, Sr, Vr;
+    algo.run(m1,Ur,Sr,Vr);
+    
+    ASSERT_EQ(12,Ur->rows());
+    ASSERT_EQ(1,Ur->cols());
+    ASSERT_EQ(1,Sr->rows());
+    ASSERT_EQ(2,Vr->rows());
+    ASSERT_EQ(1,Vr->cols());
+    
+    EXPECT_NEAR((*S)(0,0), (*Sr)(0,0), 1e-8);
+    //Singular vectors are unique up to sign.
+    EXPECT_NEAR(1.0, std::abs(V->col(0).dot(Vr->col(0))), 1e-8);
+    EXPECT_NEAR(1.0, std::abs(U->col(0).dot(Ur->col(0))), 1e-8);
+}
@@ -123,4 +123,75 @@ TEST(ComputeSVDtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m2,LeftSingularMatrix_U,SingularValues_S,RightSingularMatrix_V));
     EXPECT_ANY_THROW(algo.run(m3,LeftSingularMatrix_U,SingularValues_S,RightSingularMatrix_V));
     
-}
\ No newline at end of file
+}
+
+namespace
+{
+    //Matrix of known rank built from orthonormal factors with decaying singular values.
+    DenseMatrixHandle lowRankMatrix(int rows, int cols, int rank)
+    {
+        Eigen::MatrixXd left = Eigen::MatrixXd::Random(rows, rank).householderQr().householderQ() * Eigen::MatrixXd::Identity(rows, rank);
+        Eigen::MatrixXd right = Eigen::MatrixXd::Random(cols, rank).householderQr().householderQ() * Eigen::MatrixXd::Identity(cols, rank);
+        Eigen::VectorXd values(rank);
+        for (int i = 0; i < rank; ++i)
+            values(i) = 10.0 / (i + 1);
+        return boost::make_shared<DenseMatrix>(left * values.asDiagonal() * right.transpose());
+    }
+}
+
+//The divide and conquer and Jacobi backends give the same singular values.
+TEST(ComputeSVDtest, JacobiAndDivideAndConquerAgree)
+{
+    auto m1 = lowRankMatrix(40, 25, 25);
+
+    ComputeSVDAlgo algo;
+    DenseMatrixHandle U1, S1, V1, U2, S2, V2;
+
+    algo.setOption(Parameters::SVDMethod, "Jacobi");
+    algo.run(m1, U1, S1, V1);
+    algo.setOption(Parameters::SVDMethod, "DivideAndConquer");
+    algo.run(m1, U2, S2, V2);
+
+    ASSERT_EQ(40, U2->rows());
+    ASSERT_EQ(40, U2->cols());
+    ASSERT_EQ(25, V2->cols());
+    for (int i = 0; i < 25; ++i)
+        EXPECT_NEAR((*S1)(i,0), (*S2)(i,0), 1e-10);
+}
+
+//A positive truncation rank returns thin factors with the leading singular triplets.
+TEST(ComputeSVDtest, TruncatedAndRandomizedReturnLeadingTriplets)
+{
+    auto m1 = lowRankMatrix(200, 60, 8);
+
+    ComputeSVDAlgo algo;
+    algo.set(Parameters::TruncationRank, 8);
+
+    for (const auto& method : { "DivideAndConquer", "Randomized" })
+    {
+        algo.setOption(Parameters::SVDMethod, method);
+        DenseMatrixHandle U, S, V;
+        algo.run(m1, U, S, V);
+
+        ASSERT_EQ(200, U->rows());
+        ASSERT_EQ(8, U->cols());
+        ASSERT_EQ(8, S->rows());
+        ASSERT_EQ(60, V->rows());
+        ASSERT_EQ(8, V->cols());
+
+        for (int i = 0; i < 8; ++i)
+            EXPECT_NEAR(10.0 / (i + 1), (*S)(i,0), 1e-8) << method;
+
+        DenseMatrix product = (*U) * S->col(0).asDiagonal() * V->transpose();
+        EXPECT_NEAR(0.0, (product - *m1).norm(), 1e-8) << method;
+    }
+}
+
+TEST(ComputeSVDtest, RandomizedRequiresRank)
+{
+    ComputeSVDAlgo algo;
+    algo.setOption(Parameters::SVDMethod, "Randomized");
+
+    DenseMatrixHandle U, S, V;
+    EXPECT_ANY_THROW(algo.run(inputMatrix(), U, S, V));
+}
@@ -0,0 +1,255 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Core/Algorithms/Math/LinearSystem/LinearSystemSession.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <Core/Logging/LoggerInterface.h>
+#include <Eigen/SparseCholesky>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::TestUtils;
+using namespace SCIRun;
+
+namespace
+{
+  // 7-point Laplacian on an n^3 grid with Dirichlet boundary, plus a small shift
+  SparseRowMatrixHandle laplacian3D(int n)
+  {
+    const int size = n*n*n;
+    std::vector<Eigen::Triplet<double>> entries;
+    auto index = [n](int i, int j, int k) { return (k*n + j)*n + i; };
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+        {
+          const int row = index(i, j, k);
+          entries.emplace_back(row, row, 6.01);
+          if (i > 0) entries.emplace_back(row, index(i-1, j, k), -1);
+          if (i < n-1) entries.emplace_back(row, index(i+1, j, k), -1);
+          if (j > 0) entries.emplace_back(row, index(i, j-1, k), -1);
+          if (j < n-1) entries.emplace_back(row, index(i, j+1, k), -1);
+          if (k > 0) entries.emplace_back(row, index(i, j, k-1), -1);
+          if (k < n-1) entries.emplace_back(row, index(i, j, k+1), -1);
+        }
+    auto A = boost::make_shared<SparseRowMatrix>(size, size);
+    A->setFromTriplets(entries.begin(), entries.end());
+    A->makeCompressed();
+    return A;
+  }
+
+  // Right-hand side of a montage: unit current injected at node "anode", removed at "cathode"
+  DenseColumnMatrixHandle electrodePair(int size, int anode, int cathode, double current)
+  {
+    auto b = boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Zero(size));
+    (*b)(anode) = current;
+    (*b)(cathode) = -current;
+    return b;
+  }
+
+  // Keeps the iteration counts the iterative solvers report, to see what an initial guess saved.
+  class IterationRecorder : public Core::Logging::LegacyLoggerInterface
+  {
+  public:
+    virtual void error(const std::string&) const override {}
+    virtual bool errorReported() const override { return false; }
+    virtual void setErrorFlag(bool) override {}
+    virtual void warning(const std::string&) const override {}
+    virtual void status(const std::string&) const override {}
+    virtual void remark(const std::string& msg) const override
+    {
+      const std::string prefix = " after ";
+      const auto pos = msg.find(prefix);
+      if (pos != std::string::npos)
+        iterations.push_back(std::stoi(msg.substr(pos + prefix.size())));
+    }
+    mutable std::vector<int> iterations;
+  };
+
+  double relativeResidual(const SparseRowMatrix& A, const DenseColumnMatrix& x, const DenseColumnMatrix& b)
+  {
+    DenseColumnMatrix r = b - A * x;
+    return r.norm() / b.norm();
+  }
+}
+
+TEST(LinearSystemSessionTests, InitialGuessIsZeroForEmptySession)
+{
+  auto A = laplacian3D(4);
+  LinearSystemSession session(A);
+  auto b = electrodePair(A->nrows(), 0, 10, 1.0);
+  auto x0 = session.initialGuess(*b);
+  EXPECT_EQ(0, session.basisSize());
+  EXPECT_EQ(0, x0->norm());
+}
+
+TEST(LinearSystemSessionTests, RecoversSolutionsInSpanOfEarlierOnes)
+{
+  auto A = laplacian3D(6);
+  const int size = A->nrows();
+  LinearSystemSession session(A);
+
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct(*A);
+  auto b1 = electrodePair(size, 3, 200, 1.0);
+  auto b2 = electrodePair(size, 50, 120, 2.0);
+  DenseColumnMatrix x1 = direct.solve(*b1);
+  DenseColumnMatrix x2 = direct.solve(*b2);
+  EXPECT_TRUE(session.addSolution(x1));
+  EXPECT_TRUE(session.addSolution(x2));
+  EXPECT_FALSE(session.addSolution(3 * x1 - x2));
+  EXPECT_EQ(2, session.basisSize());
+
+  DenseColumnMatrix b = 0.5 * *b1 + 4 * *b2;
+  auto x0 = session.initialGuess(b);
+  EXPECT_LT(relativeResidual(*A, *x0, b), 1e-10);
+}
+
+TEST(LinearSystemSessionTests, DropsOldestSolutionWhenFull)
+{
+  auto A = laplacian3D(4);
+  LinearSystemSession session(A, 2);
+  const int size = A->nrows();
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct(*A);
+  for (int i = 0; i < 4; ++i)
+  {
+    DenseColumnMatrix x = direct.solve(*electrodePair(size, i, size - 1 - i, 1.0));
+    session.addSolution(x);
+  }
+  EXPECT_EQ(2, session.basisSize());
+  EXPECT_TRUE(session.matches(A));
+  EXPECT_FALSE(session.matches(laplacian3D(4)));
+}
+
+TEST(LinearSystemSessionTests, MontageSweepReusesEarlierSolves)
+{
+  auto A = laplacian3D(20);
+  const int size = A->nrows();
+  const int numElectrodes = 6;
+  std::vector<int> electrodeNodes;
+  for (int e = 0; e < numElectrodes; ++e)
+    electrodeNodes.push_back((e * 1297 + 31) % size);
+
+  // every montage is a combination of currents from the same electrodes, so after the first few
+  // solves each new right-hand side lies in the span of the earlier ones
+  auto montage = [&](int m)
+  {
+    auto b = boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Zero(size));
+    for (int e = 0; e < numElectrodes - 1; ++e)
+    {
+      const double current = std::sin(1.0 + m * (e + 1));
+      (*b)(electrodeNodes[e]) += current;
+      (*b)(electrodeNodes[numElectrodes - 1]) -= current;
+    }
+    return b;
+  };
+
+  auto configure = [](SolveLinearSystemAlgo& algo, boost::shared_ptr<IterationRecorder> recorder)
+  {
+    algo.set(Variables::MaxIterations, 5000);
+    algo.set(Variables::TargetError, 1e-10);
+    algo.setOption(Variables::Method, "cg");
+    algo.setOption(Variables::Preconditioner, "Jacobi");
+    algo.setLogger(recorder);
+  };
+
+  const int numMontages = 12;
+  auto withSession = boost::make_shared<IterationRecorder>();
+  SolveLinearSystemAlgo algo;
+  configure(algo, withSession);
+  std::vector<DenseMatrixHandle> sweep;
+  {
+    ScopedTimer t("montage sweep with session");
+    for (int m = 0; m < numMontages; ++m)
+    {
+      AlgorithmInput input;
+      input[Variables::LHS] = A;
+      input[Variables::RHS] = montage(m);
+      sweep.push_back(algo.run(input).get<DenseMatrix>(Variables::Solution));
+    }
+  }
+  ASSERT_EQ(numMontages, withSession->iterations.size());
+
+  LinearSystemSession session(A);
+  for (int m = 0; m < numElectrodes - 1; ++m)
+  {
+    DenseColumnMatrix x = sweep[m]->col(0);
+    session.addSolution(x);
+  }
+  for (int m = numElectrodes - 1; m < numMontages; ++m)
+  {
+    auto b = montage(m);
+    EXPECT_LT(relativeResidual(*A, *session.initialGuess(*b), *b), 1e-6);
+  }
+
+  auto withoutSession = boost::make_shared<IterationRecorder>();
+  {
+    ScopedTimer t("montage sweep without session");
+    for (int m = 0; m < numMontages; ++m)
+    {
+      SolveLinearSystemAlgo fresh;
+      configure(fresh, withoutSession);
+      AlgorithmInput input;
+      input[Variables::LHS] = A;
+      input[Variables::RHS] = montage(m);
+      auto x = fresh.run(input).get<DenseMatrix>(Variables::Solution);
+      DenseColumnMatrix diff = x->col(0) - sweep[m]->col(0);
+      EXPECT_LT(diff.norm() / x->norm(), 1e-6);
+    }
+  }
+  ASSERT_EQ(numMontages, withoutSession->iterations.size());
+
+  // The first solve starts from zero either way; once the electrodes are spanned, the
+  // session starts close to the solution and CG only has to close the remaining gap.
+  EXPECT_EQ(withoutSession->iterations[0], withSession->iterations[0]);
+  int reused = 0, fresh = 0;
+  for (int m = numElectrodes - 1; m < numMontages; ++m)
+  {
+    EXPECT_LT(withSession->iterations[m], withoutSession->iterations[m]) << m;
+    reused += withSession->iterations[m];
+    fresh += withoutSession->iterations[m];
+  }
+  EXPECT_LT(2 * reused, fresh);
+}
+
+TEST(LinearSystemSessionTests, MatrixEditedInPlaceNoLongerMatches)
+{
+  auto A = laplacian3D(4);
+  LinearSystemSession session(A);
+  EXPECT_TRUE(session.matches(A));
+
+  A->coeffRef(5, 5) += 1.0;
+  EXPECT_FALSE(session.matches(A));
+}
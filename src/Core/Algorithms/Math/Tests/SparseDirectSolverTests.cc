@@ -0,0 +1,221 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Core/Algorithms/Math/LinearSystem/SparseDirectSolver.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
+#include <Core/Algorithms/Math/SolveLinearSystemWithEigen.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::TestUtils;
+using namespace SCIRun;
+
+namespace
+{
+  // 7-point Laplacian on an n^3 grid scaled by conductivity, plus a small shift
+  SparseRowMatrixHandle laplacian3D(int n, double conductivity = 1)
+  {
+    const int size = n*n*n;
+    std::vector<Eigen::Triplet<double>> entries;
+    auto index = [n](int i, int j, int k) { return (k*n + j)*n + i; };
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+        {
+          const int row = index(i, j, k);
+          entries.emplace_back(row, row, 6.01 * conductivity);
+          if (i > 0) entries.emplace_back(row, index(i-1, j, k), -conductivity);
+          if (i < n-1) entries.emplace_back(row, index(i+1, j, k), -conductivity);
+          if (j > 0) entries.emplace_back(row, index(i, j-1, k), -conductivity);
+          if (j < n-1) entries.emplace_back(row, index(i, j+1, k), -conductivity);
+          if (k > 0) entries.emplace_back(row, index(i, j, k-1), -conductivity);
+          if (k < n-1) entries.emplace_back(row, index(i, j, k+1), -conductivity);
+        }
+    auto A = boost::make_shared<SparseRowMatrix>(size, size);
+    A->setFromTriplets(entries.begin(), entries.end());
+    A->makeCompressed();
+    return A;
+  }
+
+  DenseColumnMatrixHandle unitSource(int size, int node)
+  {
+    auto b = boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Zero(size));
+    (*b)(node) = 1;
+    return b;
+  }
+
+  double relativeResidual(const SparseRowMatrix& A, const DenseColumnMatrix& x, const DenseColumnMatrix& b)
+  {
+    DenseColumnMatrix r = b - A * x;
+    return r.norm() / b.norm();
+  }
+}
+
+TEST(SparseDirectSolverTests, ReusesFactorForSameMatrix)
+{
+  auto A = laplacian3D(10);
+  SparseDirectSolver solver;
+  for (int node = 0; node < 5; ++node)
+  {
+    auto b = unitSource(A->nrows(), node * 97);
+    auto x = solver.solve(*A, *b);
+    EXPECT_LT(relativeResidual(*A, *x, *b), 1e-12);
+  }
+  EXPECT_EQ(1, solver.symbolicAnalyses());
+  EXPECT_EQ(1, solver.numericFactorizations());
+}
+
+TEST(SparseDirectSolverTests, ReusesAnalysisForSamePattern)
+{
+  SparseDirectSolver solver;
+  auto b = unitSource(512, 100);
+  auto A1 = laplacian3D(8);
+  auto A2 = laplacian3D(8, 3.0);
+  auto x1 = solver.solve(*A1, *b);
+  auto x2 = solver.solve(*A2, *b);
+  EXPECT_LT(relativeResidual(*A2, *x2, *b), 1e-12);
+  EXPECT_NEAR(x1->norm(), 3 * x2->norm(), 1e-10);
+  EXPECT_EQ(1, solver.symbolicAnalyses());
+  EXPECT_EQ(2, solver.numericFactorizations());
+
+  auto A3 = laplacian3D(9);
+  auto b3 = unitSource(729, 5);
+  auto x3 = solver.solve(*A3, *b3);
+  EXPECT_LT(relativeResidual(*A3, *x3, *b3), 1e-12);
+  EXPECT_EQ(2, solver.symbolicAnalyses());
+}
+
+TEST(SparseDirectSolverTests, ThrowsOnMismatchedSizes)
+{
+  SparseDirectSolver solver;
+  EXPECT_THROW(solver.solve(*laplacian3D(4), *unitSource(10, 0)), AlgorithmProcessingException);
+}
+
+TEST(SparseDirectSolverTests, SolveLinearSystemAlgoDirectMethodMatchesCG)
+{
+  auto A = laplacian3D(16);
+  SolveLinearSystemAlgo direct;
+  direct.setOption(Variables::Method, "ldlt");
+  SolveLinearSystemAlgo cg;
+  cg.set(Variables::TargetError, 1e-12);
+  cg.set(Variables::MaxIterations, 5000);
+
+  for (int node = 0; node < 3; ++node)
+  {
+    auto b = unitSource(A->nrows(), 1000 + node * 500);
+    DenseColumnMatrixHandle x, xcg;
+    {
+      ScopedTimer t("ldlt solve");
+      ASSERT_TRUE(direct.run(A, b, DenseColumnMatrixHandle(), x));
+    }
+    {
+      ScopedTimer t("cg solve");
+      ASSERT_TRUE(cg.run(A, b, DenseColumnMatrixHandle(), xcg));
+    }
+    DenseColumnMatrix diff = *x - *xcg;
+    EXPECT_LT(diff.norm() / x->norm(), 1e-8);
+  }
+}
+
+TEST(SparseDirectSolverTests, EigenAlgorithmLDLTMethod)
+{
+  auto A = laplacian3D(6);
+  auto b = unitSource(A->nrows(), 17);
+  SolveLinearSystemAlgorithm algo;
+  auto output = algo.run(SolveLinearSystemAlgorithm::Inputs(A, b), SolveLinearSystemAlgorithm::Parameters(1e-10, 10, "ldlt"));
+  auto x = std::get<0>(output);
+  ASSERT_TRUE(x != nullptr);
+  EXPECT_LT(relativeResidual(*A, *x, *b), 1e-12);
+  EXPECT_LT(std::get<1>(output), 1e-12);
+
+  DenseMatrixHandle dense(boost::make_shared<DenseMatrix>(A->toDense()));
+  auto denseOutput = algo.run(SolveLinearSystemAlgorithm::Inputs(dense, b), SolveLinearSystemAlgorithm::Parameters(1e-10, 10, "ldlt"));
+  DenseColumnMatrix diff = *std::get<0>(denseOutput) - *x;
+  EXPECT_LT(diff.norm(), 1e-10);
+}
+
+TEST(SparseDirectSolverTests, RefactorizesWhenValuesChangeUnderTheSameId)
+{
+  SparseDirectSolver solver;
+  auto A = laplacian3D(6);
+  auto b = unitSource(A->nrows(), 40);
+  auto x1 = solver.solve(*A, *b);
+
+  const auto id = A->id();
+  *A = *laplacian3D(6, 2.0);
+  ASSERT_EQ(id, A->id());
+  auto x2 = solver.solve(*A, *b);
+  EXPECT_LT(relativeResidual(*A, *x2, *b), 1e-12);
+  EXPECT_NEAR(x1->norm(), 2 * x2->norm(), 1e-10);
+
+  A->valuePtr()[0] += 1;
+  auto x3 = solver.solve(*A, *b);
+  EXPECT_LT(relativeResidual(*A, *x3, *b), 1e-12);
+  EXPECT_EQ(3, solver.numericFactorizations());
+  EXPECT_EQ(1, solver.symbolicAnalyses());
+}
+
+TEST(SparseDirectSolverTests, ThrowsOnNonsymmetricMatrix)
+{
+  auto A = laplacian3D(4);
+  A->coeffRef(0, 1) = -2;
+  SparseDirectSolver solver;
+  EXPECT_THROW(solver.solve(*A, *unitSource(A->nrows(), 0)), AlgorithmProcessingException);
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, "ldlt");
+  DenseColumnMatrixHandle x;
+  EXPECT_THROW(algo.run(A, unitSource(A->nrows(), 0), DenseColumnMatrixHandle(), x), AlgorithmProcessingException);
+}
+
+TEST(SparseDirectSolverTests, ThrowsOnSingularMatrix)
+{
+  // pure Neumann Laplacian: every row sums to zero
+  const int n = 5;
+  std::vector<Eigen::Triplet<double>> entries;
+  for (int i = 0; i < n; ++i)
+  {
+    entries.emplace_back(i, i, (i == 0 || i == n - 1) ? 1 : 2);
+    if (i > 0) entries.emplace_back(i, i - 1, -1);
+    if (i < n - 1) entries.emplace_back(i, i + 1, -1);
+  }
+  SparseRowMatrix A(n, n);
+  A.setFromTriplets(entries.begin(), entries.end());
+  A.makeCompressed();
+
+  SparseDirectSolver solver;
+  EXPECT_THROW(solver.solve(A, *unitSource(n, 0)), AlgorithmProcessingException);
+}
@@ -0,0 +1,169 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+///
+///@file   CopyOnWriteVector.h
+///@brief  Reference counted std::vector that is copied on the first write.
+///
+
+/// Copying a CopyOnWriteVector only copies a reference to the underlying
+/// std::vector. The elements are copied the first time one of the copies is
+/// modified. Reading is done through the const interface, which never
+/// copies; all modifications go through writable() or one of the modifying
+/// members, which make the storage private to this object first.
+///
+/// The first modification of a shared vector replaces the storage of this
+/// object, hence it should not run concurrently with other accesses to the
+/// same object. Once the storage is private, concurrent reads and writes to
+/// different elements are as safe as they are for a std::vector.
+
+#ifndef CORE_CONTAINERS_COPYONWRITEVECTOR_H
+#define CORE_CONTAINERS_COPYONWRITEVECTOR_H 1
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <Core/Persistent/PersistentSTL.h>
+#include <vector>
+
+namespace SCIRun {
+
+template <class T>
+class CopyOnWriteVector
+{
+public:
+  typedef std::vector<T>                              vector_type;
+  typedef typename vector_type::value_type            value_type;
+  typedef typename vector_type::size_type             size_type;
+  typedef typename vector_type::const_reference       const_reference;
+  typedef typename vector_type::const_iterator        const_iterator;
+  typedef typename vector_type::const_reverse_iterator const_reverse_iterator;
+
+  CopyOnWriteVector() : data_(boost::make_shared<vector_type>()) {}
+  explicit CopyOnWriteVector(size_type size, const T& val = T()) :
+    data_(boost::make_shared<vector_type>(size, val)) {}
+  CopyOnWriteVector(const vector_type& data) :
+    data_(boost::make_shared<vector_type>(data)) {}
+
+  /// Assigning a std::vector gives this object its own storage
+  CopyOnWriteVector& operator=(const vector_type& data)
+  {
+    data_ = boost::make_shared<vector_type>(data);
+    return (*this);
+  }
+
+  //--------------------------------------------------------------------------
+  // Read access, this never copies the data
+
+  const vector_type& get() const { return (*data_); }
+
+  const_reference operator[](size_type idx) const { return ((*data_)[idx]); }
+  const_reference at(size_type idx) const { return (data_->at(idx)); }
+  const_reference front() const { return (data_->front()); }
+  const_reference back() const { return (data_->back()); }
+  const T* data() const { return (data_->data()); }
+
+  const_iterator begin() const { return (data_->begin()); }
+  const_iterator end() const { return (data_->end()); }
+  const_reverse_iterator rbegin() const { return (data_->rbegin()); }
+  const_reverse_iterator rend() const { return (data_->rend()); }
+
+  size_type size() const { return (data_->size()); }
+  size_type capacity() const { return (data_->capacity()); }
+  bool empty() const { return (data_->empty()); }
+
+  /// Whether the storage is currently shared with another copy
+  bool shared() const { return (!data_.unique()); }
+  /// Whether both objects refer to the same storage
+  bool shares_data_with(const CopyOnWriteVector& other) const
+    { return (data_ == other.data_); }
+
+  //--------------------------------------------------------------------------
+  // Write access, these make a private copy of the data if it is shared
+
+  vector_type& writable()
+  {
+    if (!data_.unique()) data_ = boost::make_shared<vector_type>(*data_);
+    return (*data_);
+  }
+
+  void set(size_type idx, const T& val) { writable()[idx] = val; }
+
+  void push_back(const T& val) { writable().push_back(val); }
+  void pop_back() { writable().pop_back(); }
+  void resize(size_type size) { writable().resize(size); }
+  void resize(size_type size, const T& val) { writable().resize(size, val); }
+  void reserve(size_type size) { writable().reserve(size); }
+  void shrink_to_fit() { writable().shrink_to_fit(); }
+
+  /// Iterators may point into the shared storage, hence positions are
+  /// converted to offsets before the storage is made private
+  const_iterator erase(const_iterator pos)
+  {
+    const size_type offset = pos - data_->begin();
+    vector_type& data = writable();
+    return (data.erase(data.begin() + offset));
+  }
+
+  const_iterator erase(const_iterator first, const_iterator last)
+  {
+    const size_type offset = first - data_->begin();
+    const size_type count = last - first;
+    vector_type& data = writable();
+    return (data.erase(data.begin() + offset, data.begin() + offset + count));
+  }
+
+  /// Clearing a shared vector just drops the reference
+  void clear()
+  {
+    if (!data_.unique()) data_ = boost::make_shared<vector_type>();
+    else data_->clear();
+  }
+
+  void swap(CopyOnWriteVector& other) { data_.swap(other.data_); }
+  void swap(vector_type& other) { writable().swap(other); }
+
+private:
+  boost::shared_ptr<vector_type> data_;
+};
+
+template<class T>
+void Pio(Piostream& stream, CopyOnWriteVector<T>& data)
+{
+  if (stream.reading()) Pio(stream, data.writable());
+  else Pio(stream, const_cast<std::vector<T>&>(data.get()));
+}
+
+inline void Pio_index(Piostream& stream, CopyOnWriteVector<index_type>& data)
+{
+  if (stream.reading()) Pio_index(stream, data.writable());
+  else Pio_index(stream, const_cast<std::vector<index_type>&>(data.get()));
+}
+
+} // End namespace SCIRun
+
+#endif
@@ -0,0 +1,104 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <Core/Containers/CopyOnWriteVector.h>
+
+using namespace SCIRun;
+
+TEST(CopyOnWriteVectorTest, CopySharesStorageUntilWritten)
+{
+  CopyOnWriteVector<double> a(3, 1.0);
+  CopyOnWriteVector<double> b(a);
+
+  EXPECT_TRUE(a.shares_data_with(b));
+  EXPECT_TRUE(a.shared());
+  EXPECT_EQ(a.data(), b.data());
+
+  b.set(1, 5.0);
+
+  EXPECT_FALSE(a.shares_data_with(b));
+  EXPECT_FALSE(a.shared());
+  EXPECT_EQ(1.0, a[1]);
+  EXPECT_EQ(5.0, b[1]);
+  EXPECT_EQ(3, a.size());
+  EXPECT_EQ(3, b.size());
+}
+
+TEST(CopyOnWriteVectorTest, WritingUnsharedStorageDoesNotCopy)
+{
+  CopyOnWriteVector<int> a(4, 2);
+  const int* before = a.data();
+  a.writable()[0] = 7;
+  a.set(3, 9);
+  EXPECT_EQ(before, a.data());
+  EXPECT_EQ(7, a[0]);
+  EXPECT_EQ(9, a.back());
+}
+
+TEST(CopyOnWriteVectorTest, ResizeAndPushBackDetach)
+{
+  CopyOnWriteVector<int> a;
+  a.push_back(1);
+  a.push_back(2);
+
+  CopyOnWriteVector<int> b(a);
+  b.push_back(3);
+  EXPECT_EQ(2, a.size());
+  EXPECT_EQ(3, b.size());
+
+  CopyOnWriteVector<int> c(a);
+  c.resize(5, 4);
+  EXPECT_EQ(2, a.size());
+  EXPECT_EQ(5, c.size());
+  EXPECT_EQ(4, c[4]);
+}
+
+TEST(CopyOnWriteVectorTest, EraseOnSharedStorageUsesOwnCopy)
+{
+  std::vector<int> values = { 0, 1, 2, 3, 4 };
+  CopyOnWriteVector<int> a(values);
+  CopyOnWriteVector<int> b(a);
+
+  b.erase(b.begin() + 1, b.begin() + 3);
+  ASSERT_EQ(3, b.size());
+  EXPECT_EQ(0, b[0]);
+  EXPECT_EQ(3, b[1]);
+  EXPECT_EQ(values, a.get());
+}
+
+TEST(CopyOnWriteVectorTest, ClearDropsSharedReference)
+{
+  CopyOnWriteVector<int> a(10, 1);
+  CopyOnWriteVector<int> b(a);
+  b.clear();
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(10, a.size());
+  EXPECT_FALSE(a.shared());
+}
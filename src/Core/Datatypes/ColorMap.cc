@@ -30,11 +30,13 @@
 #include <Core/Math/MiscMath.h>
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/Logging/Log.h>
+#include <Core/Utils/Exception.h>
 #include <iostream>
 #include <boost/functional/factory.hpp>
 #include <boost/function.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
+#include <Eigen/Core>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -47,7 +49,7 @@ ColorMap::ColorMap(ColorMapStrategyHandle color, const std::string& name, const
   invert_(invert), rescale_scale_(rescale_scale), rescale_shift_(rescale_shift),
   alphaLookup_(alphaPoints)
 {
-
+  buildLookupTable();
 }
 
 ColorMap* ColorMap::clone() const
@@ -255,19 +257,29 @@ StandardColorMapFactory::NameList StandardColorMapFactory::getList()
  * @return The scalar double value transformed into ColorMap space from raw data.
  */
 double ColorMap::getTransformedValue(double f) const
+{
+  return getTransformedValueFromIndex(getLookupIndex(f));
+}
+
+// Rescales, clamps and inverts the value, then applies the resolution. The
+// transformed value only depends on the resulting index in [0, resolution_].
+size_t ColorMap::getLookupIndex(double f) const
 {
   const double rescaled01 = static_cast<double>((f + rescale_shift_) * rescale_scale_);
 
   double v = std::min(std::max(0., rescaled01), 1.);
-  double shift = shift_;
-  if (invert_) {
+  if (invert_)
     v = 1.f - v;
+  return static_cast<size_t>(static_cast<int>(v * static_cast<double>(resolution_)));
+}
+
+double ColorMap::getTransformedValueFromIndex(size_t index) const
+{
+  double shift = shift_;
+  if (invert_)
     shift *= -1.;
-  }
   //apply the resolution
-  v = static_cast<double>((static_cast<int>(v *
-    static_cast<double>(resolution_)))) /
-    static_cast<double>(resolution_ - 1);
+  double v = static_cast<double>(index) / static_cast<double>(resolution_ - 1);
   // the shift is a gamma.
   double denom = std::tan(M_PI_2 * (0.5 - std::min(std::max(shift, -0.99), 0.99) * 0.5));
   // make sure we don't hit divide by zero
@@ -276,6 +288,25 @@ double ColorMap::getTransformedValue(double f) const
   v = std::pow(v, (1. / denom));
   return std::min(std::max(0.,v),1.);
 }
+
+void ColorMap::buildLookupTable()
+{
+  colorLookup_.clear();
+  if (!color_)
+    return;
+
+  colorLookup_.reserve(4 * (resolution_ + 1));
+  for (size_t i = 0; i <= resolution_; ++i)
+  {
+    const double f = getTransformedValueFromIndex(i);
+    const auto color = applyAlpha(f, color_->getColorMapVal(f));
+    colorLookup_.push_back(static_cast<float>(color.r()));
+    colorLookup_.push_back(static_cast<float>(color.g()));
+    colorLookup_.push_back(static_cast<float>(color.b()));
+    colorLookup_.push_back(static_cast<float>(color.a()));
+  }
+}
+
 /**
  * @name getColorMapVal
  * @brief This method returns the RGB value for the current colormap parameters.
@@ -288,6 +319,8 @@ double ColorMap::getTransformedValue(double f) const
  */
 ColorRGB ColorMap::getColorMapVal(double v) const
 {
+  if (!color_)
+    THROW_INVALID_ARGUMENT("ColorMap has no color scheme: " + nameInfo_);
   double f = getTransformedValue(v);
   auto colorWithoutAlpha = color_->getColorMapVal(f);
   return applyAlpha(f, colorWithoutAlpha);
@@ -341,6 +374,54 @@ ColorRGB ColorMap::valueToColor(double scalar) const
   return getColorMapVal(scalar);
 }
 
+/**
+ * @name valueToColor
+ * @brief Maps an array of scalars to RGBA. The rescale, clamp, invert and
+ *        resolution steps run vectorized on blocks of the input; the colors
+ *        then come from the precomputed table.
+ * @param in The raw data values.
+ * @param n Number of values.
+ * @param rgbaOut Output array of 4*n floats.
+ */
+void ColorMap::valueToColor(const double* in, size_t n, float* rgbaOut) const
+{
+  // No lookup table without a color scheme; take the scalar path so the error is the same.
+  if (colorLookup_.empty())
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const auto color = getColorMapVal(in[i]);
+      rgbaOut[4 * i + 0] = static_cast<float>(color.r());
+      rgbaOut[4 * i + 1] = static_cast<float>(color.g());
+      rgbaOut[4 * i + 2] = static_cast<float>(color.b());
+      rgbaOut[4 * i + 3] = static_cast<float>(color.a());
+    }
+    return;
+  }
+
+  const size_t blockSize = 1024;
+  Eigen::ArrayXd v(blockSize);
+  Eigen::ArrayXi index(blockSize);
+
+  for (size_t start = 0; start < n; start += blockSize)
+  {
+    const auto count = static_cast<Eigen::Index>(std::min(blockSize, n - start));
+    auto values = Eigen::Map<const Eigen::ArrayXd>(in + start, count);
+    auto block = v.head(count);
+
+    block = (values + rescale_shift_) * rescale_scale_;
+    // NaN compares false and maps to 0, like std::max(0., NaN) in the scalar version.
+    block = (block == block).select(block, 0.).max(0.).min(1.);
+    if (invert_)
+      block = 1. - block;
+    index.head(count) = (block * static_cast<double>(resolution_)).cast<int>();
+
+    float* out = rgbaOut + 4 * start;
+    for (Eigen::Index i = 0; i < count; ++i, out += 4)
+      std::copy_n(&colorLookup_[4 * index[i]], 4, out);
+  }
+}
+
 /**
  * @name valueToColor
  * @brief Takes a tensor value and creates an RGB value based on the magnitude of the eigenvalues.
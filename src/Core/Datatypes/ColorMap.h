@@ -68,6 +68,10 @@ namespace Datatypes {
     ColorRGB valueToColor(double scalar) const;
     ColorRGB valueToColor(Core::Geometry::Tensor &tensor) const;
     ColorRGB valueToColor(const Core::Geometry::Vector &vector) const;
+    /// Batch version of valueToColor(double): writes n RGBA quadruples to rgbaOut,
+    /// which must hold 4*n floats. Evaluated through a lookup table built at the
+    /// map's resolution, so the result matches the scalar version.
+    void valueToColor(const double* in, size_t n, float* rgbaOut) const;
 
     virtual std::string dynamic_type_name() const override { return "ColorMap"; }
 
@@ -75,6 +79,9 @@ namespace Datatypes {
     ///<< Internal functions.
     Core::Datatypes::ColorRGB getColorMapVal(double v) const;
     double getTransformedValue(double v) const;
+    size_t getLookupIndex(double v) const;
+    double getTransformedValueFromIndex(size_t index) const;
+    void buildLookupTable();
     ColorRGB applyAlpha(double transformed, ColorRGB colorWithoutAlpha) const;
     double alpha(double transformedValue) const;
 
@@ -93,6 +100,8 @@ namespace Datatypes {
     double rescale_shift_;
 
     std::vector<double> alphaLookup_;
+    ///<< RGBA for every index returned by getLookupIndex, i.e. resolution_ + 1 entries.
+    std::vector<float> colorLookup_;
   };
 
   class SCISHARE ColorMapStrategy
@@ -98,6 +98,7 @@ public:
 
 
   virtual VMesh::index_type* get_elems_pointer() const;
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
 };
 
 
@@ -284,7 +285,16 @@ VCurveMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->edges_.size() == 0) return (0);
-   return (&(this->mesh_->edges_[0]));
+   return (&(this->mesh_->edges_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VCurveMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->edges_.size() == 0) return (0);
+  return (this->mesh_->edges_.data());
 }
 
 } // end namespace
@@ -34,6 +34,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 #include <Core/Persistent/PersistentSTL.h>
 
 #include <Core/GeometryPrimitives/BBox.h>
@@ -478,7 +479,7 @@ public:
   void get_point(Core::Geometry::Point &result, typename Node::index_type idx) const
     { get_center(result,idx); }
   void set_point(const Core::Geometry::Point &point, typename Node::index_type index)
-    { points_[index] = point; }
+    { points_.set(index, point); }
   void get_random_point(Core::Geometry::Point &p, typename Elem::index_type i, FieldRNG &r) const;
 
   /// Normals for visualizations
@@ -1096,7 +1097,7 @@ public:
 		     static_cast<index_type>(0),
 		     static_cast<index_type>(points_.size()));
 
-    std::vector<Core::Geometry::Point>::iterator niter;
+    std::vector<Core::Geometry::Point>::const_iterator niter;
     niter = points_.begin() + i1;
     points_.erase(niter);
     return static_cast<typename Node::index_type>(points_.size() - 1);
@@ -1113,10 +1114,10 @@ public:
 		     static_cast<index_type>(0),
 		     static_cast<index_type>(points_.size()+1));
 
-    std::vector<Core::Geometry::Point>::iterator niter1;
+    std::vector<Core::Geometry::Point>::const_iterator niter1;
     niter1 = points_.begin() + i1;
 
-    std::vector<Core::Geometry::Point>::iterator niter2;
+    std::vector<Core::Geometry::Point>::const_iterator niter2;
     niter2 = points_.begin() + i2;
 
     points_.erase(niter1, niter2);
@@ -1129,10 +1130,10 @@ public:
 		     static_cast<index_type>(0),
 		     static_cast<index_type>(edges_.size()>>1));
 
-    typename std::vector<index_type>::iterator niter1;
+    typename std::vector<index_type>::const_iterator niter1;
     niter1 = edges_.begin() + 2*i1;
 
-    typename std::vector<index_type>::iterator niter2;
+    typename std::vector<index_type>::const_iterator niter2;
     niter2 = edges_.begin() + 2*i1+2;
 
     edges_.erase(niter1, niter2);
@@ -1150,10 +1151,10 @@ public:
 		     static_cast<index_type>(0), 
 		     static_cast<index_type>((edges_.size()>>1)+1));
 
-    typename std::vector<index_type>::iterator niter1;
+    typename std::vector<index_type>::const_iterator niter1;
     niter1 = edges_.begin() + 2*i1;
 
-    typename std::vector<index_type>::iterator niter2;
+    typename std::vector<index_type>::const_iterator niter2;
     niter2 = edges_.begin() + 2*i2;
 
     edges_.erase(niter1, niter2);
@@ -1210,8 +1211,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<index_type>& elems = edges_.writable();
     for (index_type n = 0; n < 2; ++n)
-      edges_[idx * 2 + n] = static_cast<index_type>(array[n]);
+      elems[idx * 2 + n] = static_cast<index_type>(array[n]);
   }
 
   template <class INDEX1, class INDEX2>
@@ -1306,9 +1308,9 @@ protected:
   // Actual data stored in the mesh
   
   /// Vector with the node locations
-  std::vector<Core::Geometry::Point>           points_;
+  CopyOnWriteVector<Core::Geometry::Point>           points_;
   /// Vector with connectivity data
-  std::vector<index_type>      edges_;
+  CopyOnWriteVector<index_type>      edges_;
   /// The basis function, contains additional information on elements
   Basis                   basis_;
 
@@ -1549,8 +1551,8 @@ template <class Basis>
 void
 CurveMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
-  auto itr = points_.begin();
-  auto eitr = points_.end();
+  auto itr = points_.writable().begin();
+  auto eitr = points_.writable().end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
@@ -1745,11 +1747,12 @@ CurveMesh<Basis>::io(Piostream& stream)
     // used index_type
     std::vector<std::pair<unsigned int,unsigned int> > tmp;
     Pio(stream,tmp);
-    edges_.resize(tmp.size()*2);
+    std::vector<index_type>& edges = edges_.writable();
+    edges.resize(tmp.size()*2);
     for (std::vector<std::pair<unsigned int,unsigned int> >::size_type j=0;j<tmp.size();j++)
     {
-      edges_[2*j] = tmp[j].first;
-      edges_[2*j+1] = tmp[j].second;
+      edges[2*j] = tmp[j].first;
+      edges[2*j+1] = tmp[j].second;
     }
   }
   else
@@ -156,6 +156,7 @@ public:
                          VMesh::Cell::index_type);
 
   virtual VMesh::index_type* get_elems_pointer() const;                          
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
 };
 
 /// Functions for creating the virtual interface for specific mesh types
@@ -524,7 +525,16 @@ VHexVolMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->cells_.size() == 0) return (0);
-   return (&(this->mesh_->cells_[0]));
+   return (&(this->mesh_->cells_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VHexVolMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->cells_.size() == 0) return (0);
+  return (this->mesh_->cells_.data());
 }
 
 
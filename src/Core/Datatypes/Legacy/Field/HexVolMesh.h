@@ -35,6 +35,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 
 #include <Core/GeometryPrimitives/SearchGridT.h>
 #include <Core/GeometryPrimitives/BBox.h>
@@ -714,7 +715,7 @@ public:
   void get_point(Core::Geometry::Point &result, typename Node::index_type index) const
   { result = points_[index]; }
   void set_point(const Core::Geometry::Point &point, typename Node::index_type index)
-  { points_[index] = point; }
+  { points_.set(index, point); }
   void get_random_point(Core::Geometry::Point &p, typename Elem::index_type i, FieldRNG &r) const;
 
   /// Normals for visualizations
@@ -1545,7 +1546,7 @@ public:
 				    const Core::Geometry::Point &p6, const Core::Geometry::Point &p7);
 
   /// must detach, if altering points!
-  std::vector<Core::Geometry::Point>& get_points() { return points_; }
+  std::vector<Core::Geometry::Point>& get_points() { return points_.writable(); }
 
   int compute_checksum();
 
@@ -2014,8 +2015,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<under_type>& elems = cells_.writable();
     for (index_type n = 0; n < 8; ++n)
-      cells_[idx * 8 + n] = static_cast<index_type>(array[n]);
+      elems[idx * 8 + n] = static_cast<index_type>(array[n]);
   }
 
 
@@ -2266,9 +2268,25 @@ protected:
     if (sz == 0) return (false);
 
     /// Check whether the estimate given in idx is the point we are looking for
-    if ((elem > 0)&&(elem < sz))
+    if ((elem >= 0)&&(elem < sz))
     {
       if (inside(elem,p)) return (true);
+
+      /// A point that moved a short distance, e.g. along a streamline, is
+      /// mostly found in one of the neighbors of the estimate
+      if (synchronized_ & Mesh::FACES_E)
+      {
+        typename Elem::array_type neighbors;
+        get_elem_neighbors(neighbors, typename Elem::index_type(elem));
+        for (size_t j = 0; j < neighbors.size(); j++)
+        {
+          if (inside(neighbors[j],p))
+          {
+            elem = static_cast<INDEX>(neighbors[j]);
+            return (true);
+          }
+        }
+      }
     }
 
     ASSERTMSG(synchronized_ & Mesh::ELEM_LOCATE_E,
@@ -2481,9 +2499,9 @@ protected:
   }
 
   /// all the nodes.
-  std::vector<Core::Geometry::Point>        points_;
+  CopyOnWriteVector<Core::Geometry::Point>        points_;
   /// each 8 indecies make up a Hex
-  std::vector<under_type>   cells_;
+  CopyOnWriteVector<under_type>   cells_;
 
   /// Face information.
   class PFaceCell {
@@ -2972,7 +2990,7 @@ HexVolMesh<Basis>::fill_points(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   points_.resize(end - begin); // resize to the new size
-  std::vector<Core::Geometry::Point>::iterator piter = points_.begin();
+  std::vector<Core::Geometry::Point>::iterator piter = points_.writable().begin();
   while (iter != end)
   {
     *piter = fill_ftor(*iter);
@@ -2989,7 +3007,7 @@ HexVolMesh<Basis>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   cells_.resize((end - begin) * 8); // resize to the new size
-  std::vector<under_type>::iterator citer = cells_.begin();
+  std::vector<under_type>::iterator citer = cells_.writable().begin();
   while (iter != end)
   {
     index_type *nodes = fill_ftor(*iter); // returns an array of length 8
@@ -3176,8 +3194,8 @@ HexVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
+  std::vector<Core::Geometry::Point>::iterator itr = points_.writable().begin();
+  std::vector<Core::Geometry::Point>::iterator eitr = points_.writable().end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
@@ -92,6 +92,7 @@ public:
   virtual void set_point(const Point &point, VMesh::Node::index_type i);
 
   virtual Point* get_points_pointer() const;
+  virtual const Point* get_const_points_pointer() const;
 
   virtual void add_node(const Point &point,VMesh::Node::index_type &i);
   virtual void add_elem(const VMesh::Node::array_type &nodes,
@@ -390,7 +391,7 @@ template <class MESH>
 void
 VPointCloudMesh<MESH>::set_point(const Point &point, VMesh::Node::index_type i)
 {
-  this->mesh_->points_[i] = point;
+  this->mesh_->points_.set(i, point);
 }
 
 template <class MESH>
@@ -400,7 +401,17 @@ VPointCloudMesh<MESH>::get_points_pointer() const
   if (this->mesh_->points_.empty())
     return 0;
 
-  return(&(this->mesh_->points_[0]));
+  return(&(this->mesh_->points_.writable()[0]));
+}
+
+template <class MESH>
+const Point*
+VPointCloudMesh<MESH>::get_const_points_pointer() const
+{
+  if (this->mesh_->points_.empty())
+    return 0;
+
+  return(this->mesh_->points_.data());
 }
 
 
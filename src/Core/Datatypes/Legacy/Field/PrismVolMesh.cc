@@ -135,6 +135,7 @@ public:
 
 
   virtual VMesh::index_type* get_elems_pointer() const;
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
 };
 
 /// Functions for creating the virtual interface for specific mesh types
@@ -455,7 +456,16 @@ VPrismVolMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->cells_.size() == 0) return (0);
-   return (&(this->mesh_->cells_[0]));
+   return (&(this->mesh_->cells_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VPrismVolMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->cells_.size() == 0) return (0);
+  return (this->mesh_->cells_.data());
 }
 
 }
@@ -35,6 +35,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 #include <Core/Persistent/PersistentSTL.h>
 
 #include <Core/GeometryPrimitives/SearchGridT.h>
@@ -649,7 +650,7 @@ public:
   void get_point(Core::Geometry::Point &result, typename Node::index_type index) const
     { result = points_[index]; }
   void set_point(const Core::Geometry::Point &point, typename Node::index_type index)
-    { points_[index] = point; }
+    { points_.set(index, point); }
   void get_random_point(Core::Geometry::Point &p, typename Elem::index_type i, FieldRNG &r) const;
 
   /// Function for getting node normals
@@ -1435,7 +1436,7 @@ public:
 				      const Core::Geometry::Point &p4, const Core::Geometry::Point &p5);
 
   /// must detach, if altering points!
-  std::vector<Core::Geometry::Point>& get_points() { return points_; }
+  std::vector<Core::Geometry::Point>& get_points() { return points_.writable(); }
 
   int compute_checksum();
 
@@ -1759,8 +1760,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<under_type>& elems = cells_.writable();
     for (index_type n = 0; n < 6; ++n)
-      cells_[idx * 6 + n] = static_cast<index_type>(array[n]);
+      elems[idx * 6 + n] = static_cast<index_type>(array[n]);
   }
 
   template <class INDEX1, class INDEX2>
@@ -2000,9 +2002,25 @@ protected:
     if (sz == 0) return (false);
 
     /// Check whether the estimate given in idx is the point we are looking for
-    if ((elem > 0)&&(elem < sz))
+    if ((elem >= 0)&&(elem < sz))
     {
       if (inside(elem,p)) return (true);
+
+      /// A point that moved a short distance, e.g. along a streamline, is
+      /// mostly found in one of the neighbors of the estimate
+      if (synchronized_ & Mesh::FACES_E)
+      {
+        typename Elem::array_type neighbors;
+        get_elem_neighbors(neighbors, typename Elem::index_type(elem));
+        for (size_t j = 0; j < neighbors.size(); j++)
+        {
+          if (inside(neighbors[j],p))
+          {
+            elem = static_cast<INDEX>(neighbors[j]);
+            return (true);
+          }
+        }
+      }
     }
 
     ASSERTMSG(synchronized_ & Mesh::ELEM_LOCATE_E,
@@ -2213,9 +2231,9 @@ protected:
   }
 
   /// all the nodes.
-  std::vector<Core::Geometry::Point>        points_;
+  CopyOnWriteVector<Core::Geometry::Point>        points_;
   /// each 6 indecies make up a Prism
-  std::vector<under_type>   cells_;
+  CopyOnWriteVector<under_type>   cells_;
 
   /// Face information.
   struct PFace {
@@ -2696,7 +2714,7 @@ PrismVolMesh<Basis>::fill_points(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   points_.resize(end - begin); // resize to the new size
-  std::vector<Core::Geometry::Point>::iterator piter = points_.begin();
+  std::vector<Core::Geometry::Point>::iterator piter = points_.writable().begin();
   while (iter != end)
   {
     *piter = fill_ftor(*iter);
@@ -2713,7 +2731,7 @@ PrismVolMesh<Basis>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   cells_.resize((end - begin) * 6); // resize to the new size
-  std::vector<under_type>::iterator citer = cells_.begin();
+  std::vector<under_type>::iterator citer = cells_.writable().begin();
   while (iter != end)
   {
     int *nodes = fill_ftor(*iter); // returns an array of length NNODES
@@ -2851,8 +2869,8 @@ PrismVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
+  std::vector<Core::Geometry::Point>::iterator itr = points_.writable().begin();
+  std::vector<Core::Geometry::Point>::iterator eitr = points_.writable().end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
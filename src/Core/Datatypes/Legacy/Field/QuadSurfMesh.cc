@@ -112,6 +112,7 @@ public:
                          VMesh::Face::index_type);  
 
   virtual VMesh::index_type* get_elems_pointer() const;                          
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
 };
 
 
@@ -374,7 +375,16 @@ VQuadSurfMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->faces_.size() == 0) return (0);
-   return (&(this->mesh_->faces_[0]));
+   return (&(this->mesh_->faces_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VQuadSurfMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->faces_.size() == 0) return (0);
+  return (this->mesh_->faces_.data());
 }
 
 
@@ -34,6 +34,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 
 #include <Core/GeometryPrimitives/SearchGridT.h>
 #include <Core/GeometryPrimitives/BBox.h>
@@ -609,7 +610,7 @@ public:
   void get_point(Core::Geometry::Point &p, typename Node::index_type i) const
     { p = points_[i]; }
   void set_point(const Core::Geometry::Point &p, typename Node::index_type i)
-    { points_[i] = p; }
+    { points_.set(i, p); }
 
   void get_random_point(Core::Geometry::Point &, typename Elem::index_type, FieldRNG &rng) const;
 
@@ -1771,8 +1772,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<index_type>& elems = faces_.writable();
     for (index_type n = 0; n < 4; ++n)
-      faces_[idx * 4 + n] = static_cast<index_type>(array[n]);
+      elems[idx * 4 + n] = static_cast<index_type>(array[n]);
   }
 
   /// This function has been rewritten to allow for non manifold surfaces to be
@@ -2238,9 +2240,9 @@ protected:
   index_type prev(index_type i) { return ((i%4)==0) ? (i+3) : (i-1); }
 
   /// array with all the points
-  std::vector<Core::Geometry::Point>                         points_;
+  CopyOnWriteVector<Core::Geometry::Point>                         points_;
   /// array with the four nodes that make up a face
-  std::vector<index_type>                    faces_;
+  CopyOnWriteVector<index_type>                    faces_;
 
   /// FOR EDGE -> NODES
   /// array with information from edge number (unique ones) to the node numbers
@@ -2397,8 +2399,8 @@ void
 QuadSurfMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
+  std::vector<Core::Geometry::Point>::iterator itr = points_.writable().begin();
+  std::vector<Core::Geometry::Point>::iterator eitr = points_.writable().end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
@@ -3126,9 +3128,10 @@ QuadSurfMesh<Basis>::io(Piostream &stream)
   {
     if (stream.reading())
     {
-      for (size_t i=0; i < faces_.size(); i += 4)
+      std::vector<index_type>& faces = faces_.writable();
+      for (size_t i=0; i < faces.size(); i += 4)
       {
-        ASSERTMSG(order_face_nodes(faces_[i],faces_[i+1],faces_[i+2],faces_[i+3]),
+        ASSERTMSG(order_face_nodes(faces[i],faces[i+1],faces[i+2],faces[i+3]),
           "Detected an invalid quadrilateral face");
       }
     }
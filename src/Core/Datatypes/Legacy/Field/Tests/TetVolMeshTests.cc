@@ -70,3 +70,42 @@ TEST(TetVolMeshTest, CheckMeshIteratorTetVolMesh)
 }
 
 
+
+TEST(TetVolMeshTest, DeepCloneDetachesNodesOnFirstWrite)
+{
+  FieldHandle tetmesh = CubeTetVolLinearBasis(NONE_E);
+  FieldHandle copy(tetmesh->deep_clone());
+
+  VMesh* mesh = tetmesh->vmesh();
+  VMesh* cmesh = copy->vmesh();
+
+  Point p0, p1;
+  mesh->get_center(p0, VMesh::Node::index_type(0));
+  cmesh->set_point(Point(10.0, 20.0, 30.0), VMesh::Node::index_type(0));
+
+  mesh->get_center(p1, VMesh::Node::index_type(0));
+  EXPECT_EQ(p0, p1);
+  cmesh->get_center(p1, VMesh::Node::index_type(0));
+  EXPECT_EQ(Point(10.0, 20.0, 30.0), p1);
+
+  VMesh::Node::array_type nodes, cnodes;
+  mesh->get_nodes(nodes, VMesh::Elem::index_type(0));
+  cmesh->get_nodes(cnodes, VMesh::Elem::index_type(0));
+  EXPECT_EQ(nodes, cnodes);
+}
+
+TEST(TetVolMeshTest, ConstPointersDoNotDetachSharedStorage)
+{
+  FieldHandle tetmesh = CubeTetVolLinearBasis(NONE_E);
+  FieldHandle copy(tetmesh->deep_clone());
+
+  VMesh* mesh = tetmesh->vmesh();
+  VMesh* cmesh = copy->vmesh();
+
+  EXPECT_EQ(mesh->get_const_points_pointer(), cmesh->get_const_points_pointer());
+  EXPECT_EQ(mesh->get_const_elems_pointer(), cmesh->get_const_elems_pointer());
+
+  Point* points = cmesh->get_points_pointer();
+  EXPECT_NE(mesh->get_const_points_pointer(), static_cast<const Point*>(points));
+  EXPECT_EQ(mesh->get_const_elems_pointer(), cmesh->get_const_elems_pointer());
+}
@@ -146,6 +146,7 @@ public:
                                      Point& point);
 
   virtual VMesh::index_type* get_elems_pointer() const;
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
   
   virtual double inscribed_circumscribed_radius_metric(VMesh::Elem::index_type idx) const;
 };
@@ -506,7 +507,16 @@ VTetVolMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->cells_.size() == 0) return (0);
-   return (&(this->mesh_->cells_[0]));
+   return (&(this->mesh_->cells_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VTetVolMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->cells_.size() == 0) return (0);
+  return (this->mesh_->cells_.data());
 }
 
 
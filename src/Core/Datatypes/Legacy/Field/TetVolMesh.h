@@ -35,6 +35,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 #include <Core/Persistent/PersistentSTL.h>
 
 #include <Core/GeometryPrimitives/SearchGridT.h>
@@ -648,7 +649,7 @@ public:
   void get_point(Core::Geometry::Point &result, typename Node::index_type index) const
   { result = points_[index]; }
   void set_point(const Core::Geometry::Point &point, typename Node::index_type index)
-  { points_[index] = point; }
+  { points_.set(index, point); }
   void get_random_point(Core::Geometry::Point &p, typename Elem::index_type i, FieldRNG &r) const;
 
   /// Normals for visualizations
@@ -1494,7 +1495,7 @@ public:
 			   const Core::Geometry::Point &p);
 
   /// must detach, if altering points!
-  std::vector<Core::Geometry::Point>& get_points() { return points_; }
+  std::vector<Core::Geometry::Point>& get_points() { return points_.writable(); }
 
   int compute_checksum();
 
@@ -1860,8 +1861,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<under_type>& cells = cells_.writable();
     for (index_type n = 0; n < 4; ++n)
-      cells_[idx * 4 + n] = static_cast<index_type>(array[n]);
+      cells[idx * 4 + n] = static_cast<index_type>(array[n]);
   }
 
   template <class INDEX1, class INDEX2>
@@ -2108,9 +2110,25 @@ protected:
     if (sz == 0) return (false);
 
     /// Check whether the estimate given in idx is the point we are looking for
-    if ((elem > 0)&&(elem < sz))
+    if ((elem >= 0)&&(elem < sz))
     {
       if (inside(elem,p)) return (true);
+
+      /// A point that moved a short distance, e.g. along a streamline, is
+      /// mostly found in one of the neighbors of the estimate
+      if (synchronized_ & Mesh::FACES_E)
+      {
+        typename Elem::array_type neighbors;
+        get_elem_neighbors(neighbors, typename Elem::index_type(elem));
+        for (size_t j = 0; j < neighbors.size(); j++)
+        {
+          if (inside(neighbors[j],p))
+          {
+            elem = static_cast<INDEX>(neighbors[j]);
+            return (true);
+          }
+        }
+      }
     }
 
     ASSERTMSG(synchronized_ & Mesh::ELEM_LOCATE_E,
@@ -2326,11 +2344,11 @@ protected:
     return (true);
   }
 
-  /// all the nodes.
-  std::vector<Core::Geometry::Point>         points_;
+  /// all the nodes, shared with copies of this mesh until modified.
+  CopyOnWriteVector<Core::Geometry::Point>   points_;
 
-  /// each 4 indicies make up a tet
-  std::vector<under_type>    cells_;
+  /// each 4 indicies make up a tet, shared like the nodes.
+  CopyOnWriteVector<under_type>    cells_;
 
   /// Face information.
   class PFaceCell {
@@ -2733,7 +2751,7 @@ TetVolMesh<Basis>::fill_points(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   points_.resize(end - begin); // resize to the new size
-  std::vector<Core::Geometry::Point>::iterator piter = points_.begin();
+  std::vector<Core::Geometry::Point>::iterator piter = points_.writable().begin();
   while (iter != end)
   {
     *piter = fill_ftor(*iter);
@@ -2750,7 +2768,7 @@ TetVolMesh<Basis>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.lock();
   Iter iter = begin;
   cells_.resize((end - begin) * 4); // resize to the new size
-  std::vector<under_type>::iterator citer = cells_.begin();
+  std::vector<under_type>::iterator citer = cells_.writable().begin();
   while (iter != end)
   {
     index_type *nodes = fill_ftor(*iter); // returns an array of length 4
@@ -2869,8 +2887,9 @@ TetVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
+  std::vector<Core::Geometry::Point>& points = points_.writable();
+  std::vector<Core::Geometry::Point>::iterator itr = points.begin();
+  std::vector<Core::Geometry::Point>::iterator eitr = points.end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
@@ -3662,8 +3681,9 @@ TetVolMesh<Basis>::set_nodes(typename Node::array_type &array,
 
   delete_cell_syncinfo(idx);
 
+  std::vector<under_type>& cells = cells_.writable();
   for (index_type n = 0; n < 4; ++n)
-    cells_[idx * 4 + n] = array[n];
+    cells[idx * 4 + n] = array[n];
 
   create_cell_syncinfo(idx);
 }
@@ -3971,18 +3991,19 @@ TetVolMesh<Basis>::mod_tet_pos(typename TetVolMesh<Basis>::Elem::index_type ci,
   const Core::Geometry::Point &p2 = point(c);
   const Core::Geometry::Point &p3 = point(d);
 
+  std::vector<under_type>& cells = cells_.writable();
   if (Dot(Cross(p1-p0,p2-p0),p3-p0) >= 0.0)
   {
-    cells_[ci*4+0] = a;
-    cells_[ci*4+1] = b;
+    cells[ci*4+0] = a;
+    cells[ci*4+1] = b;
   }
   else
   {
-    cells_[ci*4+0] = b;
-    cells_[ci*4+1] = a;
+    cells[ci*4+0] = b;
+    cells[ci*4+1] = a;
   }
-  cells_[ci*4+2] = c;
-  cells_[ci*4+3] = d;
+  cells[ci*4+2] = c;
+  cells[ci*4+3] = d;
 }
 
 template <class Basis>
@@ -3996,10 +4017,11 @@ TetVolMesh<Basis>::delete_cells(std::set<index_type> &to_delete)
     // erase the correct cell
     typename TetVolMesh<Basis>::Cell::index_type ci = *iter++;
     index_type ind = ci * 4;
-    std::vector<index_type>::iterator cb = cells_.begin() + ind;
+    std::vector<index_type>& cells = cells_.writable();
+    std::vector<index_type>::iterator cb = cells.begin() + ind;
     std::vector<index_type>::iterator ce = cb;
     ce+=4;
-    cells_.erase(cb, ce);
+    cells.erase(cb, ce);
   }
 
   synchronized_ &= ~Mesh::LOCATE_E;
@@ -4026,8 +4048,9 @@ TetVolMesh<Basis>::delete_nodes(std::set<index_type> &to_delete)
   while (iter != to_delete.rend())
   {
     typename TetVolMesh::Node::index_type n = *iter++;
-    std::vector<Core::Geometry::Point>::iterator pit = points_.begin() + n;
-    points_.erase(pit);
+    std::vector<Core::Geometry::Point>& points = points_.writable();
+    std::vector<Core::Geometry::Point>::iterator pit = points.begin() + n;
+    points.erase(pit);
   }
   synchronized_ &= ~Mesh::LOCATE_E;
   synchronized_ &= ~Mesh::NODE_NEIGHBORS_E;
@@ -4368,9 +4391,8 @@ TetVolMesh<Basis>::orient(typename Cell::index_type ci)
   const double sgn = Dot(Cross(p1-p0,p2-p0),p3-p0);
   if (sgn < 0.0)
   {
-    typename Node::index_type tmp = cells_[ci*4+0];
-    cells_[ci*4+0] = cells_[ci*4+1];
-    cells_[ci*4+1] = tmp;
+    std::vector<under_type>& cells = cells_.writable();
+    std::swap(cells[ci*4+0],cells[ci*4+1]);
   }
 }
 
@@ -121,6 +121,7 @@ public:
                                      Point& point);
 
   virtual VMesh::index_type* get_elems_pointer() const;
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
   virtual boost::shared_ptr<SearchGridT<typename SCIRun::index_type> > get_elem_search_grid() { return this->mesh_->elem_grid_; }
   virtual boost::shared_ptr<SearchGridT<typename SCIRun::index_type> > get_node_search_grid() { return this->mesh_->node_grid_; }
 
@@ -389,7 +390,16 @@ VTriSurfMesh<MESH>::
 get_elems_pointer() const
 {
   if (this->mesh_->faces_.size() == 0) return (0);
-   return (&(this->mesh_->faces_[0]));
+   return (&(this->mesh_->faces_.writable()[0]));
+}
+
+template <class MESH>
+const VMesh::index_type*
+VTriSurfMesh<MESH>::
+get_const_elems_pointer() const
+{
+  if (this->mesh_->faces_.size() == 0) return (0);
+  return (this->mesh_->faces_.data());
 }
 
 /// @todo: Fix this function so it does not need the vector conversion
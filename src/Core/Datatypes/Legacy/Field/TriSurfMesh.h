@@ -34,6 +34,7 @@
 #include <Core/Datatypes/Legacy/Field/MeshSupport.h>
 
 #include <Core/Containers/StackVector.h>
+#include <Core/Containers/CopyOnWriteVector.h>
 
 #include <Core/GeometryPrimitives/Transform.h>
 #include <Core/GeometryPrimitives/Point.h>
@@ -551,7 +552,7 @@ public:
   void get_point(Core::Geometry::Point &result, typename Node::index_type index) const
     { result = points_[index]; }
   void set_point(const Core::Geometry::Point &point, typename Node::index_type index)
-    { points_[index] = point; }
+    { points_.set(index, point); }
 
   void get_random_point(Core::Geometry::Point &, typename Elem::index_type, FieldRNG &rng) const;
 
@@ -1621,8 +1622,9 @@ protected:
   template <class ARRAY, class INDEX>
   inline void set_nodes_by_elem(ARRAY &array, INDEX idx)
   {
+    std::vector<index_type>& elems = faces_.writable();
     for (index_type n = 0; n < 3; ++n)
-      faces_[idx * 3 + n] = static_cast<index_type>(array[n]);
+      elems[idx * 3 + n] = static_cast<index_type>(array[n]);
   }
 
 
@@ -2027,10 +2029,10 @@ protected:
   static index_type prev(index_type i) { return ((i%3)==0) ? (i+2) : (i-1); }
 
   /// Actual parameters
-  std::vector<Core::Geometry::Point>         points_;              // Location of vertices
+  CopyOnWriteVector<Core::Geometry::Point>         points_;              // Location of vertices
   std::vector<std::vector<index_type> >    edges_;               // edges->halfedge map
   std::vector<index_type>    halfedge_to_edge_;    // halfedge->edge map
-  std::vector<index_type>    faces_;               // Connectivity of this mesh
+  CopyOnWriteVector<index_type>    faces_;               // Connectivity of this mesh
   std::vector<index_type>    edge_neighbors_;      // Neighbor connectivity
   std::vector<Core::Geometry::Vector>        normals_;             // normalized per node normal.
   std::vector<std::vector<index_type> > node_neighbors_; // Node neighbor connectivity
@@ -2233,8 +2235,8 @@ void
 TriSurfMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
+  std::vector<Core::Geometry::Point>::iterator itr = points_.writable().begin();
+  std::vector<Core::Geometry::Point>::iterator eitr = points_.writable().end();
   while (itr != eitr)
   {
     *itr = t.project(*itr);
@@ -2660,7 +2662,7 @@ TriSurfMesh<Basis>::insert_node(typename Face::index_type face, const Core::Geom
   faces_.push_back(pi);
 
   // must do last
-  faces_[f0+2] = pi;
+  faces_.set(f0+2, pi);
 
   if (do_neighbors)
   {
@@ -2769,7 +2771,7 @@ TriSurfMesh<Basis>::insert_node_in_edge_aux(typename Face::array_type &tris,
 
   // f0
   tris.push_back(halfedge / 3);
-  faces_[next(halfedge)] = ni;
+  faces_.set(next(halfedge), ni);
   edge_neighbors_[halfedge] = (nbr!=MESH_NO_NEIGHBOR)?f3:MESH_NO_NEIGHBOR;
   edge_neighbors_[next(halfedge)] = prev(f1);
   edge_neighbors_[prev(halfedge)] = edge_neighbors_[prev(halfedge)];
@@ -2794,7 +2796,7 @@ TriSurfMesh<Basis>::insert_node_in_edge_aux(typename Face::array_type &tris,
 
     // f2
     tris.push_back(nbr / 3);
-    faces_[next(nbr)] = ni;
+    faces_.set(next(nbr), ni);
     edge_neighbors_[nbr] = f1;
     edge_neighbors_[next(nbr)] = f3+2;
   }
@@ -2862,7 +2864,7 @@ TriSurfMesh<Basis>::insert_node_in_face_aux(typename Face::array_type &tris,
 
   // Must do last
   tris.push_back(face);
-  faces_[f0+2] = ni;
+  faces_.set(f0+2, ni);
   edge_neighbors_[f0+1] = f1+2;
   edge_neighbors_[f0+2] = f2+1;
 
@@ -2959,9 +2961,10 @@ template <class Basis>
 void
 TriSurfMesh<Basis>::collapse_edges(const std::vector<index_type> &nodemap)
 {
-  for (size_t i = 0; i < faces_.size(); i++)
+  std::vector<index_type>& faces = faces_.writable();
+  for (size_t i = 0; i < faces.size(); i++)
   {
-    faces_[i] = nodemap[faces_[i]];
+    faces[i] = nodemap[faces[i]];
   }
 }
 
@@ -2970,7 +2973,7 @@ template <class Basis>
 void
 TriSurfMesh<Basis>::remove_obvious_degenerate_triangles()
 {
-  std::vector<index_type> oldfaces = faces_;
+  std::vector<index_type> oldfaces = faces_.get();
   faces_.clear();
   for (size_t i = 0; i< oldfaces.size(); i+=3)
   {
@@ -3044,9 +3047,9 @@ TriSurfMesh<Basis>::bisect_element(const typename Face::index_type face)
   faces_.push_back(nodes[5]);
   faces_.push_back(nodes[4]);
 
-  faces_[f0+0] = nodes[3];
-  faces_[f0+1] = nodes[4];
-  faces_[f0+2] = nodes[5];
+  faces_.set(f0+0, nodes[3]);
+  faces_.set(f0+1, nodes[4]);
+  faces_.set(f0+2, nodes[5]);
 
 
   if (do_neighbors)
@@ -3101,7 +3104,7 @@ TriSurfMesh<Basis>::bisect_element(const typename Face::index_type face)
     edge_neighbors_.push_back(pnbr);
     edge_neighbors_.push_back(edge_neighbors_[pnbr]);
     edge_neighbors_[edge_neighbors_.back()] = f4+2;
-    faces_[nbr] = nodes[3];
+    faces_.set(nbr, nodes[3]);
     edge_neighbors_[pnbr] = f4+1;
     if (do_normals)
     {
@@ -3125,7 +3128,7 @@ TriSurfMesh<Basis>::bisect_element(const typename Face::index_type face)
     edge_neighbors_.push_back(pnbr);
     edge_neighbors_.push_back(edge_neighbors_[pnbr]);
     edge_neighbors_[edge_neighbors_.back()] = f5+2;
-    faces_[nbr] = nodes[4];
+    faces_.set(nbr, nodes[4]);
     edge_neighbors_[pnbr] = f5+1;
     if (do_normals)
     {
@@ -3149,7 +3152,7 @@ TriSurfMesh<Basis>::bisect_element(const typename Face::index_type face)
     edge_neighbors_.push_back(pnbr);
     edge_neighbors_.push_back(edge_neighbors_[pnbr]);
     edge_neighbors_[edge_neighbors_.back()] = f6+2;
-    faces_[nbr] = nodes[5];
+    faces_.set(nbr, nodes[5]);
     edge_neighbors_[pnbr] = f6+1;
     if (do_normals)
     {
@@ -3340,13 +3343,13 @@ TriSurfMesh<Basis>::swap_shared_edge(typename Face::index_type f1,
   index_type s2 = *iter;
 
   synchronize_lock_.lock();
-  faces_[face1] = s1;
-  faces_[face1 + 1] = not_shar[0];
-  faces_[face1 + 2] = s2;
+  faces_.set(face1, s1);
+  faces_.set(face1 + 1, not_shar[0]);
+  faces_.set(face1 + 2, s2);
 
-  faces_[face2] = s2;
-  faces_[face2 + 1] = not_shar[1];
-  faces_[face2 + 2] = s1;
+  faces_.set(face2, s2);
+  faces_.set(face2 + 1, not_shar[1]);
+  faces_.set(face2 + 2, s1);
 
   synchronized_ &= ~Mesh::ELEM_NEIGHBORS_E;
   synchronized_ &= ~Mesh::NODE_NEIGHBORS_E;
@@ -3379,7 +3382,7 @@ TriSurfMesh<Basis>::remove_orphan_nodes()
   while (orph_iter != onodes.rend())
   {
     index_type i = *orph_iter++;
-    std::vector<index_type>::iterator iter = faces_.begin();
+    std::vector<index_type>::iterator iter = faces_.writable().begin();
     while (iter != faces_.end())
     {
       index_type &node = *iter++;
@@ -3388,7 +3391,7 @@ TriSurfMesh<Basis>::remove_orphan_nodes()
         node--;
       }
     }
-    std::vector<Core::Geometry::Point>::iterator niter = points_.begin();
+    std::vector<Core::Geometry::Point>::iterator niter = points_.writable().begin();
     niter += i;
     points_.erase(niter);
   }
@@ -3406,7 +3409,7 @@ TriSurfMesh<Basis>::remove_face(typename Face::index_type f)
   bool rval = true;
 
   synchronize_lock_.lock();
-  std::vector<under_type>::iterator fb = faces_.begin() + f*3;
+  std::vector<under_type>::iterator fb = faces_.writable().begin() + f*3;
   std::vector<under_type>::iterator fe = fb + 3;
 
   if (fe <= faces_.end())
@@ -3468,8 +3471,8 @@ TriSurfMesh<Basis>::flip_face(typename Face::index_type face)
 {
   const index_type base = face * 3;
   index_type tmp = faces_[base + 1];
-  faces_[base + 1] = faces_[base + 2];
-  faces_[base + 2] = tmp;
+  faces_.set(base + 1, faces_[base + 2]);
+  faces_.set(base + 2, tmp);
 
   synchronized_ &= ~(Mesh::EDGES_E);
   synchronized_ &= ~Mesh::ELEM_NEIGHBORS_E;
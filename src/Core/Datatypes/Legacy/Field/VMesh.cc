@@ -657,6 +657,18 @@ VMesh::get_elems_pointer() const
   ASSERTFAIL("VMesh interface: get_elems_pointer() has not been implemented");  
 }
 
+const Point*
+VMesh::get_const_points_pointer() const
+{
+  return (get_points_pointer());
+}
+
+const VMesh::index_type*
+VMesh::get_const_elems_pointer() const
+{
+  return (get_elems_pointer());
+}
+
 void 
 VMesh::node_reserve(size_t)
 {
@@ -774,13 +774,19 @@ public:
   // Only for unstructured data
   virtual VMesh::index_type* get_elems_pointer() const;
 
+  /// Read only versions of the above. Unstructured meshes share their storage
+  /// between copies and the pointers above give each copy its own storage
+  /// first, so code that does not modify the mesh should use these.
+  virtual const Core::Geometry::Point* get_const_points_pointer() const;
+  virtual const VMesh::index_type* get_const_elems_pointer() const;
+
   /// Copy nodes from one mesh to another mesh
   /// Note: currently only for irregular meshes
   /// @todo: Add regular meshes to the mix
   inline void copy_nodes(VMesh* imesh, Node::index_type i,
                           Node::index_type o,Node::size_type size)
   {
-    Core::Geometry::Point* ipoint = imesh->get_points_pointer();
+    const Core::Geometry::Point* ipoint = imesh->get_const_points_pointer();
     Core::Geometry::Point* opoint = get_points_pointer();
     for (index_type j=0; j<size; j++,i++,o++ ) opoint[o] = ipoint[i];
   }
@@ -789,7 +795,7 @@ public:
   {
     size_type size = imesh->num_nodes();
     resize_nodes(size);
-    Core::Geometry::Point* ipoint = imesh->get_points_pointer();
+    const Core::Geometry::Point* ipoint = imesh->get_const_points_pointer();
     Core::Geometry::Point* opoint = get_points_pointer();
     for (index_type j=0; j<size; j++) opoint[j] = ipoint[j];
   }
@@ -798,7 +804,7 @@ public:
                           Elem::index_type o,Elem::size_type size,
                           Elem::size_type offset)
   {
-    VMesh::index_type* ielem = imesh->get_elems_pointer();
+    const VMesh::index_type* ielem = imesh->get_const_elems_pointer();
     VMesh::index_type* oelem  = get_elems_pointer();
     index_type ii = i*num_nodes_per_elem_;
     index_type oo = o*num_nodes_per_elem_;
@@ -808,7 +814,7 @@ public:
 
   inline void copy_elems(VMesh* imesh)
   {
-    VMesh::index_type* ielem = imesh->get_elems_pointer();
+    const VMesh::index_type* ielem = imesh->get_const_elems_pointer();
     VMesh::index_type* oelem  = get_elems_pointer();
     size_type  ss = num_elems()*num_nodes_per_elem_;
     for (index_type j=0; j <ss; j++) oelem[j] = ielem[j];
@@ -100,6 +100,7 @@ public:
   virtual void set_point(const Core::Geometry::Point &point, VMesh::ENode::index_type i);
   
   virtual Core::Geometry::Point* get_points_pointer() const;
+  virtual const Core::Geometry::Point* get_const_points_pointer() const;
   
   virtual void add_node(const Core::Geometry::Point &point,VMesh::Node::index_type &i);
   virtual void add_enode(const Core::Geometry::Point &point,VMesh::ENode::index_type &i);
@@ -701,7 +702,7 @@ void
 VUnstructuredMesh<MESH>::
 set_point(const Core::Geometry::Point &point, VMesh::Node::index_type i)
 {
-  this->mesh_->points_[i] = point;
+  this->mesh_->points_.set(i, point);
 }
 
 template <class MESH>
@@ -729,7 +730,16 @@ VUnstructuredMesh<MESH>::
 get_points_pointer() const
 {
   if (this->mesh_->points_.size() == 0) return (0);
-   return (&(this->mesh_->points_[0]));
+   return (&(this->mesh_->points_.writable()[0]));
+}
+
+template <class MESH>
+const Core::Geometry::Point*
+VUnstructuredMesh<MESH>::
+get_const_points_pointer() const
+{
+  if (this->mesh_->points_.size() == 0) return (0);
+  return (this->mesh_->points_.data());
 }
 
 template <class MESH>
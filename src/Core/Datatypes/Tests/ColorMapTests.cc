@@ -0,0 +1,92 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/ColorMap.h>
+#include <Core/Utils/Exception.h>
+#include <limits>
+
+using namespace SCIRun::Core;
+using namespace SCIRun::Core::Datatypes;
+
+namespace
+{
+  void expectBatchMatchesScalar(const ColorMap& map)
+  {
+    std::vector<double> values;
+    for (int i = -1200; i <= 1200; ++i)
+      values.push_back(i / 1000.0);
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(-std::numeric_limits<double>::infinity());
+
+    std::vector<float> rgba(4 * values.size());
+    map.valueToColor(values.data(), values.size(), rgba.data());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      auto expected = map.valueToColor(values[i]);
+      EXPECT_FLOAT_EQ(expected.r(), rgba[4 * i + 0]) << values[i];
+      EXPECT_FLOAT_EQ(expected.g(), rgba[4 * i + 1]) << values[i];
+      EXPECT_FLOAT_EQ(expected.b(), rgba[4 * i + 2]) << values[i];
+      EXPECT_FLOAT_EQ(expected.a(), rgba[4 * i + 3]) << values[i];
+    }
+  }
+}
+
+TEST(ColorMapTests, BatchLookupMatchesScalarForAllStandardMaps)
+{
+  for (const auto& name : StandardColorMapFactory::getList())
+  {
+    SCOPED_TRACE(name);
+    expectBatchMatchesScalar(*StandardColorMapFactory::create(name));
+  }
+}
+
+TEST(ColorMapTests, BatchLookupMatchesScalarWithRescaleShiftAndInvert)
+{
+  expectBatchMatchesScalar(*StandardColorMapFactory::create("Rainbow", 17, 0.3, true, 2.0, 0.1));
+  expectBatchMatchesScalar(*StandardColorMapFactory::create("Viridis", 256, -0.5, false, 0.25, -0.2, { 0.2, 0.1, 0.5, 0.9, 0.8, 0.3 }));
+}
+
+TEST(ColorMapTests, BatchLookupHandlesEmptyInput)
+{
+  auto map = StandardColorMapFactory::create();
+  map->valueToColor(nullptr, 0, nullptr);
+}
+
+TEST(ColorMapTests, BatchLookupWithoutColorSchemeThrowsLikeScalar)
+{
+  ColorMap map(nullptr, "None");
+  std::vector<double> values { -1.0, 0.0, 1.0 };
+  std::vector<float> rgba(4 * values.size());
+
+  EXPECT_THROW(map.valueToColor(values[0]), InvalidArgumentException);
+  EXPECT_THROW(map.valueToColor(values.data(), values.size(), rgba.data()), InvalidArgumentException);
+  map.valueToColor(nullptr, 0, nullptr);
+}
@@ -49,6 +49,33 @@ TEST(SinCosTableTests, ThrowsForSizeOneTable)
   EXPECT_THROW(SinCosTable(1, 0, 1), AssertionFailed);
 }
 
+TEST(SinCosTableTests, SharedTablesAreBuiltOncePerParameters)
+{
+  auto a = SinCosTable::shared(10, 0, M_PI);
+  auto b = SinCosTable::shared(10, 0, M_PI);
+  auto c = SinCosTable::shared(10, 0, 2*M_PI);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_NE(a.get(), c.get());
+
+  SinCosTable local(10, 0, M_PI);
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(local.sin(i), a->sin(i));
+    EXPECT_EQ(local.cos(i), a->cos(i));
+  }
+}
+
+TEST(SinCosTableTests, SharedTablesOutliveTheCache)
+{
+  auto a = SinCosTable::shared(12, 0, M_PI);
+  for (int i = 0; i < 1000; ++i)
+    SinCosTable::shared(12, 0, 1.0 + i * 1e-3);
+
+  SinCosTable local(12, 0, M_PI);
+  for (int i = 0; i < 12; ++i)
+    EXPECT_EQ(local.sin(i), a->sin(i));
+}
+
 TEST(MathTest, LogChangeOfBase)
 {
   EXPECT_DOUBLE_EQ(log(34.0) / log(10.0), log10(34.0));
@@ -29,6 +29,10 @@
 #include <Core/Math/TrigTable.h>
 #include <Core/Math/MiscMath.h>
 #include <Core/Exceptions/AssertionFailed.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 namespace SCIRun {
 
@@ -68,4 +72,25 @@ void SinCosTable::fill_table( double max, double min, double scale )
   }
 }
 
+std::shared_ptr<const SinCosTable> SinCosTable::shared(int n, double min, double max)
+{
+  typedef std::tuple<int, double, double> Key;
+  static const size_t maxTables = 64;
+  static std::map<Key, std::shared_ptr<const SinCosTable>> tables;
+  static std::mutex tablesLock;
+
+  std::lock_guard<std::mutex> lock(tablesLock);
+  const Key key(n, min, max);
+  auto it = tables.find(key);
+  if (it != tables.end())
+    return it->second;
+
+  // The angles can come from glyph parameters, so the cache is emptied once it is full.
+  if (tables.size() >= maxTables)
+    tables.clear();
+  auto table = std::make_shared<const SinCosTable>(n, min, max);
+  tables[key] = table;
+  return table;
+}
+
 } // end namespace
@@ -29,6 +29,7 @@
 #ifndef SCI_Math_TrigTable_h
 #define SCI_Math_TrigTable_h 1
 
+#include <memory>
 #include <vector>
 #include <Core/Math/share.h>
 
@@ -43,6 +44,12 @@ class SCISHARE SinCosTable {
 
     void build_table(int n, double min, double max, double scale=1.0);
 
+    // Returns a table built once per (n, min, max) and shared by all callers.
+    // Safe to call from several threads; the returned table is never modified.
+    // Only a limited number of tables is cached, a table dropped from the cache
+    // stays valid for as long as a caller holds on to it.
+    static std::shared_ptr<const SinCosTable> shared(int n, double min, double max);
+
     inline double sin(int i) const { return sindata_[i]; } 
     inline double cos(int i) const { return cosdata_[i]; } 
 
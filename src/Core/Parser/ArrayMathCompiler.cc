@@ -0,0 +1,567 @@
+//  
+//  For more information, please see: http://software.sci.utah.edu
+//  
+//  The MIT License
+//  
+//  Copyright (c) 2015 Scientific Computing and Imaging Institute,
+//  University of Utah.
+//  
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//  
+
+#include <Core/Parser/ArrayMathCompiler.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/CastFData.h>
+#include <Core/Thread/Parallel.h>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+namespace {
+
+template<class T>
+void load_scalar(const void* data, index_type offset, size_type size, double* dest)
+{
+  const T* src = static_cast<const T*>(data) + offset;
+  for (size_type k = 0; k < size; k++) dest[k] = CastFData<double>(src[k]);
+}
+
+template<class T>
+void store_scalar(void* data, index_type offset, size_type size, const double* src)
+{
+  T* dest = static_cast<T*>(data) + offset;
+  for (size_type k = 0; k < size; k++) dest[k] = CastFData<T>(src[k]);
+}
+
+void load_vector(const void* data, index_type offset, size_type size, double* dest)
+{
+  const Vector* src = static_cast<const Vector*>(data) + offset;
+  for (size_type k = 0; k < size; k++, dest += 3)
+  {
+    dest[0] = src[k].x(); dest[1] = src[k].y(); dest[2] = src[k].z();
+  }
+}
+
+void store_vector(void* data, index_type offset, size_type size, const double* src)
+{
+  Vector* dest = static_cast<Vector*>(data) + offset;
+  for (size_type k = 0; k < size; k++, src += 3)
+    dest[k] = Vector(src[0], src[1], src[2]);
+}
+
+template<class T, class LOAD, class STORE>
+bool select_scalar_access(VField* vfield, LOAD& load, STORE& store)
+{
+  if (!(vfield->is_type(static_cast<T*>(0)))) return (false);
+  load = &load_scalar<T>;
+  store = &store_scalar<T>;
+  return (true);
+}
+
+template<class LOAD, class STORE>
+bool select_access(VField* vfield, LOAD& load, STORE& store)
+{
+  if (vfield->is_vector())
+  {
+    load = &load_vector;
+    store = &store_vector;
+    return (true);
+  }
+  if (!(vfield->is_scalar())) return (false);
+
+  return (select_scalar_access<double>(vfield,load,store) ||
+          select_scalar_access<float>(vfield,load,store) ||
+          select_scalar_access<int>(vfield,load,store) ||
+          select_scalar_access<unsigned int>(vfield,load,store) ||
+          select_scalar_access<char>(vfield,load,store) ||
+          select_scalar_access<unsigned char>(vfield,load,store) ||
+          select_scalar_access<short>(vfield,load,store) ||
+          select_scalar_access<unsigned short>(vfield,load,store) ||
+          select_scalar_access<long>(vfield,load,store) ||
+          select_scalar_access<unsigned long>(vfield,load,store) ||
+          select_scalar_access<long long>(vfield,load,store) ||
+          select_scalar_access<unsigned long long>(vfield,load,store));
+}
+
+size_type type_width(const std::string& type)
+{
+  if (type == "S") return (1);
+  if (type == "V") return (3);
+  if (type == "T") return (6);
+  return (0);
+}
+
+}
+
+ArrayMathCompiledProgram::ArrayMathCompiledProgram(ArrayMathProgram* mprogram) :
+  mprogram_(mprogram),
+  block_size_(mprogram->get_buffer_size()),
+  register_width_(0)
+{
+}
+
+size_t
+ArrayMathCompiledProgram::num_compiled_instructions() const
+{
+  size_t num = 0;
+  for (size_t j=0; j<instructions_.size(); j++)
+    if (instructions_[j].op != FUNCTION_E) num++;
+  return (num);
+}
+
+ArrayMathCompiledProgramHandle
+ArrayMathCompiledProgram::compile(ParserProgramHandle& pprogram,
+                                  ArrayMathProgram* mprogram)
+{
+  ArrayMathCompiledProgramHandle handle;
+  size_t num_functions = pprogram->num_sequential_functions();
+  if (num_functions == 0) return (handle);
+
+  handle.reset(new ArrayMathCompiledProgram(mprogram));
+  ArrayMathCompiledProgram& program = *handle;
+  program.instructions_.resize(num_functions);
+
+  // Find the last function that uses each sequential variable, after which
+  // its register can be handed out again
+  std::map<int,size_t> last_use;
+  for (size_t j=0; j<num_functions; j++)
+  {
+    ParserScriptFunctionHandle fhandle;
+    pprogram->get_sequential_function(j,fhandle);
+    ParserScriptVariableHandle ohandle = fhandle->get_output_var();
+    if (type_width(ohandle->get_type()))
+      last_use[ohandle->get_var_number()] = j;
+    for (size_t i=0; i<fhandle->num_input_vars(); i++)
+    {
+      ParserScriptVariableHandle ihandle = fhandle->get_input_var(i);
+      if (type_width(ihandle->get_type()) &&
+          (ihandle->get_flags() & SCRIPT_SEQUENTIAL_VAR_E))
+        last_use[ihandle->get_var_number()] = j;
+    }
+  }
+
+  // Assign registers in program order
+  std::map<int,size_type> register_of;
+  std::map<size_type,std::vector<size_type> > free_registers;
+  // Register offsets of the S/V/T arguments of each function, in argument
+  // order, -1 for arguments that are not stored in a register
+  std::vector<std::vector<index_type> > arguments(num_functions);
+
+  for (size_t j=0; j<num_functions; j++)
+  {
+    ParserScriptFunctionHandle fhandle;
+    pprogram->get_sequential_function(j,fhandle);
+    size_t num_inputs = fhandle->num_input_vars();
+    arguments[j].assign(num_inputs+1,-1);
+
+    for (size_t i=0; i<num_inputs; i++)
+    {
+      ParserScriptVariableHandle ihandle = fhandle->get_input_var(i);
+      if (!(type_width(ihandle->get_type())) ||
+          !(ihandle->get_flags() & SCRIPT_SEQUENTIAL_VAR_E)) continue;
+
+      std::map<int,size_type>::iterator it = register_of.find(ihandle->get_var_number());
+      if (it != register_of.end())
+      {
+        arguments[j][i+1] = it->second;
+      }
+      else if (ihandle->get_flags() & SCRIPT_CONST_VAR_E)
+      {
+        // Buffer filled once by the const part of the program, it is shared
+        // by all threads and only read
+        if (i < 3) program.instructions_[j].external[i] =
+          mprogram->get_sequential_variable(ihandle->get_var_number(),0)->get_data();
+      }
+      else
+      {
+        // Variable is used before it is computed, leave it to the interpreter
+        return (ArrayMathCompiledProgramHandle());
+      }
+    }
+
+    ParserScriptVariableHandle ohandle = fhandle->get_output_var();
+    size_type width = type_width(ohandle->get_type());
+    if (width)
+    {
+      int onum = ohandle->get_var_number();
+      std::map<int,size_type>::iterator it = register_of.find(onum);
+      if (it == register_of.end())
+      {
+        std::vector<size_type>& free_list = free_registers[width];
+        size_type offset;
+        if (free_list.empty())
+        {
+          offset = program.register_width_;
+          program.register_width_ += width;
+        }
+        else
+        {
+          offset = free_list.back();
+          free_list.pop_back();
+        }
+        it = register_of.insert(std::make_pair(onum,offset)).first;
+      }
+      arguments[j][0] = it->second;
+    }
+
+    // Release the registers that are not needed anymore
+    for (std::map<int,size_t>::iterator it = last_use.begin(); it != last_use.end(); ++it)
+    {
+      if (it->second != j) continue;
+      std::map<int,size_type>::iterator rit = register_of.find(it->first);
+      if (rit == register_of.end()) continue;
+      ParserScriptVariableHandle vhandle;
+      pprogram->get_sequential_variable(it->first,vhandle);
+      free_registers[type_width(vhandle->get_type())].push_back(rit->second);
+      register_of.erase(rit);
+    }
+
+    Instruction& instr = program.instructions_[j];
+    instr.output = arguments[j][0] < 0 ? 0 : arguments[j][0];
+    for (size_t i=0; i<num_inputs && i<3; i++)
+      instr.input[i] = arguments[j][i+1] < 0 ? 0 : arguments[j][i+1];
+    if (!(program.compile_function(fhandle,instr))) instr.op = FUNCTION_E;
+  }
+
+  // Allocate the registers and point the program code of every function at
+  // them, so functions without a compiled loop read and write the same memory
+  int num_proc = mprogram->get_num_proc();
+  program.registers_.resize(num_proc);
+  for (int np=0; np<num_proc; np++)
+  {
+    program.registers_[np].resize(program.register_width_*program.block_size_+1);
+    double* registers = &(program.registers_[np][0]);
+    for (size_t j=0; j<num_functions; j++)
+    {
+      ArrayMathProgramCodePtr pc = mprogram->get_sequential_program_code(j,np);
+      for (size_t i=0; i<arguments[j].size(); i++)
+      {
+        if (arguments[j][i] >= 0)
+          pc->set_variable(i,registers+arguments[j][i]*program.block_size_);
+      }
+    }
+  }
+
+  return (handle);
+}
+
+bool
+ArrayMathCompiledProgram::compile_function(ParserScriptFunctionHandle& fhandle,
+                                           Instruction& instr)
+{
+  const std::string& id = fhandle->get_function()->get_function_id();
+  ParserScriptVariableHandle ohandle = fhandle->get_output_var();
+  size_t num_inputs = fhandle->num_input_vars();
+
+  // Data sources and sinks
+  if (id == "get_scalar$FD" || id == "get_vector$FD")
+  {
+    ArrayMathProgramSource ps;
+    if (!(mprogram_->find_source(fhandle->get_input_var(0)->get_name(),ps)) ||
+        !(ps.is_vfield())) return (false);
+    instr.vfield = ps.get_vfield();
+    if (!(select_access(instr.vfield,instr.load,instr.store))) return (false);
+    bool vector = (id == "get_vector$FD");
+    if (vector != instr.vfield->is_vector()) return (false);
+    instr.op = vector ? LOAD_VECTOR_E : LOAD_SCALAR_E;
+    return (true);
+  }
+  if (id == "to_fielddata$S" || id == "to_fielddata$V")
+  {
+    ArrayMathProgramSource ps;
+    if (!(mprogram_->find_sink(ohandle->get_name(),ps)) ||
+        !(ps.is_vfield())) return (false);
+    instr.vfield = ps.get_vfield();
+    if (!(select_access(instr.vfield,instr.load,instr.store))) return (false);
+    bool vector = (id == "to_fielddata$V");
+    if (vector != instr.vfield->is_vector()) return (false);
+    if (!(fhandle->get_input_var(0)->get_flags() & SCRIPT_SEQUENTIAL_VAR_E)) return (false);
+    instr.op = vector ? STORE_VECTOR_E : STORE_SCALAR_E;
+    return (true);
+  }
+
+  // All other compiled functions produce a register
+  instr.width = type_width(ohandle->get_type());
+  if (instr.width == 0) return (false);
+
+  // Broadcast of a constant or a value computed once
+  if (id == "seq$S" || id == "seq$V" || id == "seq$T")
+  {
+    ParserScriptVariableHandle ihandle = fhandle->get_input_var(0);
+    int flags = ihandle->get_flags();
+    if (flags & SCRIPT_SEQUENTIAL_VAR_E)
+    {
+      instr.op = COPY_E;
+      return (true);
+    }
+    if (flags & SCRIPT_SINGLE_VAR_E)
+      instr.constant = mprogram_->get_single_variable(ihandle->get_var_number())->get_data();
+    else if (flags & SCRIPT_CONST_VAR_E)
+      instr.constant = mprogram_->get_const_variable(ihandle->get_var_number())->get_data();
+    if (!instr.constant) return (false);
+    instr.op = BROADCAST_E;
+    return (true);
+  }
+
+  // The compiled loops only read registers
+  for (size_t i=0; i<num_inputs; i++)
+  {
+    ParserScriptVariableHandle ihandle = fhandle->get_input_var(i);
+    if (!(type_width(ihandle->get_type())) ||
+        !(ihandle->get_flags() & SCRIPT_SEQUENTIAL_VAR_E)) return (false);
+  }
+
+  // Element wise functions that are the same for scalars, vectors and tensors
+  if (id == "add$S:S" || id == "add$V:V" || id == "add$T:T") { instr.op = ADD_E; return (true); }
+  if (id == "sub$S:S" || id == "sub$V:V" || id == "sub$T:T") { instr.op = SUB_E; return (true); }
+  if (id == "neg$S" || id == "neg$V" || id == "neg$T") { instr.op = NEG_E; return (true); }
+  if (id == "add$V:S" || id == "add$T:S") { instr.op = ADD_VS_E; return (true); }
+  if (id == "sub$V:S" || id == "sub$T:S") { instr.op = SUB_VS_E; return (true); }
+  if (id == "sub$S:V" || id == "sub$S:T") { instr.op = SUB_SV_E; return (true); }
+  if (id == "mult$V:S" || id == "mult$T:S") { instr.op = MULT_VS_E; return (true); }
+  if (id == "div$V:S" || id == "div$T:S") { instr.op = DIV_VS_E; return (true); }
+
+  // Scalar functions
+  if (id == "mult$S:S") { instr.op = MULT_E; return (true); }
+  if (id == "div$S:S") { instr.op = DIV_E; return (true); }
+  if (id == "rem$S:S") { instr.op = REM_E; return (true); }
+  if (id == "sqrt$S") { instr.op = SQRT_E; return (true); }
+  if (id == "exp$S") { instr.op = EXP_E; return (true); }
+  if (id == "log$S" || id == "ln$S") { instr.op = LOG_E; return (true); }
+  if (id == "sin$S") { instr.op = SIN_E; return (true); }
+  if (id == "cos$S") { instr.op = COS_E; return (true); }
+  if (id == "tan$S") { instr.op = TAN_E; return (true); }
+  if (id == "abs$S") { instr.op = ABS_E; return (true); }
+  if (id == "floor$S") { instr.op = FLOOR_E; return (true); }
+  if (id == "ceil$S") { instr.op = CEIL_E; return (true); }
+  if (id == "pow$S:S") { instr.op = POW_E; return (true); }
+  if (id == "min$S:S") { instr.op = MIN_E; return (true); }
+  if (id == "max$S:S") { instr.op = MAX_E; return (true); }
+  if (id == "and$S:S") { instr.op = AND_E; return (true); }
+  if (id == "or$S:S") { instr.op = OR_E; return (true); }
+  if (id == "eq$S:S") { instr.op = EQ_E; return (true); }
+  if (id == "neq$S:S") { instr.op = NEQ_E; return (true); }
+  if (id == "le$S:S") { instr.op = LE_E; return (true); }
+  if (id == "ge$S:S") { instr.op = GE_E; return (true); }
+  if (id == "ls$S:S") { instr.op = LS_E; return (true); }
+  if (id == "gt$S:S") { instr.op = GT_E; return (true); }
+  if (id == "select$S:S:S") { instr.op = SELECT_E; return (true); }
+
+  // Vector functions
+  if (id == "vector$S:S:S" || id == "Vector$S:S:S") { instr.op = VECTOR_E; return (true); }
+  if (id == "x$V") { instr.op = X_E; return (true); }
+  if (id == "y$V") { instr.op = Y_E; return (true); }
+  if (id == "z$V") { instr.op = Z_E; return (true); }
+  if (id == "dot$V:V") { instr.op = DOT_E; return (true); }
+  if (id == "cross$V:V") { instr.op = CROSS_E; return (true); }
+  if (id == "norm$V") { instr.op = NORM_E; return (true); }
+
+  return (false);
+}
+
+bool
+ArrayMathCompiledProgram::prepare_fields()
+{
+  size_type array_size = mprogram_->get_array_size();
+  for (size_t j=0; j<instructions_.size(); j++)
+  {
+    Instruction& instr = instructions_[j];
+    if (!instr.vfield || instr.op == FUNCTION_E) continue;
+
+    // The data may have been reallocated since the program was compiled,
+    // fields that are too small are left to the range checked interpreter
+    instr.data = instr.vfield->fdata_pointer();
+    if (!instr.data || instr.vfield->num_values() < array_size)
+      instr.op = FUNCTION_E;
+  }
+  return (true);
+}
+
+bool
+ArrayMathCompiledProgram::run(size_t& error_line)
+{
+  prepare_fields();
+
+  int num_proc = mprogram_->get_num_proc();
+  error_line_.assign(num_proc,0);
+  success_.assign(num_proc,1);
+
+  Parallel::RunTasks(boost::bind(&ArrayMathCompiledProgram::run_parallel, this, _1), num_proc);
+
+  for (int j=0; j<num_proc; j++)
+  {
+    if (!success_[j])
+    {
+      error_line = error_line_[j];
+      return (false);
+    }
+  }
+  return (true);
+}
+
+void
+ArrayMathCompiledProgram::run_parallel(int proc)
+{
+  int num_proc = mprogram_->get_num_proc();
+  index_type array_size = mprogram_->get_array_size();
+  index_type per_thread = array_size/num_proc;
+  index_type start = proc*per_thread;
+  index_type end = (proc+1)*per_thread;
+  if (proc+1 == num_proc) end = array_size;
+
+  double* registers = &(registers_[proc][0]);
+  size_t num_instructions = instructions_.size();
+
+  for (index_type offset = start; offset < end; offset += block_size_)
+  {
+    const size_type n = std::min<size_type>(block_size_,end-offset);
+
+    for (size_t j=0; j<num_instructions; j++)
+    {
+      const Instruction& instr = instructions_[j];
+      double* r0 = registers + instr.output*block_size_;
+      const double* r1 = instr.external[0] ? instr.external[0] : registers + instr.input[0]*block_size_;
+      const double* r2 = instr.external[1] ? instr.external[1] : registers + instr.input[1]*block_size_;
+      const double* r3 = instr.external[2] ? instr.external[2] : registers + instr.input[2]*block_size_;
+      const size_type w = instr.width;
+      const size_type nw = n*w;
+
+      switch (instr.op)
+      {
+        case FUNCTION_E:
+        {
+          ArrayMathProgramCodePtr pc = mprogram_->get_sequential_program_code(j,proc);
+          pc->set_index(offset);
+          pc->set_size(n);
+          if (!(pc->run()))
+          {
+            error_line_[proc] = j;
+            success_[proc] = 0;
+            return;
+          }
+          break;
+        }
+        case LOAD_SCALAR_E:
+        case LOAD_VECTOR_E:
+          instr.load(instr.data,offset,n,r0);
+          break;
+        case STORE_SCALAR_E:
+        case STORE_VECTOR_E:
+          instr.store(instr.data,offset,n,r1);
+          break;
+        case BROADCAST_E:
+          for (size_type k=0; k<n; k++)
+            for (size_type c=0; c<w; c++) r0[k*w+c] = instr.constant[c];
+          break;
+        case COPY_E:
+          std::copy(r1,r1+nw,r0);
+          break;
+
+        case ADD_E:  for (size_type k=0; k<nw; k++) r0[k] = r1[k] + r2[k]; break;
+        case SUB_E:  for (size_type k=0; k<nw; k++) r0[k] = r1[k] - r2[k]; break;
+        case NEG_E:  for (size_type k=0; k<nw; k++) r0[k] = -r1[k]; break;
+        case ADD_VS_E:
+          for (size_type k=0; k<n; k++)
+            for (size_type c=0; c<w; c++) r0[k*w+c] = r1[k*w+c] + r2[k];
+          break;
+        case SUB_VS_E:
+          for (size_type k=0; k<n; k++)
+            for (size_type c=0; c<w; c++) r0[k*w+c] = r1[k*w+c] - r2[k];
+          break;
+        case SUB_SV_E:
+          for (size_type k=0; k<n; k++)
+            for (size_type c=0; c<w; c++) r0[k*w+c] = r1[k] - r2[k*w+c];
+          break;
+        case MULT_VS_E:
+          for (size_type k=0; k<n; k++)
+            for (size_type c=0; c<w; c++) r0[k*w+c] = r1[k*w+c] * r2[k];
+          break;
+        case DIV_VS_E:
+          for (size_type k=0; k<n; k++)
+          {
+            const double val = 1.0/r2[k];
+            for (size_type c=0; c<w; c++) r0[k*w+c] = r1[k*w+c] * val;
+          }
+          break;
+
+        case MULT_E:  for (size_type k=0; k<n; k++) r0[k] = r1[k] * r2[k]; break;
+        case DIV_E:   for (size_type k=0; k<n; k++) r0[k] = r1[k] / r2[k]; break;
+        case REM_E:   for (size_type k=0; k<n; k++) r0[k] = ::fmod(r1[k],r2[k]); break;
+        case SQRT_E:  for (size_type k=0; k<n; k++) r0[k] = ::sqrt(r1[k]); break;
+        case EXP_E:   for (size_type k=0; k<n; k++) r0[k] = ::exp(r1[k]); break;
+        case LOG_E:   for (size_type k=0; k<n; k++) r0[k] = ::log(r1[k]); break;
+        case SIN_E:   for (size_type k=0; k<n; k++) r0[k] = ::sin(r1[k]); break;
+        case COS_E:   for (size_type k=0; k<n; k++) r0[k] = ::cos(r1[k]); break;
+        case TAN_E:   for (size_type k=0; k<n; k++) r0[k] = ::tan(r1[k]); break;
+        case ABS_E:   for (size_type k=0; k<n; k++) r0[k] = r1[k] < 0 ? -r1[k] : r1[k]; break;
+        case FLOOR_E: for (size_type k=0; k<n; k++) r0[k] = ::floor(r1[k]); break;
+        case CEIL_E:  for (size_type k=0; k<n; k++) r0[k] = ::ceil(r1[k]); break;
+        case POW_E:   for (size_type k=0; k<n; k++) r0[k] = ::pow(r1[k],r2[k]); break;
+        case MIN_E:   for (size_type k=0; k<n; k++) r0[k] = r1[k] < r2[k] ? r1[k] : r2[k]; break;
+        case MAX_E:   for (size_type k=0; k<n; k++) r0[k] = r1[k] > r2[k] ? r1[k] : r2[k]; break;
+        case AND_E:   for (size_type k=0; k<n; k++) r0[k] = (r1[k] && r2[k]); break;
+        case OR_E:    for (size_type k=0; k<n; k++) r0[k] = (r1[k] || r2[k]); break;
+        case EQ_E:    for (size_type k=0; k<n; k++) r0[k] = r1[k] == r2[k] ? 1.0 : 0.0; break;
+        case NEQ_E:   for (size_type k=0; k<n; k++) r0[k] = r1[k] != r2[k] ? 1.0 : 0.0; break;
+        case LE_E:    for (size_type k=0; k<n; k++) r0[k] = r1[k] <= r2[k] ? 1.0 : 0.0; break;
+        case GE_E:    for (size_type k=0; k<n; k++) r0[k] = r1[k] >= r2[k] ? 1.0 : 0.0; break;
+        case LS_E:    for (size_type k=0; k<n; k++) r0[k] = r1[k] < r2[k] ? 1.0 : 0.0; break;
+        case GT_E:    for (size_type k=0; k<n; k++) r0[k] = r1[k] > r2[k] ? 1.0 : 0.0; break;
+        case SELECT_E: for (size_type k=0; k<n; k++) r0[k] = r1[k] ? r2[k] : r3[k]; break;
+
+        case VECTOR_E:
+          for (size_type k=0; k<n; k++)
+          {
+            r0[3*k] = r1[k]; r0[3*k+1] = r2[k]; r0[3*k+2] = r3[k];
+          }
+          break;
+        case X_E: for (size_type k=0; k<n; k++) r0[k] = r1[3*k]; break;
+        case Y_E: for (size_type k=0; k<n; k++) r0[k] = r1[3*k+1]; break;
+        case Z_E: for (size_type k=0; k<n; k++) r0[k] = r1[3*k+2]; break;
+        case DOT_E:
+          for (size_type k=0; k<n; k++)
+            r0[k] = r1[3*k]*r2[3*k] + r1[3*k+1]*r2[3*k+1] + r1[3*k+2]*r2[3*k+2];
+          break;
+        case CROSS_E:
+          for (size_type k=0; k<n; k++)
+          {
+            const double* a = r1+3*k;
+            const double* b = r2+3*k;
+            r0[3*k]   = a[1]*b[2] - a[2]*b[1];
+            r0[3*k+1] = a[2]*b[0] - a[0]*b[2];
+            r0[3*k+2] = a[0]*b[1] - a[1]*b[0];
+          }
+          break;
+        case NORM_E:
+          for (size_type k=0; k<n; k++)
+            r0[k] = ::sqrt(r1[3*k]*r1[3*k] + r1[3*k+1]*r1[3*k+1] + r1[3*k+2]*r1[3*k+2]);
+          break;
+      }
+    }
+  }
+}
@@ -0,0 +1,150 @@
+//  
+//  For more information, please see: http://software.sci.utah.edu
+//  
+//  The MIT License
+//  
+//  Copyright (c) 2015 Scientific Computing and Imaging Institute,
+//  University of Utah.
+//  
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//  
+
+#ifndef CORE_PARSER_ARRAYMATHCOMPILER_H
+#define CORE_PARSER_ARRAYMATHCOMPILER_H 1
+
+#include <Core/Parser/ArrayMathInterpreter.h>
+
+// Include files needed for Windows
+#include <Core/Parser/share.h>
+
+namespace SCIRun {
+
+//-----------------------------------------------------------------------------
+// Compiled form of the sequential part of an ArrayMathProgram.
+//
+// The interpreter evaluates every function of the sequential list on a buffer
+// of 128 values and gives every variable of the script its own buffer. Field
+// data is read and written through the virtual VField accessors, one value at
+// the time. This class lowers the same function list into a small register
+// machine:
+//
+// - every sequential variable gets a register of one buffer of values,
+//   registers are reused as soon as the last function reading them has run,
+//   so the working set of a block stays in the first level cache;
+// - the common arithmetic, comparison and vector functions are evaluated by
+//   tight loops over these registers that the compiler can vectorize;
+// - field data sources and sinks access the raw field data directly, with the
+//   conversions done by CastFData, exactly like VField::get_value/set_value.
+//
+// Every other function of the catalog still runs through its ArrayMathFunction,
+// with its buffers pointing at the registers, so any script can be compiled.
+// The results are identical to the interpreted program.
+
+class ArrayMathCompiledProgram;
+typedef boost::shared_ptr<ArrayMathCompiledProgram> ArrayMathCompiledProgramHandle;
+
+class SCISHARE ArrayMathCompiledProgram : boost::noncopyable {
+  public:
+    // Lower the sequential list of a translated program. The program code of
+    // the sequential functions is rebound to the registers of the compiled
+    // program, hence the result should be stored in the program with
+    // set_compiled_program().
+    static ArrayMathCompiledProgramHandle compile(ParserProgramHandle& pprogram,
+                                                  ArrayMathProgram* mprogram);
+
+    // Run the sequential part of the program, error_line is the sequential
+    // function that failed
+    bool run(size_t& error_line);
+
+    // Number of values processed per block
+    size_type get_block_size() const { return (block_size_); }
+    // Number of doubles in the registers for one value
+    size_type get_register_width() const { return (register_width_); }
+    // Number of sequential functions and how many of them are evaluated by
+    // the compiled loops instead of the catalog functions
+    size_t num_instructions() const { return (instructions_.size()); }
+    size_t num_compiled_instructions() const;
+
+  private:
+    explicit ArrayMathCompiledProgram(ArrayMathProgram* mprogram);
+
+    // Compiled operations, the ones that are not listed use the catalog
+    // function
+    enum OpCode {
+      FUNCTION_E = 0,
+      LOAD_SCALAR_E, LOAD_VECTOR_E, STORE_SCALAR_E, STORE_VECTOR_E,
+      BROADCAST_E, COPY_E,
+      ADD_E, SUB_E, MULT_E, DIV_E, NEG_E, REM_E,
+      ADD_VS_E, SUB_VS_E, SUB_SV_E, MULT_VS_E, DIV_VS_E,
+      SQRT_E, EXP_E, LOG_E, SIN_E, COS_E, TAN_E, ABS_E, FLOOR_E, CEIL_E,
+      POW_E, MIN_E, MAX_E, AND_E, OR_E,
+      EQ_E, NEQ_E, LE_E, GE_E, LS_E, GT_E, SELECT_E,
+      VECTOR_E, X_E, Y_E, Z_E, DOT_E, CROSS_E, NORM_E
+    };
+
+    // Conversion between raw field data and double registers
+    typedef void (*LoadFunction)(const void* data, index_type offset, size_type size, double* dest);
+    typedef void (*StoreFunction)(void* data, index_type offset, size_type size, const double* src);
+
+    struct Instruction {
+      Instruction() : op(FUNCTION_E), width(1), output(0), constant(0),
+        vfield(0), load(0), store(0), data(0)
+      {
+        for (int k=0; k<3; k++) { input[k] = 0; external[k] = 0; }
+      }
+
+      OpCode     op;
+      // Number of doubles per value of the output (or of the input for sinks)
+      size_type  width;
+      // Register offsets in doubles per value
+      size_type  output;
+      size_type  input[3];
+      // Inputs that are constant buffers of the program instead of registers
+      const double* external[3];
+      // Value that is broadcast by BROADCAST_E
+      double*    constant;
+      // Field data source or sink
+      VField*        vfield;
+      LoadFunction   load;
+      StoreFunction  store;
+      // Raw field data, looked up when the program is run
+      void*          data;
+    };
+
+    bool compile_function(ParserScriptFunctionHandle& fhandle, Instruction& instr);
+    bool prepare_fields();
+    void run_parallel(int proc);
+
+    ArrayMathProgram* mprogram_;
+
+    size_type block_size_;
+    size_type register_width_;
+
+    std::vector<Instruction> instructions_;
+    // Register file for each thread
+    std::vector<std::vector<double> > registers_;
+
+    std::vector<size_t> error_line_;
+    std::vector<char>   success_;
+};
+
+}
+
+#endif
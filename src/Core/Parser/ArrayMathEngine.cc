@@ -1836,3 +1836,10 @@ NewArrayMathEngine::clear()
   fieldmesh_.clear();
   matrixdata_.clear();
 }
+
+std::string
+NewArrayMathEngine::get_optimized_program() const
+{
+  if (!pprogram_) return (std::string());
+  return (pprogram_->get_optimized_program());
+}
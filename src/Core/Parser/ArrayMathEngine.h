@@ -189,6 +189,9 @@ class SCISHARE NewArrayMathEngine : public Parser, public ArrayMathInterpreter
 
     // Clean up the engine
     void clear();
+
+    // Listing of the optimized program of the last run, for debugging
+    std::string get_optimized_program() const;
     
   private:
     Core::Logging::ConsoleLogger def_pr_;
@@ -27,6 +27,7 @@
 //  
 
 #include <Core/Parser/ArrayMathInterpreter.h> 
+#include <Core/Parser/ArrayMathCompiler.h>
 #include <Core/Parser/ArrayMathFunctionCatalog.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
@@ -1188,6 +1189,14 @@ ArrayMathInterpreter::translate(ParserProgramHandle& pprogram,
     }
   }
 
+  // Lower the sequential list into fused blocks, this rebinds the buffers of
+  // the sequential program code to the registers of the compiled program
+  if (compile_sequential_)
+  {
+    mprogram->set_compiled_program(
+      ArrayMathCompiledProgram::compile(pprogram,mprogram.get()));
+  }
+
   return (true);
 }
 
@@ -1512,6 +1521,8 @@ ArrayMathProgram::run_single(size_t& error_line)
 bool
 ArrayMathProgram::run_sequential(size_t& error_line)
 {  
+  if (compiled_program_) return (compiled_program_->run(error_line));
+
   error_line_.resize(num_proc_,0);
   success_.resize(num_proc_,true);
   
@@ -56,6 +56,7 @@ class ArrayMathFunction;
 class ArrayMathProgram;
 class ArrayMathProgramCode;
 class ArrayMathProgramVariable;
+class ArrayMathCompiledProgram;
 
 // Handles for a few of the classes
 // As Program is stored in a large array we do not need a handle for that
@@ -63,6 +64,7 @@ class ArrayMathProgramVariable;
 
 typedef boost::shared_ptr<ArrayMathProgramVariable> ArrayMathProgramVariableHandle;
 typedef boost::shared_ptr<ArrayMathProgram>         ArrayMathProgramHandle;
+typedef boost::shared_ptr<ArrayMathCompiledProgram> ArrayMathCompiledProgramHandle;
 
 //-----------------------------------------------------------------------------
 // Functions for databasing the function calls that make up the program
@@ -407,6 +409,15 @@ class SCISHARE ArrayMathProgramSource {
       { single_functions_[j] = pc; }
     void set_sequential_program_code(size_t j, size_t np, ArrayMathProgramCodePtr pc)
       { sequential_functions_[np][j] = pc; }
+    ArrayMathProgramCodePtr get_sequential_program_code(size_t j, size_t np) const
+      { return (sequential_functions_[np][j]); }
+
+    // Compiled version of the sequential program code, when set it is used
+    // instead of the interpreted buffers
+    void set_compiled_program(ArrayMathCompiledProgramHandle handle)
+      { compiled_program_ = handle; }
+    ArrayMathCompiledProgramHandle get_compiled_program() const
+      { return (compiled_program_); }
     
     // Code to find the pointers that are given for sources and sinks  
     bool find_source(const std::string& name,  ArrayMathProgramSource& ps);
@@ -445,6 +456,7 @@ class SCISHARE ArrayMathProgramSource {
     std::vector<ArrayMathProgramCodePtr> const_functions_;
     std::vector<ArrayMathProgramCodePtr> single_functions_;
     std::vector<std::vector<ArrayMathProgramCodePtr> > sequential_functions_;
+    ArrayMathCompiledProgramHandle compiled_program_;
     
     ParserProgramHandle pprogram_;
     
@@ -462,6 +474,13 @@ class SCISHARE ArrayMathProgramSource {
 class SCISHARE ArrayMathInterpreter {
 
   public:
+    ArrayMathInterpreter() : compile_sequential_(true) {}
+
+    // Compile the sequential part of the program into fused blocks when
+    // translating (default), or run it through the interpreter buffers
+    void set_compile_sequential(bool compile) { compile_sequential_ = compile; }
+    bool get_compile_sequential() const { return (compile_sequential_); }
+
     // The interpreter Creates executable code from the parsed code
     // The first step is setting the data sources and sinks
 
@@ -557,7 +576,9 @@ class SCISHARE ArrayMathInterpreter {
     // Step 4: Run the code
   
     bool run(ArrayMathProgramHandle& mprogram,std::string& error);
-    
+
+  private:
+    bool compile_sequential_;
 };
 
 }
@@ -200,4 +200,11 @@ NewLinAlgEngine::clear()
   matrixdata_.clear();
 }
 
+std::string
+NewLinAlgEngine::get_optimized_program() const
+{
+  if (!pprogram_) return (std::string());
+  return (pprogram_->get_optimized_program());
+}
+
 } // end namespace
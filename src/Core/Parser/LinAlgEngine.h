@@ -79,6 +79,9 @@ class SCISHARE NewLinAlgEngine : public Parser, public LinAlgInterpreter
     // Clean up the engine
     void clear();
 
+    // Listing of the optimized program of the last run, for debugging
+    std::string get_optimized_program() const;
+
   private:
     Core::Logging::LoggerHandle  def_pr_;
     // Progress reporter for reporting error
@@ -33,6 +33,9 @@
 #include <sci_debug.h>
 #include <boost/math/constants/constants.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <sstream>
 
 using namespace SCIRun;
 
@@ -76,6 +79,63 @@ namespace
     }
   return (fid);
   }
+
+  // Evaluate a scalar function on constant arguments. Only pure functions
+  // are listed, they use the same expressions as the ArrayMath and LinAlg
+  // catalogs so folding does not change the result.
+  bool
+  ParserFoldScalarFunction(const std::string& fid, const std::vector<double>& a, double& val)
+  {
+  if (a.size() == 1)
+    {
+    if (fid == "neg$S") { val = -a[0]; return (true); }
+    if (fid == "abs$S") { val = (a[0] < 0 ? -a[0] : a[0]); return (true); }
+    if (fid == "sqrt$S") { val = ::sqrt(a[0]); return (true); }
+    if (fid == "exp$S") { val = ::exp(a[0]); return (true); }
+    if (fid == "log$S" || fid == "ln$S") { val = ::log(a[0]); return (true); }
+    if (fid == "sin$S") { val = ::sin(a[0]); return (true); }
+    if (fid == "cos$S") { val = ::cos(a[0]); return (true); }
+    if (fid == "tan$S") { val = ::tan(a[0]); return (true); }
+    if (fid == "floor$S") { val = ::floor(a[0]); return (true); }
+    if (fid == "ceil$S") { val = ::ceil(a[0]); return (true); }
+    }
+  else if (a.size() == 2)
+    {
+    if (fid == "add$S:S") { val = a[0] + a[1]; return (true); }
+    if (fid == "sub$S:S") { val = a[0] - a[1]; return (true); }
+    if (fid == "mult$S:S") { val = a[0] * a[1]; return (true); }
+    if (fid == "div$S:S") { val = a[0] / a[1]; return (true); }
+    if (fid == "rem$S:S") { val = ::fmod(a[0],a[1]); return (true); }
+    if (fid == "pow$S:S") { val = ::pow(a[0],a[1]); return (true); }
+    if (fid == "min$S:S") { val = (a[0] < a[1] ? a[0] : a[1]); return (true); }
+    if (fid == "max$S:S") { val = (a[0] > a[1] ? a[0] : a[1]); return (true); }
+    }
+  return (false);
+  }
+
+  // Check whether a script variable is the numerical constant val
+  bool
+  ParserIsConstant(const ParserScriptVariableHandle& handle, double val)
+  {
+  return (handle->get_kind() == SCRIPT_CONSTANT_SCALAR_E &&
+          handle->get_scalar_value() == val);
+  }
+
+  // Name used for a script variable in the optimized program listing
+  std::string
+  ParserScriptVariableLabel(const ParserScriptVariableHandle& handle)
+  {
+  if (handle->get_kind() == SCRIPT_CONSTANT_SCALAR_E)
+  {
+    std::ostringstream oss;
+    oss << handle->get_scalar_value();
+    return (oss.str());
+  }
+  if (handle->get_kind() == SCRIPT_CONSTANT_STRING_E)
+    return ("'" + handle->get_string_value() + "'");
+  if (!handle->get_name().empty()) return (handle->get_name());
+  return (handle->get_uname());
+  }
 }
 void ParserNode::print(int level) const
 {
@@ -185,6 +245,37 @@ ParserProgram::print() const
 }
 
 
+std::string
+ParserProgram::get_optimized_program() const
+{
+  std::ostringstream oss;
+
+  const std::vector<ParserScriptFunctionHandle>* lists[3] =
+    { &const_functions_, &single_functions_, &sequential_functions_ };
+  const char* headers[3] = { "CONST", "SINGLE", "SEQUENTIAL" };
+
+  for (size_t k=0; k<3; k++)
+  {
+    oss << "--- " << headers[k] << " FUNCTION LIST ---\n";
+    for (size_t j=0; j<lists[k]->size(); j++)
+    {
+      ParserScriptFunctionHandle fhandle = (*lists[k])[j];
+      oss << "  " << ParserScriptVariableLabel(fhandle->get_output_var())
+          << " = " << fhandle->get_name() << "(";
+      size_t num_input_vars = fhandle->num_input_vars();
+      for (size_t i=0; i<num_input_vars; i++)
+      {
+        oss << ParserScriptVariableLabel(fhandle->get_input_var(i));
+        if (i < (num_input_vars-1)) oss << ",";
+      }
+      oss << ")\n";
+    }
+  }
+
+  return (oss.str());
+}
+
+
 void
 ParserFunctionCatalog::print() const
 {
@@ -2478,6 +2569,27 @@ Parser::optimize(ParserProgramHandle program,
     named_order[varname] = order; order++;
   }
 
+  // Phase 2c: Fold functions on constants and remove algebraic identities,
+  // so the duplicate removal below sees the simplified expressions.
+  // Users of output variables are not rewired, as the output variables may
+  // still need to be sequenced in the next phase
+  std::set<ParserScriptVariableHandle> output_handles;
+  {
+    ParserVariableList output_variables;
+    program->get_output_variables(output_variables);
+
+    ParserVariableList::iterator vit = output_variables.begin();
+    while (vit != output_variables.end())
+    {
+      std::map<std::string,ParserScriptVariableHandle>::iterator nit;
+      nit = named_variables.find((*vit).first);
+      if (nit != named_variables.end()) output_handles.insert((*nit).second);
+      ++vit;
+    }
+  }
+
+  if (!(optimize_simplify(program,variables,functions,output_handles,cnt,error))) return (false);
+
   // Now variables and functions should contain a list of needed spaces and
   // functions contains a list in order in which expression need to be evaluated
 
@@ -2658,59 +2770,58 @@ Parser::optimize(ParserProgramHandle program,
 
 
   // Phase 5: Remove duplicate expressions
+  // Every used function is hashed on its dependence string, which names the
+  // function and the unique names of its inputs. As the list is in evaluation
+  // order, inputs are rewritten to their surviving copies before the function
+  // itself is hashed, so one pass finds nested duplicates as well.
+  // Unused functions are skipped, they are removed in the next phase and
+  // cannot stand in for a function that is used. Program outputs are never
+  // removed as they need their own storage, and functions without arguments
+  // (e.g. rand) are never shared.
+
+  std::map<std::string,ParserScriptVariableHandle> expressions;
+  std::map<ParserScriptVariableHandle,ParserScriptVariableHandle> duplicates;
+  std::set<ParserScriptVariableHandle> protected_variables(ovariables.begin(),ovariables.end());
 
   fit = functions.begin();
   fit_end = functions.end();
 
-  std::string dependence, dependence2;
-  
   while (fit != fit_end)
   {
+    if (!((*fit)->get_flags() & SCRIPT_USED_VAR_E)) { ++fit; continue; }
+
+    size_t num_input_vars = (*fit)->num_input_vars();
+    for (size_t j=0; j<num_input_vars;j++)
+    {
+      std::map<ParserScriptVariableHandle,ParserScriptVariableHandle>::iterator dit =
+        duplicates.find((*fit)->get_input_var(j));
+      if (dit != duplicates.end()) (*fit)->set_input_var(j,(*dit).second);
+    }
+
+    if (num_input_vars == 0) { ++fit; continue; }
+
     ParserScriptVariableHandle handle = (*fit)->get_output_var();
     handle->compute_dependence();
-    dependence = handle->get_dependence();
- 
-    fit2 = functions.begin();
-    while (fit2 != fit)
-    {
-      ParserScriptVariableHandle nhandle = (*fit2)->get_output_var();
+    const std::string& dependence = handle->get_dependence();
 
-      dependence2 = nhandle->get_dependence();
-      if (dependence2 == dependence)
-      {
-        // The handle with which the ones in the script need to be replaced
-        // Expressions are equal
-        // Clear dependence, clear flags
-        handle->clear_dependence();
-        // Clear the used flag for this variable
-        handle->clear_flags();
-        ParserScriptFunctionHandle fhandle = handle->get_parent();
-        if (!fhandle)
-        {
-          error = "INTERNAL ERROR -  Duplicate input variable.";
-          return (false);
-        }
-        // Clear the function that computes the variable
-        fhandle->clear_flags();
-        std::list<ParserScriptFunctionHandle>::iterator hit, hit_end;
-        hit = functions.begin();
-        hit_end = functions.end();
-        while (hit != hit_end)
-        {
-          ParserScriptFunctionHandle hhandle = (*hit);
-          size_t num_input_vars = hhandle->num_input_vars();
-          for (size_t j=0; j<num_input_vars;j++)
-          {
-            if (hhandle->get_input_var(j) == handle)
-            {
-              hhandle->set_input_var(j,nhandle);
-            }
-          }
-          ++hit;
-        }
-      }
-      ++fit2;
-    }  
+    std::map<std::string,ParserScriptVariableHandle>::iterator eit =
+      expressions.find(dependence);
+
+    if (eit == expressions.end())
+    {
+      expressions[dependence] = handle;
+    }
+    else if (protected_variables.find(handle) == protected_variables.end())
+    {
+      // Expressions are equal
+      // Clear dependence, clear flags
+      handle->clear_dependence();
+      // Clear the used flag for this variable
+      handle->clear_flags();
+      // Clear the function that computes the variable
+      (*fit)->clear_flags();
+      duplicates[handle] = (*eit).second;
+    }
     ++fit;
   }
 
@@ -2908,6 +3019,139 @@ Parser::optimize_mark_used(ParserScriptFunctionHandle& fhandle)
 }
 
 
+// Fold functions whose arguments are all constants and remove algebraic
+// identities. The function list is processed in evaluation order and every
+// variable that is simplified is recorded in a replacement table, so the
+// functions that use it are rewired before they are inspected themselves.
+// Functions that are bypassed this way are not marked as used later on and
+// are dropped from the program, unless their result is a program output.
+// Only identities that are exact in floating point are applied, e.g. x*1 and
+// x-0, but not x+0 as it alters the sign of a negative zero.
+// Variables in output_handles are program outputs and keep their users.
+
+bool
+Parser::optimize_simplify(ParserProgramHandle& program,
+                          std::list<ParserScriptVariableHandle>& variables,
+                          std::list<ParserScriptFunctionHandle>& functions,
+                          std::set<ParserScriptVariableHandle>& output_handles,
+                          int& cnt,
+                          std::string& error)
+{
+  std::map<ParserScriptVariableHandle,ParserScriptVariableHandle> replace;
+  std::vector<double> args;
+
+  std::list<ParserScriptFunctionHandle>::iterator fit, fit_end;
+  fit = functions.begin();
+  fit_end = functions.end();
+
+  while (fit != fit_end)
+  {
+    ParserScriptFunctionHandle fhandle = (*fit);
+    size_t num_input_vars = fhandle->num_input_vars();
+
+    bool all_constant = (num_input_vars > 0);
+    args.resize(num_input_vars);
+
+    for (size_t j=0; j<num_input_vars; j++)
+    {
+      ParserScriptVariableHandle ihandle = fhandle->get_input_var(j);
+      std::map<ParserScriptVariableHandle,ParserScriptVariableHandle>::iterator rit =
+        replace.find(ihandle);
+      if (rit != replace.end())
+      {
+        ihandle = (*rit).second;
+        fhandle->set_input_var(j,ihandle);
+      }
+
+      if (ihandle->get_kind() == SCRIPT_CONSTANT_SCALAR_E)
+        args[j] = ihandle->get_scalar_value();
+      else
+        all_constant = false;
+    }
+
+    ParserScriptVariableHandle ohandle = fhandle->get_output_var();
+    const std::string& name = fhandle->get_name();
+    ParserScriptVariableHandle rhandle;
+    double val;
+
+    if (all_constant &&
+        ParserFoldScalarFunction(fhandle->get_function()->get_function_id(),args,val))
+    {
+      // Reuse the constant if it is already in the list
+      std::list<ParserScriptVariableHandle>::iterator pit, pit_end;
+      pit = variables.begin();
+      pit_end = variables.end();
+
+      while (pit != pit_end)
+      {
+        if (ParserIsConstant(*pit,val)) { rhandle = *pit; break; }
+        ++pit;
+      }
+
+      if (!rhandle)
+      {
+        std::string uname = "$D"+boost::lexical_cast<std::string>(cnt); cnt++;
+        rhandle.reset(new ParserScriptVariable(uname,val));
+        variables.push_back(rhandle);
+      }
+    }
+    else if (num_input_vars == 2)
+    {
+      ParserScriptVariableHandle ahandle = fhandle->get_input_var(0);
+      ParserScriptVariableHandle bhandle = fhandle->get_input_var(1);
+
+      if (name == "mult")
+      {
+        if (ParserIsConstant(bhandle,1.0)) rhandle = ahandle;
+        else if (ParserIsConstant(ahandle,1.0)) rhandle = bhandle;
+      }
+      else if (name == "div" || name == "pow")
+      {
+        if (ParserIsConstant(bhandle,1.0)) rhandle = ahandle;
+      }
+      else if (name == "sub")
+      {
+        if (ParserIsConstant(bhandle,0.0)) rhandle = ahandle;
+      }
+
+      // Squares are far cheaper as a multiplication
+      if (!rhandle && fhandle->get_function()->get_function_id() == "pow$S:S" &&
+          ParserIsConstant(bhandle,2.0))
+      {
+        ParserFunctionHandle fun_ptr;
+        if (program->get_catalog()->find_function("mult$S:S",fun_ptr))
+        {
+          ParserScriptFunctionHandle mhandle(new ParserScriptFunction("mult",fun_ptr));
+          mhandle->set_flags(fhandle->get_flags());
+          mhandle->set_input_var(0,ahandle);
+          mhandle->set_input_var(1,ahandle);
+          mhandle->set_output_var(ohandle);
+          ohandle->set_parent(mhandle);
+          (*fit) = mhandle;
+        }
+      }
+    }
+    else if (num_input_vars == 1 && name == "neg")
+    {
+      // -(-x) = x
+      ParserScriptFunctionHandle phandle = fhandle->get_input_var(0)->get_parent();
+      if (phandle && phandle->get_name() == "neg" && phandle->num_input_vars() == 1)
+        rhandle = phandle->get_input_var(0);
+    }
+
+    if (rhandle && rhandle->get_type() == ohandle->get_type() &&
+        output_handles.find(ohandle) == output_handles.end())
+    {
+      replace[ohandle] = rhandle;
+    }
+
+    ++fit;
+  }
+
+  return (true);
+}
+
+
 
 bool
 Parser::optimize_process_node(ParserNodeHandle& nhandle,
@@ -33,6 +33,7 @@
 #include <Core/Thread/Mutex.h>
 #include <map>
 #include <list>
+#include <set>
 
 // Include files needed for Windows
 #include <Core/Parser/share.h>
@@ -371,6 +372,10 @@ class SCISHARE ParserProgram {
     // For debugging
     void print() const;
 
+    // Listing of the optimized program, one function call per line, in the
+    // order in which the functions are evaluated
+    std::string get_optimized_program() const;
+
   private:
     // Short cut to the parser function catalog
     ParserFunctionCatalogHandle catalog_;
@@ -880,6 +885,13 @@ class SCISHARE Parser {
     // Sub functions for optimization
     void optimize_mark_used(ParserScriptFunctionHandle& fhandle);
 
+    bool optimize_simplify(ParserProgramHandle& program,
+          std::list<ParserScriptVariableHandle>& variables,
+          std::list<ParserScriptFunctionHandle>& functions,
+          std::set<ParserScriptVariableHandle>& output_handles,
+          int& cnt,
+          std::string& error);
+
     bool optimize_process_node(ParserNodeHandle& nhandle,
           std::list<ParserScriptVariableHandle>& variables,
           std::map<std::string,ParserScriptVariableHandle>& named_variables,
@@ -1404,6 +1404,135 @@ TEST_F(BasicParserTests, CreateFieldData_find_normal2)
   EXPECT_NEAR(19.4422, max,1e-4); 
 }
 
+namespace
+{
+  std::vector<double> runFieldDataExpression(FieldHandle scalarField, FieldHandle vectorField,
+    const std::string& function, const std::string& format, bool compile)
+  {
+    NewArrayMathEngine engine;
+    engine.set_compile_sequential(compile);
+    EXPECT_TRUE(engine.add_input_fielddata("A", scalarField));
+    EXPECT_TRUE(engine.add_input_fielddata("V", vectorField));
+    EXPECT_TRUE(engine.add_input_fielddata_location("POS", scalarField));
+    EXPECT_TRUE(engine.add_input_fielddata_coordinates("X", "Y", "Z", scalarField));
+    EXPECT_TRUE(engine.add_output_fielddata("RESULT", scalarField, 1, format));
+    EXPECT_TRUE(engine.add_expressions(function));
+    EXPECT_TRUE(engine.run());
+
+    FieldHandle ofield;
+    engine.get_field("RESULT", ofield);
+    std::vector<double> values;
+    if (!ofield)
+      return values;
+
+    auto ovfield = ofield->vfield();
+    for (VMesh::index_type idx = 0; idx < ovfield->num_values(); ++idx)
+    {
+      if (ovfield->is_vector())
+      {
+        Vector v;
+        ovfield->get_value(v, idx);
+        values.push_back(v.x());
+        values.push_back(v.y());
+        values.push_back(v.z());
+      }
+      else
+      {
+        double val;
+        ovfield->get_value(val, idx);
+        values.push_back(val);
+      }
+    }
+    return values;
+  }
+}
+
+TEST_F(BasicParserTests, CompiledFieldDataMatchesInterpreter)
+{
+  // Large enough to give every thread several blocks and a partial last block
+  FieldHandle field(CreateEmptyLatVol(31, 29, 27));
+  FieldInformation vfi("LatVolMesh", 1, "Vector");
+  FieldHandle vfield = CreateField(vfi, field->mesh());
+
+  auto ivfield = field->vfield();
+  auto ivvfield = vfield->vfield();
+  for (VMesh::index_type idx = 0; idx < ivfield->num_values(); ++idx)
+  {
+    ivfield->set_value(10.0*sin(0.01*idx), idx);
+    ivvfield->set_value(Vector(cos(0.02*idx), 0.5*idx/ivfield->num_values(), -1.0), idx);
+  }
+
+  const std::string expressions[] = {
+    "RESULT = 2*A + sin(X)*cos(Y) - A/(abs(Z)+1);",
+    "RESULT = norm(cross(V,POS)) + dot(V,vector(X,Y,Z)) - x(V)*z(POS);",
+    "RESULT = select(A > 0, sqrt(abs(A)), -A*A) + max(X,Y) + min(A,2) + floor(A) + pow(abs(A),1.5) + exp(-A*A) + log(1+abs(A));",
+    "RESULT = (A >= 1) + (A < -1) + (A == 0) + (X != Y) + (X <= Y) + (A > 2 && X < 0);",
+    "RESULT = V*A - V/(2+abs(A)) + 1 - POS;"
+  };
+  const std::string formats[] = { "double", "float", "int" };
+
+  for (const auto& function : expressions)
+  {
+    for (const auto& format : formats)
+    {
+      auto interpreted = runFieldDataExpression(field, vfield, function, format, false);
+      auto compiled = runFieldDataExpression(field, vfield, function, format, true);
+      ASSERT_EQ(ivfield->num_values() * (function.find("RESULT = V") == 0 ? 3 : 1), interpreted.size()) << function;
+      ASSERT_EQ(interpreted.size(), compiled.size()) << function;
+      for (size_t i = 0; i < interpreted.size(); ++i)
+        ASSERT_EQ(interpreted[i], compiled[i]) << function << " " << format << " at " << i;
+    }
+  }
+}
+
+TEST_F(BasicParserTests, OptimizerFoldsConstantsAndSharesSubexpressions)
+{
+  FieldHandle field(CreateEmptyLatVol(4, 4, 4));
+  auto ifield = field->vfield();
+  for (VMesh::index_type idx = 0; idx < ifield->num_values(); ++idx)
+    ifield->set_value(0.25*idx - 3.0, idx);
+
+  // The unused temporary B used to absorb the identical expression in RESULT
+  const std::string function =
+    "B = A*A; RESULT = sqrt(A*A+X*X) + sqrt(A*A+X*X)*1 + 2*3 + -(-A) + A^2 - A*A;";
+
+  NewArrayMathEngine engine;
+  EXPECT_TRUE(engine.add_input_fielddata("A", field));
+  EXPECT_TRUE(engine.add_input_fielddata_coordinates("X", "Y", "Z", field));
+  EXPECT_TRUE(engine.add_output_fielddata("RESULT", field, 1, "double"));
+  EXPECT_TRUE(engine.add_expressions(function));
+  ASSERT_TRUE(engine.run());
+
+  auto count = [](const std::string& text, const std::string& pattern)
+  {
+    size_t n = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) ++n;
+    return n;
+  };
+
+  const std::string program = engine.get_optimized_program();
+  EXPECT_EQ(1, count(program, " sqrt(")) << program;
+  EXPECT_EQ(0, count(program, " pow(")) << program;
+  EXPECT_EQ(0, count(program, " neg(")) << program;
+  EXPECT_EQ(0, count(program, "(2,3)")) << program;
+  EXPECT_EQ(0, count(program, ",1)")) << program;
+
+  FieldHandle ofield;
+  engine.get_field("RESULT", ofield);
+  ASSERT_TRUE(ofield != nullptr);
+  auto ovfield = ofield->vfield();
+  auto mesh = field->vmesh();
+  for (VMesh::index_type idx = 0; idx < ovfield->num_values(); ++idx)
+  {
+    double a, val;
+    Point p;
+    ifield->get_value(a, idx);
+    mesh->get_center(p, VMesh::Node::index_type(idx));
+    ovfield->get_value(val, idx);
+    EXPECT_NEAR(2.0*sqrt(a*a + p.x()*p.x()) + 6.0 + a, val, 1e-10);
+  }
+}
+
 
 //Run these tests when the functions below are implemented 
 /*
@@ -0,0 +1,560 @@
+/*
+ For more information, please see: http://software.sci.utah.edu
+
+ The MIT License
+
+ Copyright (c) 2015 Scientific Computing and Imaging Institute,
+ University of Utah.
+
+
+ Permission is hereby granted, free of charge, to any person obtaining a
+ copy of this software and associated documentation files (the "Software"),
+ to deal in the Software without restriction, including without limitation
+ the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the
+ Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included
+ in all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+ */
+
+#ifdef BUILD_WITH_PYTHON
+
+#include <Core/Python/PythonDatatypeBuffer.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Python;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  static_assert(sizeof(Point) == 3 * sizeof(double), "Point layout does not allow a node array view");
+  static_assert(sizeof(Vector) == 3 * sizeof(double), "Vector layout does not allow a value array view");
+  static_assert(sizeof(VMesh::index_type) == sizeof(long long), "Element array view assumes 64 bit indices");
+
+  /// Storage behind a buffer object. data() is asked for every new view, since
+  /// detach() replaces the storage with a private copy. Read only views ask for
+  /// data(false), which must not modify or copy the storage.
+  class BufferSource
+  {
+  public:
+    virtual ~BufferSource() {}
+    virtual bool isShared() const = 0;
+    virtual void detach() = 0;
+    virtual void* data(bool writable) const = 0;
+    virtual DatatypeHandle datatype() const = 0;
+  };
+
+  class DenseMatrixSource : public BufferSource
+  {
+  public:
+    explicit DenseMatrixSource(DenseMatrixHandle matrix) : matrix_(matrix) {}
+    virtual bool isShared() const override { return matrix_.use_count() > 1; }
+    virtual void detach() override { matrix_.reset(matrix_->clone()); }
+    virtual void* data(bool) const override { return matrix_->data(); }
+    virtual DatatypeHandle datatype() const override { return matrix_; }
+  private:
+    DenseMatrixHandle matrix_;
+  };
+
+  enum class SparseArray { Rows, Columns, Values };
+
+  class SparseRowMatrixSource : public BufferSource
+  {
+  public:
+    SparseRowMatrixSource(SparseRowMatrixHandle matrix, SparseArray array) : matrix_(matrix), array_(array) {}
+    virtual bool isShared() const override { return matrix_.use_count() > 1; }
+    virtual void detach() override { matrix_.reset(matrix_->clone()); }
+    virtual void* data(bool) const override
+    {
+      switch (array_)
+      {
+      case SparseArray::Rows:
+        return matrix_->outerIndexPtr();
+      case SparseArray::Columns:
+        return matrix_->innerIndexPtr();
+      default:
+        return matrix_->valuePtr();
+      }
+    }
+    virtual DatatypeHandle datatype() const override { return matrix_; }
+  private:
+    SparseRowMatrixHandle matrix_;
+    SparseArray array_;
+  };
+
+  enum class FieldArray { Nodes, Elements, Values };
+
+  /// Meshes can be shared between fields without showing in the field's use count,
+  /// so field storage only counts as private after this source made its own copy.
+  /// That copy still shares the node and element arrays with the original mesh;
+  /// they are only copied once a writable view asks for them.
+  class FieldSource : public BufferSource
+  {
+  public:
+    FieldSource(FieldHandle field, FieldArray array) : field_(field), array_(array), private_(false) {}
+    virtual bool isShared() const override { return !private_ || field_.use_count() > 1; }
+    virtual void detach() override
+    {
+      field_.reset(field_->deep_clone());
+      private_ = true;
+    }
+    virtual void* data(bool writable) const override
+    {
+      VMesh* mesh = field_->vmesh();
+      switch (array_)
+      {
+      case FieldArray::Nodes:
+        if (writable)
+          return mesh->get_points_pointer();
+        return const_cast<Point*>(mesh->get_const_points_pointer());
+      case FieldArray::Elements:
+        if (writable)
+          return mesh->get_elems_pointer();
+        return const_cast<VMesh::index_type*>(mesh->get_const_elems_pointer());
+      default:
+        return field_->vfield()->fdata_pointer();
+      }
+    }
+    virtual DatatypeHandle datatype() const override { return field_; }
+  private:
+    FieldHandle field_;
+    FieldArray array_;
+    bool private_;
+  };
+
+  struct PyDatatypeBuffer
+  {
+    PyObject_HEAD
+    BufferSource* source;
+    const char* format;
+    int ndim;
+    Py_ssize_t itemsize;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    Py_ssize_t exports;
+    Py_ssize_t writableExports;
+  };
+
+  bool detachBuffer(PyDatatypeBuffer* buffer)
+  {
+    if (buffer->exports > 0)
+    {
+      PyErr_SetString(PyExc_BufferError, "cannot copy shared datatype storage while views of it are held");
+      return false;
+    }
+    try
+    {
+      buffer->source->detach();
+    }
+    catch (std::exception& e)
+    {
+      PyErr_SetString(PyExc_MemoryError, e.what());
+      return false;
+    }
+    return true;
+  }
+
+  int getBuffer(PyObject* self, Py_buffer* view, int flags)
+  {
+    auto buffer = reinterpret_cast<PyDatatypeBuffer*>(self);
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && buffer->source->isShared() && !detachBuffer(buffer))
+    {
+      view->obj = nullptr;
+      return -1;
+    }
+
+    view->readonly = buffer->source->isShared() ? 1 : 0;
+    try
+    {
+      view->buf = buffer->source->data(!view->readonly);
+    }
+    catch (std::exception& e)
+    {
+      PyErr_SetString(PyExc_MemoryError, e.what());
+      view->obj = nullptr;
+      return -1;
+    }
+    view->obj = self;
+    Py_INCREF(self);
+    view->itemsize = buffer->itemsize;
+    view->len = buffer->itemsize;
+    for (int i = 0; i < buffer->ndim; ++i)
+      view->len *= buffer->shape[i];
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(buffer->format) : nullptr;
+    view->ndim = buffer->ndim;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? buffer->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? buffer->strides : nullptr;
+    view->suboffsets = nullptr;
+    // non-null marks a writable export, so the datatype is not handed back to the network while Python can still change it
+    view->internal = view->readonly ? nullptr : self;
+
+    ++buffer->exports;
+    if (!view->readonly)
+      ++buffer->writableExports;
+    return 0;
+  }
+
+  void releaseBuffer(PyObject* self, Py_buffer* view)
+  {
+    auto buffer = reinterpret_cast<PyDatatypeBuffer*>(self);
+    --buffer->exports;
+    if (view->internal)
+      --buffer->writableExports;
+  }
+
+  PyObject* makeWritable(PyObject* self, PyObject*)
+  {
+    auto buffer = reinterpret_cast<PyDatatypeBuffer*>(self);
+    if (buffer->source->isShared() && !detachBuffer(buffer))
+      return nullptr;
+    Py_INCREF(self);
+    return self;
+  }
+
+  void deallocBuffer(PyObject* self)
+  {
+    delete reinterpret_cast<PyDatatypeBuffer*>(self)->source;
+    Py_TYPE(self)->tp_free(self);
+  }
+
+  PyTypeObject* bufferType()
+  {
+    static PyBufferProcs bufferProcs = { getBuffer, releaseBuffer };
+    static PyMethodDef methods[] =
+    {
+      { "writable", makeWritable, METH_NOARGS, "Copy the storage if it is shared, so that views taken afterwards are writable. Returns the buffer." },
+      { nullptr, nullptr, 0, nullptr }
+    };
+    static PyTypeObject type = { PyVarObject_HEAD_INIT(nullptr, 0) };
+    static bool ready = false;
+    if (!ready)
+    {
+      type.tp_name = "SCIRun.DatatypeBuffer";
+      type.tp_basicsize = sizeof(PyDatatypeBuffer);
+      type.tp_dealloc = deallocBuffer;
+      type.tp_as_buffer = &bufferProcs;
+      type.tp_flags = Py_TPFLAGS_DEFAULT;
+      type.tp_doc = "Buffer protocol view of SCIRun datatype storage.";
+      type.tp_methods = methods;
+      if (PyType_Ready(&type) < 0)
+        boost::python::throw_error_already_set();
+      ready = true;
+    }
+    return &type;
+  }
+
+  boost::python::object makeBuffer(BufferSource* source, const char* format, Py_ssize_t itemsize, const std::vector<Py_ssize_t>& shape)
+  {
+    std::unique_ptr<BufferSource> owned(source);
+    auto type = bufferType();
+    auto buffer = reinterpret_cast<PyDatatypeBuffer*>(type->tp_alloc(type, 0));
+    if (!buffer)
+      boost::python::throw_error_already_set();
+
+    buffer->source = owned.release();
+    buffer->format = format;
+    buffer->itemsize = itemsize;
+    buffer->ndim = static_cast<int>(shape.size());
+    Py_ssize_t stride = itemsize;
+    for (int i = buffer->ndim - 1; i >= 0; --i)
+    {
+      buffer->shape[i] = shape[i];
+      buffer->strides[i] = stride;
+      stride *= shape[i];
+    }
+    buffer->exports = 0;
+    buffer->writableExports = 0;
+    return boost::python::object(boost::python::handle<>(reinterpret_cast<PyObject*>(buffer)));
+  }
+
+  PyDatatypeBuffer* asDatatypeBuffer(const boost::python::object& object)
+  {
+    if (Py_TYPE(object.ptr()) == bufferType())
+      return reinterpret_cast<PyDatatypeBuffer*>(object.ptr());
+    return nullptr;
+  }
+
+  bool fieldValueFormat(VField* vfield, const char*& format, Py_ssize_t& itemsize, Py_ssize_t& components)
+  {
+    components = 1;
+    if (vfield->is_vector())
+    {
+      format = "d";
+      itemsize = sizeof(double);
+      components = 3;
+      return true;
+    }
+    if (!vfield->is_scalar())
+      return false;
+
+    if (vfield->is_double())                { format = "d"; itemsize = sizeof(double); }
+    else if (vfield->is_float())            { format = "f"; itemsize = sizeof(float); }
+    else if (vfield->is_int())              { format = "i"; itemsize = sizeof(int); }
+    else if (vfield->is_unsigned_int())     { format = "I"; itemsize = sizeof(unsigned int); }
+    else if (vfield->is_short())            { format = "h"; itemsize = sizeof(short); }
+    else if (vfield->is_unsigned_short())   { format = "H"; itemsize = sizeof(unsigned short); }
+    else if (vfield->is_char())             { format = "b"; itemsize = sizeof(char); }
+    else if (vfield->is_unsigned_char())    { format = "B"; itemsize = sizeof(unsigned char); }
+    else if (vfield->is_long())             { format = "l"; itemsize = sizeof(long); }
+    else if (vfield->is_unsigned_long())    { format = "L"; itemsize = sizeof(unsigned long); }
+    else if (vfield->is_longlong())         { format = "q"; itemsize = sizeof(long long); }
+    else if (vfield->is_unsigned_longlong()) { format = "Q"; itemsize = sizeof(unsigned long long); }
+    else
+      return false;
+    return true;
+  }
+
+  enum class ElementKind { Unsupported, Float, Signed, Unsigned, Bool };
+
+  /// Numeric buffer exported by an arbitrary Python object, read through its strides.
+  class NumericBufferView
+  {
+  public:
+    explicit NumericBufferView(const boost::python::object& object) : valid_(false), kind_(ElementKind::Unsupported)
+    {
+      auto ptr = object.ptr();
+      if (PyBytes_Check(ptr) || PyByteArray_Check(ptr) || !PyObject_CheckBuffer(ptr))
+        return;
+      if (PyObject_GetBuffer(ptr, &view_, PyBUF_RECORDS_RO) != 0)
+      {
+        PyErr_Clear();
+        return;
+      }
+      valid_ = true;
+      kind_ = elementKind();
+    }
+
+    ~NumericBufferView()
+    {
+      if (valid_)
+        PyBuffer_Release(&view_);
+    }
+
+    NumericBufferView(const NumericBufferView&) = delete;
+    NumericBufferView& operator=(const NumericBufferView&) = delete;
+
+    bool isNumeric() const
+    {
+      return valid_ && kind_ != ElementKind::Unsupported && (view_.ndim == 1 || view_.ndim == 2) && !view_.suboffsets;
+    }
+
+    Py_ssize_t rows() const { return view_.shape[0]; }
+    Py_ssize_t columns() const { return view_.ndim == 2 ? view_.shape[1] : 1; }
+
+    std::vector<Py_ssize_t> shape() const { return std::vector<Py_ssize_t>(view_.shape, view_.shape + view_.ndim); }
+
+    /// Copies the elements in C order into out, which must hold rows() * columns() values.
+    template <class T>
+    void copyTo(T* out) const
+    {
+      auto rowStride = view_.strides ? view_.strides[0] : columns() * view_.itemsize;
+      auto columnStride = view_.ndim == 2 ? (view_.strides ? view_.strides[1] : view_.itemsize) : 0;
+      if (kind_ == ElementKind::Float && view_.itemsize == sizeof(T) && std::is_same<T, double>::value
+        && columnStride == (view_.ndim == 2 ? view_.itemsize : 0) && rowStride == columns() * view_.itemsize)
+      {
+        std::memcpy(out, view_.buf, rows() * columns() * sizeof(T));
+        return;
+      }
+      auto base = static_cast<const char*>(view_.buf);
+      for (Py_ssize_t i = 0; i < rows(); ++i)
+      {
+        for (Py_ssize_t j = 0; j < columns(); ++j)
+          *out++ = element<T>(base + i * rowStride + j * columnStride);
+      }
+    }
+
+  private:
+    ElementKind elementKind() const
+    {
+      std::string format = view_.format ? view_.format : "B";
+      // native or little endian standard sizes; the element size is taken from itemsize
+      if (!format.empty() && (format[0] == '@' || format[0] == '=' || format[0] == '<'))
+        format = format.substr(1);
+      if (format.size() != 1)
+        return ElementKind::Unsupported;
+      switch (format[0])
+      {
+      case 'f': case 'd':
+        return ElementKind::Float;
+      case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+        return ElementKind::Signed;
+      case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+        return ElementKind::Unsigned;
+      case '?':
+        return ElementKind::Bool;
+      default:
+        return ElementKind::Unsupported;
+      }
+    }
+
+    template <class T>
+    T element(const char* ptr) const
+    {
+      switch (kind_)
+      {
+      case ElementKind::Float:
+        return view_.itemsize == sizeof(float) ? static_cast<T>(read<float>(ptr)) : static_cast<T>(read<double>(ptr));
+      case ElementKind::Signed:
+        switch (view_.itemsize)
+        {
+        case 1: return static_cast<T>(read<int8_t>(ptr));
+        case 2: return static_cast<T>(read<int16_t>(ptr));
+        case 4: return static_cast<T>(read<int32_t>(ptr));
+        default: return static_cast<T>(read<int64_t>(ptr));
+        }
+      case ElementKind::Unsigned:
+        switch (view_.itemsize)
+        {
+        case 1: return static_cast<T>(read<uint8_t>(ptr));
+        case 2: return static_cast<T>(read<uint16_t>(ptr));
+        case 4: return static_cast<T>(read<uint32_t>(ptr));
+        default: return static_cast<T>(read<uint64_t>(ptr));
+        }
+      default:
+        return static_cast<T>(read<uint8_t>(ptr) != 0);
+      }
+    }
+
+    template <class S>
+    static S read(const char* ptr)
+    {
+      S value;
+      std::memcpy(&value, ptr, sizeof(S));
+      return value;
+    }
+
+    Py_buffer view_;
+    bool valid_;
+    ElementKind kind_;
+  };
+
+  template <class T>
+  std::vector<T> copyNumericBuffer(const boost::python::object& object, std::vector<Py_ssize_t>& shape)
+  {
+    NumericBufferView view(object);
+    if (!view.isNumeric())
+      throw std::invalid_argument("Python object does not export a 1-D or 2-D numeric buffer.");
+    std::vector<T> values(view.rows() * view.columns());
+    if (!values.empty())
+      view.copyTo(&values[0]);
+    shape = view.shape();
+    return values;
+  }
+}
+
+boost::python::object SCIRun::Core::Python::convertMatrixToPythonBuffer(DenseMatrixHandle matrix)
+{
+  if (!matrix)
+    return {};
+  return makeBuffer(new DenseMatrixSource(matrix), "d", sizeof(double), { static_cast<Py_ssize_t>(matrix->nrows()), static_cast<Py_ssize_t>(matrix->ncols()) });
+}
+
+boost::python::dict SCIRun::Core::Python::convertMatrixToPythonBuffers(SparseRowMatrixHandle matrix)
+{
+  boost::python::dict arrays;
+  if (!matrix)
+    return arrays;
+
+  if (!matrix->isCompressed())
+  {
+    matrix.reset(matrix->clone());
+    matrix->makeCompressed();
+  }
+
+  Py_ssize_t nnz = matrix->nonZeros();
+  arrays["nrows"] = matrix->nrows();
+  arrays["ncols"] = matrix->ncols();
+  arrays["rows"] = makeBuffer(new SparseRowMatrixSource(matrix, SparseArray::Rows), "q", sizeof(index_type), { matrix->outerSize() + 1 });
+  arrays["columns"] = makeBuffer(new SparseRowMatrixSource(matrix, SparseArray::Columns), "q", sizeof(index_type), { nnz });
+  arrays["values"] = makeBuffer(new SparseRowMatrixSource(matrix, SparseArray::Values), "d", sizeof(double), { nnz });
+  return arrays;
+}
+
+boost::python::dict SCIRun::Core::Python::convertFieldToPythonBuffers(FieldHandle field)
+{
+  boost::python::dict arrays;
+  if (!field)
+    return arrays;
+
+  auto vmesh = field->vmesh();
+  if (vmesh->is_unstructuredmesh() && (vmesh->is_linearmesh() || vmesh->is_pointcloudmesh()))
+  {
+    arrays["node"] = makeBuffer(new FieldSource(field, FieldArray::Nodes), "d", sizeof(double), { vmesh->num_nodes(), 3 });
+    // Point clouds have no connectivity array to share.
+    if (vmesh->get_const_elems_pointer())
+      arrays["element"] = makeBuffer(new FieldSource(field, FieldArray::Elements), "q", sizeof(VMesh::index_type),
+        { vmesh->num_elems(), static_cast<Py_ssize_t>(vmesh->num_nodes_per_elem()) });
+  }
+
+  auto vfield = field->vfield();
+  const char* format;
+  Py_ssize_t itemsize, components;
+  if (!vfield->is_nodata() && fieldValueFormat(vfield, format, itemsize, components))
+  {
+    std::vector<Py_ssize_t> shape { vfield->num_values() };
+    if (components > 1)
+      shape.push_back(components);
+    arrays["field"] = makeBuffer(new FieldSource(field, FieldArray::Values), format, itemsize, shape);
+  }
+  return arrays;
+}
+
+bool SCIRun::Core::Python::isNumericPythonBuffer(const boost::python::object& object)
+{
+  return NumericBufferView(object).isNumeric();
+}
+
+DatatypeHandle SCIRun::Core::Python::datatypeFromPythonBuffer(const boost::python::object& object)
+{
+  auto buffer = asDatatypeBuffer(object);
+  if (buffer && 0 == buffer->writableExports)
+    return buffer->source->datatype();
+  return nullptr;
+}
+
+DenseMatrixHandle SCIRun::Core::Python::denseMatrixFromPythonBuffer(const boost::python::object& object)
+{
+  auto dense = boost::dynamic_pointer_cast<DenseMatrix>(datatypeFromPythonBuffer(object));
+  if (dense)
+    return dense;
+
+  NumericBufferView view(object);
+  if (!view.isNumeric())
+    return nullptr;
+  dense.reset(new DenseMatrix(view.rows(), view.columns()));
+  if (dense->size() > 0)
+    view.copyTo(dense->data());
+  return dense;
+}
+
+std::vector<double> SCIRun::Core::Python::doublesFromPythonBuffer(const boost::python::object& object, std::vector<Py_ssize_t>& shape)
+{
+  return copyNumericBuffer<double>(object, shape);
+}
+
+std::vector<index_type> SCIRun::Core::Python::indicesFromPythonBuffer(const boost::python::object& object)
+{
+  std::vector<Py_ssize_t> shape;
+  return copyNumericBuffer<index_type>(object, shape);
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ For more information, please see: http://software.sci.utah.edu
+
+ The MIT License
+
+ Copyright (c) 2015 Scientific Computing and Imaging Institute,
+ University of Utah.
+
+
+ Permission is hereby granted, free of charge, to any person obtaining a
+ copy of this software and associated documentation files (the "Software"),
+ to deal in the Software without restriction, including without limitation
+ the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the
+ Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included
+ in all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+ */
+
+#ifdef BUILD_WITH_PYTHON
+#ifndef CORE_PYTHON_PYTHONDATATYPEBUFFER_H
+#define CORE_PYTHON_PYTHONDATATYPEBUFFER_H
+
+#include <boost/python.hpp>
+#include <vector>
+#include <Core/Datatypes/DatatypeFwd.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+
+#include <Core/Python/share.h>
+
+namespace SCIRun
+{
+  namespace Core
+  {
+    namespace Python
+    {
+      /// Zero-copy views of datatype storage through the Python buffer protocol
+      /// (memoryview, numpy.asarray, ...). A view keeps the datatype alive and is
+      /// read-only while the storage is shared with the rest of the network; asking
+      /// for a writable view, or calling writable() on the buffer, first detaches a
+      /// private copy of the datatype (copy-on-write).
+
+      /// nrows x ncols view of the row-major matrix storage.
+      SCISHARE boost::python::object convertMatrixToPythonBuffer(Datatypes::DenseMatrixHandle matrix);
+      /// Dictionary with nrows, ncols and the CSR arrays rows (nrows + 1), columns and values (nnz).
+      SCISHARE boost::python::dict convertMatrixToPythonBuffers(Datatypes::SparseRowMatrixHandle matrix);
+      /// Dictionary with the node (n x 3) and element (n x nodes per element) arrays of
+      /// unstructured meshes (nodes only for point clouds) and the field value array, where
+      /// their layout allows a view.
+      SCISHARE boost::python::dict convertFieldToPythonBuffers(FieldHandle field);
+
+      /// True for objects exporting a 1-D or 2-D numeric buffer (numpy arrays, memoryviews,
+      /// the views above); bytes and bytearray are not treated as numeric data.
+      SCISHARE bool isNumericPythonBuffer(const boost::python::object& object);
+
+      /// The datatype behind one of the views above, or null for other objects or while a
+      /// writable view of it is still held by Python.
+      SCISHARE Datatypes::DatatypeHandle datatypeFromPythonBuffer(const boost::python::object& object);
+
+      /// Dense matrix from a numeric buffer: the original matrix when the buffer is one of
+      /// our views, otherwise a single copy of the data (1-D buffers become a column).
+      SCISHARE Datatypes::DenseMatrixHandle denseMatrixFromPythonBuffer(const boost::python::object& object);
+
+      /// Flattened (C order) contents of a numeric buffer, converted to the requested type.
+      SCISHARE std::vector<double> doublesFromPythonBuffer(const boost::python::object& object, std::vector<Py_ssize_t>& shape);
+      SCISHARE std::vector<index_type> indicesFromPythonBuffer(const boost::python::object& object);
+    }
+  }
+}
+
+#endif
+#endif
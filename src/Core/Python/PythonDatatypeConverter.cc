@@ -35,6 +35,7 @@
 #endif
 
 #include <Core/Python/PythonDatatypeConverter.h>
+#include <Core/Python/PythonDatatypeBuffer.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/String.h>
@@ -170,6 +171,9 @@ boost::python::object SCIRun::Core::Python::convertStringToPython(StringHandle s
 
 bool DenseMatrixExtractor::check() const
 {
+  if (isNumericPythonBuffer(object_))
+    return true;
+
   boost::python::extract<boost::python::list> e(object_);
   if (!e.check())
     return false;
@@ -186,6 +190,9 @@ bool DenseMatrixExtractor::check() const
 
 DatatypeHandle DenseMatrixExtractor::operator()() const
 {
+  if (isNumericPythonBuffer(object_))
+    return denseMatrixFromPythonBuffer(object_);
+
   DenseMatrixHandle dense;
   boost::python::extract<boost::python::list> e(object_);
   if (e.check())
@@ -255,7 +262,7 @@ bool SparseRowMatrixExtractor::check() const
 
     boost::python::extract<boost::python::list> value_i_list(values[i]);
     boost::python::extract<size_t> value_i_int(values[i]);
-    if (!value_i_int.check() && !value_i_list.check())
+    if (!value_i_int.check() && !value_i_list.check() && !isNumericPythonBuffer(values[i]))
       return false;
   }
 
@@ -271,6 +278,16 @@ DatatypeHandle SparseRowMatrixExtractor::operator()() const
   boost::python::extract<boost::python::dict> e(object_);
   auto pyMatlabDict = e();
 
+  // arrays that are still the views made by convertMatrixToPythonBuffers hand back the original matrix
+  {
+    auto original = datatypeFromPythonBuffer(pyMatlabDict.get("values"));
+    if (original && original == datatypeFromPythonBuffer(pyMatlabDict.get("rows"))
+      && original == datatypeFromPythonBuffer(pyMatlabDict.get("columns")))
+    {
+      return original;
+    }
+  }
+
   auto length = len(pyMatlabDict);
 
   auto keys = pyMatlabDict.keys();
@@ -285,11 +302,11 @@ DatatypeHandle SparseRowMatrixExtractor::operator()() const
     auto fieldName = key_i();
     if (fieldName == "rows")
     {
-      rows = to_std_vector<index_type>(value_i_list());
+      rows = value_i_list.check() ? to_std_vector<index_type>(value_i_list()) : indicesFromPythonBuffer(values[i]);
     }
     else if (fieldName == "columns")
     {
-      columns = to_std_vector<index_type>(value_i_list());
+      columns = value_i_list.check() ? to_std_vector<index_type>(value_i_list()) : indicesFromPythonBuffer(values[i]);
     }
     else if (fieldName == "nrows")
     {
@@ -303,7 +320,8 @@ DatatypeHandle SparseRowMatrixExtractor::operator()() const
     }
     else if (fieldName == "values")
     {
-      matrixValues = to_std_vector<double>(value_i_list());
+      std::vector<Py_ssize_t> shape;
+      matrixValues = value_i_list.check() ? to_std_vector<double>(value_i_list()) : doublesFromPythonBuffer(values[i], shape);
     }
   }
 
@@ -338,7 +356,7 @@ bool FieldExtractor::check() const
 
     boost::python::extract<std::string> value_i_string(values[i]);
     boost::python::extract<boost::python::list> value_i_list(values[i]);
-    if (!value_i_string.check() && !value_i_list.check())
+    if (!value_i_string.check() && !value_i_list.check() && !isNumericPythonBuffer(values[i]))
       return false;
   }
 
@@ -347,10 +365,22 @@ bool FieldExtractor::check() const
 
 namespace
 {
-  matlabarray getPythonFieldDictionaryValue(const boost::python::extract<std::string>& strExtract, const boost::python::extract<boost::python::list>& listExtract)
+  matlabarray getPythonFieldDictionaryValue(const boost::python::object& object, const boost::python::extract<std::string>& strExtract, const boost::python::extract<boost::python::list>& listExtract)
   {
     matlabarray value;
-    if (strExtract.check())
+    if (isNumericPythonBuffer(object))
+    {
+      // same layout as a list of rows: dims are (row length, number of rows) over the flattened rows
+      std::vector<Py_ssize_t> shape;
+      auto values = doublesFromPythonBuffer(object, shape);
+      if (1 == values.size())
+        value.createdoublescalar(values[0]);
+      else if (2 == shape.size())
+        value.createdoublematrix(values, { static_cast<int>(shape[1]), static_cast<int>(shape[0]) });
+      else
+        value.createdoublevector(values);
+    }
+    else if (strExtract.check())
     {
       value.createstringarray();
       auto strData = strExtract();
@@ -415,7 +445,7 @@ DatatypeHandle FieldExtractor::operator()() const
     boost::python::extract<boost::python::list> value_i_list(values[i]);
     auto fieldName = key_i();
     //std::cout << "setting field " << fieldName << std::endl;
-    ma.setfield(0, fieldName, getPythonFieldDictionaryValue(value_i_string, value_i_list));
+    ma.setfield(0, fieldName, getPythonFieldDictionaryValue(values[i], value_i_string, value_i_list));
   }
 
   FieldHandle field;
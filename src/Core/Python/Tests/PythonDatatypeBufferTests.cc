@@ -0,0 +1,279 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+   */
+
+#include <Python.h>
+#include <boost/python.hpp>
+
+#include <gtest/gtest.h>
+#include <Core/Python/PythonDatatypeBuffer.h>
+#include <Core/Python/PythonDatatypeConverter.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Python;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::TestUtils;
+
+class PythonDatatypeBufferTests : public testing::Test
+{
+protected:
+  virtual void SetUp() override
+  {
+    Py_Initialize();
+  }
+
+  static DenseMatrixHandle matrix23()
+  {
+    DenseMatrixHandle m(new DenseMatrix(2, 3));
+    *m << 1, 2, 3,
+          4, 5, 6;
+    return m;
+  }
+
+  static boost::python::object eval(const std::string& expression)
+  {
+    auto main = boost::python::import("__main__");
+    return boost::python::eval(expression.c_str(), main.attr("__dict__"));
+  }
+};
+
+TEST_F(PythonDatatypeBufferTests, DenseMatrixViewSharesStorage)
+{
+  auto m = matrix23();
+  auto buffer = convertMatrixToPythonBuffer(m);
+
+  Py_buffer view;
+  ASSERT_EQ(0, PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_RECORDS_RO));
+  EXPECT_EQ(m->data(), view.buf);
+  EXPECT_EQ(2, view.ndim);
+  EXPECT_EQ(2, view.shape[0]);
+  EXPECT_EQ(3, view.shape[1]);
+  EXPECT_EQ(1, view.readonly);
+  EXPECT_EQ(std::string("d"), view.format);
+  PyBuffer_Release(&view);
+
+  auto main = boost::python::import("__main__");
+  main.attr("__dict__")["m"] = buffer;
+  EXPECT_EQ(6.0, boost::python::extract<double>(eval("memoryview(m)[1, 2]"))());
+}
+
+TEST_F(PythonDatatypeBufferTests, WritableViewCopiesSharedMatrix)
+{
+  auto m = matrix23();
+  auto buffer = convertMatrixToPythonBuffer(m);
+
+  Py_buffer view;
+  ASSERT_EQ(0, PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_RECORDS));
+  EXPECT_NE(m->data(), view.buf);
+  EXPECT_EQ(0, view.readonly);
+  static_cast<double*>(view.buf)[0] = 42;
+
+  // the network's matrix is untouched, and the copy is not handed back while it can still change
+  EXPECT_EQ(1.0, (*m)(0, 0));
+  EXPECT_FALSE(datatypeFromPythonBuffer(buffer));
+  PyBuffer_Release(&view);
+
+  auto copy = denseMatrixFromPythonBuffer(buffer);
+  ASSERT_TRUE(copy != nullptr);
+  EXPECT_NE(m, copy);
+  EXPECT_EQ(42.0, (*copy)(0, 0));
+  EXPECT_EQ(6.0, (*copy)(1, 2));
+}
+
+TEST_F(PythonDatatypeBufferTests, CannotDetachWhileViewsAreHeld)
+{
+  auto m = matrix23();
+  auto buffer = convertMatrixToPythonBuffer(m);
+
+  Py_buffer view;
+  ASSERT_EQ(0, PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_RECORDS_RO));
+  Py_buffer writable;
+  EXPECT_EQ(-1, PyObject_GetBuffer(buffer.ptr(), &writable, PyBUF_RECORDS));
+  EXPECT_TRUE(PyErr_ExceptionMatches(PyExc_BufferError));
+  PyErr_Clear();
+  PyBuffer_Release(&view);
+
+  ASSERT_EQ(0, PyObject_GetBuffer(buffer.ptr(), &writable, PyBUF_RECORDS));
+  PyBuffer_Release(&writable);
+}
+
+TEST_F(PythonDatatypeBufferTests, RoundTripReturnsOriginalMatrix)
+{
+  auto m = matrix23();
+  auto buffer = convertMatrixToPythonBuffer(m);
+
+  DenseMatrixExtractor extractor(buffer);
+  ASSERT_TRUE(extractor.check());
+  EXPECT_EQ(m, extractor());
+}
+
+TEST_F(PythonDatatypeBufferTests, ForeignBuffersAreCopiedIntoDenseMatrix)
+{
+  auto main = boost::python::import("__main__");
+  main.attr("__dict__")["array"] = boost::python::import("array");
+
+  auto twoD = eval("memoryview(array.array('d', [1, 2, 3, 4, 5, 6])).cast('B').cast('d', [2, 3])");
+  DenseMatrixExtractor extractor(twoD);
+  ASSERT_TRUE(extractor.check());
+  auto dense = boost::dynamic_pointer_cast<DenseMatrix>(extractor());
+  ASSERT_TRUE(dense != nullptr);
+  EXPECT_EQ(*matrix23(), *dense);
+
+  auto strided = eval("memoryview(array.array('i', [1, 2, 3, 4, 5, 6]))[::2]");
+  auto column = denseMatrixFromPythonBuffer(strided);
+  ASSERT_TRUE(column != nullptr);
+  ASSERT_EQ(3, column->nrows());
+  ASSERT_EQ(1, column->ncols());
+  EXPECT_EQ(1.0, (*column)(0, 0));
+  EXPECT_EQ(3.0, (*column)(1, 0));
+  EXPECT_EQ(5.0, (*column)(2, 0));
+
+  EXPECT_FALSE(isNumericPythonBuffer(eval("b'abc'")));
+  EXPECT_FALSE(isNumericPythonBuffer(eval("'abc'")));
+}
+
+TEST_F(PythonDatatypeBufferTests, SparseMatrixCsrArrays)
+{
+  index_type rows[] = { 0, 1, 3 };
+  index_type columns[] = { 1, 0, 2 };
+  double values[] = { 5, 6, 7 };
+  SparseRowMatrixHandle sparse(new SparseRowMatrix(2, 3, rows, columns, values, 3));
+
+  auto arrays = convertMatrixToPythonBuffers(sparse);
+  std::vector<Py_ssize_t> shape;
+  EXPECT_EQ(std::vector<double>({ 5, 6, 7 }), doublesFromPythonBuffer(arrays["values"], shape));
+  EXPECT_EQ(std::vector<index_type>({ 0, 1, 3 }), indicesFromPythonBuffer(arrays["rows"]));
+  EXPECT_EQ(std::vector<index_type>({ 1, 0, 2 }), indicesFromPythonBuffer(arrays["columns"]));
+
+  SparseRowMatrixExtractor extractor(arrays);
+  ASSERT_TRUE(extractor.check());
+  EXPECT_EQ(sparse, extractor());
+
+  // once one of the arrays is a private copy the matrix is rebuilt from the arrays
+  boost::python::object values_i = arrays["values"];
+  values_i.attr("writable")();
+  auto rebuilt = boost::dynamic_pointer_cast<SparseRowMatrix>(extractor());
+  ASSERT_TRUE(rebuilt != nullptr);
+  EXPECT_NE(sparse, rebuilt);
+  EXPECT_EQ(7.0, rebuilt->coeff(1, 2));
+  EXPECT_EQ(5.0, rebuilt->coeff(0, 1));
+}
+
+TEST_F(PythonDatatypeBufferTests, FieldNodeElementAndValueArrays)
+{
+  auto field = TetrahedronTriSurfLinearBasis(DOUBLE_E);
+  auto vmesh = field->vmesh();
+  auto vfield = field->vfield();
+  for (VMesh::index_type i = 0; i < static_cast<VMesh::index_type>(vfield->num_values()); ++i)
+    vfield->set_value(static_cast<double>(i), i);
+
+  auto arrays = convertFieldToPythonBuffers(field);
+  ASSERT_TRUE(arrays.has_key("node"));
+  ASSERT_TRUE(arrays.has_key("element"));
+  ASSERT_TRUE(arrays.has_key("field"));
+
+  std::vector<Py_ssize_t> shape;
+  auto nodes = doublesFromPythonBuffer(arrays["node"], shape);
+  ASSERT_EQ(2u, shape.size());
+  EXPECT_EQ(vmesh->num_nodes(), shape[0]);
+  EXPECT_EQ(3, shape[1]);
+  Core::Geometry::Point p;
+  vmesh->get_center(p, VMesh::Node::index_type(1));
+  EXPECT_EQ(p.x(), nodes[3]);
+  EXPECT_EQ(p.y(), nodes[4]);
+  EXPECT_EQ(p.z(), nodes[5]);
+
+  auto elements = indicesFromPythonBuffer(arrays["element"]);
+  VMesh::Node::array_type elemNodes;
+  vmesh->get_nodes(elemNodes, VMesh::Elem::index_type(1));
+  ASSERT_EQ(vmesh->num_elems() * 3, elements.size());
+  for (size_t k = 0; k < 3; ++k)
+    EXPECT_EQ(elemNodes[k], elements[3 + k]);
+
+  auto values = doublesFromPythonBuffer(arrays["field"], shape);
+  ASSERT_EQ(vfield->num_values(), values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(static_cast<double>(i), values[i]);
+
+  EXPECT_EQ(field, datatypeFromPythonBuffer(arrays["field"]));
+}
+
+TEST_F(PythonDatatypeBufferTests, PointCloudHasNoElementArray)
+{
+  FieldInformation fi("PointCloudMesh", 1, "double");
+  auto field = CreateField(fi);
+  for (int i = 0; i < 4; ++i)
+    field->vmesh()->add_point(Core::Geometry::Point(i, 2 * i, 3 * i));
+  field->vfield()->resize_values();
+  for (VMesh::index_type i = 0; i < 4; ++i)
+    field->vfield()->set_value(0.5 * i, i);
+
+  auto arrays = convertFieldToPythonBuffers(field);
+  EXPECT_FALSE(arrays.has_key("element"));
+  ASSERT_TRUE(arrays.has_key("node"));
+  ASSERT_TRUE(arrays.has_key("field"));
+
+  std::vector<Py_ssize_t> shape;
+  auto nodes = doublesFromPythonBuffer(arrays["node"], shape);
+  ASSERT_EQ(12u, nodes.size());
+  EXPECT_EQ(6.0, nodes[10]);
+  EXPECT_EQ(9.0, nodes[11]);
+  auto values = doublesFromPythonBuffer(arrays["field"], shape);
+  ASSERT_EQ(4u, values.size());
+  EXPECT_EQ(1.5, values[3]);
+}
+
+TEST_F(PythonDatatypeBufferTests, ReadOnlyFieldViewsDoNotCopyMeshStorage)
+{
+  auto field = TetrahedronTriSurfLinearBasis(DOUBLE_E);
+  auto vmesh = field->vmesh();
+  const auto points = vmesh->get_const_points_pointer();
+  auto arrays = convertFieldToPythonBuffers(field);
+
+  Py_buffer view;
+  ASSERT_EQ(0, PyObject_GetBuffer(boost::python::object(arrays["node"]).ptr(), &view, PyBUF_RECORDS_RO));
+  EXPECT_EQ(1, view.readonly);
+  EXPECT_EQ(points, view.buf);
+  PyBuffer_Release(&view);
+  EXPECT_EQ(points, vmesh->get_const_points_pointer());
+
+  ASSERT_EQ(0, PyObject_GetBuffer(boost::python::object(arrays["node"]).ptr(), &view, PyBUF_RECORDS));
+  EXPECT_EQ(0, view.readonly);
+  EXPECT_NE(points, view.buf);
+  static_cast<double*>(view.buf)[0] = 42;
+  PyBuffer_Release(&view);
+
+  EXPECT_EQ(points, vmesh->get_const_points_pointer());
+  EXPECT_NE(42.0, points[0].x());
+}
@@ -29,6 +29,8 @@
 #include <Core/Thread/Parallel.h>
 #include <Core/Logging/Log.h>
 #include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <exception>
 #include <vector>
 #include <iostream>
 
@@ -37,11 +39,29 @@ using namespace SCIRun::Core::Logging;
 
 void Parallel::RunTasks(IndexedTask task, int numProcs)
 {
+  const int numThreads = static_cast<int>(capByUserCoreCount(numProcs));
+  std::vector<std::exception_ptr> errors(std::max(numThreads, 0));
   boost::thread_group threads;
 
-  for (int i = 0; i < capByUserCoreCount(numProcs); ++i)
+  // An exception escaping a thread would end the process, so every task keeps its own
+  // and the first one in task order is rethrown on the calling thread.
+  for (int i = 0; i < numThreads; ++i)
   {
-    threads.create_thread(boost::bind(task, i));
+    threads.create_thread([&task, &errors, i]()
+    {
+      try
+      {
+        task(i);
+      }
+      catch (boost::thread_interrupted&)
+      {
+        throw;
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    });
   }
 
   try
@@ -51,8 +71,40 @@ void Parallel::RunTasks(IndexedTask task, int numProcs)
   catch (boost::thread_interrupted&)
   {
     threads.interrupt_all();
+    // The tasks still use the caller's data, so they have to stop before it unwinds.
+    boost::this_thread::disable_interruption noInterruption;
+    threads.join_all();
     throw;
   }
+
+  for (const auto& error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+void Parallel::RunTasksOverRange(RangeTask task, size_t size)
+{
+  RunTasksOverRange(task, size, NumCores());
+}
+
+void Parallel::RunTasksOverRange(RangeTask task, size_t size, int numProcs)
+{
+  if (size == 0)
+    return;
+
+  const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(capByUserCoreCount(std::max(numProcs, 1)), size));
+  if (numBlocks == 1)
+  {
+    task(0, size);
+    return;
+  }
+
+  RunTasks([&](int i)
+  {
+    task(size * i / numBlocks, size * (i + 1) / numBlocks);
+  }, static_cast<int>(numBlocks));
 }
 
 unsigned int Parallel::NumCores()
@@ -74,6 +126,11 @@ void Parallel::SetMaximumCores(unsigned int max)
   maximumCoresSetByUser_ = max;
 }
 
+unsigned int Parallel::MaximumCores()
+{
+  return maximumCoresSetByUser_ == std::numeric_limits<unsigned int>::max() ? 0 : maximumCoresSetByUser_;
+}
+
 unsigned int Parallel::capByUserCoreCount(unsigned int numProcs)
 {
   return std::min(numProcs, maximumCoresSetByUser_);
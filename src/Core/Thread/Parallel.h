@@ -31,6 +31,10 @@
 
 #include <boost/noncopyable.hpp>
 #include <boost/function.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
 #include <Core/Thread/share.h>
 
 namespace SCIRun
@@ -43,9 +47,57 @@ namespace Thread
   {
   public:
     typedef boost::function<void(int)> IndexedTask;
+    /// Runs task(i) for i in [0, numProcs) on separate threads. An exception thrown by a
+    /// task is rethrown here once all tasks have finished.
     static void RunTasks(IndexedTask task, int numProcs);
+    /// Splits [0, size) into one contiguous block per thread and runs task(begin, end) on each.
+    typedef boost::function<void(size_t, size_t)> RangeTask;
+    static void RunTasksOverRange(RangeTask task, size_t size);
+    static void RunTasksOverRange(RangeTask task, size_t size, int numProcs);
     static unsigned int NumCores();
     static void SetMaximumCores(unsigned int max);
+    /// The cap set by SetMaximumCores, 0 when unlimited.
+    static unsigned int MaximumCores();
+
+    /// Sorts [begin, end) by sorting one block per thread and merging the blocks pairwise.
+    template <class Iterator, class Compare>
+    static void Sort(Iterator begin, Iterator end, Compare comp)
+    {
+      Sort(begin, end, comp, NumCores());
+    }
+
+    /// As above with at most maxBlocks blocks. Blocks hold at least 1024 elements, so smaller
+    /// ranges are sorted serially.
+    template <class Iterator, class Compare>
+    static void Sort(Iterator begin, Iterator end, Compare comp, unsigned int maxBlocks)
+    {
+      const size_t size = static_cast<size_t>(end - begin);
+      const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(maxBlocks, size / 1024));
+      std::vector<size_t> bounds(numBlocks + 1);
+      for (size_t i = 0; i <= numBlocks; i++)
+        bounds[i] = size * i / numBlocks;
+
+      RunTasks([&](int i) { std::sort(begin + bounds[i], begin + bounds[i + 1], comp); }, static_cast<int>(numBlocks));
+
+      for (size_t width = 1; width < numBlocks; width *= 2)
+      {
+        const size_t numMerges = (numBlocks + 2 * width - 1) / (2 * width);
+        RunTasks([&](int m)
+        {
+          const size_t first = 2 * width * m;
+          const size_t middle = std::min(first + width, numBlocks);
+          const size_t last = std::min(first + 2 * width, numBlocks);
+          if (middle < last)
+            std::inplace_merge(begin + bounds[first], begin + bounds[middle], begin + bounds[last], comp);
+        }, static_cast<int>(numMerges));
+      }
+    }
+
+    template <class Iterator>
+    static void Sort(Iterator begin, Iterator end)
+    {
+      Sort(begin, end, std::less<typename std::iterator_traits<Iterator>::value_type>());
+    }
   private:
     static unsigned int maximumCoresSetByUser_;
     static unsigned int capByUserCoreCount(unsigned int numProcs);
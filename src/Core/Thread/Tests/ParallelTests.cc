@@ -27,8 +27,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <numeric>
 #include <fstream>
+#include <stdexcept>
 
 #include <Core/Thread/Parallel.h>
 #include <boost/filesystem/path.hpp>
@@ -52,6 +54,119 @@ TEST(ParallelTests, CanDoubleNumberInParallel)
   EXPECT_EQ(expectedSum * 2, std::accumulate(nums.begin(), nums.end(), 0, std::plus<int>()));
 }
 
+TEST(ParallelTests, RangeTasksCoverEveryIndexExactlyOnce)
+{
+  const size_t size = 100003;
+  std::vector<int> visits(size, 0);
+
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end) { for (size_t j = begin; j < end; ++j) ++visits[j]; }, size);
+
+  EXPECT_EQ(std::vector<int>(size, 1), visits);
+}
+
+TEST(ParallelTests, RangeTasksHandleMoreThreadsThanWork)
+{
+  std::vector<int> visits(3, 0);
+
+  Parallel::RunTasksOverRange([&](size_t begin, size_t end) { for (size_t j = begin; j < end; ++j) ++visits[j]; }, visits.size(), 16);
+
+  EXPECT_EQ(std::vector<int>(3, 1), visits);
+
+  Parallel::RunTasksOverRange([&](size_t, size_t) { FAIL() << "no work expected"; }, 0);
+}
+
+TEST(ParallelTests, TaskExceptionIsRethrownOnCallingThread)
+{
+  std::vector<int> done(4, 0);
+
+  EXPECT_THROW(Parallel::RunTasks([&](int i)
+  {
+    if (i == 2)
+      throw std::invalid_argument("bad task");
+    done[i] = 1;
+  }, 4), std::invalid_argument);
+
+  EXPECT_EQ(std::vector<int>({1, 1, 0, 1}), done);
+}
+
+namespace
+{
+  std::vector<int> RandomInts(size_t size, int range)
+  {
+    std::vector<int> values(size);
+    unsigned int state = 12345;
+    for (auto& v : values)
+    {
+      state = state * 1103515245u + 12345u;
+      v = static_cast<int>((state >> 8) % range);
+    }
+    return values;
+  }
+
+  void ExpectSortMatchesStdSort(size_t size, int range, unsigned int maxBlocks)
+  {
+    auto values = RandomInts(size, range);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    Parallel::Sort(values.begin(), values.end(), std::less<int>(), maxBlocks);
+    EXPECT_EQ(expected, values);
+  }
+}
+
+TEST(ParallelTests, SortMatchesStdSort)
+{
+  auto values = RandomInts(100000, 1 << 20);
+  auto expected = values;
+  std::sort(expected.begin(), expected.end());
+  Parallel::Sort(values.begin(), values.end());
+  EXPECT_EQ(expected, values);
+}
+
+TEST(ParallelTests, SortOfSmallRangeIsSerial)
+{
+  ExpectSortMatchesStdSort(0, 10, 8);
+  ExpectSortMatchesStdSort(1, 10, 8);
+  ExpectSortMatchesStdSort(1023, 1000, 8);
+}
+
+TEST(ParallelTests, SortMergesOddNumberOfBlocks)
+{
+  // Three and five blocks leave an unpaired block in the first merge pass.
+  ExpectSortMatchesStdSort(3 * 1024 + 17, 1 << 20, 3);
+  ExpectSortMatchesStdSort(5 * 1024 + 3, 1 << 20, 5);
+  ExpectSortMatchesStdSort(7 * 1024, 1 << 20, 7);
+}
+
+TEST(ParallelTests, SortUsesCustomComparator)
+{
+  auto values = RandomInts(10000, 1 << 20);
+  auto expected = values;
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+  Parallel::Sort(values.begin(), values.end(), std::greater<int>(), 3);
+  EXPECT_EQ(expected, values);
+}
+
+TEST(ParallelTests, SortHandlesManyEqualKeys)
+{
+  ExpectSortMatchesStdSort(10000, 3, 4);
+  ExpectSortMatchesStdSort(10000, 1, 5);
+
+  // Only the keys are compared, so check the records keep their keys in order and none is lost.
+  std::vector<std::pair<int, int>> records;
+  auto keys = RandomInts(6000, 4);
+  for (size_t i = 0; i < keys.size(); ++i)
+    records.push_back(std::make_pair(keys[i], static_cast<int>(i)));
+  auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+  Parallel::Sort(records.begin(), records.end(), byKey, 3);
+  EXPECT_TRUE(std::is_sorted(records.begin(), records.end(), byKey));
+  std::vector<int> ids;
+  for (const auto& r : records)
+    ids.push_back(r.second);
+  std::sort(ids.begin(), ids.end());
+  for (size_t i = 0; i < ids.size(); ++i)
+    EXPECT_EQ(static_cast<int>(i), ids[i]);
+}
+
 /// @todo
 #if 0
 TEST(ParallelTests, CanDoubleNumberWithParallelForEach)
@@ -35,10 +35,10 @@
 namespace SCIRun {
 
 template<class T>
-int compute_checksum(T* data, std::size_t length)
+int compute_checksum(const T* data, std::size_t length)
 {
   std::size_t total_size = (sizeof(T)*length)/sizeof(4);
-  int* ptr = reinterpret_cast<int*>(data);
+  const int* ptr = reinterpret_cast<const int*>(data);
   int sum = 0;
   for (std::size_t q=0; q< total_size; q++) sum += ptr[q];
   return (sum);
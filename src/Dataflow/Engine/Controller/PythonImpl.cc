@@ -48,7 +48,9 @@
 
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
+#include <boost/optional.hpp>
 #include <Core/Python/PythonDatatypeConverter.h>
+#include <Core/Python/PythonDatatypeBuffer.h>
 #include <Core/Python/PythonInterpreter.h>
 
 using namespace SCIRun;
@@ -81,15 +83,21 @@ namespace
       return str_;
     }
 
+    virtual boost::python::object array() const override
+    {
+      return str_;
+    }
+
   private:
     StringHandle underlying_;
     boost::python::object str_;
   };
 
+  // The list conversions are only made when value is asked for, scripts using array never pay for them.
   class PyDatatypeDenseMatrix : public PyDatatype
   {
   public:
-    explicit PyDatatypeDenseMatrix(DenseMatrixHandle underlying) : underlying_(underlying), pyMat_(convertMatrixToPython(underlying))
+    explicit PyDatatypeDenseMatrix(DenseMatrixHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -100,18 +108,25 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return pyMat_;
+      if (!pyMat_)
+        pyMat_ = convertMatrixToPython(underlying_);
+      return *pyMat_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertMatrixToPythonBuffer(underlying_);
     }
 
   private:
     DenseMatrixHandle underlying_;
-    boost::python::list pyMat_;
+    mutable boost::optional<boost::python::list> pyMat_;
   };
 
   class PyDatatypeSparseRowMatrix : public PyDatatype
   {
   public:
-    explicit PyDatatypeSparseRowMatrix(SparseRowMatrixHandle underlying) : underlying_(underlying), pyMat_(convertMatrixToPython(underlying))
+    explicit PyDatatypeSparseRowMatrix(SparseRowMatrixHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -122,18 +137,25 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return pyMat_;
+      if (!pyMat_)
+        pyMat_ = convertMatrixToPython(underlying_);
+      return *pyMat_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertMatrixToPythonBuffers(underlying_);
     }
 
   private:
     SparseRowMatrixHandle underlying_;
-    boost::python::dict pyMat_;
+    mutable boost::optional<boost::python::dict> pyMat_;
   };
 
   class PyDatatypeField : public PyDatatype
   {
   public:
-    explicit PyDatatypeField(FieldHandle underlying) : underlying_(underlying), matlabStructure_(convertFieldToPython(underlying))
+    explicit PyDatatypeField(FieldHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -144,12 +166,19 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return matlabStructure_;
+      if (!matlabStructure_)
+        matlabStructure_ = convertFieldToPython(underlying_);
+      return *matlabStructure_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertFieldToPythonBuffers(underlying_);
     }
 
   private:
     FieldHandle underlying_;
-    boost::python::dict matlabStructure_;
+    mutable boost::optional<boost::python::dict> matlabStructure_;
   };
 
   class PyDatatypeFactory
@@ -76,6 +76,8 @@ namespace SCIRun
     virtual ~PyDatatype() {}
     virtual std::string type() const = 0;
     virtual boost::python::object value() const = 0;
+    /// Zero-copy buffer views of matrix and field storage; see PythonDatatypeBuffer.h.
+    virtual boost::python::object array() const = 0;
   };
 
   class SCISHARE PyPort : public boost::enable_shared_from_this<PyPort>
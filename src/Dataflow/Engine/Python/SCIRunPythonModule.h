@@ -67,6 +67,7 @@ BOOST_PYTHON_MODULE(SCIRunPythonAPI)
   boost::python::class_<PyDatatype, boost::shared_ptr<PyDatatype>, boost::noncopyable>("SCIRun::PyDatatype", boost::python::no_init)
     .add_property("type", &PyDatatype::type)
     .add_property("value", &PyDatatype::value)
+    .add_property("array", &PyDatatype::array)
   ;
 
   //////////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,16 @@ void VarBuffer::writeBytes(const char* bytes, size_t numBytes)
   mSerializer->writeBytes(bytes, numBytes);
 }
 
+char* VarBuffer::reserveBytes(size_t numBytes)
+{
+  while (mSerializer->getOffset() + numBytes > mBufferSize)
+    resize();
+
+  size_t offset = mSerializer->getOffset();
+  mSerializer->setOffset(offset + numBytes);
+  return getBuffer() + offset;
+}
+
 void VarBuffer::writeNullTermString(const char* str)
 {
   size_t stringLength = std::strlen(str);
@@ -28,6 +28,10 @@ public:
   // Writes numBytes of bytes.
   void writeBytes(const char* bytes, size_t numBytes);
 
+  /// Advances the write position by numBytes and returns a pointer to the
+  /// skipped region so it can be filled in place (e.g. from several threads).
+  char* reserveBytes(size_t numBytes);
+
   /// Writes a null terminated string.
   void writeNullTermString(const char* str);
 
@@ -27,8 +27,12 @@
 */
 
 #include <Graphics/Datatypes/GeometryImpl.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
 
 using namespace SCIRun::Core;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Graphics::Datatypes;
 
@@ -81,3 +85,253 @@ void SpireSubPass::addUniform(const Uniform& uniform)
 {
   mUniforms.push_back(uniform);
 }
+
+size_t SpireInstancedMesh::vertexStride() const
+{
+  size_t stride = 3;
+  if (!normals.empty()) stride += 3;
+  if (colorAttribute == ColorAttribute::RGBA) stride += 4;
+  else if (colorAttribute == ColorAttribute::TEXCOORDS) stride += 2;
+  return stride;
+}
+
+void SpireInstancedMesh::expand(size_t firstInstance, size_t lastInstance, float* vertexOut,
+  uint32_t* indexOut, BBox& bbox) const
+{
+  const size_t numTemplateVertices = numVertices();
+  const bool useNormals = !normals.empty();
+
+  for (size_t i = firstInstance; i < lastInstance; ++i)
+  {
+    const float* m = &transforms[12 * i];
+    const float* n = &normalTransforms[9 * i];
+    const float* c = &colors[4 * i];
+
+    for (size_t v = 0; v < numTemplateVertices; ++v)
+    {
+      const float* p = &positions[3 * v];
+      float x = m[0] * p[0] + m[3] * p[1] + m[6] * p[2] + m[9];
+      float y = m[1] * p[0] + m[4] * p[1] + m[7] * p[2] + m[10];
+      float z = m[2] * p[0] + m[5] * p[1] + m[8] * p[2] + m[11];
+      *vertexOut++ = x;
+      *vertexOut++ = y;
+      *vertexOut++ = z;
+      if (computeBoundingBox) bbox.extend(Point(x, y, z));
+
+      if (useNormals)
+      {
+        const float* nv = &normals[3 * v];
+        float nx = n[0] * nv[0] + n[3] * nv[1] + n[6] * nv[2];
+        float ny = n[1] * nv[0] + n[4] * nv[1] + n[7] * nv[2];
+        float nz = n[2] * nv[0] + n[5] * nv[1] + n[8] * nv[2];
+        float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (length > 0.0f)
+        {
+          nx /= length;
+          ny /= length;
+          nz /= length;
+        }
+        *vertexOut++ = nx;
+        *vertexOut++ = ny;
+        *vertexOut++ = nz;
+      }
+
+      if (colorAttribute == ColorAttribute::RGBA)
+      {
+        *vertexOut++ = c[0];
+        *vertexOut++ = c[1];
+        *vertexOut++ = c[2];
+        *vertexOut++ = c[3];
+      }
+      else if (colorAttribute == ColorAttribute::TEXCOORDS)
+      {
+        *vertexOut++ = c[0];
+        *vertexOut++ = c[0];
+      }
+    }
+
+    const uint32_t offset = static_cast<uint32_t>((i - firstInstance) * numTemplateVertices);
+    for (auto index : indices)
+      *indexOut++ = index + offset;
+  }
+}
+
+SpireSubPass SpireInstancedMesh::instancedPass(SpireVBO& templateVBO, SpireVBO& instanceVBO, SpireIBO& ibo) const
+{
+  const size_t numTemplateVertices = numVertices();
+  const size_t instances = numInstances();
+  const bool useNormals = !normals.empty();
+
+  std::vector<SpireVBO::AttributeData> templateAttribs;
+  templateAttribs.push_back(SpireVBO::AttributeData("aPos", 3 * sizeof(float)));
+  if (useNormals)
+    templateAttribs.push_back(SpireVBO::AttributeData("aNormal", 3 * sizeof(float)));
+
+  const size_t templateStride = useNormals ? 6 : 3;
+  const size_t templateSize = numTemplateVertices * templateStride * sizeof(float);
+  auto templateBuffer = std::make_shared<spire::VarBuffer>(templateSize);
+  float* vertexOut = reinterpret_cast<float*>(templateBuffer->reserveBytes(templateSize));
+  BBox templateBBox;
+  for (size_t v = 0; v < numTemplateVertices; ++v)
+  {
+    const float* p = &positions[3 * v];
+    *vertexOut++ = p[0];
+    *vertexOut++ = p[1];
+    *vertexOut++ = p[2];
+    templateBBox.extend(Point(p[0], p[1], p[2]));
+    if (useNormals)
+    {
+      *vertexOut++ = normals[3 * v];
+      *vertexOut++ = normals[3 * v + 1];
+      *vertexOut++ = normals[3 * v + 2];
+    }
+  }
+
+  // Per instance: the three columns of the transform and the translation, the
+  // columns of the normal transform for lit templates, then the color.
+  std::vector<SpireVBO::AttributeData> instanceAttribs;
+  for (const char* name : { "aInstanceAxis1", "aInstanceAxis2", "aInstanceAxis3", "aInstanceOrigin" })
+    instanceAttribs.push_back(SpireVBO::AttributeData(name, 3 * sizeof(float)));
+  if (useNormals)
+  {
+    for (const char* name : { "aInstanceNormal1", "aInstanceNormal2", "aInstanceNormal3" })
+      instanceAttribs.push_back(SpireVBO::AttributeData(name, 3 * sizeof(float)));
+  }
+  if (colorAttribute == ColorAttribute::RGBA)
+    instanceAttribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float)));
+  else if (colorAttribute == ColorAttribute::TEXCOORDS)
+    instanceAttribs.push_back(SpireVBO::AttributeData("aTexCoords", 2 * sizeof(float)));
+
+  size_t instanceStride = 0;
+  for (const auto& attrib : instanceAttribs)
+    instanceStride += attrib.sizeInBytes;
+  const size_t instanceSize = instances * instanceStride;
+  auto instanceBuffer = std::make_shared<spire::VarBuffer>(instanceSize);
+  float* instanceOut = reinterpret_cast<float*>(instanceBuffer->reserveBytes(instanceSize));
+
+  for (size_t i = 0; i < instances; ++i)
+  {
+    const float* m = &transforms[12 * i];
+    instanceOut = std::copy(m, m + 12, instanceOut);
+    if (useNormals)
+      instanceOut = std::copy(&normalTransforms[9 * i], &normalTransforms[9 * i] + 9, instanceOut);
+
+    const float* c = &colors[4 * i];
+    if (colorAttribute == ColorAttribute::RGBA)
+      instanceOut = std::copy(c, c + 4, instanceOut);
+    else if (colorAttribute == ColorAttribute::TEXCOORDS)
+    {
+      *instanceOut++ = c[0];
+      *instanceOut++ = c[0];
+    }
+  }
+
+  // The bounding box of each instance is the transformed bounding box of the template.
+  // As for the expanded passes, the box stays unset when it is not computed.
+  BBox instanceBBox;
+  if (computeBoundingBox && templateBBox.valid())
+  {
+    const Point lo = templateBBox.get_min();
+    const Point hi = templateBBox.get_max();
+    for (size_t i = 0; i < instances; ++i)
+    {
+      const float* m = &transforms[12 * i];
+      for (int c = 0; c < 8; ++c)
+      {
+        const Point p((c & 1) ? hi.x() : lo.x(), (c & 2) ? hi.y() : lo.y(), (c & 4) ? hi.z() : lo.z());
+        instanceBBox.extend(Point(m[0] * p.x() + m[3] * p.y() + m[6] * p.z() + m[9],
+                                  m[1] * p.x() + m[4] * p.y() + m[7] * p.z() + m[10],
+                                  m[2] * p.x() + m[5] * p.y() + m[8] * p.z() + m[11]));
+      }
+    }
+  }
+
+  const size_t iboSize = indices.size() * sizeof(uint32_t);
+  auto iboBuffer = std::make_shared<spire::VarBuffer>(iboSize);
+  uint32_t* indexOut = reinterpret_cast<uint32_t*>(iboBuffer->reserveBytes(iboSize));
+  std::copy(indices.begin(), indices.end(), indexOut);
+
+  templateVBO = SpireVBO(name + "VBO", templateAttribs, templateBuffer, numTemplateVertices, instanceBBox, true);
+  instanceVBO = SpireVBO(name + "InstanceVBO", instanceAttribs, instanceBuffer, instances, instanceBBox, true);
+  ibo = SpireIBO(name + "IBO", primitive, sizeof(uint32_t), iboBuffer);
+
+  SpireSubPass pass(name + "Pass", templateVBO.name, ibo.name, programName + "_Instanced", colorScheme,
+    renderState, RenderType::RENDER_VBO_IBO, templateVBO, ibo, SpireText(), texture);
+  for (const auto& uniform : uniforms) pass.addUniform(uniform);
+  pass.instances.vboName = instanceVBO.name;
+  pass.instances.numInstances = instances;
+  return pass;
+}
+
+void SpireInstancedMesh::expandPasses(std::list<SpireVBO>& vbos, std::list<SpireIBO>& ibos,
+  std::list<SpireSubPass>& passes) const
+{
+  const size_t numTemplateVertices = numVertices();
+  const size_t instances = numInstances();
+  if (numTemplateVertices == 0 || instances == 0) return;
+
+  std::vector<SpireVBO::AttributeData> attribs;
+  attribs.push_back(SpireVBO::AttributeData("aPos", 3 * sizeof(float)));
+  if (!normals.empty())
+    attribs.push_back(SpireVBO::AttributeData("aNormal", 3 * sizeof(float)));
+  if (colorAttribute == ColorAttribute::RGBA)
+    attribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float)));
+  else if (colorAttribute == ColorAttribute::TEXCOORDS)
+    attribs.push_back(SpireVBO::AttributeData("aTexCoords", 2 * sizeof(float)));
+
+  const size_t stride = vertexStride();
+  const static size_t maxPointsPerPass = 3 << 24;
+  const size_t instancesPerPass = std::max<size_t>(1, maxPointsPerPass / numTemplateVertices);
+
+  int passNumber = 0;
+  for (size_t startOfPass = 0; startOfPass < instances; startOfPass += instancesPerPass)
+  {
+    std::string passID = name + "_" + std::to_string(passNumber++);
+    std::string vboName = passID + "VBO";
+    std::string iboName = passID + "IBO";
+    std::string passName = passID + "Pass";
+
+    const size_t instancesInThisPass = std::min(instancesPerPass, instances - startOfPass);
+    const size_t verticesInThisPass = instancesInThisPass * numTemplateVertices;
+    const size_t vboSize = verticesInThisPass * stride * sizeof(float);
+    const size_t iboSize = instancesInThisPass * indices.size() * sizeof(uint32_t);
+
+    auto vboBuffer = std::make_shared<spire::VarBuffer>(vboSize);
+    auto iboBuffer = std::make_shared<spire::VarBuffer>(iboSize);
+    float* vertexOut = reinterpret_cast<float*>(vboBuffer->reserveBytes(vboSize));
+    uint32_t* indexOut = reinterpret_cast<uint32_t*>(iboBuffer->reserveBytes(iboSize));
+
+    const int numThreads = static_cast<int>(std::max<size_t>(1,
+      std::min<size_t>(Parallel::NumCores(), instancesInThisPass)));
+    std::vector<BBox> threadBBoxes(numThreads);
+    Parallel::RunTasks([&](int t)
+    {
+      size_t begin = instancesInThisPass * t / numThreads;
+      size_t end = instancesInThisPass * (t + 1) / numThreads;
+      expand(startOfPass + begin, startOfPass + end,
+        vertexOut + begin * numTemplateVertices * stride,
+        indexOut + begin * indices.size(), threadBBoxes[t]);
+    }, numThreads);
+
+    BBox passBBox;
+    for (const auto& box : threadBBoxes)
+      passBBox.extend(box);
+
+    SpireVBO geomVBO(vboName, attribs, vboBuffer, verticesInThisPass, passBBox, true);
+    SpireIBO geomIBO(iboName, primitive, sizeof(uint32_t), iboBuffer);
+
+    SpireSubPass pass(passName, vboName, iboName, programName, colorScheme,
+      renderState, RenderType::RENDER_VBO_IBO, geomVBO, geomIBO, SpireText(), texture);
+    for (const auto& uniform : uniforms) pass.addUniform(uniform);
+
+    vbos.push_back(geomVBO);
+    ibos.push_back(geomIBO);
+    passes.push_back(pass);
+  }
+}
+
+void GeometryObjectSpire::expandInstancedMeshes(VBOList& vbos, IBOList& ibos, PassList& passes) const
+{
+  for (const auto& mesh : mInstancedMeshes)
+    mesh.expandPasses(vbos, ibos, passes);
+}
@@ -38,6 +38,7 @@
 #include FT_FREETYPE_H
 
 #include <glm/glm.hpp>
+#include <limits>
 #include <var-buffer/VarBuffer.hpp>
 #include <es-cereal/ComponentSerialize.hpp>
 #include <Graphics/Datatypes/share.h>
@@ -165,6 +166,37 @@ namespace SCIRun {
       };
 
 
+      /// Screen-space error range in which a pass is drawn. Passes that hold
+      /// successive levels of a decimated mesh share a bounding box; the renderer
+      /// draws the coarsest one whose geometric error stays within the pixel
+      /// tolerance. The default range is always drawn.
+      struct SCISHARE SpireLevelOfDetail
+      {
+        SpireLevelOfDetail() : level(0), error(0.0), coarserError(std::numeric_limits<double>::infinity()),
+          pixelTolerance(1.0) {}
+
+        /// pixelsPerUnit: screen pixels covered by one world unit at the object.
+        bool isSelected(double pixelsPerUnit) const
+        {
+          return error * pixelsPerUnit <= pixelTolerance && coarserError * pixelsPerUnit > pixelTolerance;
+        }
+
+        int     level;          ///< 0 is full resolution.
+        double  error;          ///< World-space geometric error of this level.
+        double  coarserError;   ///< Error of the next coarser level, infinity for the coarsest.
+        double  pixelTolerance;
+      };
+
+      /// A pass that draws its VBO/IBO once per instance. The per-instance data lives
+      /// in a second VBO whose attributes advance once per instance.
+      struct SCISHARE SpireInstances
+      {
+        SpireInstances() : numInstances(0) {}
+
+        std::string   vboName;
+        size_t        numInstances;
+      };
+
       /// Defines a Spire object 'pass'.
       struct SCISHARE SpireSubPass
       {
@@ -207,6 +239,8 @@ namespace SCIRun {
         SpireText     text;//draw a string (usually single character) on geometry
         SpireTexture2D texture;
         double        scalar;
+        SpireLevelOfDetail lod;
+        SpireInstances instances;
 
 
         struct Uniform
@@ -244,9 +278,62 @@ namespace SCIRun {
         void addUniform(const Uniform& uniform);
       };
 
+      /// Template mesh shared by many glyphs of the same shape and resolution.
+      /// Each instance supplies an affine transform, a normal transform and a
+      /// color; the template is only stored once.
+      struct SCISHARE SpireInstancedMesh
+      {
+        enum class ColorAttribute
+        {
+          NONE,
+          RGBA,
+          TEXCOORDS
+        };
+
+        SpireInstancedMesh() : colorAttribute(ColorAttribute::NONE),
+          primitive(SpireIBO::PRIMITIVE::TRIANGLES), colorScheme(ColorScheme::COLOR_UNIFORM),
+          computeBoundingBox(true) {}
+
+        size_t numVertices() const { return positions.size() / 3; }
+        size_t numInstances() const { return transforms.size() / 12; }
+
+        /// Writes the instances in [firstInstance, lastInstance) as ordinary
+        /// vertex and index data, in the layout GlyphGeom uses for its passes.
+        void expand(size_t firstInstance, size_t lastInstance, float* vertexOut,
+          uint32_t* indexOut, Core::Geometry::BBox& bbox) const;
+        size_t vertexStride() const;
+
+        /// Builds the pass for renderers that draw instances: the template mesh goes
+        /// into templateVBO and ibo, the transforms and colors into instanceVBO. The
+        /// pass uses the "_Instanced" variant of programName.
+        SpireSubPass instancedPass(SpireVBO& templateVBO, SpireVBO& instanceVBO, SpireIBO& ibo) const;
+
+        /// Expands the instances into regular VBO/IBO passes on the CPU and appends
+        /// them to the given lists, splitting very large meshes over several passes.
+        void expandPasses(std::list<SpireVBO>& vbos, std::list<SpireIBO>& ibos,
+          std::list<SpireSubPass>& passes) const;
+
+        std::string                           name;
+        std::vector<float>                    positions;        // xyz per template vertex
+        std::vector<float>                    normals;          // xyz per template vertex, empty when unlit
+        std::vector<uint32_t>                 indices;          // into the template vertices
+        std::vector<float>                    transforms;       // per instance: 3x3 columns, then translation
+        std::vector<float>                    normalTransforms; // per instance: 3x3 columns
+        std::vector<float>                    colors;           // per instance: rgba
+        ColorAttribute                        colorAttribute;
+        SpireIBO::PRIMITIVE                   primitive;
+        std::string                           programName;
+        ColorScheme                           colorScheme;
+        RenderState                           renderState;
+        std::vector<SpireSubPass::Uniform>    uniforms;
+        SpireTexture2D                        texture;
+        bool                                  computeBoundingBox;
+      };
+
       using VBOList = std::list<SpireVBO>;
       using IBOList = std::list<SpireIBO>;
       using PassList = std::list<SpireSubPass>;
+      using InstancedMeshList = std::list<SpireInstancedMesh>;
 
       class SCISHARE GeometryObjectSpire : public Core::Datatypes::GeometryObject
       {
@@ -260,6 +347,13 @@ namespace SCIRun {
         IBOList& ibos() { return mIBOs; }
         const PassList& passes() const { return mPasses; }
         PassList& passes() { return mPasses; }
+        const InstancedMeshList& instancedMeshes() const { return mInstancedMeshes; }
+        InstancedMeshList& instancedMeshes() { return mInstancedMeshes; }
+
+        /// Converts the instanced meshes to regular VBO/IBO passes on the CPU and
+        /// appends them to the given lists, for renderers and exporters that cannot
+        /// draw instances directly. The object itself is left unchanged.
+        void expandInstancedMeshes(VBOList& vbos, IBOList& ibos, PassList& passes) const;
 
         bool isClippable() const {return isClippable_;}
 
@@ -270,6 +364,7 @@ namespace SCIRun {
         VBOList mVBOs;  ///< Array of vertex buffer objects.
         IBOList mIBOs;  ///< Array of index buffer objects.
         PassList  mPasses; /// List of passes to setup.
+        InstancedMeshList mInstancedMeshes; ///< Glyph templates not yet expanded into passes.
         bool isClippable_;
         boost::optional<std::string> mColorMap;
 
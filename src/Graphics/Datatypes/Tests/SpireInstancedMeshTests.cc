@@ -0,0 +1,200 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Graphics::Datatypes;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  // One lit triangle drawn at three places: shifted, scaled and rotated about z.
+  SpireInstancedMesh TriangleInstances()
+  {
+    SpireInstancedMesh mesh;
+    mesh.name = "triangles";
+    mesh.programName = "Shaders/Phong_Color";
+    mesh.colorAttribute = SpireInstancedMesh::ColorAttribute::RGBA;
+    mesh.positions = { 0, 0, 0,  1, 0, 0,  0, 1, 0 };
+    mesh.normals = { 0, 0, 1,  0, 0, 1,  0, 0, 1 };
+    mesh.indices = { 0, 1, 2 };
+    mesh.transforms = {
+      1, 0, 0,  0, 1, 0,  0, 0, 1,  5, 0, 0,
+      2, 0, 0,  0, 2, 0,  0, 0, 2,  0, -3, 1,
+      0, 1, 0,  -1, 0, 0,  0, 0, 1,  0, 0, -2 };
+    mesh.normalTransforms = {
+      1, 0, 0,  0, 1, 0,  0, 0, 1,
+      0.5f, 0, 0,  0, 0.5f, 0,  0, 0, 0.5f,
+      0, 1, 0,  -1, 0, 0,  0, 0, 1 };
+    mesh.colors = {
+      1, 0, 0, 1,
+      0, 1, 0, 1,
+      0, 0, 1, 0.5f };
+    return mesh;
+  }
+
+  // The geometry the instances stand for, one vertex at a time: position, normal, color.
+  std::vector<float> ExpectedVertices(const SpireInstancedMesh& mesh, BBox& bbox)
+  {
+    std::vector<float> vertices;
+    for (size_t i = 0; i < mesh.numInstances(); ++i)
+    {
+      const float* m = &mesh.transforms[12 * i];
+      for (size_t v = 0; v < mesh.numVertices(); ++v)
+      {
+        const float* p = &mesh.positions[3 * v];
+        Point q(m[0] * p[0] + m[3] * p[1] + m[6] * p[2] + m[9],
+                m[1] * p[0] + m[4] * p[1] + m[7] * p[2] + m[10],
+                m[2] * p[0] + m[5] * p[1] + m[8] * p[2] + m[11]);
+        bbox.extend(q);
+        vertices.insert(vertices.end(), { float(q.x()), float(q.y()), float(q.z()) });
+        // All the template normals are +z and every instance keeps z.
+        vertices.insert(vertices.end(), { 0, 0, 1 });
+        vertices.insert(vertices.end(), mesh.colors.begin() + 4 * i, mesh.colors.begin() + 4 * i + 4);
+      }
+    }
+    return vertices;
+  }
+
+  std::vector<float> Floats(const SpireVBO& vbo)
+  {
+    const float* data = reinterpret_cast<const float*>(vbo.data->getBuffer());
+    return std::vector<float>(data, data + vbo.data->getBufferSize() / sizeof(float));
+  }
+
+  std::vector<uint32_t> Indices(const SpireIBO& ibo)
+  {
+    const uint32_t* data = reinterpret_cast<const uint32_t*>(ibo.data->getBuffer());
+    return std::vector<uint32_t>(data, data + ibo.data->getBufferSize() / sizeof(uint32_t));
+  }
+}
+
+TEST(SpireInstancedMeshTests, ExpandedPassMatchesTransformedTemplate)
+{
+  auto mesh = TriangleInstances();
+  std::list<SpireVBO> vbos;
+  std::list<SpireIBO> ibos;
+  std::list<SpireSubPass> passes;
+  mesh.expandPasses(vbos, ibos, passes);
+
+  ASSERT_EQ(1u, vbos.size());
+  ASSERT_EQ(1u, ibos.size());
+  ASSERT_EQ(1u, passes.size());
+  EXPECT_EQ(10u, mesh.vertexStride());
+  EXPECT_EQ(9u, vbos.front().numElements);
+  EXPECT_EQ("Shaders/Phong_Color", passes.front().programName);
+
+  BBox expectedBBox;
+  auto expected = ExpectedVertices(mesh, expectedBBox);
+  auto vertices = Floats(vbos.front());
+  ASSERT_EQ(expected.size(), vertices.size());
+  for (size_t k = 0; k < expected.size(); ++k)
+    EXPECT_NEAR(expected[k], vertices[k], 1e-6) << k;
+
+  EXPECT_EQ(std::vector<uint32_t>({ 0, 1, 2, 3, 4, 5, 6, 7, 8 }), Indices(ibos.front()));
+
+  const BBox& bbox = vbos.front().boundingBox;
+  ASSERT_TRUE(bbox.valid());
+  EXPECT_EQ(expectedBBox.get_min(), bbox.get_min());
+  EXPECT_EQ(expectedBBox.get_max(), bbox.get_max());
+}
+
+TEST(SpireInstancedMeshTests, InstancedPassHoldsTemplateOnceAndBoundsEveryInstance)
+{
+  auto mesh = TriangleInstances();
+  SpireVBO templateVBO, instanceVBO;
+  SpireIBO ibo;
+  auto pass = mesh.instancedPass(templateVBO, instanceVBO, ibo);
+
+  EXPECT_EQ("Shaders/Phong_Color_Instanced", pass.programName);
+  EXPECT_EQ(instanceVBO.name, pass.instances.vboName);
+  EXPECT_EQ(3u, pass.instances.numInstances);
+  EXPECT_EQ(std::vector<uint32_t>({ 0, 1, 2 }), Indices(ibo));
+
+  std::vector<float> templateVertices = { 0, 0, 0, 0, 0, 1,  1, 0, 0, 0, 0, 1,  0, 1, 0, 0, 0, 1 };
+  EXPECT_EQ(templateVertices, Floats(templateVBO));
+
+  // Per instance: transform, normal transform and color.
+  auto instanceData = Floats(instanceVBO);
+  ASSERT_EQ(3u * (12 + 9 + 4), instanceData.size());
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const float* row = &instanceData[25 * i];
+    EXPECT_TRUE(std::equal(row, row + 12, &mesh.transforms[12 * i]));
+    EXPECT_TRUE(std::equal(row + 12, row + 21, &mesh.normalTransforms[9 * i]));
+    EXPECT_TRUE(std::equal(row + 21, row + 25, &mesh.colors[4 * i]));
+  }
+
+  // The triangle touches every side of its template box, and these transforms keep the
+  // box axis aligned, so the box of the instances is that of the expanded geometry.
+  BBox expectedBBox;
+  ExpectedVertices(mesh, expectedBBox);
+  const BBox& bbox = instanceVBO.boundingBox;
+  ASSERT_TRUE(bbox.valid());
+  EXPECT_EQ(expectedBBox.get_min(), bbox.get_min());
+  EXPECT_EQ(expectedBBox.get_max(), bbox.get_max());
+  EXPECT_EQ(bbox.get_min(), templateVBO.boundingBox.get_min());
+  EXPECT_EQ(bbox.get_max(), templateVBO.boundingBox.get_max());
+}
+
+TEST(SpireInstancedMeshTests, BoundingBoxesStayUnsetWhenNotComputed)
+{
+  auto mesh = TriangleInstances();
+  mesh.computeBoundingBox = false;
+
+  std::list<SpireVBO> vbos;
+  std::list<SpireIBO> ibos;
+  std::list<SpireSubPass> passes;
+  mesh.expandPasses(vbos, ibos, passes);
+  ASSERT_EQ(1u, vbos.size());
+  EXPECT_FALSE(vbos.front().boundingBox.valid());
+
+  SpireVBO templateVBO, instanceVBO;
+  SpireIBO ibo;
+  mesh.instancedPass(templateVBO, instanceVBO, ibo);
+  EXPECT_FALSE(templateVBO.boundingBox.valid());
+  EXPECT_FALSE(instanceVBO.boundingBox.valid());
+}
+
+TEST(SpireInstancedMeshTests, EmptyMeshAddsNoPasses)
+{
+  auto mesh = TriangleInstances();
+  mesh.transforms.clear();
+  mesh.normalTransforms.clear();
+  mesh.colors.clear();
+
+  std::list<SpireVBO> vbos;
+  std::list<SpireIBO> ibos;
+  std::list<SpireSubPass> passes;
+  mesh.expandPasses(vbos, ibos, passes);
+  EXPECT_TRUE(vbos.empty());
+  EXPECT_TRUE(ibos.empty());
+  EXPECT_TRUE(passes.empty());
+}
@@ -31,14 +31,16 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/Math/MiscMath.h>
 #include <Core/GeometryPrimitives/Transform.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace Graphics;
 using namespace Datatypes;
 using namespace Core::Geometry;
 using namespace Core::Datatypes;
+using namespace Core::Thread;
 
-GlyphGeom::GlyphGeom() : numVBOElements_(0), lineIndex_(0)
+GlyphGeom::GlyphGeom() : numVBOElements_(0), lineIndex_(0), useInstancing_(false)
 {
 
 }
@@ -111,6 +113,26 @@ void GlyphGeom::buildObject(GeometryObjectSpire& geom, const std::string& unique
 
   if (isTransparent) uniforms.push_back(SpireSubPass::Uniform("uTransparency", static_cast<float>(transparencyValue)));
 
+  state.set(RenderState::IS_ON, true);
+  state.set(RenderState::HAS_DATA, true);
+
+  if (!instances_.empty())
+  {
+    // Instanced glyphs are shaded like the rest of this geometry, so they are only
+    // lit when every tessellated glyph carries normals as well.
+    SpireInstancedMesh description;
+    description.colorAttribute = !useColor ? SpireInstancedMesh::ColorAttribute::NONE :
+      colorMap ? SpireInstancedMesh::ColorAttribute::TEXCOORDS : SpireInstancedMesh::ColorAttribute::RGBA;
+    description.primitive = primIn;
+    description.programName = shader;
+    description.colorScheme = colorScheme;
+    description.renderState = state;
+    description.uniforms = uniforms;
+    description.texture = texture;
+    description.computeBoundingBox = bbox.valid();
+    buildInstancedMeshes(geom, uniqueNodeID, description, useNormals);
+  }
+
   size_t pointsLeft = points_.size();
   size_t startOfPass = 0;
   int passNumber = 0;
@@ -177,8 +199,6 @@ void GlyphGeom::buildObject(GeometryObjectSpire& geom, const std::string& unique
     SpireVBO geomVBO(vboName, attribs, vboBufferSPtr, numVBOElements_, newBBox, true);
     SpireIBO geomIBO(iboName, primIn, sizeof(uint32_t), iboBufferSPtr);
 
-    state.set(RenderState::IS_ON, true);
-    state.set(RenderState::HAS_DATA, true);
     SpireSubPass pass(passName, vboName, iboName, shader, colorScheme, state, renderType, geomVBO, geomIBO, text, texture);
 
     for (const auto& uniform : uniforms) pass.addUniform(uniform);
@@ -189,9 +209,207 @@ void GlyphGeom::buildObject(GeometryObjectSpire& geom, const std::string& unique
   }
 }
 
+void GlyphGeom::append(const std::vector<GlyphGeom>& parts)
+{
+  if (parts.empty())
+    return;
+
+  // First pass: offsets of each part in the combined buffers.
+  struct Offsets { size_t points, normals, colors, indices; };
+  std::vector<Offsets> offsets(parts.size());
+  Offsets total { points_.size(), normals_.size(), colors_.size(), indices_.size() };
+  for (size_t i = 0; i < parts.size(); ++i)
+  {
+    offsets[i] = total;
+    total.points += parts[i].points_.size();
+    total.normals += parts[i].normals_.size();
+    total.colors += parts[i].colors_.size();
+    total.indices += parts[i].indices_.size();
+  }
+
+  points_.resize(total.points);
+  normals_.resize(total.normals);
+  colors_.resize(total.colors);
+  indices_.resize(total.indices);
+
+  // Second pass: copy every part to its slot. Indices are relative to the part's own points.
+  Parallel::RunTasks([&](int i)
+  {
+    const GlyphGeom& part = parts[i];
+    const Offsets& offset = offsets[i];
+    std::copy(part.points_.begin(), part.points_.end(), points_.begin() + offset.points);
+    std::copy(part.normals_.begin(), part.normals_.end(), normals_.begin() + offset.normals);
+    std::copy(part.colors_.begin(), part.colors_.end(), colors_.begin() + offset.colors);
+    std::transform(part.indices_.begin(), part.indices_.end(), indices_.begin() + offset.indices,
+      [&offset](size_t index) { return index + offset.points; });
+  }, static_cast<int>(parts.size()));
+
+  for (const auto& part : parts)
+  {
+    numVBOElements_ += part.numVBOElements_;
+    lineIndex_ += part.lineIndex_;
+  }
+
+  std::map<std::string, size_t> instanceCounts;
+  for (const auto& part : parts)
+    for (const auto& entry : part.instances_)
+      instanceCounts[entry.first] += entry.second.colors.size() / 4;
+  for (const auto& count : instanceCounts)
+  {
+    InstanceBatch& batch = instances_[count.first];
+    batch.transforms.reserve(batch.transforms.size() + 12 * count.second);
+    batch.normalTransforms.reserve(batch.normalTransforms.size() + 9 * count.second);
+    batch.colors.reserve(batch.colors.size() + 4 * count.second);
+  }
+  for (const auto& part : parts)
+  {
+    for (const auto& entry : part.instances_)
+    {
+      InstanceBatch& batch = instances_[entry.first];
+      if (!batch.templateGeom)
+        batch.templateGeom = entry.second.templateGeom;
+      batch.transforms.insert(batch.transforms.end(), entry.second.transforms.begin(), entry.second.transforms.end());
+      batch.normalTransforms.insert(batch.normalTransforms.end(), entry.second.normalTransforms.begin(), entry.second.normalTransforms.end());
+      batch.colors.insert(batch.colors.end(), entry.second.colors.begin(), entry.second.colors.end());
+    }
+  }
+}
+
+void GlyphGeom::buildInstancedMeshes(GeometryObjectSpire& geom, const std::string& uniqueNodeID,
+  const SpireInstancedMesh& description, bool useNormals) const
+{
+  for (const auto& entry : instances_)
+  {
+    const InstanceBatch& batch = entry.second;
+    const GlyphGeom& templ = *batch.templateGeom;
+
+    SpireInstancedMesh mesh(description);
+    mesh.name = uniqueNodeID + "_" + entry.first;
+
+    mesh.positions.reserve(3 * templ.points_.size());
+    for (const auto& point : templ.points_)
+    {
+      mesh.positions.push_back(static_cast<float>(point.x()));
+      mesh.positions.push_back(static_cast<float>(point.y()));
+      mesh.positions.push_back(static_cast<float>(point.z()));
+    }
+    if (useNormals)
+    {
+      mesh.normals.reserve(3 * templ.normals_.size());
+      for (const auto& normal : templ.normals_)
+      {
+        mesh.normals.push_back(static_cast<float>(normal.x()));
+        mesh.normals.push_back(static_cast<float>(normal.y()));
+        mesh.normals.push_back(static_cast<float>(normal.z()));
+      }
+    }
+    mesh.indices.assign(templ.indices_.begin(), templ.indices_.end());
+
+    mesh.transforms = batch.transforms;
+    mesh.normalTransforms = batch.normalTransforms;
+    mesh.colors = batch.colors;
+
+    geom.instancedMeshes().push_back(mesh);
+  }
+}
+
+template <class MakeTemplate>
+GlyphGeom::InstanceBatch& GlyphGeom::instanceBatch(const std::string& key, MakeTemplate makeTemplate)
+{
+  InstanceBatch& batch = instances_[key];
+  if (!batch.templateGeom)
+  {
+    batch.templateGeom = boost::make_shared<GlyphGeom>();
+    makeTemplate(*batch.templateGeom);
+  }
+  return batch;
+}
+
+void GlyphGeom::addInstance(InstanceBatch& batch, const Transform& trans, const Transform& normalTrans,
+                            const ColorRGB& color)
+{
+  addInstance(batch, trans * Vector(1, 0, 0), trans * Vector(0, 1, 0), trans * Vector(0, 0, 1),
+              trans * Point(0, 0, 0), normalTrans * Vector(1, 0, 0), normalTrans * Vector(0, 1, 0),
+              normalTrans * Vector(0, 0, 1), color);
+}
+
+void GlyphGeom::addInstance(InstanceBatch& batch, const Vector& axis1, const Vector& axis2,
+                            const Vector& axis3, const Point& origin, const Vector& normalAxis1,
+                            const Vector& normalAxis2, const Vector& normalAxis3, const ColorRGB& color)
+{
+  for (const Vector& v : { axis1, axis2, axis3, Vector(origin) })
+  {
+    batch.transforms.push_back(static_cast<float>(v.x()));
+    batch.transforms.push_back(static_cast<float>(v.y()));
+    batch.transforms.push_back(static_cast<float>(v.z()));
+  }
+  for (const Vector& v : { normalAxis1, normalAxis2, normalAxis3 })
+  {
+    batch.normalTransforms.push_back(static_cast<float>(v.x()));
+    batch.normalTransforms.push_back(static_cast<float>(v.y()));
+    batch.normalTransforms.push_back(static_cast<float>(v.z()));
+  }
+  batch.colors.push_back(static_cast<float>(color.r()));
+  batch.colors.push_back(static_cast<float>(color.g()));
+  batch.colors.push_back(static_cast<float>(color.b()));
+  batch.colors.push_back(static_cast<float>(color.a()));
+}
+
+// Axial glyphs (arrows, cones, disks) are generated around the axis p1->p2 using the
+// same tangent frame as generateCylinder/generateCone. The template is built from
+// (0,0,0) to (0,0,1) with unit radius, so each instance is a rotation of that frame
+// scaled by the radius across the axis and by the length along it.
+template <class MakeTemplate>
+bool GlyphGeom::addAxialInstance(const std::string& key, const Point& p1, const Point& p2,
+                                 double radius, const ColorRGB& color, MakeTemplate makeTemplate)
+{
+  const double length = (p2 - p1).length();
+  if (length < 1.0e-12 || radius < 1.0e-12)
+    return false;
+
+  static const Vector templateAxis(0, 0, 1);
+  static const Vector templateN = -templateAxis;
+  static const Vector templateCrx = templateN.getArbitraryTangent();
+  static const Vector templateU = Cross(templateCrx, templateN).normal();
+
+  Vector n((p1 - p2).normal());
+  Vector crx = n.getArbitraryTangent();
+  Vector u = Cross(crx, n).normal();
+  Vector axis = -n;
+
+  auto mapAxis = [&](const Vector& e, double across, double along)
+  {
+    return across * (Dot(templateU, e) * u + Dot(templateCrx, e) * crx) + along * Dot(templateAxis, e) * axis;
+  };
+
+  InstanceBatch& batch = instanceBatch(key, [&](GlyphGeom& templ)
+  {
+    makeTemplate(templ, Point(0, 0, 0), Point(0, 0, 1));
+  });
+
+  addInstance(batch,
+              mapAxis(Vector(1, 0, 0), radius, length), mapAxis(Vector(0, 1, 0), radius, length),
+              mapAxis(Vector(0, 0, 1), radius, length), p1,
+              mapAxis(Vector(1, 0, 0), 1.0 / radius, 1.0 / length), mapAxis(Vector(0, 1, 0), 1.0 / radius, 1.0 / length),
+              mapAxis(Vector(0, 0, 1), 1.0 / radius, 1.0 / length), color);
+  return true;
+}
+
 void GlyphGeom::addArrow(const Point& p1, const Point& p2, double radius, double ratio, int resolution,
                          const ColorRGB& color1, const ColorRGB& color2, bool render_cylinder_base, bool render_cone_base)
 {
+  if (useInstancing_ && color1 == color2)
+  {
+    std::string key = "arrow" + std::to_string(resolution) + "_" + std::to_string(ratio) + "_" +
+      std::to_string(render_cylinder_base) + std::to_string(render_cone_base);
+    auto makeTemplate = [=](GlyphGeom& templ, const Point& t1, const Point& t2)
+    {
+      templ.addArrow(t1, t2, 1.0, ratio, resolution, color1, color2, render_cylinder_base, render_cone_base);
+    };
+    if (addAxialInstance(key, p1, p2, radius, color1, makeTemplate))
+      return;
+  }
+
   Point mid((p1.x() * ratio + p2.x() * (1 - ratio)), (p1.y() * ratio + p2.y() * (1 - ratio)), (p1.z() * ratio + p2.z() * (1 - ratio)));
 
   generateCylinder(p1, mid, radius / 6.0, radius / 6.0, resolution, color1, color2, render_cylinder_base, false);
@@ -200,6 +418,17 @@ void GlyphGeom::addArrow(const Point& p1, const Point& p2, double radius, double
 
 void GlyphGeom::addSphere(const Point& p, double radius, int resolution, const ColorRGB& color)
 {
+  if (useInstancing_)
+  {
+    InstanceBatch& batch = instanceBatch("sphere" + std::to_string(resolution), [=](GlyphGeom& templ)
+    {
+      templ.generateSphere(Point(0, 0, 0), 1.0, resolution, color);
+    });
+    double r = radius < 0 ? 1.0 : radius;
+    addInstance(batch, Vector(r, 0, 0), Vector(0, r, 0), Vector(0, 0, r), p,
+                Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1), color);
+    return;
+  }
   generateSphere(p, radius, resolution, color);
 }
 
@@ -241,6 +470,15 @@ void GlyphGeom::addCylinder(const Point& p1, const Point& p2, double radius1, do
 void GlyphGeom::addDisk(const Point& p1, const Point& p2, double radius, int resolution,
                             const ColorRGB& color1, const ColorRGB& color2)
 {
+  if (useInstancing_ && color1 == color2)
+  {
+    auto makeTemplate = [=](GlyphGeom& templ, const Point& t1, const Point& t2)
+    {
+      templ.generateCylinder(t1, t2, 1.0, 1.0, resolution, color1, color2, true, true);
+    };
+    if (addAxialInstance("disk" + std::to_string(resolution), p1, p2, radius, color1, makeTemplate))
+      return;
+  }
   generateCylinder(p1, p2, radius, radius, resolution, color1, color2, true, true);
 }
 
@@ -253,6 +491,16 @@ void GlyphGeom::addTorus(const Point& p1, const Point& p2, double major_radius,
 void GlyphGeom::addCone(const Point& p1, const Point& p2, double radius, int resolution,
                         bool render_base, const ColorRGB& color1, const ColorRGB& color2)
 {
+  if (useInstancing_ && color1 == color2)
+  {
+    std::string key = "cone" + std::to_string(resolution) + "_" + std::to_string(render_base);
+    auto makeTemplate = [=](GlyphGeom& templ, const Point& t1, const Point& t2)
+    {
+      templ.generateCone(t1, t2, 1.0, resolution, render_base, color1, color2);
+    };
+    if (addAxialInstance(key, p1, p2, radius, color1, makeTemplate))
+      return;
+  }
   generateCone(p1, p2, radius, resolution, render_base, color1, color2);
 }
 
@@ -630,25 +878,25 @@ void GlyphGeom::generateComet(const Point& p1, const Point& p2,
 
   double end = M_PI * (0.5 + sphere_extrusion);
 
-  SinCosTable tab1(nu, 0, 2 * M_PI);
-  SinCosTable tab2(nv, 0, end);
+  auto tab1 = SinCosTable::shared(nu, 0, 2 * M_PI);
+  auto tab2 = SinCosTable::shared(nv, 0, end);
 
   int cone_rim_index = 0;
 
   // Draw the ellipsoid
   for (int v = 0; v<nv - 1; v++)
   {
-    double nr1 = tab2.sin(v + 1);
-    double nr2 = tab2.sin(v);
+    double nr1 = tab2->sin(v + 1);
+    double nr2 = tab2->sin(v);
 
-    double nz1 = tab2.cos(v + 1);
-    double nz2 = tab2.cos(v);
+    double nz1 = tab2->cos(v + 1);
+    double nz2 = tab2->cos(v);
 
     for (int u = 0; u<nu; u++)
     {
       uint32_t offset = static_cast<uint32_t>(numVBOElements_);
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       double x1 = nr1 * nx;
       double y1 = nr1 * ny;
@@ -799,6 +1047,24 @@ void GlyphGeom::generateBox(const Point& center, Tensor& t, double scale, ColorR
   Transform trans, rotate;
   generateTransforms(center, eigvectors[0], eigvectors[1], eigvectors[2], trans, rotate);
 
+  if (useInstancing_)
+  {
+    InstanceBatch& batch = instanceBatch("box", [=](GlyphGeom& templ)
+    {
+      templ.generateBoxSides(Transform(), Transform(), Vector(1.0, 1.0, 1.0), node_color);
+    });
+    Transform scaled(trans);
+    scaled.post_scale(eigvals);
+    addInstance(batch, scaled, rotate, node_color);
+    return;
+  }
+
+  generateBoxSides(trans, rotate, eigvals, node_color);
+}
+
+void GlyphGeom::generateBoxSides(const Transform& trans, const Transform& rotate, const Vector& eigvals,
+                                 const ColorRGB& node_color)
+{
   std::vector<Vector> box_points = generateBoxPoints(trans, eigvals);
   std::vector<Vector> column_vectors = rotate.get_column_vectors();
 
@@ -891,6 +1157,24 @@ void GlyphGeom::generateEllipsoid(const Point& center, Tensor& t, double scale,
   trans.post_scale (Vector(1.0,1.0,1.0) * eigvals);
   rotate.post_scale(Vector(1.0,1.0,1.0) / eigvals);
 
+  // Flat tensors use a fixed normal per side, which a linear normal transform cannot express.
+  if (useInstancing_ && !flatTensor)
+  {
+    std::string key = (half ? "half_ellipsoid" : "ellipsoid") + std::to_string(resolution);
+    InstanceBatch& batch = instanceBatch(key, [=](GlyphGeom& templ)
+    {
+      templ.generateEllipsoidSurface(Transform(), Transform(), resolution, color, half, false, Vector());
+    });
+    addInstance(batch, trans, rotate, color);
+    return;
+  }
+
+  generateEllipsoidSurface(trans, rotate, resolution, color, half, flatTensor, zero_norm);
+}
+
+void GlyphGeom::generateEllipsoidSurface(const Transform& trans, const Transform& rotate, int resolution,
+                                         const ColorRGB& color, bool half, bool flatTensor, const Vector& zero_norm)
+{
   int nu = resolution + 1;
 
   // Half ellipsoid criteria.
@@ -902,23 +1186,23 @@ void GlyphGeom::generateEllipsoid(const Point& center, Tensor& t, double scale,
 
   double end = half ? M_PI / 2 : M_PI;
 
-  SinCosTable tab1(nu, 0, 2 * M_PI);
-  SinCosTable tab2(nv, 0, end);
+  auto tab1 = SinCosTable::shared(nu, 0, 2 * M_PI);
+  auto tab2 = SinCosTable::shared(nv, 0, end);
 
   // Draw the ellipsoid
   for (int v = 0; v<nv - 1; v++)
   {
-    double nr1 = tab2.sin(v + 1);
-    double nr2 = tab2.sin(v);
+    double nr1 = tab2->sin(v + 1);
+    double nr2 = tab2->sin(v);
 
-    double nz1 = tab2.cos(v + 1);
-    double nz2 = tab2.cos(v);
+    double nz1 = tab2->cos(v + 1);
+    double nz2 = tab2->cos(v);
 
     for (int u = 0; u<nu; u++)
     {
       uint32_t offset = static_cast<uint32_t>(numVBOElements_);
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       double x1 = nr1 * nx;
       double y1 = nr1 * ny;
@@ -1052,8 +1336,8 @@ void GlyphGeom::generateSuperEllipsoid(const Point& center, Tensor& t, double sc
   int nu = resolution + 1;
   int nv = resolution;
 
-  SinCosTable tab1(nu, 0, 2 * M_PI);
-  SinCosTable tab2(nv, 0, M_PI);
+  auto tab1 = SinCosTable::shared(nu, 0, 2 * M_PI);
+  auto tab2 = SinCosTable::shared(nv, 0, M_PI);
 
   double cl = (eigvals[0] - eigvals[1]) / (eigvals[0] + eigvals[1] + eigvals[2]);
   double cp = 2.0 * (eigvals[1] - eigvals[2]) / (eigvals[0] + eigvals[1] + eigvals[2]);
@@ -1065,16 +1349,16 @@ void GlyphGeom::generateSuperEllipsoid(const Point& center, Tensor& t, double sc
 
   for (int v=0; v < nv-1; v++)
   {
-    nr[0] = tab2.sin(v+1);
-    nr[1] = tab2.sin(v);
+    nr[0] = tab2->sin(v+1);
+    nr[1] = tab2->sin(v);
 
-    nz[0] = tab2.cos(v+1);
-    nz[1] = tab2.cos(v);
+    nz[0] = tab2->cos(v+1);
+    nz[1] = tab2->cos(v);
 
     for (int u=0; u<nu; u++)
     {
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       uint32_t offset = static_cast<uint32_t>(numVBOElements_);
       for( unsigned int i=0; i<2; i++ )
@@ -1117,8 +1401,8 @@ void GlyphGeom::generateTorus(const Point& p1, const Point& p2, double major_rad
   int nv = resolution;
   int nu = nv + 1;
 
-  SinCosTable tab1(nu, 0, 2*M_PI);
-  SinCosTable tab2(nv, 0, 2*M_PI, minor_radius);
+  auto tab1 = SinCosTable::shared(nu, 0, 2*M_PI);
+  auto tab2 = SinCosTable::shared(nv, 0, 2*M_PI);
 
   Transform trans;
   Transform rotate;
@@ -1128,11 +1412,11 @@ void GlyphGeom::generateTorus(const Point& p1, const Point& p2, double major_rad
   // Draw the torus
   for (int v=0; v<nv-1; v++)
   {
-    double z1 = tab2.cos(v+1);
-    double z2 = tab2.cos(v);
+    double z1 = tab2->cos(v+1) * minor_radius;
+    double z2 = tab2->cos(v) * minor_radius;
 
-    double nr1 = tab2.sin(v+1);
-    double nr2 = tab2.sin(v);
+    double nr1 = tab2->sin(v+1) * minor_radius;
+    double nr2 = tab2->sin(v) * minor_radius;
 
     double r1 = major_radius + nr1;
     double r2 = major_radius + nr2;
@@ -1141,8 +1425,8 @@ void GlyphGeom::generateTorus(const Point& p1, const Point& p2, double major_rad
     {
       uint32_t offset = static_cast<uint32_t>(numVBOElements_);
 
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       double x1 = r1 * nx;
       double y1 = r1 * ny;
@@ -1289,7 +1573,7 @@ void GlyphGeom::generateCylinder(const Point& center, const Vector& t, double ra
 
   if (nu > 20) nu = 20;
   if (nv == 0) nv = 20;
-  SinCosTable& tab1 = tables_[nu];
+  auto tab1 = SinCosTable::shared(nu, 0, 2 * M_PI);
 
   Transform trans;
   Transform rotate;
@@ -1311,8 +1595,8 @@ void GlyphGeom::generateCylinder(const Point& center, const Vector& t, double ra
 
     for (int u = 0; u<nu; u++)
     {
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       double x1 = r1 * nx;
       double y1 = r1 * ny;
@@ -1354,8 +1638,8 @@ void GlyphGeom::generateEllipsoid(const Point& center, const Vector& t, double s
   // Should only happen when doing half ellipsoids.
   if (nv < 2) nv = 2;
 
-  SinCosTable tab1(nu, 0, 2 * M_PI);
-  SinCosTable tab2(nv, start, stop);
+  auto tab1 = SinCosTable::shared(nu, 0, 2 * M_PI);
+  auto tab2 = SinCosTable::shared(nv, start, stop);
 
   Transform trans;
   Transform rotate;
@@ -1367,18 +1651,18 @@ void GlyphGeom::generateEllipsoid(const Point& center, const Vector& t, double s
   // Draw the ellipsoid
   for (int v = 0; v<nv - 1; v++)
   {
-    double nr1 = tab2.sin(v + 1);
-    double nr2 = tab2.sin(v);
+    double nr1 = tab2->sin(v + 1);
+    double nr2 = tab2->sin(v);
 
-    double nz1 = tab2.cos(v + 1);
-    double nz2 = tab2.cos(v);
+    double nz1 = tab2->cos(v + 1);
+    double nz2 = tab2->cos(v);
 
     QuadStrip quadstrip;
 
     for (int u = 0; u<nu; u++)
     {
-      double nx = tab1.sin(u);
-      double ny = tab1.cos(u);
+      double nx = tab1->sin(u);
+      double ny = tab1->cos(u);
 
       double x1 = nr1 * nx;
       double y1 = nr1 * ny;
@@ -36,6 +36,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Graphics/Datatypes/GeometryImpl.h>
 #include <Core/Datatypes/Color.h>
 #include <Eigen/Dense>
+#include <map>
 
 #include <Graphics/Glyphs/share.h>
 
@@ -49,6 +50,15 @@ namespace SCIRun {
 
       GlyphGeom();
 
+      /// Store spheres, ellipsoids, boxes, arrows, cones and disks as instances of one template
+      /// mesh per shape and resolution instead of tessellating every glyph. buildObject then emits
+      /// GeometryObjectSpire::instancedMeshes() for those glyphs.
+      void setUseInstancing(bool useInstancing) { useInstancing_ = useInstancing; }
+
+      /// Appends partial builds (for example one per thread) in order. Output sizes are summed
+      /// first so every buffer grows once, then the parts are copied in parallel.
+      void append(const std::vector<GlyphGeom>& parts);
+
       void buildObject(Datatypes::GeometryObjectSpire& geom, const std::string& uniqueNodeID, const bool isTransparent, const double transparencyValue,
         const Datatypes::ColorScheme& colorScheme, RenderState state,
         const Datatypes::SpireIBO::PRIMITIVE& primIn, const Core::Geometry::BBox& bbox, const bool isClippable = true, const Core::Datatypes::ColorMapHandle colorMap = nullptr);
@@ -98,13 +108,36 @@ namespace SCIRun {
       void addSphere(const Core::Geometry::Point& center, double radius, int nu=20, int nv=20, int half=0);
 
     private:
-      std::vector<SinCosTable> tables_;
+      struct InstanceBatch
+      {
+        boost::shared_ptr<GlyphGeom> templateGeom;
+        std::vector<float> transforms;
+        std::vector<float> normalTransforms;
+        std::vector<float> colors;
+      };
+
       std::vector<Core::Geometry::Vector> points_;
       std::vector<Core::Geometry::Vector> normals_;
       std::vector<Core::Datatypes::ColorRGB> colors_;
       std::vector<size_t> indices_;
       size_t numVBOElements_;
       size_t lineIndex_;
+      bool useInstancing_;
+      std::map<std::string, InstanceBatch> instances_;
+
+      template <class MakeTemplate>
+      InstanceBatch& instanceBatch(const std::string& key, MakeTemplate makeTemplate);
+      void addInstance(InstanceBatch& batch, const Core::Geometry::Transform& trans,
+                       const Core::Geometry::Transform& normalTrans, const Core::Datatypes::ColorRGB& color);
+      void addInstance(InstanceBatch& batch, const Core::Geometry::Vector& axis1, const Core::Geometry::Vector& axis2,
+                       const Core::Geometry::Vector& axis3, const Core::Geometry::Point& origin,
+                       const Core::Geometry::Vector& normalAxis1, const Core::Geometry::Vector& normalAxis2,
+                       const Core::Geometry::Vector& normalAxis3, const Core::Datatypes::ColorRGB& color);
+      template <class MakeTemplate>
+      bool addAxialInstance(const std::string& key, const Core::Geometry::Point& p1, const Core::Geometry::Point& p2,
+                            double radius, const Core::Datatypes::ColorRGB& color, MakeTemplate makeTemplate);
+      void buildInstancedMeshes(Datatypes::GeometryObjectSpire& geom, const std::string& uniqueNodeID,
+                                const Datatypes::SpireInstancedMesh& description, bool useNormals) const;
 
       void generateCylinder(const  Core::Geometry::Point& p1, const  Core::Geometry::Point& p2, double radius1, double radius2, int resolution, const Core::Datatypes::ColorRGB& color1, const Core::Datatypes::ColorRGB& color2);
       void generateSphere(const Core::Geometry::Point& center, double radius, int resolution, const Core::Datatypes::ColorRGB& color);
@@ -114,6 +147,10 @@ namespace SCIRun {
                            const Core::Geometry::Vector& p3, const Core::Geometry::Vector& p4,
                            const Core::Geometry::Vector& normal, const Core::Datatypes::ColorRGB& node_color);
       void generateEllipsoid(const Core::Geometry::Point& center, Core::Geometry::Tensor& t, double scale, int resolution, const Core::Datatypes::ColorRGB& color, bool half, bool normalize);
+      void generateEllipsoidSurface(const Core::Geometry::Transform& trans, const Core::Geometry::Transform& rotate, int resolution,
+                                    const Core::Datatypes::ColorRGB& color, bool half, bool flatTensor, const Core::Geometry::Vector& zero_norm);
+      void generateBoxSides(const Core::Geometry::Transform& trans, const Core::Geometry::Transform& rotate,
+                            const Core::Geometry::Vector& eigvals, const Core::Datatypes::ColorRGB& node_color);
       void generateSuperEllipsoid(const Core::Geometry::Point& center, Core::Geometry::Tensor& t, double scale, int resolution, const Core::Datatypes::ColorRGB& color, bool normalize, double emphasis);
       void generateCone(const  Core::Geometry::Point& p1, const  Core::Geometry::Point& p2, double radius, int resolution, bool renderBase, const Core::Datatypes::ColorRGB& color1, const Core::Datatypes::ColorRGB& color2);
       void generateTorus(const Core::Geometry::Point& p1, const Core::Geometry::Point& p2, double major_radius, double minor_radius,
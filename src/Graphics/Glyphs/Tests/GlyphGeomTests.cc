@@ -0,0 +1,318 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Graphics/Glyphs/GlyphGeom.h>
+#include <Core/GeometryPrimitives/Tensor.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Graphics;
+using namespace SCIRun::Graphics::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Datatypes;
+
+namespace
+{
+  class NameAsIdGenerator : public Core::GeometryIDGenerator
+  {
+  public:
+    virtual std::string generateGeometryID(const std::string& tag) const override { return tag; }
+  };
+
+  const ColorRGB color(0.2, 0.4, 0.6);
+
+  Tensor SampleTensor()
+  {
+    return Tensor(Vector(3, 0.5, 0.2), Vector(0.5, 2, 0.1), Vector(0.2, 0.1, 1));
+  }
+
+  // Builds the same glyphs tessellated and instanced, expands the instances on the CPU and
+  // checks both give the same vertices, indices, shader and bounding box.
+  template <class AddGlyphs>
+  void ExpectInstancedMatchesTessellated(AddGlyphs addGlyphs)
+  {
+    NameAsIdGenerator gen;
+    GeometryObjectSpire tessellated(gen, "tessellated", true), instanced(gen, "instanced", true);
+    GlyphGeom direct, instances;
+    instances.setUseInstancing(true);
+    addGlyphs(direct);
+    addGlyphs(instances);
+
+    RenderState state;
+    BBox bbox(Point(0, 0, 0), Point(1, 1, 1));
+    direct.buildObject(tessellated, "glyphs", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+      SpireIBO::PRIMITIVE::TRIANGLES, bbox);
+    instances.buildObject(instanced, "glyphs", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+      SpireIBO::PRIMITIVE::TRIANGLES, bbox);
+
+    ASSERT_EQ(1u, instanced.instancedMeshes().size());
+    ASSERT_TRUE(instanced.passes().empty());
+    VBOList vbos;
+    IBOList ibos;
+    PassList passes;
+    instanced.expandInstancedMeshes(vbos, ibos, passes);
+    ASSERT_EQ(1u, tessellated.passes().size());
+    ASSERT_EQ(1u, passes.size());
+
+    auto& expected = *tessellated.vbos().front().data;
+    auto& actual = *vbos.front().data;
+    ASSERT_EQ(expected.getBufferSize(), actual.getBufferSize());
+    ASSERT_EQ(tessellated.vbos().front().numElements, vbos.front().numElements);
+    const size_t stride = expected.getBufferSize() / sizeof(float) / vbos.front().numElements;
+    const float* e = reinterpret_cast<const float*>(expected.getBuffer());
+    const float* a = reinterpret_cast<const float*>(actual.getBuffer());
+    for (size_t v = 0; v < vbos.front().numElements; ++v, e += stride, a += stride)
+    {
+      // Positions and colors match exactly; the expanded normals are unit length, which the
+      // tessellated ones need not be when the tensor eigenvectors are not normalized.
+      Vector expectedNormal(e[3], e[4], e[5]), actualNormal(a[3], a[4], a[5]);
+      expectedNormal.safe_normalize();
+      for (size_t k = 0; k < stride; ++k)
+      {
+        if (k >= 3 && k < 6)
+          EXPECT_NEAR(expectedNormal[k - 3], actualNormal[k - 3], 1e-4) << v;
+        else
+          EXPECT_NEAR(e[k], a[k], 1e-4) << v;
+      }
+    }
+
+    auto& expectedIndices = *tessellated.ibos().front().data;
+    auto& actualIndices = *ibos.front().data;
+    ASSERT_EQ(expectedIndices.getBufferSize(), actualIndices.getBufferSize());
+    EXPECT_EQ(0, memcmp(expectedIndices.getBuffer(), actualIndices.getBuffer(), expectedIndices.getBufferSize()));
+
+    EXPECT_EQ(tessellated.passes().front().programName, passes.front().programName);
+    EXPECT_EQ(tessellated.passes().front().mUniforms.size(), passes.front().mUniforms.size());
+
+    const BBox& expectedBBox = tessellated.vbos().front().boundingBox;
+    const BBox& actualBBox = vbos.front().boundingBox;
+    ASSERT_TRUE(actualBBox.valid());
+    EXPECT_LT((expectedBBox.get_min() - actualBBox.get_min()).length(), 1e-4);
+    EXPECT_LT((expectedBBox.get_max() - actualBBox.get_max()).length(), 1e-4);
+  }
+}
+
+TEST(GlyphGeomTests, InstancedSpheresMatchTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g)
+  {
+    g.addSphere(Point(1, 2, 3), 0.7, 10, color);
+    g.addSphere(Point(-2, 0, 1), 0.3, 10, color);
+  });
+}
+
+TEST(GlyphGeomTests, InstancedArrowMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { g.addArrow(Point(1, 2, 3), Point(2, 0.5, 4), 0.3, 0.7, 8, color, color, true, true); });
+}
+
+TEST(GlyphGeomTests, InstancedArrowWithoutBaseMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { g.addArrow(Point(1, 2, 3), Point(1, 2, -4), 0.3, 0.5, 8, color, color, false, false); });
+}
+
+TEST(GlyphGeomTests, InstancedConeMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { g.addCone(Point(1, 2, 3), Point(0.2, 0.5, 1), 0.3, 8, true, color, color); });
+}
+
+TEST(GlyphGeomTests, InstancedDiskMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { g.addDisk(Point(1, 2, 3), Point(1.1, 2.05, 3), 0.8, 8, color, color); });
+}
+
+TEST(GlyphGeomTests, InstancedEllipsoidMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { Tensor t = SampleTensor(); g.addEllipsoid(Point(1, 2, 3), t, 0.5, 10, color, false); });
+}
+
+TEST(GlyphGeomTests, InstancedNormalizedEllipsoidMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { Tensor t = SampleTensor(); g.addEllipsoid(Point(1, 2, 3), t, 0.5, 10, color, true); });
+}
+
+TEST(GlyphGeomTests, InstancedBoxMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g) { Tensor t = SampleTensor(); ColorRGB c = color; g.addBox(Point(1, 2, 3), t, 0.5, c, false); });
+}
+
+TEST(GlyphGeomTests, InstancedFlatBoxMatchesTessellated)
+{
+  ExpectInstancedMatchesTessellated([](GlyphGeom& g)
+  {
+    Tensor flat(Vector(3, 0, 0), Vector(0, 2, 0), Vector(0, 0, 0));
+    ColorRGB c = color;
+    g.addBox(Point(1, 2, 3), flat, 0.5, c, false);
+  });
+}
+
+TEST(GlyphGeomTests, InstancedBoundingBoxCoversAllInstances)
+{
+  NameAsIdGenerator gen;
+  GeometryObjectSpire geom(gen, "spheres", true);
+  GlyphGeom glyphs;
+  glyphs.setUseInstancing(true);
+  for (int i = 0; i < 1000; ++i)
+    glyphs.addSphere(Point(i, 0, 0), 0.5, 6, color);
+
+  RenderState state;
+  glyphs.buildObject(geom, "spheres", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+    SpireIBO::PRIMITIVE::TRIANGLES, BBox(Point(0, 0, 0), Point(1, 1, 1)));
+  ASSERT_EQ(1u, geom.instancedMeshes().size());
+  EXPECT_EQ(1000u, geom.instancedMeshes().front().numInstances());
+
+  SpireVBO templateVBO, instanceVBO;
+  SpireIBO ibo;
+  geom.instancedMeshes().front().instancedPass(templateVBO, instanceVBO, ibo);
+  ASSERT_TRUE(instanceVBO.boundingBox.valid());
+  EXPECT_NEAR(-0.5, instanceVBO.boundingBox.get_min().x(), 1e-5);
+  EXPECT_NEAR(999.5, instanceVBO.boundingBox.get_max().x(), 1e-5);
+
+  VBOList vbos;
+  IBOList ibos;
+  PassList passes;
+  geom.expandInstancedMeshes(vbos, ibos, passes);
+  ASSERT_EQ(1u, passes.size());
+  const BBox& bbox = vbos.front().boundingBox;
+  EXPECT_NEAR(-0.5, bbox.get_min().x(), 1e-5);
+  EXPECT_NEAR(999.5, bbox.get_max().x(), 1e-5);
+}
+
+TEST(GlyphGeomTests, InvalidBoundingBoxIsNotComputedForInstances)
+{
+  NameAsIdGenerator gen;
+  GeometryObjectSpire geom(gen, "spheres", true);
+  GlyphGeom glyphs;
+  glyphs.setUseInstancing(true);
+  glyphs.addSphere(Point(1, 2, 3), 0.5, 6, color);
+
+  RenderState state;
+  glyphs.buildObject(geom, "spheres", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+    SpireIBO::PRIMITIVE::TRIANGLES, BBox());
+  ASSERT_EQ(1u, geom.instancedMeshes().size());
+  EXPECT_FALSE(geom.instancedMeshes().front().computeBoundingBox);
+
+  SpireVBO templateVBO, instanceVBO;
+  SpireIBO ibo;
+  geom.instancedMeshes().front().instancedPass(templateVBO, instanceVBO, ibo);
+  EXPECT_FALSE(instanceVBO.boundingBox.valid());
+}
+
+namespace
+{
+  // A mix of tessellated and (when instancing) instanced glyphs, as ShowFieldGlyphs emits them.
+  void AddMixedGlyphs(GlyphGeom& glyphs, int begin, int end)
+  {
+    for (int i = begin; i < end; ++i)
+    {
+      Tensor t = SampleTensor();
+      const ColorRGB c(i / 40.0, 0.5, 1 - i / 40.0);
+      switch (i % 4)
+      {
+      case 0: glyphs.addSuperEllipsoid(Point(i, 0, 0), t, 0.5, 6, c, false, 0.8); break;
+      case 1: glyphs.addEllipsoid(Point(i, 1, 0), t, 0.5, 6, c, false); break;
+      case 2: glyphs.addTorus(Point(i, 0, 1), Point(i, 1, 1), 1.0, 0.2, 6, c, c); break;
+      default: glyphs.addArrow(Point(i, 0, 0), Point(i, 2, 1), 0.2, 0.7, 6, c, c, true, true); break;
+      }
+    }
+  }
+
+  void ExpectSameBuffers(const VBOList& expected, const VBOList& actual)
+  {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto e = expected.begin(), a = actual.begin(); e != expected.end(); ++e, ++a)
+    {
+      EXPECT_EQ(e->numElements, a->numElements);
+      ASSERT_EQ(e->data->getBufferSize(), a->data->getBufferSize());
+      EXPECT_EQ(0, memcmp(e->data->getBuffer(), a->data->getBuffer(), e->data->getBufferSize()));
+    }
+  }
+
+  void ExpectSameBuffers(const IBOList& expected, const IBOList& actual)
+  {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto e = expected.begin(), a = actual.begin(); e != expected.end(); ++e, ++a)
+    {
+      ASSERT_EQ(e->data->getBufferSize(), a->data->getBufferSize());
+      EXPECT_EQ(0, memcmp(e->data->getBuffer(), a->data->getBuffer(), e->data->getBufferSize()));
+    }
+  }
+
+  // Builds 40 glyphs serially and as uneven blocks (one of them empty) merged by append, and
+  // checks the two give the same vertices and indices, tessellated and instanced alike.
+  void ExpectAppendedBlocksMatchSerialBuild(bool useInstancing)
+  {
+    GlyphGeom serial;
+    serial.setUseInstancing(useInstancing);
+    AddMixedGlyphs(serial, 0, 40);
+
+    const int bounds[] = { 0, 7, 7, 23, 40 };
+    std::vector<GlyphGeom> parts(4);
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+      parts[i].setUseInstancing(useInstancing);
+      AddMixedGlyphs(parts[i], bounds[i], bounds[i + 1]);
+    }
+    GlyphGeom merged;
+    merged.setUseInstancing(useInstancing);
+    merged.append(parts);
+
+    NameAsIdGenerator gen;
+    GeometryObjectSpire serialGeom(gen, "serial", true), mergedGeom(gen, "merged", true);
+    RenderState state;
+    BBox bbox(Point(0, 0, 0), Point(1, 1, 1));
+    serial.buildObject(serialGeom, "glyphs", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+      SpireIBO::PRIMITIVE::TRIANGLES, bbox);
+    merged.buildObject(mergedGeom, "glyphs", false, 1.0, ColorScheme::COLOR_IN_SITU, state,
+      SpireIBO::PRIMITIVE::TRIANGLES, bbox);
+
+    ASSERT_EQ(1u, serialGeom.passes().size());
+    ExpectSameBuffers(serialGeom.vbos(), mergedGeom.vbos());
+    ExpectSameBuffers(serialGeom.ibos(), mergedGeom.ibos());
+
+    ASSERT_EQ(useInstancing ? 2u : 0u, serialGeom.instancedMeshes().size());
+    ASSERT_EQ(serialGeom.instancedMeshes().size(), mergedGeom.instancedMeshes().size());
+    VBOList serialVBOs, mergedVBOs;
+    IBOList serialIBOs, mergedIBOs;
+    PassList serialPasses, mergedPasses;
+    serialGeom.expandInstancedMeshes(serialVBOs, serialIBOs, serialPasses);
+    mergedGeom.expandInstancedMeshes(mergedVBOs, mergedIBOs, mergedPasses);
+    ExpectSameBuffers(serialVBOs, mergedVBOs);
+    ExpectSameBuffers(serialIBOs, mergedIBOs);
+  }
+}
+
+TEST(GlyphGeomTests, AppendedBlocksMatchSerialBuild)
+{
+  ExpectAppendedBlocksMatchSerialBuild(false);
+}
+
+TEST(GlyphGeomTests, AppendedInstancedBlocksMatchSerialBuild)
+{
+  ExpectAppendedBlocksMatchSerialBuild(true);
+}
@@ -45,4 +45,5 @@ CalculateDistanceToFieldBoundaryDialog::CalculateDistanceToFieldBoundaryDialog(c
   addDoubleSpinBoxManager(truncateDoubleSpinBox_, Parameters::TruncateDistance);
   addComboBoxManager(basisTypeComboBox_, Parameters::BasisType);
   addComboBoxManager(dataTypeComboBox_, Parameters::OutputFieldDatatype);
+  addComboBoxManager(distanceMethodComboBox_, Parameters::DistanceMethod);
 }
@@ -44,11 +44,14 @@ FairMeshDialog::FairMeshDialog(const std::string& name, ModuleStateHandle state,
 
   connect(fastWeightingButton_, SIGNAL(clicked()), this, SLOT(push()));
   connect(desbrunWeightingButton_, SIGNAL(clicked()), this, SLOT(push()));
+  connect(hcWeightingButton_, SIGNAL(clicked()), this, SLOT(push()));
 
   using namespace Parameters;
   addSpinBoxManager(iterationsSpinBox_, NumIterations);
   addDoubleSpinBoxManager(spatialCutOffDoubleSpinBox_, FilterCutoff);
   addDoubleSpinBoxManager(relaxationParameterDoubleSpinBox_, Lambda);
+  addDoubleSpinBoxManager(hcAlphaDoubleSpinBox_, HCAlpha);
+  addDoubleSpinBoxManager(hcBetaDoubleSpinBox_, HCBeta);
 }
 
 void FairMeshDialog::push()
@@ -56,7 +59,10 @@ void FairMeshDialog::push()
   if (!pulling_)
   {
     using namespace Parameters;
-    state_->setValue(FairMeshMethod, fastWeightingButton_->isChecked() ? std::string("fast") : std::string("desbrun"));
+    std::string method = "desbrun";
+    if (fastWeightingButton_->isChecked()) method = "fast";
+    else if (hcWeightingButton_->isChecked()) method = "hc";
+    state_->setValue(FairMeshMethod, method);
   }
 }
 
@@ -66,4 +72,5 @@ void FairMeshDialog::pullSpecial() //TODO: change to checkbox manager //TODO ref
   auto method = state_->getValue(FairMeshMethod).toString();
   fastWeightingButton_->setChecked("fast" == method);
   desbrunWeightingButton_->setChecked("desbrun" == method);
+  hcWeightingButton_->setChecked("hc" == method);
 }
@@ -47,6 +47,9 @@ GetMeshQualityFieldDialog::GetMeshQualityFieldDialog(const std::string& name, Mo
   map_.insert(StringPair("Jacobian","jacobian"));
   map_.insert(StringPair("Volume","volume"));
   map_.insert(StringPair("Scaled Inscribed/Circumscribed Ratio","insc_circ_ratio"));
+  map_.insert(StringPair("Condition Number","condition_number"));
+  map_.insert(StringPair("Aspect Ratio","aspect_ratio"));
     
   addComboBoxManager(metricComboBox_, Metric,map_);
+  addSpinBoxManager(histogramBinsSpinBox_, HistogramBins);
 }
@@ -45,4 +45,5 @@ SplitFieldByConnectedRegionDialog::SplitFieldByConnectedRegionDialog(const std::
 
   addCheckBoxManager(SortDomainBySize, SplitFieldByConnectedRegionAlgo::SortDomainBySize());
   addCheckBoxManager(SortAscending, SplitFieldByConnectedRegionAlgo::SortAscending());
+  addCheckBoxManager(OutputLabelField, SplitFieldByConnectedRegionAlgo::OutputLabelField());
 }
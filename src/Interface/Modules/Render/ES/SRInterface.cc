@@ -63,6 +63,7 @@
 #include <es-fs/FilesystemSync.hpp>
 
 #include "CoreBootstrap.h"
+#include "SRUtil.h"
 #include "comp/StaticSRInterface.h"
 #include "comp/RenderBasicGeom.h"
 #include "comp/SRRenderState.h"
@@ -93,6 +94,22 @@ namespace SCIRun {
       return glm::pow(in, glm::vec3(2.2));
     }
 
+    static GLenum primitiveMode(SpireIBO::PRIMITIVE prim)
+    {
+      switch (prim)
+      {
+        case SpireIBO::PRIMITIVE::POINTS:
+          return GL_POINTS;
+        case SpireIBO::PRIMITIVE::LINES:
+          return GL_LINES;
+        case SpireIBO::PRIMITIVE::QUADS:
+          return GL_QUADS;
+        case SpireIBO::PRIMITIVE::TRIANGLES:
+        default:
+          return GL_TRIANGLES;
+      }
+    }
+
     //----------------------------------------------------------------------------------------------
     SRInterface::SRInterface(int frameInitLimit) :
       frameInitLimit_(frameInitLimit),
@@ -413,10 +430,16 @@ namespace SCIRun {
         selMap.insert(std::make_pair(selid, objectName));
         glm::vec4 selCol = getVectorForID(selid);
 
+        // Selection only needs positions, so glyph instances are expanded on the CPU.
+        GeometryObjectSpire::VBOList vbos(obj->vbos());
+        GeometryObjectSpire::IBOList ibos(obj->ibos());
+        GeometryObjectSpire::PassList passes(obj->passes());
+        obj->expandInstancedMeshes(vbos, ibos, passes);
+
         // Add vertex buffer objects.
         std::vector<char*> vbo_buffer;
         std::vector<size_t> stride_vbo;
-        for (auto it = obj->vbos().cbegin(); it != obj->vbos().cend(); ++it, ++nameIndex)
+        for (auto it = vbos.cbegin(); it != vbos.cend(); ++it, ++nameIndex)
         {
           const auto& vbo = *it;
 
@@ -441,7 +464,7 @@ namespace SCIRun {
 
         // Add index buffer objects.
         nameIndex = 0;
-        for (auto it = obj->ibos().cbegin(); it != obj->ibos().cend(); ++it, ++nameIndex)
+        for (auto it = ibos.cbegin(); it != ibos.cend(); ++it, ++nameIndex)
         {
           const auto& ibo = *it;
           GLenum primType = GL_UNSIGNED_SHORT;
@@ -493,7 +516,7 @@ namespace SCIRun {
         if (auto shaderMan = sm.lock())
         {
           // Add passes
-          for (auto& pass : obj->passes())
+          for (auto& pass : passes)
           {
             uint64_t entityID = getEntityIDForName(pass.passName, port);
 
@@ -1031,12 +1054,48 @@ namespace SCIRun {
           }
 
           DEBUG_LOG_LINE_INFO
+          RENDERER_LOG("Draw opaque glyph instances from their template mesh when the context can. "
+            "Other instances are expanded into regular passes on local copies of the object's lists.");
+          GeometryObjectSpire::VBOList vbos(obj->vbos());
+          GeometryObjectSpire::IBOList ibos(obj->ibos());
+          GeometryObjectSpire::PassList passes(obj->passes());
+          GeometryObjectSpire::PassList instancedPasses;
+          const bool instancing = !obj->instancedMeshes().empty() && instancedRenderingSupported();
+          for (const auto& mesh : obj->instancedMeshes())
+          {
+            // Transparent instances need the per-triangle sorted IBOs, so they are expanded too.
+            const bool transparent = mesh.renderState.get(RenderState::USE_TRANSPARENCY) ||
+              mesh.renderState.get(RenderState::USE_TRANSPARENT_EDGES) ||
+              mesh.renderState.get(RenderState::USE_TRANSPARENT_NODES);
+            if (!instancing || transparent || mesh.numVertices() == 0 || mesh.numInstances() == 0)
+            {
+              mesh.expandPasses(vbos, ibos, passes);
+              continue;
+            }
+
+            SpireVBO templateVBO, instanceVBO;
+            SpireIBO ibo;
+            instancedPasses.push_back(mesh.instancedPass(templateVBO, instanceVBO, ibo));
+            for (const auto* vbo : { &templateVBO, &instanceVBO })
+            {
+              std::vector<std::tuple<std::string, size_t, bool>> attributeData;
+              for (const auto& attribData : vbo->attributes)
+                attributeData.push_back(std::make_tuple(attribData.name, attribData.sizeInBytes, attribData.normalize));
+              vboMan->addInMemoryVBO(vbo->data->getBuffer(), vbo->data->getBufferSize(), attributeData, vbo->name);
+            }
+            iboMan->addInMemoryIBO(ibo.data->getBuffer(), ibo.data->getBufferSize(), primitiveMode(ibo.prim),
+              GL_UNSIGNED_INT, static_cast<int>(ibo.data->getBufferSize() / ibo.indexSize), ibo.name);
+            if (instanceVBO.boundingBox.valid())
+              bbox.extend(instanceVBO.boundingBox);
+          }
+          passes.splice(passes.end(), instancedPasses);
+
           RENDERER_LOG("Add vertex buffer objects.");
           std::vector<char*> vbo_buffer;
           std::vector<size_t> stride_vbo;
 
           int nameIndex = 0;
-          for (auto it = obj->vbos().cbegin(); it != obj->vbos().cend(); ++it, ++nameIndex)
+          for (auto it = vbos.cbegin(); it != vbos.cend(); ++it, ++nameIndex)
           {
             const auto& vbo = *it;
 
@@ -1064,7 +1123,7 @@ namespace SCIRun {
           DEBUG_LOG_LINE_INFO
           RENDERER_LOG("Add index buffer objects.");
           nameIndex = 0;
-          for (auto it = obj->ibos().cbegin(); it != obj->ibos().cend(); ++it, ++nameIndex)
+          for (auto it = ibos.cbegin(); it != ibos.cend(); ++it, ++nameIndex)
           {
             const auto& ibo = *it;
             GLenum primType = GL_UNSIGNED_SHORT;
@@ -1089,25 +1148,7 @@ namespace SCIRun {
               break;
             }
 
-            GLenum primitive = GL_TRIANGLES;
-            switch (ibo.prim)
-            {
-              case SpireIBO::PRIMITIVE::POINTS:
-                primitive = GL_POINTS;
-                break;
-
-              case SpireIBO::PRIMITIVE::LINES:
-                primitive = GL_LINES;
-                break;
-
-              case SpireIBO::PRIMITIVE::TRIANGLES:
-                primitive = GL_TRIANGLES;
-                break;
-
-              case SpireIBO::PRIMITIVE::QUADS:
-                primitive = GL_QUADS;
-                break;
-            }
+            GLenum primitive = primitiveMode(ibo.prim);
 
             if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
             {
@@ -1220,14 +1261,20 @@ namespace SCIRun {
             }
 
             RENDERER_LOG("Add passes");
-            for (auto& pass : obj->passes())
+            for (auto& pass : passes)
             {
               uint64_t entityID = getEntityIDForName(pass.passName, port);
 
               if (pass.renderType == RenderType::RENDER_VBO_IBO)
               {
                 addVBOToEntity(entityID, pass.vboName);
-                if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
+                if (!pass.instances.vboName.empty())
+                {
+                  RENDERER_LOG("Instanced passes are opaque and draw their single IBO once per instance.");
+                  addVBOToEntity(entityID, pass.instances.vboName);
+                  addIBOToEntity(entityID, pass.iboName);
+                }
+                else if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
                 {
                   for (int i = 0; i <= 6; ++i)
                   {
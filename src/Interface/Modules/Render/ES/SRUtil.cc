@@ -27,8 +27,14 @@
 */
 
 #include <Interface/Modules/Render/ES/SRUtil.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
+#include <es-general/comp/StaticCamera.hpp>
 
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 
 namespace SCIRun {
 namespace Render {
@@ -108,6 +114,67 @@ size_t buildNormalRenderingForVBO(std::shared_ptr<std::vector<uint8_t>> vboData,
   return numInVertices;
 }
 
+bool isLevelOfDetailVisible(const Graphics::Datatypes::SpireSubPass& pass,
+                            const gen::StaticCameraData& camera)
+{
+  const auto& lod = pass.lod;
+  if (lod.error <= 0.0 && std::isinf(lod.coarserError))
+    return true;
+
+  // Orthographic views and unsized windows fall back to full resolution.
+  const auto& bbox = pass.vbo.boundingBox;
+  if (!bbox.valid() || camera.fovy <= 0.0f || camera.aspect <= 0.0f || camera.winWidth <= 0.0f)
+    return lod.level == 0;
+
+  const auto center = bbox.center();
+  const float radius = static_cast<float>(0.5 * bbox.diagonal().length());
+  const glm::vec4 viewCenter = camera.view * glm::vec4(center.x(), center.y(), center.z(), 1.0f);
+  const float distance = std::max(-viewCenter.z - radius, camera.znear);
+
+  const float winHeight = camera.winWidth / camera.aspect;
+  const double pixelsPerUnit = winHeight / (2.0 * distance * std::tan(0.5 * camera.fovy));
+  return lod.isSelected(pixelsPerUnit);
+}
+
+bool instancedRenderingSupported()
+{
+#ifdef USE_OPENGL_ES
+  return false;
+#else
+  const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+  int major = 0, minor = 0;
+  if (version && sscanf(version, "%d.%d", &major, &minor) == 2 &&
+      (major > 3 || (major == 3 && minor >= 3)))
+    return true;
+
+  const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+  return extensions && strstr(extensions, "GL_ARB_instanced_arrays") &&
+    strstr(extensions, "GL_ARB_draw_instanced");
+#endif
+}
+
+void vertexAttribDivisor(GLuint index, GLuint divisor)
+{
+#if defined(USE_OPENGL_ES)
+  (void)index; (void)divisor;
+#elif defined(__APPLE__) && !defined(USE_CORE_PROFILE_3) && !defined(USE_CORE_PROFILE_4)
+  GL(glVertexAttribDivisorARB(index, divisor));
+#else
+  GL(glVertexAttribDivisor(index, divisor));
+#endif
+}
+
+void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, GLsizei instances)
+{
+#if defined(USE_OPENGL_ES)
+  (void)mode; (void)count; (void)type; (void)instances;
+#elif defined(__APPLE__) && !defined(USE_CORE_PROFILE_3) && !defined(USE_CORE_PROFILE_4)
+  GL(glDrawElementsInstancedARB(mode, count, type, 0, instances));
+#else
+  GL(glDrawElementsInstanced(mode, count, type, 0, instances));
+#endif
+}
+
 } // namespace Render
 } // namespace SCIRun 
 
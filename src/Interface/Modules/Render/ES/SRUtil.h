@@ -33,8 +33,19 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <gl-platform/GLPlatform.hpp>
+
+namespace gen {
+struct StaticCameraData;
+}
 
 namespace SCIRun {
+namespace Graphics {
+namespace Datatypes {
+struct SpireSubPass;
+}
+}
+
 namespace Render {
 
 // Misc SCIRun utilities.
@@ -58,6 +69,24 @@ size_t buildNormalRenderingForVBO(std::shared_ptr<std::vector<uint8_t>> vboData,
                                   size_t posOffset = 0,
                                   size_t normOffset = sizeof(float) * 3);
 
+/// Whether a pass holding one level of a decimated mesh should be drawn from
+/// the current camera. The object is taken to be as close as its bounding
+/// sphere allows, so the selection errs towards finer levels. Passes without
+/// level of detail information are always drawn.
+bool isLevelOfDetailVisible(const Graphics::Datatypes::SpireSubPass& pass,
+                            const gen::StaticCameraData& camera);
+
+/// Whether the current context can draw instances with per-instance vertex
+/// attributes (OpenGL 3.3, or ARB_instanced_arrays with ARB_draw_instanced).
+/// Requires a current context.
+bool instancedRenderingSupported();
+
+/// Sets how often the given attribute advances: 0 per vertex, 1 per instance.
+void vertexAttribDivisor(GLuint index, GLuint divisor);
+
+/// Draws the bound IBO the given number of times.
+void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, GLsizei instances);
+
 } // namespace Render
 } // namespace SCIRun 
 
@@ -5,10 +5,83 @@
 #include <es-cereal/ComponentSerialize.hpp>
 #include <es-render/util/Shader.hpp>
 #include <es-render/comp/StaticVBOMan.hpp>
+#include "../SRUtil.h"
 
 namespace SCIRun {
 namespace Render {
 
+/// Attributes of a pass drawn with instancing. The template VBO advances per
+/// vertex and the instance VBO once per instance; each VBO supplies the shader
+/// attributes it has.
+class InstancedVBOAttribs
+{
+public:
+  static const int MaxNumAttributes = 8;
+
+  InstancedVBOAttribs() : mIsSetup(false) {}
+
+  void setup(GLuint templateVBO, GLuint instanceVBO, GLuint shaderID, const ren::StaticVBOMan& vboMan)
+  {
+    std::vector<spire::ShaderAttribute> attribs = spire::getProgramAttributes(shaderID);
+    spire::sortAttributesAlphabetically(attribs);
+
+    mTemplate.setup(templateVBO, attribs, *vboMan.instance_);
+    mInstance.setup(instanceVBO, attribs, *vboMan.instance_);
+    if (mTemplate.size + mInstance.size < attribs.size())
+    {
+      std::cerr << "InstancedVBOAttribs: Unable to satisfy shader! Not enough attributes." << std::endl;
+    }
+    mIsSetup = true;
+  }
+
+  bool isSetup() const {return mIsSetup;}
+
+  void bind() const
+  {
+    GL(glBindBuffer(GL_ARRAY_BUFFER, mTemplate.vbo));
+    spire::bindPreappliedAttrib(mTemplate.applied, mTemplate.size, mTemplate.stride);
+
+    GL(glBindBuffer(GL_ARRAY_BUFFER, mInstance.vbo));
+    spire::bindPreappliedAttrib(mInstance.applied, mInstance.size, mInstance.stride);
+    for (size_t i = 0; i < mInstance.size; ++i)
+      vertexAttribDivisor(static_cast<GLuint>(mInstance.applied[i].attribLoc), 1);
+  }
+
+  void unbind() const
+  {
+    for (size_t i = 0; i < mInstance.size; ++i)
+      vertexAttribDivisor(static_cast<GLuint>(mInstance.applied[i].attribLoc), 0);
+    spire::unbindPreappliedAttrib(mInstance.applied, mInstance.size);
+    spire::unbindPreappliedAttrib(mTemplate.applied, mTemplate.size);
+  }
+
+private:
+  struct Binding
+  {
+    Binding() : vbo(0), size(0), stride(0) {}
+
+    void setup(GLuint vboID, std::vector<spire::ShaderAttribute>& attribs, const ren::VBOMan& vboMan)
+    {
+      vbo = vboID;
+      std::vector<spire::ShaderAttribute> vboAttribs = vboMan.getVBOAttributes(vboID);
+      std::tuple<size_t, size_t> sizes = spire::buildPreappliedAttrib(
+          &vboAttribs[0], vboAttribs.size(), &attribs[0], attribs.size(),
+          applied, MaxNumAttributes);
+      size = std::get<0>(sizes);
+      stride = std::get<1>(sizes);
+    }
+
+    GLuint  vbo;
+    size_t  size;
+    size_t  stride;
+    spire::ShaderAttributeApplied applied[MaxNumAttributes];
+  };
+
+  bool    mIsSetup;
+  Binding mTemplate;
+  Binding mInstance;
+};
+
 /// \todo Transition this class to use a base class that is shared with
 ///       render color mapped geom. That will get rid of the duplication
 ///       while retaining state and functionality.
@@ -17,6 +90,7 @@ struct RenderBasicGeom
   // -- Data --
   static const int MaxNumAttributes = 5;
   ren::ShaderVBOAttribs<MaxNumAttributes> attribs;
+  InstancedVBOAttribs instancedAttribs;
 
   // -- Functions --
   RenderBasicGeom() {}
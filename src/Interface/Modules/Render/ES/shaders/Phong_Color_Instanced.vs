@@ -0,0 +1,65 @@
+/*
+  For more information, please see: http://software.sci.utah.edu
+
+  The MIT License
+
+  Copyright (c) 2015 Scientific Computing and Imaging Institute,
+  University of Utah.
+
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and associated documentation files (the "Software"),
+  to deal in the Software without restriction, including without limitation
+  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+  and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+  DEALINGS IN THE SOFTWARE.
+*/
+
+// Uniforms
+uniform mat4    uModelViewProjection;
+uniform mat4    uModel;
+uniform mat4    uView;
+
+// Attributes
+attribute vec3  aPos;
+attribute vec3  aNormal;
+
+// Per-instance attributes: the columns of the instance transform and its origin.
+attribute vec3  aInstanceAxis1;
+attribute vec3  aInstanceAxis2;
+attribute vec3  aInstanceAxis3;
+attribute vec3  aInstanceOrigin;
+attribute vec3  aInstanceNormal1;
+attribute vec3  aInstanceNormal2;
+attribute vec3  aInstanceNormal3;
+attribute vec4  aColor;
+
+// Outputs to the fragment shader.
+varying vec3    vNormal;
+varying vec4    vPosWorld;
+varying vec4    vPosView;
+varying vec4    vColor;
+
+void main( void )
+{
+  vec3 pos = aInstanceAxis1 * aPos.x + aInstanceAxis2 * aPos.y + aInstanceAxis3 * aPos.z + aInstanceOrigin;
+  vec3 normal = aInstanceNormal1 * aNormal.x + aInstanceNormal2 * aNormal.y + aInstanceNormal3 * aNormal.z;
+
+  vPosWorld = uModel * vec4(pos, 1.0);
+  vPosView = uView * vPosWorld;
+  vNormal = normalize((uView * uModel * vec4(normal, 0.0)).xyz);
+  vColor = aColor;
+
+  gl_Position = uModelViewProjection * vec4(pos, 1.0);
+}
@@ -57,6 +57,8 @@
 #include "../comp/StaticClippingPlanes.h"
 #include "../comp/LightingUniforms.h"
 #include "../comp/ClippingPlaneUniforms.h"
+#include "../SRUtil.h"
+#include <Graphics/Datatypes/GeometryImpl.h>
 
 // Every component is self contained. It only accesses the systems and
 // components that it specifies in it's component list.
@@ -81,6 +83,7 @@ class RenderBasicSys :
                              ren::MatUniform,
                              ren::Shader,
                              ren::GLState,
+                             Graphics::Datatypes::SpireSubPass,
                              StaticWorldLight,
                              StaticClippingPlanes,
                              gen::StaticCamera,
@@ -103,6 +106,7 @@ public:
                                   ren::VecUniform,
                                   ren::MatUniform,
                                   ren::Texture,
+                                  Graphics::Datatypes::SpireSubPass,
                                   ren::StaticTextureMan>(type);
   }
 
@@ -123,6 +127,7 @@ public:
       const spire::ComponentGroup<ren::MatUniform>& matUniforms,
       const spire::ComponentGroup<ren::Shader>& shader,
       const spire::ComponentGroup<ren::GLState>& state,
+      const spire::ComponentGroup<Graphics::Datatypes::SpireSubPass>& pass,
       const spire::ComponentGroup<StaticWorldLight>& worldLight,
       const spire::ComponentGroup<StaticClippingPlanes>& clippingPlanes,
       const spire::ComponentGroup<gen::StaticCamera>& camera,
@@ -144,20 +149,41 @@ public:
       return;
     }
 
+    // Only one level of a decimated mesh is drawn per frame.
+    if (pass.size() > 0 && !isLevelOfDetailVisible(pass.front(), camera.front().data))
+    {
+      return;
+    }
+
     GLuint iboID = ibo.front().glid;
 
+    // Instanced passes carry a second VBO with one entry per instance.
+    const bool instanced = pass.size() > 0 && pass.front().instances.numInstances > 0;
+    const bool attribsSetup = instanced ? geom.front().instancedAttribs.isSetup()
+                                        : geom.front().attribs.isSetup();
+
     // Setup *everything*. We don't want to enter multiple conditional
     // statements if we can avoid it. So we assume everything has not been
     // setup (including uniforms) if the simple geom hasn't been setup.
-    if (!geom.front().attribs.isSetup())
+    if (!attribsSetup)
     {
       // We use const cast to get around a 'modify' call for 2 reasons:
       // 1) This is populating system specific GL data. It has no bearing on the
       //    actual simulation state.
       // 2) It is more correct than issuing a modify call. The data is used
       //    directly below to render geometry.
-      const_cast<RenderBasicGeom&>(geom.front()).attribs.setup(
-          vbo.front().glid, shader.front().glid, vboMan.front());
+      if (instanced)
+      {
+        const auto& vbos = *vboMan.front().instance_;
+        const_cast<RenderBasicGeom&>(geom.front()).instancedAttribs.setup(
+            vbos.hasVBO(pass.front().vboName), vbos.hasVBO(pass.front().instances.vboName),
+            shader.front().glid, vboMan.front());
+      }
+      else
+      {
+        const_cast<RenderBasicGeom&>(geom.front()).attribs.setup(
+            vbo.front().glid, shader.front().glid, vboMan.front());
+      }
 
       /// \todo Optimize by pulling uniforms only once.
       if (commonUniforms.size() > 0)
@@ -249,9 +275,17 @@ public:
       GL(glBindTexture(tex.textureType, tex.glid));
     }
 
-    geom.front().attribs.bind();
-
-    GL(glDrawElements(ibo.front().primMode, ibo.front().numPrims, ibo.front().primType, 0));
+    if (instanced)
+    {
+      geom.front().instancedAttribs.bind();
+      drawElementsInstanced(ibo.front().primMode, ibo.front().numPrims, ibo.front().primType,
+                            static_cast<GLsizei>(pass.front().instances.numInstances));
+    }
+    else
+    {
+      geom.front().attribs.bind();
+      GL(glDrawElements(ibo.front().primMode, ibo.front().numPrims, ibo.front().primType, 0));
+    }
 
     if (!depthMask)
     {
@@ -273,7 +307,10 @@ public:
       GL(glBindTexture(tex.textureType, 0));
     }
 
-    geom.front().attribs.unbind();
+    if (instanced)
+      geom.front().instancedAttribs.unbind();
+    else
+      geom.front().attribs.unbind();
 
     // Reapply the default state here -- only do this if static state is
     // present.
@@ -58,6 +58,7 @@
 #include "../comp/StaticClippingPlanes.h"
 #include "../comp/LightingUniforms.h"
 #include "../comp/ClippingPlaneUniforms.h"
+#include "../SRUtil.h"
 
 namespace es = spire;
 namespace shaders = spire;
@@ -270,6 +271,11 @@ private:
       return;
     }
 
+    if (!isLevelOfDetailVisible(pass.front(), camera.front().data))
+    {
+      return;
+    }
+
     bool drawLines = (ibo.front().primMode == static_cast<int>(SpireIBO::PRIMITIVE::LINES));
     GLuint iboID = ibo.front().glid;
 
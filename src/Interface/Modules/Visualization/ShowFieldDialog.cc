@@ -65,6 +65,7 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
   addCheckBoxManager(textAlwaysVisibleCheckBox_, Parameters::TextAlwaysVisible);
   addCheckBoxManager(renderIndicesLocationsCheckBox_, Parameters::RenderAsLocation);
   addCheckBoxManager(useFaceNormalsCheckBox_, Parameters::UseFaceNormals);
+  addCheckBoxManager(facesBoundaryOnlyCheckBox_, Parameters::FacesBoundaryOnly);
   addDoubleSpinBoxManager(transparencyDoubleSpinBox_, Parameters::FaceTransparencyValue);
   addDoubleSpinBoxManager(nodeTransparencyDoubleSpinBox_, Parameters::NodeTransparencyValue);
   addDoubleSpinBoxManager(edgeTransparencyDoubleSpinBox_, Parameters::EdgeTransparencyValue);
@@ -74,6 +75,8 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
   addSpinBoxManager(sphereResolutionSpinBox, Parameters::SphereResolution);
   addSpinBoxManager(textSizeSpinBox_, Parameters::TextSize);
   addSpinBoxManager(textPrecisionSpinBox_, Parameters::TextPrecision);
+  addSpinBoxManager(levelsOfDetailSpinBox_, Parameters::FacesLevelsOfDetail);
+  addDoubleSpinBoxManager(levelOfDetailPixelErrorDoubleSpinBox_, Parameters::FacesLevelOfDetailPixelError);
   addRadioButtonGroupManager({ edgesAsLinesButton_, edgesAsCylindersButton_ }, Parameters::EdgesAsCylinders);
   addRadioButtonGroupManager({ nodesAsPointsButton_, nodesAsSpheresButton_ }, Parameters::NodeAsSpheres);
   addRadioButtonGroupManager({ defaultNodeColoringButton_, colormapLookupNodeColoringButton_/*, conversionRGBNodeColoringButton_*/ }, Parameters::NodesColoring);
@@ -93,6 +96,7 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
     defaultMeshColorButton_, textColorPushButton_ });
 
   connectButtonToExecuteSignal(useFaceNormalsCheckBox_);
+  connectButtonToExecuteSignal(facesBoundaryOnlyCheckBox_);
 
   createExecuteInteractivelyToggleAction();
 
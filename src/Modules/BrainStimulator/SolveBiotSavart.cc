@@ -56,6 +56,7 @@ void SolveBiotSavart::setStateDefaults()
 {
   auto state = get_state();
   setStateIntFromAlgo(Parameters::OutType);
+  setStateDoubleFromAlgo(Parameters::OpeningAngle);
 }
 
 void SolveBiotSavart::execute()
@@ -85,6 +86,7 @@ void SolveBiotSavart::execute()
 
   if (needToExecute())  //newStatePresent
   {
+    setAlgoDoubleFromState(Parameters::OpeningAngle);
     auto input = make_input((Mesh, mesh)(Coil, coil));
 
     if ((oport_connected(VectorBField) || oport_connected(VectorAField)))
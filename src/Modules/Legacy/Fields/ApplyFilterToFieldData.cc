@@ -26,89 +26,43 @@
    DEALINGS IN THE SOFTWARE.
 */
 
-#include <Core/Algorithms/Fields/FilterFieldData/DilateFieldData.h>
-#include <Core/Algorithms/Fields/FilterFieldData/ErodeFieldData.h>
+#include <Modules/Legacy/Fields/ApplyFilterToFieldData.h>
 
-#include <Dataflow/Network/Module.h>
-#include <Dataflow/Network/Ports/FieldPort.h>
-
-namespace SCIRun {
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/ApplyFilterToFieldData.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
 
+using namespace SCIRun::Modules::Fields;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun;
-using namespace SCIRunAlgo;
-
-/// @class ApplyFilterToFieldData
-/// @brief Applies a dilate or erode filter to a regular mesh. 
-
-class ApplyFilterToFieldData : public Module {
-  public:
-    ApplyFilterToFieldData(GuiContext*);
-    virtual ~ApplyFilterToFieldData() {}
-    virtual void execute();
 
-  private:
-    GuiString method_;
-    GuiString edmethod_;
-    GuiInt edniter_;
-    
-    SCIRunAlgo::ErodeFieldDataAlgo  erode_algo_;
-    SCIRunAlgo::DilateFieldDataAlgo dilate_algo_;
-};
+MODULE_INFO_DEF(ApplyFilterToFieldData, ChangeFieldData, SCIRun)
 
-
-DECLARE_MAKER(ApplyFilterToFieldData)
-
-ApplyFilterToFieldData::ApplyFilterToFieldData(GuiContext* ctx) :
-  Module("ApplyFilterToFieldData", ctx, Source, "ChangeFieldData", "SCIRun"),
-    method_(ctx->subVar("method")),
-    edmethod_(ctx->subVar("ed-method")),
-    edniter_(ctx->subVar("ed-iterations"))
+ApplyFilterToFieldData::ApplyFilterToFieldData() : Module(staticInfo_)
 {
-  erode_algo_.set_progress_reporter(this);
-  dilate_algo_.set_progress_reporter(this);
+  INITIALIZE_PORT(InputField);
+  INITIALIZE_PORT(OutputField);
 }
 
-
-void
-ApplyFilterToFieldData::execute()
+void ApplyFilterToFieldData::setStateDefaults()
 {
-  FieldHandle input, output;
-  
-  get_input_handle("Field",input,true);
-  
-  if (inputs_changed_ || !oport_cached("Field") || method_.changed() ||
-      edmethod_.changed() || edniter_.changed())
-  {
-    // Inform module that execution started
-    update_state(Executing);
-  
-    if (method_.get() == "erodedilate")
-    {
-      if (edmethod_.get() == "erode")
-      {
-        erode_algo_.set_int("num_iterations",edniter_.get());
-        if(!(erode_algo_.run(input,output))) return;
-      }
-      else  if (edmethod_.get() == "dilate")
-      {
-        dilate_algo_.set_int("num_iterations",edniter_.get());
-        if(!(dilate_algo_.run(input,output))) return;
-      }
-      else
-      {
-        erode_algo_.set_int("num_iterations",edniter_.get());
-        dilate_algo_.set_int("num_iterations",edniter_.get());
-        if(!(erode_algo_.run(input,output))) return;
-        if(!(dilate_algo_.run(output,output))) return;
-      }
-    }
-  
-    // Send output to output ports
-    send_output_handle("Field",output,true);
-  }
+  setStateStringFromAlgoOption(Parameters::MorphologicalMethod);
+  setStateIntFromAlgo(Parameters::FilterIterations);
 }
 
+void ApplyFilterToFieldData::execute()
+{
+  auto input = getRequiredInput(InputField);
 
-} // End namespace SCIRun
+  if (needToExecute())
+  {
+    setAlgoOptionFromState(Parameters::MorphologicalMethod);
+    setAlgoIntFromState(Parameters::FilterIterations);
 
+    auto output = algo().run(withInputData((InputField, input)));
 
+    sendOutputFromAlgorithm(OutputField, output);
+  }
+}
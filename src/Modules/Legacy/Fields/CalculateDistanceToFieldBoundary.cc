@@ -62,6 +62,7 @@ void CalculateDistanceToFieldBoundary::setStateDefaults()
   setStateDoubleFromAlgo(Parameters::TruncateDistance);
   setStateStringFromAlgoOption(Parameters::BasisType);
   setStateStringFromAlgoOption(Parameters::OutputFieldDatatype);
+  setStateStringFromAlgoOption(Parameters::DistanceMethod);
 }
 
 void
@@ -80,6 +81,7 @@ CalculateDistanceToFieldBoundary::execute()
     setAlgoDoubleFromState(Parameters::TruncateDistance);
     setAlgoOptionFromState(Parameters::BasisType);
     setAlgoOptionFromState(Parameters::OutputFieldDatatype);
+    setAlgoOptionFromState(Parameters::DistanceMethod);
 
     //TODO: set up secondary algorithm
     GetFieldBoundaryAlgo falgo;
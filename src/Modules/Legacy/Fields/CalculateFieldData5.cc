@@ -33,6 +33,7 @@
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Parser/ArrayMathEngine.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Logging/Log.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -234,6 +235,7 @@ void CalculateFieldData::execute()
       error("Error in parser."); //todo: improve
       return;
     }
+    LOG_DEBUG("CalculateFieldData optimized program:\n{}", engine.get_optimized_program());
 
     // Get the result from the engine
     FieldHandle ofield;
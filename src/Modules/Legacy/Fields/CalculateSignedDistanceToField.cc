@@ -46,6 +46,11 @@ CalculateSignedDistanceToField::CalculateSignedDistanceToField()
   INITIALIZE_PORT(ValueField);
 }
 
+void CalculateSignedDistanceToField::setStateDefaults()
+{
+  setStateStringFromAlgoOption(CalculateSignedDistanceFieldAlgo::DistanceMethod);
+}
+
 void CalculateSignedDistanceToField::execute()
 {
   FieldHandle input = getRequiredInput(InputField);
@@ -55,6 +60,7 @@ void CalculateSignedDistanceToField::execute()
 
   if (needToExecute())
   {
+    setAlgoOptionFromState(CalculateSignedDistanceFieldAlgo::DistanceMethod);
     auto inputs = make_input((InputField, input)(ObjectField, object));
 
     algo().set(CalculateSignedDistanceFieldAlgo::OutputValueField, value_connected);
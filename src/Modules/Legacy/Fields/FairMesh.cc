@@ -56,6 +56,8 @@ void FairMesh::setStateDefaults()
   setStateIntFromAlgo(Parameters::NumIterations);
   setStateDoubleFromAlgo(Parameters::Lambda);
   setStateDoubleFromAlgo(Parameters::FilterCutoff);
+  setStateDoubleFromAlgo(Parameters::HCAlpha);
+  setStateDoubleFromAlgo(Parameters::HCBeta);
 }
 
 void FairMesh::execute()
@@ -68,6 +70,8 @@ void FairMesh::execute()
     setAlgoIntFromState(Parameters::NumIterations);
     setAlgoDoubleFromState(Parameters::Lambda);
     setAlgoDoubleFromState(Parameters::FilterCutoff);
+    setAlgoDoubleFromState(Parameters::HCAlpha);
+    setAlgoDoubleFromState(Parameters::HCBeta);
     setAlgoOptionFromState(Parameters::FairMeshMethod);
 
     auto output = algo().run(withInputData((Input_Mesh, input)));
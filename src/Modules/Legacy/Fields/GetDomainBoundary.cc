@@ -46,6 +46,7 @@ GetDomainBoundary::GetDomainBoundary()
 {
   INITIALIZE_PORT(InputField);
   INITIALIZE_PORT(BoundaryField);
+  INITIALIZE_PORT(Mapping);
   INITIALIZE_PORT(MinValue);
   INITIALIZE_PORT(MaxValue);
   INITIALIZE_PORT(ElemLink);
@@ -123,5 +124,6 @@ void GetDomainBoundary::execute()
     auto output = algo().run(withInputData((InputField, ifield)(ElemLink, optionalAlgoInput(elemLink))));
 
     sendOutputFromAlgorithm(BoundaryField, output);
+    sendOutputFromAlgorithm(Mapping, output);
   }
 }
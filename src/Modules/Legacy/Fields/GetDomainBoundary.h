@@ -42,7 +42,7 @@ namespace SCIRun {
 
       class SCISHARE GetDomainBoundary : public Dataflow::Networks::Module,
         public Has4InputPorts<FieldPortTag, ScalarPortTag, ScalarPortTag, MatrixPortTag>,
-        public Has1OutputPort<FieldPortTag>,
+        public Has2OutputPorts<FieldPortTag, MatrixPortTag>,
         public Core::Thread::Interruptible
       {
       public:
@@ -56,6 +56,7 @@ namespace SCIRun {
         INPUT_PORT(2, MaxValue, Double);
         INPUT_PORT(3, ElemLink, SparseRowMatrix);
         OUTPUT_PORT(0, BoundaryField, Field);
+        OUTPUT_PORT(1, Mapping, Matrix);
 
         MODULE_TRAITS_AND_INFO(ModuleHasUIAndAlgorithm)
       };
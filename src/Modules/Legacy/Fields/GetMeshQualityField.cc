@@ -30,6 +30,7 @@
 
 #include <Core/Algorithms/Legacy/Fields/MeshData/GetMeshQualityFieldAlgo.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/DenseMatrix.h>
 #include <Dataflow/Network/Module.h>
 #include <Modules/Legacy/Fields/GetMeshQualityField.h>
 
@@ -46,11 +47,14 @@ GetMeshQualityField::GetMeshQualityField() : Module(staticInfo_)
     //Initialize all ports.
     INITIALIZE_PORT(InputField);
     INITIALIZE_PORT(OutputField);
+    INITIALIZE_PORT(Histogram);
+    INITIALIZE_PORT(Statistics);
 }
 
 void GetMeshQualityField::setStateDefaults()
 {
     setStateStringFromAlgoOption(Metric);
+    setStateIntFromAlgo(HistogramBins);
 }
 
 void GetMeshQualityField::execute()
@@ -60,10 +64,13 @@ void GetMeshQualityField::execute()
   if (needToExecute())
   {
     setAlgoOptionFromState(Metric);
+    setAlgoIntFromState(HistogramBins);
 
     auto output = algo().run(withInputData((InputField,input)));
 
     sendOutputFromAlgorithm(OutputField,output);
+    sendOutputFromAlgorithm(Histogram,output);
+    sendOutputFromAlgorithm(Statistics,output);
 
   }
 }
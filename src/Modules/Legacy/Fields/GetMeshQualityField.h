@@ -39,7 +39,7 @@ namespace Fields {
 
   class SCISHARE GetMeshQualityField : public SCIRun::Dataflow::Networks::Module,
     public Has1InputPort<FieldPortTag>,
-    public Has1OutputPort<FieldPortTag>
+    public Has3OutputPorts<FieldPortTag, MatrixPortTag, MatrixPortTag>
   {
   public:
     GetMeshQualityField();
@@ -49,6 +49,8 @@ namespace Fields {
 
     INPUT_PORT(0, InputField, Field);
     OUTPUT_PORT(0, OutputField, Field);
+    OUTPUT_PORT(1, Histogram, Matrix);
+    OUTPUT_PORT(2, Statistics, Matrix);
 
     MODULE_TRAITS_AND_INFO(ModuleHasUIAndAlgorithm)
   };
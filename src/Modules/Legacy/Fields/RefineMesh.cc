@@ -57,6 +57,7 @@ void RefineMesh::setStateDefaults()
 		setStateStringFromAlgoOption(Parameters::AddConstraints);
 		setStateStringFromAlgoOption(Parameters::RefineMethod);
 		setStateDoubleFromAlgo(Parameters::IsoValue);
+		setStateIntFromAlgo(Parameters::RefineIterations);
 }
 
 void
@@ -73,6 +74,7 @@ auto isovaluefield = getOptionalInput(IsoValueField);
 		setAlgoOptionFromState(Parameters::AddConstraints);
 		setAlgoOptionFromState(Parameters::RefineMethod);
 		setAlgoDoubleFromState(Parameters::IsoValue);
+		setAlgoIntFromState(Parameters::RefineIterations);
 
 		#if SCIRUN4_CODE_TO_BE_ENABLED_LATER
 		if (need_mapping)
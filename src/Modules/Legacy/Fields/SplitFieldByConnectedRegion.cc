@@ -57,6 +57,7 @@ void SplitFieldByConnectedRegion::setStateDefaults()
 {
  setStateBoolFromAlgo(SplitFieldByConnectedRegionAlgo::SortDomainBySize());
  setStateBoolFromAlgo(SplitFieldByConnectedRegionAlgo::SortAscending());
+ setStateBoolFromAlgo(SplitFieldByConnectedRegionAlgo::OutputLabelField());
 }
 
 void SplitFieldByConnectedRegion::execute()
@@ -67,6 +68,7 @@ void SplitFieldByConnectedRegion::execute()
   {
     setAlgoBoolFromState(SplitFieldByConnectedRegionAlgo::SortDomainBySize());
     setAlgoBoolFromState(SplitFieldByConnectedRegionAlgo::SortAscending());
+    setAlgoBoolFromState(SplitFieldByConnectedRegionAlgo::OutputLabelField());
 
     auto output = algo().run(make_input((InputField, input_field)));
 
@@ -42,7 +42,7 @@ namespace SCIRun {
 			{
 				public:
 					ComputeSVD();
-					virtual void setStateDefaults() override {}
+					virtual void setStateDefaults() override;
 					virtual void execute() override;
 
 					INPUT_PORT(0, InputMatrix, Matrix);
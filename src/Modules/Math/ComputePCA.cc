@@ -41,12 +41,25 @@ ComputePCA::ComputePCA() : Module(ModuleLookupInfo("ComputePCA", "Math", "SCIRun
     INITIALIZE_PORT(RightPrincipalMatrix);
 }
 
+void ComputePCA::setStateDefaults()
+{
+    setStateStringFromAlgoOption(Parameters::SVDMethod);
+    setStateIntFromAlgo(Parameters::TruncationRank);
+    setStateIntFromAlgo(Parameters::Oversampling);
+    setStateIntFromAlgo(Parameters::PowerIterations);
+}
+
 void ComputePCA::execute()
 {
     auto input_matrix = getRequiredInput(InputMatrix);
 
     if(needToExecute())
-    {        
+    {
+        setAlgoOptionFromState(Parameters::SVDMethod);
+        setAlgoIntFromState(Parameters::TruncationRank);
+        setAlgoIntFromState(Parameters::Oversampling);
+        setAlgoIntFromState(Parameters::PowerIterations);
+
         auto output = algo().run(withInputData((InputMatrix,input_matrix)));
 
         sendOutputFromAlgorithm(LeftPrincipalMatrix, output);
@@ -37,7 +37,7 @@ namespace SCIRun {
             {
             public:
                 ComputePCA();
-                virtual void setStateDefaults() override {}
+                virtual void setStateDefaults() override;
                 virtual void execute() override;
 
                 INPUT_PORT(0, InputMatrix, Matrix);
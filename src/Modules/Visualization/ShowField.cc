@@ -31,12 +31,17 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Algorithms/Visualization/RenderFieldState.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Color.h>
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/GeometryPrimitives/Tensor.h>
+#include <Core/Thread/Parallel.h>
 #include <Graphics/Glyphs/GlyphGeom.h>
+#include <unordered_map>
+#include <iomanip>
+#include <limits>
 
 using namespace SCIRun;
 using namespace Modules::Visualization;
@@ -63,7 +68,8 @@ namespace detail
 class GeometryBuilder
 {
 public:
-  GeometryBuilder(const std::string& moduleId, ModuleStateHandle state) : moduleId_(moduleId), state_(state) {}
+  GeometryBuilder(const std::string& moduleId, ModuleStateHandle state, const Core::Logging::LegacyLoggerInterface* log) :
+    moduleId_(moduleId), state_(state), log_(log) {}
   /// Constructs a geometry object (essentially a spire object) from the given
   /// field data.
   GeometryHandle buildGeometryObject(
@@ -95,6 +101,10 @@ public:
     RenderState state, GeometryHandle geom,
     const std::string& id);
 
+  /// All faces of the mesh, or only those on its boundary. The list is cached
+  /// for the last mesh seen.
+  const std::vector<VMesh::Face::index_type>& facesToRender(FieldHandle field, bool boundaryOnly);
+
   void addFaceGeom(
     const std::vector<Point>  &points,
     const std::vector<Vector> &normals,
@@ -123,13 +133,28 @@ private:
   float nodeTransparencyValue_ = 0.65f;
   std::string moduleId_;
   ModuleStateHandle state_;
+  const Core::Logging::LegacyLoggerInterface* log_;
+
+  /// Face VBOs/IBOs of the last execution, one pair per render pass, and the
+  /// level of detail each pass belongs to.
+  struct FaceBuffers
+  {
+    std::string key;
+    std::vector<std::shared_ptr<spire::VarBuffer>> vbos;
+    std::vector<std::shared_ptr<spire::VarBuffer>> ibos;
+    std::vector<SpireLevelOfDetail> lods;
+  };
+  FaceBuffers faceBuffers_;
+  std::vector<VMesh::Face::index_type> faceList_;
+  Datatype::id_type faceListMeshId_ = -1;
+  bool faceListIsBoundary_ = false;
 };
 }}}}
 
 using namespace detail;
 
 ShowField::ShowField() : GeometryGeneratingModule(staticInfo_),
-  builder_(new GeometryBuilder(id().id_, get_state()))
+  builder_(new GeometryBuilder(id().id_, get_state(), this))
 {
   INITIALIZE_PORT(Field);
   INITIALIZE_PORT(ColorMapObject);
@@ -183,6 +208,9 @@ void ShowField::setStateDefaults()
 
   state->setValue(UseFaceNormals, false);
   state->setValue(FaceInvertNormals, false);
+  state->setValue(FacesBoundaryOnly, false);
+  state->setValue(FacesLevelsOfDetail, 0);
+  state->setValue(FacesLevelOfDetailPixelError, 1.0);
 
   state->setValue(FieldName, std::string());
 
@@ -423,51 +451,154 @@ void GeometryBuilder::renderFaces(
 
 namespace
 {
-  template <typename T>
-  inline void writeFloats(spire::VarBuffer* vboBuffer, std::initializer_list<T> ts)
+  // Structure-of-arrays copy of the faces being rendered, gathered once through
+  // the virtual mesh interface. Everything is stored per face vertex so the VBO
+  // fill below is a flat, branch-free loop.
+  struct FaceArrays
   {
-    for (const T& t : ts)
-      vboBuffer->writeUnsafe(static_cast<float>(t));
-  }
+    std::vector<float> x, y, z;
+    std::vector<float> nx, ny, nz;
+    std::vector<float> u, v;
+  };
 
-  inline void writeAtributeToVBO(const Point& point, spire::VarBuffer* vboBuffer)
-  {
-    writeFloats(vboBuffer, {point.x(), point.y(), point.z()});
-  }
+  enum class FaceNormals { NONE, COMPUTED, FROM_MESH };
 
-  inline void writeAtributeToVBO(const Vector& vector, spire::VarBuffer* vboBuffer)
+  template <int NodesPerFace>
+  inline void computeFaceNormal(const FaceArrays& a, size_t v0, float n[3])
   {
-    writeFloats(vboBuffer, {vector.x(), vector.y(), vector.z()});
+    n[0] = n[1] = n[2] = 0.0f;
+    for (int k = 0; k < NodesPerFace; ++k)
+    {
+      const size_t i0 = v0 + k;
+      const size_t i1 = v0 + (k + 1) % NodesPerFace;
+      const size_t i2 = v0 + (k + 2) % NodesPerFace;
+      const float e1x = a.x[i1] - a.x[i0], e1y = a.y[i1] - a.y[i0], e1z = a.z[i1] - a.z[i0];
+      const float e2x = a.x[i2] - a.x[i1], e2y = a.y[i2] - a.y[i1], e2z = a.z[i2] - a.z[i1];
+      n[0] += e1y * e2z - e1z * e2y;
+      n[1] += e1z * e2x - e1x * e2z;
+      n[2] += e1x * e2y - e1y * e2x;
+      // a triangle has a single independent edge pair
+      if (NodesPerFace == 3) break;
+    }
+    const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+    n[0] *= scale; n[1] *= scale; n[2] *= scale;
   }
 
-  inline void writeAtributeToVBO(const glm::vec2& coords, spire::VarBuffer* vboBuffer)
+  template <int NodesPerFace, FaceNormals Normals, bool TexCoords>
+  void fillFaceVBO(const FaceArrays& a, size_t begin, size_t end, size_t passBegin, float normalSign, float* out)
   {
-    writeFloats(vboBuffer, {coords.x, coords.y});
+    const int stride = 3 + (Normals != FaceNormals::NONE ? 3 : 0) + (TexCoords ? 2 : 0);
+    for (size_t f = begin; f < end; ++f)
+    {
+      const size_t v0 = f * NodesPerFace;
+      float* dst = out + (f - passBegin) * NodesPerFace * stride;
+      float n[3] = { 0.0f, 0.0f, 0.0f };
+      if (Normals == FaceNormals::COMPUTED)
+        computeFaceNormal<NodesPerFace>(a, v0, n);
+
+      for (int k = 0; k < NodesPerFace; ++k)
+      {
+        const size_t i = v0 + k;
+        *dst++ = a.x[i];
+        *dst++ = a.y[i];
+        *dst++ = a.z[i];
+        if (Normals == FaceNormals::FROM_MESH)
+        {
+          n[0] = a.nx[i]; n[1] = a.ny[i]; n[2] = a.nz[i];
+        }
+        if (Normals != FaceNormals::NONE)
+        {
+          *dst++ = normalSign * n[0];
+          *dst++ = normalSign * n[1];
+          *dst++ = normalSign * n[2];
+        }
+        if (TexCoords)
+        {
+          *dst++ = a.u[i];
+          *dst++ = a.v[i];
+        }
+      }
+    }
   }
 
-  template<typename ... Params>
-  void writeTri(spire::VarBuffer* vboBuffer, const Params& ... params)
+  template <int NodesPerFace>
+  void fillFaceVBO(FaceNormals normals, bool texCoords, const FaceArrays& a,
+    size_t begin, size_t end, size_t passBegin, float normalSign, float* out)
   {
-    for(int i = 0; i < 3; ++i)
-      (void)std::initializer_list<int>{(writeAtributeToVBO(params[i], vboBuffer), 0)...};
+    switch (normals)
+    {
+    case FaceNormals::NONE:
+      return texCoords ? fillFaceVBO<NodesPerFace, FaceNormals::NONE, true>(a, begin, end, passBegin, normalSign, out)
+        : fillFaceVBO<NodesPerFace, FaceNormals::NONE, false>(a, begin, end, passBegin, normalSign, out);
+    case FaceNormals::COMPUTED:
+      return texCoords ? fillFaceVBO<NodesPerFace, FaceNormals::COMPUTED, true>(a, begin, end, passBegin, normalSign, out)
+        : fillFaceVBO<NodesPerFace, FaceNormals::COMPUTED, false>(a, begin, end, passBegin, normalSign, out);
+    case FaceNormals::FROM_MESH:
+      return texCoords ? fillFaceVBO<NodesPerFace, FaceNormals::FROM_MESH, true>(a, begin, end, passBegin, normalSign, out)
+        : fillFaceVBO<NodesPerFace, FaceNormals::FROM_MESH, false>(a, begin, end, passBegin, normalSign, out);
+    }
   }
 
-  template<typename ...Params>
-  void writeQuad(spire::VarBuffer* vboBuffer, const Params& ... params)
+  // Quads are split into two triangles (0,1,2) and (2,3,0).
+  template <int NodesPerFace>
+  void fillFaceIBO(size_t begin, size_t end, uint32_t* out)
   {
-    for(int i = 0; i < 4; ++i)
-      (void)std::initializer_list<int>{(writeAtributeToVBO(params[i], vboBuffer), 0)...};
+    const int indicesPerFace = (NodesPerFace - 2) * 3;
+    for (size_t f = begin; f < end; ++f)
+    {
+      const uint32_t base = static_cast<uint32_t>(f * NodesPerFace);
+      uint32_t* dst = out + f * indicesPerFace;
+      dst[0] = base + 0;
+      dst[1] = base + 1;
+      dst[2] = base + 2;
+      if (NodesPerFace == 4)
+      {
+        dst[3] = base + 2;
+        dst[4] = base + 3;
+        dst[5] = base + 0;
+      }
+    }
   }
 
-  enum : int
+  // The scalar a ColorMap looks up for a field value: the value itself, the
+  // vector length, or the magnitude of the tensor eigenvalues.
+  double colorMapScalar(VField* fld, VMesh::index_type idx)
   {
-    TRI, TRI_TEXCOORDS, TRI_NORMALS, TRI_NORMALS_TEXCOORDS,
-    QUAD, QUAD_TEXCOORDS, QUAD_NORMALS, QUAD_NORMALS_TEXCOORDS
-  };
+    if (fld->is_scalar())
+    {
+      double sval;
+      fld->get_value(sval, idx);
+      return sval;
+    }
+    if (fld->is_vector())
+    {
+      Vector vval;
+      fld->get_value(vval, idx);
+      return vval.length();
+    }
+    Tensor tval;
+    fld->get_value(tval, idx);
+    double eigen1, eigen2, eigen3;
+    tval.get_eigenvalues(eigen1, eigen2, eigen3);
+    return Vector(eigen1, eigen2, eigen3).length();
+  }
 
-  inline int getWriteCase(bool writeQuads, bool writeNormals, bool writeTexCoords)
+  // Texture coordinates are the red channel of the grayscale coordinate map.
+  void scalarsToTexCoords(const ColorMap& coordinateMap, const std::vector<double>& scalars, std::vector<float>& texCoords)
   {
-    return ((int)writeQuads << 2) | ((int)writeNormals << 1) | ((int)writeTexCoords);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      const size_t chunkSize = 4096;
+      std::vector<float> rgba(4 * chunkSize);
+      for (size_t start = begin; start < end; start += chunkSize)
+      {
+        const size_t count = std::min(chunkSize, end - start);
+        coordinateMap.valueToColor(&scalars[start], count, rgba.data());
+        for (size_t i = 0; i < count; ++i)
+          texCoords[start + i] = rgba[4 * i];
+      }
+    }, scalars.size());
   }
 
   void spiltColorMapToTextureAndCoordinates(
@@ -486,10 +617,454 @@ namespace
     coordinateMap = StandardColorMapFactory::create("Grayscale", 256, 0, false,
       realColorMap->getColorMapRescaleScale(), realColorMap->getColorMapRescaleShift());
   }
+
+  // Cells of the clustering grid are keyed by three packed 21 bit indices.
+  const int cellBits = 21;
+  const uint64_t cellMask = (uint64_t(1) << cellBits) - 1;
+
+  // Coarser copies of the rendered faces by vertex clustering with error
+  // quadrics (Lindstrom, "Out-of-core simplification of large polygonal models").
+  // Face vertices falling into the same grid cell merge into the point closest
+  // to the planes of their faces, and triangles left with fewer than three
+  // distinct clusters vanish. Every level doubles the cell size and clusters the
+  // level before it, which is valid because quadrics add.
+  class FaceDecimator
+  {
+  public:
+    FaceDecimator(const FaceArrays& arrays, size_t numFaces, int nodesPerFace, const BBox& bbox,
+      bool meshNormals, bool texCoords) : arrays_(arrays), numFaces_(numFaces), nodesPerFace_(nodesPerFace),
+      meshNormals_(meshNormals), texCoords_(texCoords), origin_(bbox.get_min())
+    {
+      // Aim for about a quarter of the triangles at the first level: a surface
+      // of T triangles has about T/2 vertices and covers on the order of 2 R^2
+      // cells of an R^3 grid.
+      const Vector extent = bbox.diagonal();
+      maxExtent_ = std::max(extent.x(), std::max(extent.y(), extent.z()));
+      const double resolution = std::min(std::sqrt(static_cast<double>(numFaces * (nodesPerFace - 2))) / 4.0,
+        static_cast<double>(cellMask));
+      cellSize_ = resolution >= 2.0 ? maxExtent_ / resolution : 0.0;
+    }
+
+    /// Builds the next coarser level as independent triangles. Returns false
+    /// once the grid is too coarse to hold any triangle.
+    bool nextLevel(FaceArrays& out, size_t& numTriangles, double& error);
+
+  private:
+    struct VertexCluster
+    {
+      double quadric[9] = {};     // xx xy xz yy yz zz of A and b, for x'Ax + 2b'x + c
+      double position[3] = {};
+      double attributes[5] = {};  // mesh normal, texture coordinates
+      double count = 0.0;
+
+      void add(const VertexCluster& other)
+      {
+        for (int i = 0; i < 9; ++i) quadric[i] += other.quadric[i];
+        for (int i = 0; i < 3; ++i) position[i] += other.position[i];
+        for (int i = 0; i < 5; ++i) attributes[i] += other.attributes[i];
+        count += other.count;
+      }
+    };
+
+    struct Triangle
+    {
+      uint32_t v[3];
+      bool operator<(const Triangle& t) const { return std::lexicographical_compare(v, v + 3, t.v, t.v + 3); }
+      bool operator==(const Triangle& t) const { return std::equal(v, v + 3, t.v); }
+    };
+
+    uint64_t cellKey(float x, float y, float z) const
+    {
+      auto index = [this](double c, double o)
+      {
+        return std::min(static_cast<uint64_t>(std::max(0.0, (c - o) / cellSize_)), cellMask);
+      };
+      return index(x, origin_.x()) | (index(y, origin_.y()) << cellBits) | (index(z, origin_.z()) << (2 * cellBits));
+    }
+
+    static uint64_t coarserCellKey(uint64_t key)
+    {
+      return ((key & cellMask) >> 1) | ((((key >> cellBits) & cellMask) >> 1) << cellBits)
+        | ((((key >> (2 * cellBits)) & cellMask) >> 1) << (2 * cellBits));
+    }
+
+    template <class KeyOf, class Accumulate>
+    void clusterByCell(size_t numVertices, const KeyOf& keyOf, const Accumulate& accumulate,
+      std::vector<uint32_t>& clusterOf, std::vector<uint64_t>& clusterKeys, std::vector<VertexCluster>& clusters) const;
+
+    template <class CornerOf>
+    static std::vector<Triangle> collapseTriangles(size_t numTriangles, const CornerOf& cornerOf,
+      const std::vector<uint32_t>& clusterOf);
+
+    Point clusterPoint(const VertexCluster& cluster, uint64_t key) const;
+    void addFaceQuadric(size_t faceVertex, VertexCluster& cluster) const;
+
+    const FaceArrays& arrays_;
+    size_t numFaces_;
+    int nodesPerFace_;
+    bool meshNormals_, texCoords_;
+    Point origin_;
+    double maxExtent_ = 0.0;
+    double cellSize_ = 0.0;
+    int level_ = 0;
+
+    std::vector<uint64_t> clusterKeys_;
+    std::vector<VertexCluster> clusters_;
+    std::vector<Triangle> triangles_;
+  };
+
+  // Vertices are scattered into one bucket per thread by a hash of their cell,
+  // so every thread owns the clusters it builds and no locking is needed. Each
+  // cluster still adds its vertices in index order, whatever the bucket count.
+  template <class KeyOf, class Accumulate>
+  void FaceDecimator::clusterByCell(size_t numVertices, const KeyOf& keyOf, const Accumulate& accumulate,
+    std::vector<uint32_t>& clusterOf, std::vector<uint64_t>& clusterKeys, std::vector<VertexCluster>& clusters) const
+  {
+    const int numBuckets = Parallel::NumCores();
+    auto bucketOf = [numBuckets](uint64_t key)
+    {
+      return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) % numBuckets;
+    };
+
+    std::vector<std::vector<size_t>> next(numBuckets, std::vector<size_t>(numBuckets, 0));
+    Parallel::RunTasks([&](int t)
+    {
+      const size_t begin = numVertices * t / numBuckets, end = numVertices * (t + 1) / numBuckets;
+      for (size_t v = begin; v < end; ++v)
+        ++next[t][bucketOf(keyOf(v))];
+    }, numBuckets);
+
+    std::vector<size_t> bucketBegin(numBuckets + 1, 0);
+    size_t offset = 0;
+    for (int b = 0; b < numBuckets; ++b)
+    {
+      bucketBegin[b] = offset;
+      for (int t = 0; t < numBuckets; ++t)
+      {
+        const size_t count = next[t][b];
+        next[t][b] = offset;
+        offset += count;
+      }
+      bucketBegin[b + 1] = offset;
+    }
+
+    std::vector<uint32_t> order(numVertices);
+    Parallel::RunTasks([&](int t)
+    {
+      const size_t begin = numVertices * t / numBuckets, end = numVertices * (t + 1) / numBuckets;
+      for (size_t v = begin; v < end; ++v)
+        order[next[t][bucketOf(keyOf(v))]++] = static_cast<uint32_t>(v);
+    }, numBuckets);
+
+    clusterOf.resize(numVertices);
+    std::vector<std::vector<uint64_t>> bucketKeys(numBuckets);
+    std::vector<std::vector<VertexCluster>> bucketClusters(numBuckets);
+    Parallel::RunTasks([&](int b)
+    {
+      std::unordered_map<uint64_t, uint32_t> ids;
+      for (size_t i = bucketBegin[b]; i < bucketBegin[b + 1]; ++i)
+      {
+        const uint32_t v = order[i];
+        const uint64_t key = keyOf(v);
+        const auto id = ids.emplace(key, static_cast<uint32_t>(bucketKeys[b].size()));
+        if (id.second)
+        {
+          bucketKeys[b].push_back(key);
+          bucketClusters[b].emplace_back();
+        }
+        clusterOf[v] = id.first->second;
+        accumulate(v, bucketClusters[b][id.first->second]);
+      }
+    }, numBuckets);
+
+    // The buckets depend on the core count, so clusters are renumbered in key
+    // order; ids, and with them the triangles, are then the same on every machine.
+    std::vector<std::pair<uint64_t, uint32_t>> byKey;
+    std::vector<uint32_t> firstCluster(numBuckets, 0);
+    for (int b = 0; b < numBuckets; ++b)
+    {
+      firstCluster[b] = static_cast<uint32_t>(byKey.size());
+      for (size_t i = 0; i < bucketKeys[b].size(); ++i)
+        byKey.emplace_back(bucketKeys[b][i], static_cast<uint32_t>(byKey.size()));
+    }
+    std::sort(byKey.begin(), byKey.end());
+
+    std::vector<uint32_t> renumbered(byKey.size());
+    clusterKeys.resize(byKey.size());
+    clusters.resize(byKey.size());
+    for (size_t c = 0; c < byKey.size(); ++c)
+    {
+      const uint32_t old = byKey[c].second;
+      const int b = static_cast<int>(std::upper_bound(firstCluster.begin(), firstCluster.end(), old) - firstCluster.begin()) - 1;
+      renumbered[old] = static_cast<uint32_t>(c);
+      clusterKeys[c] = byKey[c].first;
+      clusters[c] = bucketClusters[b][old - firstCluster[b]];
+    }
+
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t v = begin; v < end; ++v)
+        clusterOf[v] = renumbered[clusterOf[v] + firstCluster[bucketOf(keyOf(v))]];
+    }, numVertices);
+  }
+
+  // Triangles are rotated to start at their smallest cluster so that copies
+  // with the same orientation compare equal and are dropped. The result is
+  // sorted, so the split over threads does not change it.
+  template <class CornerOf>
+  std::vector<FaceDecimator::Triangle> FaceDecimator::collapseTriangles(size_t numTriangles,
+    const CornerOf& cornerOf, const std::vector<uint32_t>& clusterOf)
+  {
+    const int numThreads = Parallel::NumCores();
+    std::vector<std::vector<Triangle>> kept(numThreads);
+    Parallel::RunTasks([&](int t)
+    {
+      const size_t begin = numTriangles * t / numThreads, end = numTriangles * (t + 1) / numThreads;
+      for (size_t i = begin; i < end; ++i)
+      {
+        Triangle tri;
+        for (int c = 0; c < 3; ++c)
+          tri.v[c] = clusterOf[cornerOf(i, c)];
+        if (tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[2] == tri.v[0])
+          continue;
+        while (tri.v[0] > tri.v[1] || tri.v[0] > tri.v[2])
+          std::rotate(tri.v, tri.v + 1, tri.v + 3);
+        kept[t].push_back(tri);
+      }
+    }, numThreads);
+
+    std::vector<Triangle> triangles;
+    for (const auto& k : kept)
+      triangles.insert(triangles.end(), k.begin(), k.end());
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+    return triangles;
+  }
+
+  // Area weighted plane of the face owning a face vertex. The quad normal is
+  // taken from its diagonals.
+  void FaceDecimator::addFaceQuadric(size_t faceVertex, VertexCluster& cluster) const
+  {
+    const auto& a = arrays_;
+    const size_t v0 = faceVertex - faceVertex % nodesPerFace_;
+    const size_t i0 = v0, i1 = v0 + 1, i2 = v0 + 2, i3 = nodesPerFace_ == 4 ? v0 + 3 : v0;
+    const double e1[3] = { a.x[i2] - a.x[i0], a.y[i2] - a.y[i0], a.z[i2] - a.z[i0] };
+    const double e2[3] = { a.x[i3] - a.x[i1], a.y[i3] - a.y[i1], a.z[i3] - a.z[i1] };
+    const double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+    if (length > 0.0)
+    {
+      // |n| is twice the area, so n n' / (2 |n|) is the unit plane quadric times the area.
+      const double w = 0.5 / length;
+      const double d = -(n[0] * a.x[i0] + n[1] * a.y[i0] + n[2] * a.z[i0]);
+      double* q = cluster.quadric;
+      q[0] += w * n[0] * n[0]; q[1] += w * n[0] * n[1]; q[2] += w * n[0] * n[2];
+      q[3] += w * n[1] * n[1]; q[4] += w * n[1] * n[2]; q[5] += w * n[2] * n[2];
+      q[6] += w * d * n[0]; q[7] += w * d * n[1]; q[8] += w * d * n[2];
+    }
+
+    cluster.position[0] += a.x[faceVertex];
+    cluster.position[1] += a.y[faceVertex];
+    cluster.position[2] += a.z[faceVertex];
+    if (meshNormals_)
+    {
+      cluster.attributes[0] += a.nx[faceVertex];
+      cluster.attributes[1] += a.ny[faceVertex];
+      cluster.attributes[2] += a.nz[faceVertex];
+    }
+    if (texCoords_)
+    {
+      cluster.attributes[3] += a.u[faceVertex];
+      cluster.attributes[4] += a.v[faceVertex];
+    }
+    cluster.count += 1.0;
+  }
+
+  // Minimizer of the cluster quadric. Flat and crease-only clusters have a
+  // singular quadric, and solutions far outside the cell are unreliable; both
+  // fall back to the mean position.
+  Point FaceDecimator::clusterPoint(const VertexCluster& cluster, uint64_t key) const
+  {
+    const Point mean(cluster.position[0] / cluster.count, cluster.position[1] / cluster.count,
+      cluster.position[2] / cluster.count);
+    const double* q = cluster.quadric;
+    const double trace = q[0] + q[3] + q[5];
+    const double det = q[0] * (q[3] * q[5] - q[4] * q[4]) - q[1] * (q[1] * q[5] - q[4] * q[2])
+      + q[2] * (q[1] * q[4] - q[3] * q[2]);
+    if (trace <= 0.0 || std::abs(det) < 1e-3 * std::pow(trace / 3.0, 3))
+      return mean;
+
+    const double b[3] = { -q[6], -q[7], -q[8] };
+    const double x = (b[0] * (q[3] * q[5] - q[4] * q[4]) - q[1] * (b[1] * q[5] - q[4] * b[2])
+      + q[2] * (b[1] * q[4] - q[3] * b[2])) / det;
+    const double y = (q[0] * (b[1] * q[5] - q[4] * b[2]) - b[0] * (q[1] * q[5] - q[4] * q[2])
+      + q[2] * (q[1] * b[2] - b[1] * q[2])) / det;
+    const double z = (q[0] * (q[3] * b[2] - b[1] * q[4]) - q[1] * (q[1] * b[2] - b[1] * q[2])
+      + b[0] * (q[1] * q[4] - q[3] * q[2])) / det;
+
+    const double cell[3] = { static_cast<double>(key & cellMask), static_cast<double>((key >> cellBits) & cellMask),
+      static_cast<double>((key >> (2 * cellBits)) & cellMask) };
+    const double p[3] = { x - origin_.x(), y - origin_.y(), z - origin_.z() };
+    for (int i = 0; i < 3; ++i)
+    {
+      if (p[i] < (cell[i] - 0.5) * cellSize_ || p[i] > (cell[i] + 1.5) * cellSize_)
+        return mean;
+    }
+    return Point(x, y, z);
+  }
+
+  bool FaceDecimator::nextLevel(FaceArrays& out, size_t& numTriangles, double& error)
+  {
+    if (cellSize_ <= 0.0 || cellSize_ > maxExtent_ / 2.0)
+      return false;
+    if (level_ > 0 && triangles_.empty())
+      return false;
+
+    std::vector<uint32_t> clusterOf;
+    std::vector<uint64_t> keys;
+    std::vector<VertexCluster> clusters;
+    if (level_ == 0)
+    {
+      const auto& a = arrays_;
+      clusterByCell(numFaces_ * nodesPerFace_,
+        [&](size_t v) { return cellKey(a.x[v], a.y[v], a.z[v]); },
+        [&](size_t v, VertexCluster& cluster) { addFaceQuadric(v, cluster); },
+        clusterOf, keys, clusters);
+
+      // Quads are split into two triangles (0,1,2) and (2,3,0).
+      const int trianglesPerFace = nodesPerFace_ - 2;
+      const int npf = nodesPerFace_;
+      triangles_ = collapseTriangles(numFaces_ * trianglesPerFace, [&](size_t t, int c)
+      {
+        static const int corners[2][3] = { { 0, 1, 2 }, { 2, 3, 0 } };
+        return (t / trianglesPerFace) * npf + corners[t % trianglesPerFace][c];
+      }, clusterOf);
+    }
+    else
+    {
+      cellSize_ *= 2.0;
+      clusterByCell(clusters_.size(),
+        [&](size_t v) { return coarserCellKey(clusterKeys_[v]); },
+        [&](size_t v, VertexCluster& cluster) { cluster.add(clusters_[v]); },
+        clusterOf, keys, clusters);
+
+      const auto& previous = triangles_;
+      triangles_ = collapseTriangles(previous.size(),
+        [&](size_t t, int c) { return previous[t].v[c]; }, clusterOf);
+    }
+    clusterKeys_.swap(keys);
+    clusters_.swap(clusters);
+    ++level_;
+
+    std::vector<float> representative(clusters_.size() * 8);
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t c = begin; c < end; ++c)
+      {
+        const auto& cluster = clusters_[c];
+        const Point p = clusterPoint(cluster, clusterKeys_[c]);
+        float* r = &representative[c * 8];
+        r[0] = static_cast<float>(p.x());
+        r[1] = static_cast<float>(p.y());
+        r[2] = static_cast<float>(p.z());
+        const double* n = cluster.attributes;
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        const double scale = length > 0.0 ? 1.0 / length : 0.0;
+        for (int i = 0; i < 3; ++i)
+          r[3 + i] = static_cast<float>(n[i] * scale);
+        r[6] = static_cast<float>(n[3] / cluster.count);
+        r[7] = static_cast<float>(n[4] / cluster.count);
+      }
+    }, clusters_.size());
+
+    numTriangles = triangles_.size();
+    const size_t numVertices = 3 * numTriangles;
+    out = FaceArrays();
+    out.x.resize(numVertices); out.y.resize(numVertices); out.z.resize(numVertices);
+    if (meshNormals_)
+    {
+      out.nx.resize(numVertices); out.ny.resize(numVertices); out.nz.resize(numVertices);
+    }
+    if (texCoords_)
+    {
+      out.u.resize(numVertices); out.v.resize(numVertices);
+    }
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+    {
+      for (size_t t = begin; t < end; ++t)
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          const float* r = &representative[triangles_[t].v[c] * 8];
+          const size_t i = 3 * t + c;
+          out.x[i] = r[0]; out.y[i] = r[1]; out.z[i] = r[2];
+          if (meshNormals_)
+          {
+            out.nx[i] = r[3]; out.ny[i] = r[4]; out.nz[i] = r[5];
+          }
+          if (texCoords_)
+          {
+            out.u[i] = r[6]; out.v[i] = r[7];
+          }
+        }
+      }
+    }, numTriangles);
+
+    // A representative stays within about a cell of the vertices it replaces.
+    error = cellSize_ * std::sqrt(3.0);
+    return true;
+  }
 }
 
 
 
+const std::vector<VMesh::Face::index_type>& GeometryBuilder::facesToRender(FieldHandle field, bool boundaryOnly)
+{
+  VMesh* mesh = field->vmesh();
+  const auto meshId = field->mesh()->id();
+
+  if (faceListMeshId_ == meshId && faceListIsBoundary_ == boundaryOnly)
+    return faceList_;
+
+  VMesh::Face::size_type numMeshFaces;
+  mesh->size(numMeshFaces);
+  const size_t numFaces = numMeshFaces;
+
+  faceList_.clear();
+  if (boundaryOnly)
+  {
+    // A face is on the boundary if it is shared by exactly one element.
+    const size_t numThreads = Parallel::NumCores();
+    std::vector<std::vector<VMesh::Face::index_type>> threadFaces(numThreads);
+    Parallel::RunTasks([&](int t)
+    {
+      VMesh::Elem::array_type elems;
+      const size_t begin = numFaces * t / numThreads;
+      const size_t end = numFaces * (t + 1) / numThreads;
+      for (size_t f = begin; f < end; ++f)
+      {
+        mesh->get_elems(elems, VMesh::Face::index_type(f));
+        if (elems.size() == 1)
+          threadFaces[t].push_back(VMesh::Face::index_type(f));
+      }
+    }, numThreads);
+
+    for (const auto& faces : threadFaces)
+      faceList_.insert(faceList_.end(), faces.begin(), faces.end());
+  }
+  else
+  {
+    faceList_.resize(numFaces);
+    for (size_t f = 0; f < faceList_.size(); ++f)
+      faceList_[f] = VMesh::Face::index_type(f);
+  }
+
+  faceListMeshId_ = meshId;
+  faceListIsBoundary_ = boundaryOnly;
+  return faceList_;
+}
+
 void GeometryBuilder::renderFacesLinear(
   FieldHandle field,
   boost::optional<boost::shared_ptr<ColorMap>> colorMap,
@@ -503,19 +1078,19 @@ void GeometryBuilder::renderFacesLinear(
 
   mesh->synchronize(Mesh::FACES_E);
 
-  VMesh::Face::size_type numFaces;
-  mesh->size(numFaces);
-  if (numFaces == 0) return;
+  VMesh::Face::size_type numMeshFaces;
+  mesh->size(numMeshFaces);
+  if (numMeshFaces == 0) return;
 
-  Point idpt;
-  VMesh::Face::iterator fiter, fiterEnd;
   VMesh::Node::array_type nodes;
-  mesh->get_nodes(nodes, *fiter);
-  mesh->get_point(idpt, nodes[0]);
-  mesh->begin(fiter);
-  mesh->end(fiterEnd);
-  int numNodesPerFace = nodes.size();
-  bool useQuads = (numNodesPerFace == 4);
+  mesh->get_nodes(nodes, VMesh::Face::index_type(0));
+  const int numNodesPerFace = nodes.size();
+  const bool useQuads = (numNodesPerFace == 4);
+  if (numNodesPerFace != 3 && !useQuads)
+  {
+    log_->warning("Only triangular and quadrilateral faces are supported at this time.");
+    return;
+  }
   int numAttributes = 3; //intially 3 because we will atleast be rendering verticies (vec3's)
 
   bool useNormals = state.get(RenderState::USE_NORMALS);
@@ -526,20 +1101,15 @@ void GeometryBuilder::renderFacesLinear(
     numAttributes += 3;
     mesh->synchronize(Mesh::NORMALS_E);
   }
+  const auto normalMode = !useNormals ? FaceNormals::NONE : (useFaceNormals ? FaceNormals::FROM_MESH : FaceNormals::COMPUTED);
 
   bool useColorMap = (fld->basis_order() >= 0 && state.get(RenderState::USE_COLORMAP));
   bool isCellData = (fld->basis_order() == 0 && mesh->dimensionality() == 3);
   bool isFaceData = (fld->basis_order() == 0 && mesh->dimensionality() == 2);
   bool isNodeData = (fld->basis_order() == 1);
-  bool isScalar = fld->is_scalar();
-  bool isVector = fld->is_vector();
-  bool isTensor = fld->is_tensor();
-  int colorMapCase = (isCellData * 0 + isFaceData * 1 + isNodeData * 2) * 3;
-  colorMapCase += isScalar * 0 + isVector * 1 + isTensor * 2;
 
   ColorScheme colorScheme = ColorScheme::COLOR_UNIFORM;
 
-
   ColorMapHandle textureMap, coordinateMap;
   spiltColorMapToTextureAndCoordinates(colorMap, textureMap, coordinateMap);
 
@@ -549,213 +1119,189 @@ void GeometryBuilder::renderFacesLinear(
     colorScheme = ColorScheme::COLOR_MAP;
   }
 
-  int writeCase = getWriteCase(useQuads, useNormals, useColorMap);
+  const bool boundaryOnly = state_->getValue(FacesBoundaryOnly).toBool() && mesh->dimensionality() == 3;
 
-  std::vector<Point> points(numNodesPerFace);
-  std::vector<Vector> normals(numNodesPerFace);
-  std::vector<glm::vec2> textureCoords(numNodesPerFace);
-  std::vector<double> svals(numNodesPerFace);
-  std::vector<Vector> vvals(numNodesPerFace);
-  std::vector<Tensor> tvals(numNodesPerFace);
+  // Vertex and index buffers only depend on the field, the normal options and
+  // the data rescaling: the color map itself lives in the texture. If none of
+  // those changed, the previous buffers are reused and only the passes are rebuilt.
+  // The rescaling is written with full precision so any change to it rebuilds them.
+  std::ostringstream key;
+  const int levelsOfDetail = std::max(0, state_->getValue(FacesLevelsOfDetail).toInt());
+  key << std::setprecision(std::numeric_limits<double>::max_digits10);
+  key << field->id() << '_' << field->mesh()->id() << '_' << boundaryOnly << static_cast<int>(normalMode)
+    << invertNormals << useColorMap << '_' << coordinateMap->getColorMapRescaleScale()
+    << '_' << coordinateMap->getColorMapRescaleShift() << '_' << levelsOfDetail;
 
-  size_t passNumber = 0;
-  size_t facesLeft = mesh->num_faces();
-
-  while(facesLeft > 0)
+  if (faceBuffers_.key != key.str())
   {
-    const static size_t maxFacesPerPass = 1 << 24;
-    int facesLeftInThisPass = std::min(facesLeft, maxFacesPerPass);
-    facesLeft -= facesLeftInThisPass;
-
-    // Three 32 bit ints for each triangle to index into the VBO (triangles = verticies - 2)
-    size_t iboSize = static_cast<size_t>(facesLeftInThisPass * sizeof(uint32_t) * (numNodesPerFace - 2) * 3);
-    size_t vboSize = static_cast<size_t>(facesLeftInThisPass * sizeof(float) * numNodesPerFace * numAttributes);
-    std::shared_ptr<spire::VarBuffer> iboBufferSPtr(new spire::VarBuffer(iboSize));
-    std::shared_ptr<spire::VarBuffer> vboBufferSPtr(new spire::VarBuffer(vboSize));
-    auto iboBuffer = iboBufferSPtr.get();
-    auto vboBuffer = vboBufferSPtr.get();
-
-    if(useQuads)
+    faceBuffers_ = FaceBuffers();
+
+    const auto& faces = facesToRender(field, boundaryOnly);
+    interruptible->checkForInterruption();
+    const size_t numFaces = faces.size();
+    const size_t numFaceNodes = numFaces * numNodesPerFace;
+
+    FaceArrays arrays;
+    arrays.x.resize(numFaceNodes);
+    arrays.y.resize(numFaceNodes);
+    arrays.z.resize(numFaceNodes);
+    if (normalMode == FaceNormals::FROM_MESH)
     {
-      uint32_t nodesInThisPass = facesLeftInThisPass * 4;
-      for(uint32_t i = 0; i < nodesInThisPass; i += 4)
-      {
-        iboBuffer->writeUnsafe(i+0);
-        iboBuffer->writeUnsafe(i+1);
-        iboBuffer->writeUnsafe(i+2);
-        iboBuffer->writeUnsafe(i+2);
-        iboBuffer->writeUnsafe(i+3);
-        iboBuffer->writeUnsafe(i+0);
-      }
+      arrays.nx.resize(numFaceNodes);
+      arrays.ny.resize(numFaceNodes);
+      arrays.nz.resize(numFaceNodes);
     }
-    else
+    std::vector<double> uScalars, vScalars;
+    if (useColorMap)
     {
-      uint32_t nodesInThisPass = facesLeftInThisPass * 3;
-      for(uint32_t i = 0; i <  nodesInThisPass; i += 3)
-      {
-        iboBuffer->writeUnsafe(i+0);
-        iboBuffer->writeUnsafe(i+1);
-        iboBuffer->writeUnsafe(i+2);
-      }
+      arrays.u.resize(numFaceNodes);
+      arrays.v.resize(numFaceNodes);
+      uScalars.resize(numFaceNodes);
+      vScalars.resize(numFaceNodes);
     }
 
-    while (facesLeftInThisPass > 0)
+    Parallel::RunTasksOverRange([&](size_t begin, size_t end)
     {
-      interruptible->checkForInterruption();
-      mesh->get_nodes(nodes, *fiter);
-
-      for(size_t i = 0; i < numNodesPerFace; ++i)
-        mesh->get_point(points[i], nodes[i]);
-
-      if (useNormals)
+      VMesh::Node::array_type faceNodes;
+      VMesh::Elem::array_type cells;
+      Point p;
+      Vector n;
+      for (size_t f = begin; f < end; ++f)
       {
-        if (useFaceNormals)
+        mesh->get_nodes(faceNodes, faces[f]);
+        const size_t v0 = f * numNodesPerFace;
+        for (int i = 0; i < numNodesPerFace; ++i)
         {
-          for(size_t i = 0; i < numNodesPerFace; ++i)
-            mesh->get_normal(normals[i], nodes[i]);
+          mesh->get_point(p, faceNodes[i]);
+          arrays.x[v0 + i] = static_cast<float>(p.x());
+          arrays.y[v0 + i] = static_cast<float>(p.y());
+          arrays.z[v0 + i] = static_cast<float>(p.z());
         }
-        else
+
+        if (normalMode == FaceNormals::FROM_MESH)
         {
-          Vector norm;
-          if (useQuads)
+          for (int i = 0; i < numNodesPerFace; ++i)
           {
-            Vector edge1 = points[1] - points[0];
-            Vector edge2 = points[2] - points[1];
-            Vector edge3 = points[3] - points[2];
-            Vector edge4 = points[0] - points[3];
-            norm = Cross(edge1, edge2) + Cross(edge2, edge3) + Cross(edge3, edge4) + Cross(edge4, edge1);
-            norm.normalize();
+            mesh->get_normal(n, faceNodes[i]);
+            arrays.nx[v0 + i] = static_cast<float>(n.x());
+            arrays.ny[v0 + i] = static_cast<float>(n.y());
+            arrays.nz[v0 + i] = static_cast<float>(n.z());
           }
-          else
-          {
-            Vector edge1 = points[1] - points[0];
-            Vector edge2 = points[2] - points[1];
-            norm = Cross(edge1, edge2);
-            norm.normalize();
-          }
-
-          for(size_t i = 0; i < numNodesPerFace; ++i)
-            normals[i] = norm;
         }
 
-        if(invertNormals)
-          for(size_t i = 0; i < numNodesPerFace; ++i)
-            normals[i] = -normals[i];
-      }
+        if (!useColorMap)
+          continue;
 
-      if(useColorMap)
-      {
         // Element data (Cells) so two sided faces.
         if (isCellData)
         {
-          VMesh::Elem::array_type cells;
-          mesh->get_elems(cells, *fiter);
-
-          if (isScalar)
-          {
-            fld->get_value(svals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(svals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToColor(svals[0]).r();
-              textureCoords[i].y = coordinateMap->valueToColor(svals[1]).r();
-            }
-          }
-          else if (isVector)
-          {
-            fld->get_value(vvals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(vvals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToColor(vvals[0]).r();
-              textureCoords[i].y = coordinateMap->valueToColor(vvals[1]).r();
-            }
-          }
-          else if (isTensor)
-          {
-            fld->get_value(tvals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(tvals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToColor(tvals[0]).r();
-              textureCoords[i].y = coordinateMap->valueToColor(tvals[1]).r();
-            }
-          }
+          mesh->get_elems(cells, faces[f]);
+          const double front = colorMapScalar(fld, cells[0]);
+          const double back = cells.size() > 1 ? colorMapScalar(fld, cells[1]) : front;
+          std::fill_n(&uScalars[v0], numNodesPerFace, front);
+          std::fill_n(&vScalars[v0], numNodesPerFace, back);
         }
         // Element data (faces)
         else if (isFaceData)
         {
-          if (isScalar)
-          {
-            fld->get_value(svals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToColor(svals[0]).r();
-          }
-          else if (isVector)
-          {
-            fld->get_value(vvals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToColor(vvals[0]).r();
-          }
-          else if (isTensor)
-          {
-            fld->get_value(tvals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToColor(tvals[0]).r();
-          }
-
-          for (size_t i = 0; i < numNodesPerFace; ++i)
-            textureCoords[i].y = textureCoords[i].x = textureCoords[0].x;
+          const double value = colorMapScalar(fld, faces[f]);
+          std::fill_n(&uScalars[v0], numNodesPerFace, value);
+          std::fill_n(&vScalars[v0], numNodesPerFace, value);
         }
         // Data at nodes
         else if (isNodeData)
         {
-          if (isScalar)
-          {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(svals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToColor(svals[i]).r();
-            }
-          }
-          else if (isVector)
+          for (int i = 0; i < numNodesPerFace; ++i)
+            uScalars[v0 + i] = vScalars[v0 + i] = colorMapScalar(fld, faceNodes[i]);
+        }
+      }
+    }, numFaces);
+
+    if (useColorMap)
+    {
+      scalarsToTexCoords(*coordinateMap, uScalars, arrays.u);
+      scalarsToTexCoords(*coordinateMap, vScalars, arrays.v);
+    }
+
+    interruptible->checkForInterruption();
+
+    const float normalSign = invertNormals ? -1.0f : 1.0f;
+    auto addFaceBuffers = [&](const FaceArrays& source, size_t numSourceFaces, int nodesPerFace,
+      const SpireLevelOfDetail& lod)
+    {
+      const static size_t maxFacesPerPass = 1 << 24;
+      for (size_t passBegin = 0; passBegin < numSourceFaces; passBegin += maxFacesPerPass)
+      {
+        const size_t passEnd = std::min(numSourceFaces, passBegin + maxFacesPerPass);
+        const size_t facesInPass = passEnd - passBegin;
+
+        // Three 32 bit ints for each triangle to index into the VBO (triangles = verticies - 2)
+        size_t iboSize = facesInPass * sizeof(uint32_t) * (nodesPerFace - 2) * 3;
+        size_t vboSize = facesInPass * sizeof(float) * nodesPerFace * numAttributes;
+        std::shared_ptr<spire::VarBuffer> iboBuffer(new spire::VarBuffer(iboSize));
+        std::shared_ptr<spire::VarBuffer> vboBuffer(new spire::VarBuffer(vboSize));
+        auto ibo = reinterpret_cast<uint32_t*>(iboBuffer->reserveBytes(iboSize));
+        auto vbo = reinterpret_cast<float*>(vboBuffer->reserveBytes(vboSize));
+
+        Parallel::RunTasksOverRange([&](size_t begin, size_t end)
+        {
+          if (nodesPerFace == 4)
           {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(vvals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToColor(vvals[i]).r();
-            }
+            fillFaceIBO<4>(begin, end, ibo);
+            fillFaceVBO<4>(normalMode, useColorMap, source, passBegin + begin, passBegin + end, passBegin, normalSign, vbo);
           }
-          else if (isTensor)
+          else
           {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(tvals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToColor(tvals[i]).r();
-            }
+            fillFaceIBO<3>(begin, end, ibo);
+            fillFaceVBO<3>(normalMode, useColorMap, source, passBegin + begin, passBegin + end, passBegin, normalSign, vbo);
           }
-        }
+        }, facesInPass);
+
+        faceBuffers_.vbos.push_back(vboBuffer);
+        faceBuffers_.ibos.push_back(iboBuffer);
+        faceBuffers_.lods.push_back(lod);
+        interruptible->checkForInterruption();
       }
+    };
 
-      switch(writeCase)
+    // Full resolution is always kept as level 0; coarser levels are only
+    // emitted when they drop at least a quarter of the triangles.
+    addFaceBuffers(arrays, numFaces, numNodesPerFace, SpireLevelOfDetail());
+    if (levelsOfDetail > 0 && numFaceNodes < std::numeric_limits<uint32_t>::max())
+    {
+      FaceDecimator decimator(arrays, numFaces, numNodesPerFace, mesh->get_bounding_box(),
+        normalMode == FaceNormals::FROM_MESH, useColorMap);
+      size_t emittedTriangles = numFaces * (numNodesPerFace - 2);
+      FaceArrays level;
+      size_t numTriangles;
+      double error;
+      for (int l = 1; l <= levelsOfDetail && decimator.nextLevel(level, numTriangles, error); )
       {
-        case TRI: writeTri(vboBuffer, points); break;
-        case TRI_TEXCOORDS: writeTri(vboBuffer, points, textureCoords); break;
-        case TRI_NORMALS: writeTri(vboBuffer, points, normals); break;
-        case TRI_NORMALS_TEXCOORDS: writeTri(vboBuffer, points, normals, textureCoords); break;
-        case QUAD: writeQuad(vboBuffer, points); break;
-        case QUAD_TEXCOORDS: writeQuad(vboBuffer, points, textureCoords); break;
-        case QUAD_NORMALS: writeQuad(vboBuffer, points, normals); break;
-        case QUAD_NORMALS_TEXCOORDS: writeQuad(vboBuffer, points, normals, textureCoords); break;
-      }
+        interruptible->checkForInterruption();
+        if (numTriangles == 0)
+          break;
+        if (4 * numTriangles > 3 * emittedTriangles)
+          continue;
 
-      ++fiter;
-      --facesLeftInThisPass;
+        for (auto& previous : faceBuffers_.lods)
+        {
+          if (previous.level == l - 1)
+            previous.coarserError = error;
+        }
+        SpireLevelOfDetail lod;
+        lod.level = l;
+        lod.error = error;
+        addFaceBuffers(level, numTriangles, 3, lod);
+        emittedTriangles = numTriangles;
+        ++l;
+      }
     }
+    faceBuffers_.key = key.str();
+  }
 
+  const double lodPixelError = state_->getValue(FacesLevelOfDetailPixelError).toDouble();
+  for (size_t passNumber = 0; passNumber < faceBuffers_.vbos.size(); ++passNumber)
+  {
     std::stringstream ss;
     ss << invertNormals << static_cast<int>(colorScheme) << faceTransparencyValue_ << "_" << passNumber;
 
@@ -807,10 +1353,10 @@ void GeometryBuilder::renderFacesLinear(
     }
 
     //numVBOElements is only used in dead code and should be removed which is why its hard coded to 0
-    SpireVBO geomVBO(vboName, attribs, vboBufferSPtr, 0, mesh->get_bounding_box(), true);
+    SpireVBO geomVBO(vboName, attribs, faceBuffers_.vbos[passNumber], 0, mesh->get_bounding_box(), true);
     geom->vbos().push_back(geomVBO);
 
-    SpireIBO geomIBO(iboName, SpireIBO::PRIMITIVE::TRIANGLES, sizeof(uint32_t), iboBufferSPtr);
+    SpireIBO geomIBO(iboName, SpireIBO::PRIMITIVE::TRIANGLES, sizeof(uint32_t), faceBuffers_.ibos[passNumber]);
     geom->ibos().push_back(geomIBO);
 
     SpireText text;
@@ -819,8 +1365,10 @@ void GeometryBuilder::renderFacesLinear(
 
     for (const auto& uniform : uniforms) pass.addUniform(uniform);
 
+    pass.lod = faceBuffers_.lods[passNumber];
+    pass.lod.pixelTolerance = lodPixelError;
+
     geom->passes().push_back(pass);
-    ++passNumber;
   }
 }
 
@@ -1129,3 +1677,6 @@ ALGORITHM_PARAMETER_DEF(Visualization, TextSize);
 ALGORITHM_PARAMETER_DEF(Visualization, TextPrecision);
 ALGORITHM_PARAMETER_DEF(Visualization, TextColoring);
 ALGORITHM_PARAMETER_DEF(Visualization, UseFaceNormals);
+ALGORITHM_PARAMETER_DEF(Visualization, FacesBoundaryOnly);
+ALGORITHM_PARAMETER_DEF(Visualization, FacesLevelsOfDetail);
+ALGORITHM_PARAMETER_DEF(Visualization, FacesLevelOfDetailPixelError);
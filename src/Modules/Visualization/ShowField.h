@@ -82,6 +82,9 @@ namespace SCIRun {
         ALGORITHM_PARAMETER_DECL(TextPrecision);
         ALGORITHM_PARAMETER_DECL(TextColoring);
         ALGORITHM_PARAMETER_DECL(UseFaceNormals);
+        ALGORITHM_PARAMETER_DECL(FacesBoundaryOnly);
+        ALGORITHM_PARAMETER_DECL(FacesLevelsOfDetail);
+        ALGORITHM_PARAMETER_DECL(FacesLevelOfDetailPixelError);
       }
     }
   }
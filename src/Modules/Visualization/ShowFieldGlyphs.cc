@@ -41,6 +41,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/Color.h>
 #include <Graphics/Datatypes/GeometryImpl.h>
+#include <Core/Thread/Parallel.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -112,7 +113,21 @@ namespace SCIRun {
       RenderState getTensorsRenderState(ModuleStateHandle state);
 
       private:
+        // Glyphs built by one thread over a contiguous range of the input.
+        struct GlyphBlock
+        {
+          GlyphBlock() : negativeEigenvalueCount(0) {}
+          GlyphGeom glyphs;
+          GlyphGeom lineGlyphs;
+          GlyphGeom pointGlyphs;
+          int negativeEigenvalueCount;
+        };
+        typedef std::function<void(ShowFieldGlyphsPortHandler&, GlyphBlock&, size_t, size_t)> BlockBuilder;
+
         std::string moduleId_;
+        std::vector<GlyphBlock> buildGlyphBlocks(size_t numGlyphs, const BlockBuilder& buildBlock) const;
+        static void appendGlyphBlocks(std::vector<GlyphBlock>& blocks, GlyphGeom& glyphs,
+                                      GlyphGeom& lineGlyphs, GlyphGeom& pointGlyphs);
         ColorScheme getColoringType(const RenderState& renState, VField* fld);
         void getPoints(VMesh* mesh, std::vector<int>& indices, std::vector<Point>& points);
         std::unique_ptr<ShowFieldGlyphsPortHandler> portHandler_;
@@ -150,6 +165,41 @@ enum FieldDataType
   cell
 };
 
+// Each thread fills its own GlyphGeoms using its own copy of the port handler, which caches
+// the last value it read. The blocks are contiguous so appending them in order gives the same
+// output as a serial build. Interrupting the module stops the blocks at their next glyph, and
+// an exception from a block is rethrown here by RunTasks.
+std::vector<GlyphBuilder::GlyphBlock> GlyphBuilder::buildGlyphBlocks(size_t numGlyphs, const BlockBuilder& buildBlock) const
+{
+  const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), numGlyphs));
+  std::vector<GlyphBlock> blocks(numBlocks);
+  for (auto& block : blocks)
+    block.glyphs.setUseInstancing(true);
+
+  Parallel::RunTasks([&](int i)
+  {
+    ShowFieldGlyphsPortHandler handler(*portHandler_);
+    buildBlock(handler, blocks[i], numGlyphs * i / numBlocks, numGlyphs * (i + 1) / numBlocks);
+  }, static_cast<int>(numBlocks));
+
+  return blocks;
+}
+
+void GlyphBuilder::appendGlyphBlocks(std::vector<GlyphBlock>& blocks, GlyphGeom& glyphs,
+                                     GlyphGeom& lineGlyphs, GlyphGeom& pointGlyphs)
+{
+  std::vector<GlyphGeom> parts, lineParts, pointParts;
+  for (auto& block : blocks)
+  {
+    parts.push_back(std::move(block.glyphs));
+    lineParts.push_back(std::move(block.lineGlyphs));
+    pointParts.push_back(std::move(block.pointGlyphs));
+  }
+  glyphs.append(parts);
+  lineGlyphs.append(lineParts);
+  pointGlyphs.append(pointParts);
+}
+
 ColorScheme GlyphBuilder::getColoringType(const RenderState& renState, VField* fld)
 {
   if(fld->basis_order() < 0 || renState.get(RenderState::USE_DEFAULT_COLOR))
@@ -555,50 +605,64 @@ void GlyphBuilder::renderVectors(
   auto points = std::vector<Point>();
   getPoints(mesh, indices, points);
 
-  GlyphGeom glyphs;
-  // Render every item from facade
-  for(int i = 0; i < indices.size(); i++)
-  {
-    interruptible->checkForInterruption();
-    Vector v, pinputVector; Point p2, p3; double radius;
+  if (renState.mGlyphType == RenderState::GlyphType::SPRING_GLYPH)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Spring Geom is not supported yet."));
 
-    pinputVector = portHandler_->getPrimaryVector(indices[i]);
+  const bool useSecondaryParameter = state->getValue(ShowFieldGlyphs::SecondaryVectorParameterScalingType).toInt()
+    == SecondaryVectorParameterScalingTypeEnum::USE_INPUT;
 
-      // Normalize/Scale
-    Vector dir = pinputVector;
-    if(normalizeGlyphs)
-    dir.normalize();
-    // v = pinputVector.normal() * scale;
-    // else
-    // v = pinputVector * scale;
+  interruptible->checkForInterruption();
+  auto blocks = buildGlyphBlocks(indices.size(), [&](ShowFieldGlyphsPortHandler& handler, GlyphBlock& block, size_t begin, size_t end)
+  {
+    GlyphGeom& glyphs = block.glyphs;
+    // Render every item from facade
+    for(size_t i = begin; i < end; i++)
+    {
+      interruptible->checkForInterruption();
+      Vector v, pinputVector; Point p2, p3; double radius;
 
-    // Calculate points
-    // p2 = points[i] + v;
-    // p3 = points[i] - v;
+      pinputVector = handler.getPrimaryVector(indices[i]);
 
-    // Get radius
-    // radius = scale * radiusWidthScale / 2.0;
-    radius = radiusWidthScale / 2.0;
-    if(state->getValue(ShowFieldGlyphs::SecondaryVectorParameterScalingType).toInt() == SecondaryVectorParameterScalingTypeEnum::USE_INPUT)
-      radius *= portHandler_->getSecondaryVectorParameter(indices[i]);
+        // Normalize/Scale
+      Vector dir = pinputVector;
+      if(normalizeGlyphs)
+      dir.normalize();
+      // v = pinputVector.normal() * scale;
+      // else
+      // v = pinputVector * scale;
 
-    ColorRGB node_color = portHandler_->getNodeColor(indices[i]);
+      // Calculate points
+      // p2 = points[i] + v;
+      // p3 = points[i] - v;
 
-    if(renderGlphysBelowThreshold || pinputVector.length() >= threshold)
-    {
-      // No need to render cylinder base if arrow is bidirectional
-      bool render_cylinder_base = renderBases && !renderBidirectionaly;
-      addGlyph(glyphs, renState.mGlyphType, points[i], dir, radius, scale, arrowHeadRatio,
-               resolution, node_color, useLines, render_cylinder_base, renderBases);
+      // Get radius
+      // radius = scale * radiusWidthScale / 2.0;
+      radius = radiusWidthScale / 2.0;
+      if(useSecondaryParameter)
+        radius *= handler.getSecondaryVectorParameter(indices[i]);
+
+      ColorRGB node_color = handler.getNodeColor(indices[i]);
 
-      if(renderBidirectionaly)
+      if(renderGlphysBelowThreshold || pinputVector.length() >= threshold)
       {
-        Vector neg_dir = -dir;
-        addGlyph(glyphs, renState.mGlyphType, points[i], neg_dir, radius, scale, arrowHeadRatio,
+        // No need to render cylinder base if arrow is bidirectional
+        bool render_cylinder_base = renderBases && !renderBidirectionaly;
+        addGlyph(glyphs, renState.mGlyphType, points[i], dir, radius, scale, arrowHeadRatio,
                  resolution, node_color, useLines, render_cylinder_base, renderBases);
+
+        if(renderBidirectionaly)
+        {
+          Vector neg_dir = -dir;
+          addGlyph(glyphs, renState.mGlyphType, points[i], neg_dir, radius, scale, arrowHeadRatio,
+                   resolution, node_color, useLines, render_cylinder_base, renderBases);
+        }
       }
     }
-  }
+  });
+  interruptible->checkForInterruption();
+
+  GlyphGeom glyphs, unusedLines, unusedPoints;
+  appendGlyphBlocks(blocks, glyphs, unusedLines, unusedPoints);
 
   std::stringstream ss;
   ss << renState.mGlyphType << resolution << scale << static_cast<int>(colorScheme);
@@ -640,38 +704,44 @@ void GlyphBuilder::renderScalars(
   auto points = std::vector<Point>();
   getPoints(mesh, indices, points);
 
-  GlyphGeom glyphs;
-  // Render every item from facade
-  for(int i = 0; i < indices.size(); i++)
-  {
-    interruptible->checkForInterruption();
+  if (renState.mGlyphType == RenderState::GlyphType::BOX_GLYPH)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Box Geom is not supported yet."));
+  if (renState.mGlyphType == RenderState::GlyphType::AXIS_GLYPH)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Axis Geom is not supported yet."));
 
-    double v = portHandler_->getPrimaryScalar(indices[i]);
-    ColorRGB node_color = portHandler_->getNodeColor(indices[i]);
-    double radius = std::abs(v) * scale;
-
-    switch (renState.mGlyphType)
+  interruptible->checkForInterruption();
+  auto blocks = buildGlyphBlocks(indices.size(), [&](ShowFieldGlyphsPortHandler& handler, GlyphBlock& block, size_t begin, size_t end)
+  {
+    GlyphGeom& glyphs = block.glyphs;
+    // Render every item from facade
+    for(size_t i = begin; i < end; i++)
     {
-      case RenderState::GlyphType::POINT_GLYPH:
-        glyphs.addPoint(points[i], node_color);
-        break;
-      case RenderState::GlyphType::SPHERE_GLYPH:
-        glyphs.addSphere(points[i], radius, resolution, node_color);
-        break;
-      case RenderState::GlyphType::BOX_GLYPH:
-        BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Box Geom is not supported yet."));
-        break;
-      case RenderState::GlyphType::AXIS_GLYPH:
-        BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Axis Geom is not supported yet."));
-        break;
-      default:
-        if (usePoints)
+      interruptible->checkForInterruption();
+      double v = handler.getPrimaryScalar(indices[i]);
+      ColorRGB node_color = handler.getNodeColor(indices[i]);
+      double radius = std::abs(v) * scale;
+
+      switch (renState.mGlyphType)
+      {
+        case RenderState::GlyphType::POINT_GLYPH:
           glyphs.addPoint(points[i], node_color);
-        else
+          break;
+        case RenderState::GlyphType::SPHERE_GLYPH:
           glyphs.addSphere(points[i], radius, resolution, node_color);
-        break;
+          break;
+        default:
+          if (usePoints)
+            glyphs.addPoint(points[i], node_color);
+          else
+            glyphs.addSphere(points[i], radius, resolution, node_color);
+          break;
+      }
     }
-  }
+  });
+  interruptible->checkForInterruption();
+
+  GlyphGeom glyphs, unusedLines, unusedPoints;
+  appendGlyphBlocks(blocks, glyphs, unusedLines, unusedPoints);
 
   std::stringstream ss;
   ss << renState.mGlyphType << resolution << scale << static_cast<int>(colorScheme);
@@ -729,92 +799,102 @@ void GlyphBuilder::renderTensors(
 
   SpireIBO::PRIMITIVE primIn = SpireIBO::PRIMITIVE::TRIANGLES;
 
-  GlyphGeom tensor_line_glyphs;
-  GlyphGeom point_glyphs;
-
-  int neg_eigval_count = 0;
-  int tensorcount = 0;
   static const double vectorThreshold = 0.001;
   static const double pointThreshold = 0.01;
   static const double epsilon = pow(2, -52);
 
-  GlyphGeom glyphs;
-  // Render every item from facade
-  for(int i = 0; i < indices.size(); i++)
-  {
-    interruptible->checkForInterruption();
+  double emphasis = state->getValue(ShowFieldGlyphs::SuperquadricEmphasis).toDouble();
 
-    Tensor t = portHandler_->getPrimaryTensor(indices[i]);
+  // Eigen decompositions dominate tensor glyph cost, so they run inside the per-thread blocks.
+  interruptible->checkForInterruption();
+  auto blocks = buildGlyphBlocks(indices.size(), [&](ShowFieldGlyphsPortHandler& handler, GlyphBlock& block, size_t begin, size_t end)
+  {
+    GlyphGeom& glyphs = block.glyphs;
+    GlyphGeom& tensor_line_glyphs = block.lineGlyphs;
+    GlyphGeom& point_glyphs = block.pointGlyphs;
+    int& neg_eigval_count = block.negativeEigenvalueCount;
+    // Render every item from facade
+    for(size_t i = begin; i < end; i++)
+    {
+      interruptible->checkForInterruption();
+      Tensor t = handler.getPrimaryTensor(indices[i]);
 
-    double eigen1, eigen2, eigen3;
-    t.get_eigenvalues(eigen1, eigen2, eigen3);
-    Vector eigvals(fabs(eigen1), fabs(eigen2), fabs(eigen3));
+      double eigen1, eigen2, eigen3;
+      t.get_eigenvalues(eigen1, eigen2, eigen3);
+      Vector eigvals(fabs(eigen1), fabs(eigen2), fabs(eigen3));
 
-    // Counter for negative eigen values
-    if(eigen1 < -epsilon || eigen2 < -epsilon || eigen3 < -epsilon) ++neg_eigval_count;
+      // Counter for negative eigen values
+      if(eigen1 < -epsilon || eigen2 < -epsilon || eigen3 < -epsilon) ++neg_eigval_count;
 
-    Vector eigvec1, eigvec2, eigvec3;
-    t.get_eigenvectors(eigvec1, eigvec2, eigvec3);
+      Vector eigvec1, eigvec2, eigvec3;
+      t.get_eigenvectors(eigvec1, eigvec2, eigvec3);
 
-    // Checks to see if eigenvalues are below defined threshold
-    bool vector_eig_x_0 = eigvals.x() <= vectorThreshold;
-    bool vector_eig_y_0 = eigvals.y() <= vectorThreshold;
-    bool vector_eig_z_0 = eigvals.z() <= vectorThreshold;
-    bool point_eig_x_0 = eigvals.x() <= pointThreshold;
-    bool point_eig_y_0 = eigvals.y() <= pointThreshold;
-    bool point_eig_z_0 = eigvals.z() <= pointThreshold;
+      // Checks to see if eigenvalues are below defined threshold
+      bool vector_eig_x_0 = eigvals.x() <= vectorThreshold;
+      bool vector_eig_y_0 = eigvals.y() <= vectorThreshold;
+      bool vector_eig_z_0 = eigvals.z() <= vectorThreshold;
+      bool point_eig_x_0 = eigvals.x() <= pointThreshold;
+      bool point_eig_y_0 = eigvals.y() <= pointThreshold;
+      bool point_eig_z_0 = eigvals.z() <= pointThreshold;
 
-    bool order0Tensor = (point_eig_x_0 && point_eig_y_0 && point_eig_z_0);
-    bool order1Tensor = (vector_eig_x_0 + vector_eig_y_0 + vector_eig_z_0) >= 2;
+      bool order0Tensor = (point_eig_x_0 && point_eig_y_0 && point_eig_z_0);
+      bool order1Tensor = (vector_eig_x_0 + vector_eig_y_0 + vector_eig_z_0) >= 2;
 
-    ColorRGB node_color = portHandler_->getNodeColor(indices[i]);
+      ColorRGB node_color = handler.getNodeColor(indices[i]);
 
-    // Do not render tensors that are too small - because surfaces
-    // are not renderd at least two of the scales must be non zero.
-    if(!renderGlyphsBelowThreshold && t.magnitude() < threshold) continue;
+      // Do not render tensors that are too small - because surfaces
+      // are not renderd at least two of the scales must be non zero.
+      if(!renderGlyphsBelowThreshold && t.magnitude() < threshold) continue;
 
-    if(order0Tensor)
-    {
-      point_glyphs.addPoint(points[i], node_color);
-    }
-    else if(order1Tensor)
-    {
-      Vector dir;
-      if(vector_eig_x_0 && vector_eig_y_0)
-        dir = eigvec3 * eigvals[2];
-      else if(vector_eig_y_0 && vector_eig_z_0)
-        dir = eigvec1 * eigvals[0];
-      else if(vector_eig_x_0 && vector_eig_z_0)
-        dir = eigvec2 * eigvals[1];
-      // Point p1 = points[i];
-      // Point p2 = points[i] + dir;
-      addGlyph(tensor_line_glyphs, RenderState::GlyphType::LINE_GLYPH, points[i], dir, scale, scale, scale, resolution, node_color, true);
-    }
-    // Render as order 2 or 3 tensor
-    else
-    {
-      switch (renState.mGlyphType)
+      if(order0Tensor)
       {
-        case RenderState::GlyphType::BOX_GLYPH:
-          glyphs.addBox(points[i], t, scale, node_color, normalizeGlyphs);
-          break;
-        case RenderState::GlyphType::ELLIPSOID_GLYPH:
-          glyphs.addEllipsoid(points[i], t, scale, resolution, node_color, normalizeGlyphs);
-          break;
-        case RenderState::GlyphType::SUPERELLIPSOID_GLYPH:
+        point_glyphs.addPoint(points[i], node_color);
+      }
+      else if(order1Tensor)
+      {
+        Vector dir;
+        if(vector_eig_x_0 && vector_eig_y_0)
+          dir = eigvec3 * eigvals[2];
+        else if(vector_eig_y_0 && vector_eig_z_0)
+          dir = eigvec1 * eigvals[0];
+        else if(vector_eig_x_0 && vector_eig_z_0)
+          dir = eigvec2 * eigvals[1];
+        // Point p1 = points[i];
+        // Point p2 = points[i] + dir;
+        addGlyph(tensor_line_glyphs, RenderState::GlyphType::LINE_GLYPH, points[i], dir, scale, scale, scale, resolution, node_color, true);
+      }
+      // Render as order 2 or 3 tensor
+      else
+      {
+        switch (renState.mGlyphType)
         {
-          double emphasis = state->getValue(ShowFieldGlyphs::SuperquadricEmphasis).toDouble();
-          if(emphasis > 0.0)
-            glyphs.addSuperEllipsoid(points[i], t, scale, resolution, node_color, normalizeGlyphs, emphasis);
-          else
+          case RenderState::GlyphType::BOX_GLYPH:
+            glyphs.addBox(points[i], t, scale, node_color, normalizeGlyphs);
+            break;
+          case RenderState::GlyphType::ELLIPSOID_GLYPH:
             glyphs.addEllipsoid(points[i], t, scale, resolution, node_color, normalizeGlyphs);
+            break;
+          case RenderState::GlyphType::SUPERELLIPSOID_GLYPH:
+          {
+            if(emphasis > 0.0)
+              glyphs.addSuperEllipsoid(points[i], t, scale, resolution, node_color, normalizeGlyphs, emphasis);
+            else
+              glyphs.addEllipsoid(points[i], t, scale, resolution, node_color, normalizeGlyphs);
+          }
+          default:
+            break;
         }
-        default:
-          break;
       }
-      tensorcount++;
     }
-  }
+  });
+  interruptible->checkForInterruption();
+
+  GlyphGeom glyphs, tensor_line_glyphs, point_glyphs;
+  appendGlyphBlocks(blocks, glyphs, tensor_line_glyphs, point_glyphs);
+
+  int neg_eigval_count = 0;
+  for (const auto& block : blocks)
+    neg_eigval_count += block.negativeEigenvalueCount;
 
   // Prints warning if there are negative eigen values
   if(neg_eigval_count > 0) {
@@ -33,6 +33,8 @@
 #include <Core/Utils/Exception.h>
 #include <Core/Logging/Log.h>
 #include <Core/Datatypes/ColorMap.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
+#include <Testing/Utils/SCIRunUnitTests.h>
 
 using namespace SCIRun::Testing;
 using namespace SCIRun::TestUtils;
@@ -45,6 +47,7 @@ using namespace SCIRun::Modules::Visualization;
 using namespace SCIRun::Core;
 using namespace SCIRun;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Graphics::Datatypes;
 using ::testing::Values;
 using ::testing::Combine;
 using ::testing::Range;
@@ -129,6 +132,124 @@ TEST_F(ShowFieldStateGeometryNameSynchronizationTest, GeometryNameSynchronizesWi
   EXPECT_NE(inputChangeShouldBeDifferent, hash1);
 }
 
+class ShowFieldFaceBufferTest : public ModuleTest
+{
+protected:
+  virtual void SetUp()
+  {
+    LogSettings::Instance().setVerbose(false);
+    showField = makeModule("ShowField");
+    showField->setStateDefaults();
+    auto state = showField->get_state();
+    state->setValue(ShowFaces, true);
+    state->setValue(ShowEdges, false);
+    state->setValue(ShowNodes, false);
+    stubPortNWithThisData(showField, 0, CreateEmptyLatVol(3, 3, 3));
+  }
+
+  GeometryHandle executeAndGetGeometry()
+  {
+    showField->execute();
+    auto geom = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+    EXPECT_TRUE(geom != nullptr);
+    return geom;
+  }
+
+  static size_t numIndices(GeometryHandle geom)
+  {
+    size_t indices = 0;
+    for (const auto& ibo : geom->ibos())
+      indices += ibo.data->getBufferSize() / ibo.indexSize;
+    return indices;
+  }
+
+  UseRealModuleStateFactory f;
+  ModuleHandle showField;
+};
+
+TEST_F(ShowFieldFaceBufferTest, BoundaryFacesOnlySkipsInteriorFaces)
+{
+  // 2x2x2 cells: 36 faces in total, 24 of them on the boundary. Each quad is two triangles.
+  EXPECT_EQ(36 * 6, numIndices(executeAndGetGeometry()));
+
+  showField->get_state()->setValue(FacesBoundaryOnly, true);
+  EXPECT_EQ(24 * 6, numIndices(executeAndGetGeometry()));
+}
+
+TEST_F(ShowFieldFaceBufferTest, ChangingOnlyTheColorMapReusesFaceBuffers)
+{
+  showField->get_state()->setValue(FacesColoring, 1);
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Rainbow"));
+  auto first = executeAndGetGeometry();
+
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Blackbody"));
+  auto second = executeAndGetGeometry();
+
+  ASSERT_EQ(first->vbos().size(), second->vbos().size());
+  EXPECT_EQ(first->vbos().front().data, second->vbos().front().data);
+  EXPECT_EQ(first->ibos().front().data, second->ibos().front().data);
+  EXPECT_NE(first->passes().front().texture.bitmap, second->passes().front().texture.bitmap);
+
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Blackbody", 256, 0, false, 0.25, 1.0));
+  auto rescaled = executeAndGetGeometry();
+  EXPECT_NE(second->vbos().front().data, rescaled->vbos().front().data);
+}
+
+TEST_F(ShowFieldFaceBufferTest, LevelsOfDetailAreEmittedAsCoarserPasses)
+{
+  stubPortNWithThisData(showField, 0, CreateEmptyLatVol(20, 20, 20));
+  showField->get_state()->setValue(FacesBoundaryOnly, true);
+  showField->get_state()->setValue(FacesLevelsOfDetail, 2);
+  auto geom = executeAndGetGeometry();
+
+  ASSERT_EQ(3, geom->passes().size());
+  std::vector<size_t> indices;
+  for (const auto& ibo : geom->ibos())
+    indices.push_back(ibo.data->getBufferSize() / ibo.indexSize);
+  EXPECT_EQ(6 * 19 * 19 * 6, indices[0]);
+  EXPECT_LT(indices[1], indices[0]);
+  EXPECT_LT(indices[2], indices[1]);
+
+  // Exactly one level is selected at any scale.
+  const std::vector<SpireSubPass> passes(geom->passes().begin(), geom->passes().end());
+  EXPECT_EQ(0, passes[0].lod.error);
+  EXPECT_EQ(passes[1].lod.error, passes[0].lod.coarserError);
+  EXPECT_EQ(passes[2].lod.error, passes[1].lod.coarserError);
+  for (double pixelsPerUnit : { 0.1, 1.0, 10.0, 100.0, 1000.0 })
+  {
+    int selected = 0;
+    for (const auto& pass : passes)
+      selected += pass.lod.isSelected(pixelsPerUnit) ? 1 : 0;
+    EXPECT_EQ(1, selected);
+  }
+  EXPECT_TRUE(passes[0].lod.isSelected(1000.0));
+  EXPECT_TRUE(passes[2].lod.isSelected(0.1));
+}
+
+TEST_F(ShowFieldFaceBufferTest, LevelsOfDetailDoNotDependOnCoreCount)
+{
+  showField->get_state()->setValue(FacesBoundaryOnly, true);
+  showField->get_state()->setValue(FacesLevelsOfDetail, 2);
+
+  auto buffers = [](GeometryHandle geom) -> std::vector<std::string>
+  {
+    std::vector<std::string> bytes;
+    for (const auto& vbo : geom->vbos())
+      bytes.emplace_back(vbo.data->getBuffer(), vbo.data->getBufferSize());
+    for (const auto& ibo : geom->ibos())
+      bytes.emplace_back(ibo.data->getBuffer(), ibo.data->getBufferSize());
+    return bytes;
+  };
+
+  // a new field every time, so the buffers are rebuilt rather than reused
+  auto results = runOnOneAndAllCores([&]() -> std::vector<std::string>
+  {
+    stubPortNWithThisData(showField, 0, CreateEmptyLatVol(20, 20, 20));
+    return buffers(executeAndGetGeometry());
+  });
+  EXPECT_EQ(results.first, results.second);
+}
+
 class ShowFieldPreformaceTest : public ModuleTest {};
 TEST_F(ShowFieldPreformaceTest, TestFacePreformace)
 {
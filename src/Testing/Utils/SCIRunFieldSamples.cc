@@ -34,6 +34,8 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 
 #include <boost/assign.hpp>
+#include <cmath>
+#include <gtest/gtest.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Geometry;
@@ -308,3 +310,120 @@ FieldHandle SCIRun::TestUtils::CreateEmptyLatVol(size_type sizex, size_type size
   return ofh;
 }
 
+
+FieldHandle SCIRun::TestUtils::CreateTetVolCubeGrid(size_type n, databasis_info_type basis, data_info_type type,
+  const std::function<Point(int, int, int)>& position)
+{
+  FieldInformation fi(TETVOLMESH_E, basis, type);
+  FieldHandle field = CreateField(fi);
+  VMesh* vmesh = field->vmesh();
+
+  for (int k = 0; k <= n; k++)
+    for (int j = 0; j <= n; j++)
+      for (int i = 0; i <= n; i++)
+        vmesh->add_point(position ? position(i, j, k) : Point(i, j, k));
+
+  auto node = [n](int i, int j, int k) { return VMesh::index_type((k*(n + 1) + j)*(n + 1) + i); };
+  const int split[6][4] = { {0,1,2,6}, {0,2,3,6}, {0,3,7,6}, {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+  VMesh::Node::array_type nodes(4);
+  for (int k = 0; k < n; k++)
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < n; i++)
+      {
+        const VMesh::index_type corner[8] = { node(i,j,k), node(i+1,j,k), node(i+1,j+1,k), node(i,j+1,k),
+          node(i,j,k+1), node(i+1,j,k+1), node(i+1,j+1,k+1), node(i,j+1,k+1) };
+        for (int t = 0; t < 6; t++)
+        {
+          for (int q = 0; q < 4; q++)
+            nodes[q] = corner[split[t][q]];
+          vmesh->add_elem(nodes);
+        }
+      }
+
+  field->vfield()->resize_values();
+  field->vfield()->clear_all_values();
+  return field;
+}
+
+void SCIRun::TestUtils::AddTriSurfSphere(VMesh* vmesh, int rings, int sectors,
+  const std::function<double(double, double)>& radius, bool flipped)
+{
+  const VMesh::index_type north = vmesh->num_nodes();
+  vmesh->add_point(Point(0.0, 0.0, radius(0.0, 0.0)));
+  for (int r = 1; r < rings; r++)
+  {
+    const double theta = M_PI * r / rings;
+    for (int s = 0; s < sectors; s++)
+    {
+      const double phi = 2.0 * M_PI * s / sectors;
+      const double rad = radius(theta, phi);
+      vmesh->add_point(Point(rad*std::sin(theta)*std::cos(phi), rad*std::sin(theta)*std::sin(phi), rad*std::cos(theta)));
+    }
+  }
+  vmesh->add_point(Point(0.0, 0.0, -radius(M_PI, 0.0)));
+
+  auto node = [&](int r, int s) { return VMesh::index_type(north + 1 + (r - 1)*sectors + (s % sectors)); };
+  const VMesh::index_type south = north + 1 + (rings - 1)*sectors;
+  VMesh::Node::array_type nodes(3);
+  auto add = [&](VMesh::index_type a, VMesh::index_type b, VMesh::index_type c)
+  {
+    nodes[0] = a; nodes[1] = (flipped ? c : b); nodes[2] = (flipped ? b : c);
+    vmesh->add_elem(nodes);
+  };
+  for (int s = 0; s < sectors; s++)
+  {
+    add(north, node(1, s), node(1, s + 1));
+    for (int r = 1; r < rings - 1; r++)
+    {
+      add(node(r, s), node(r + 1, s), node(r + 1, s + 1));
+      add(node(r, s), node(r + 1, s + 1), node(r, s + 1));
+    }
+    add(node(rings - 1, s), south, node(rings - 1, s + 1));
+  }
+}
+
+
+FieldHandle SCIRun::TestUtils::CreateTriSurfSphere(int rings, int sectors, double radius, double noise)
+{
+  FieldInformation fi(TRISURFMESH_E, LINEARDATA_E, DOUBLE_E);
+  FieldHandle field = CreateField(fi);
+  AddTriSurfSphere(field->vmesh(), rings, sectors, [=](double theta, double phi)
+  {
+    // The noise is a function of the ring and sector indices of the node.
+    const double r = theta * rings / M_PI, s = phi * sectors / (2.0 * M_PI);
+    return radius * (1.0 + noise * std::sin(12.9898*r + 78.233*s));
+  });
+  field->vfield()->resize_values();
+  return field;
+}
+
+
+void SCIRun::TestUtils::ExpectIdenticalFields(FieldHandle expected, FieldHandle actual)
+{
+  VMesh* me = expected->vmesh();
+  VMesh* ma = actual->vmesh();
+  ASSERT_EQ(me->num_nodes(), ma->num_nodes());
+  ASSERT_EQ(me->num_elems(), ma->num_elems());
+  ASSERT_EQ(expected->vfield()->num_values(), actual->vfield()->num_values());
+  for (VMesh::index_type i = 0; i < me->num_nodes(); i++)
+  {
+    Point pe, pa;
+    me->get_center(pe, VMesh::Node::index_type(i));
+    ma->get_center(pa, VMesh::Node::index_type(i));
+    EXPECT_EQ(pe, pa);
+  }
+  for (VMesh::index_type i = 0; i < expected->vfield()->num_values(); i++)
+  {
+    double ve, va;
+    expected->vfield()->get_value(ve, i);
+    actual->vfield()->get_value(va, i);
+    EXPECT_EQ(ve, va);
+  }
+  VMesh::Node::array_type ne, na;
+  for (VMesh::index_type e = 0; e < me->num_elems(); e++)
+  {
+    me->get_nodes(ne, VMesh::Elem::index_type(e));
+    ma->get_nodes(na, VMesh::Elem::index_type(e));
+    EXPECT_EQ(ne, na);
+  }
+}
@@ -31,6 +31,7 @@
 
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/GeometryPrimitives/Point.h>
+#include <functional>
 
 #include <Testing/Utils/share.h>
 
@@ -95,6 +96,26 @@ SCISHARE FieldHandle CreateEmptyLatVol(size_type sizex, size_type sizey, size_ty
   data_info_type type = DOUBLE_E,
   const Core::Geometry::Point& minb = { -1, -1, -1 }, const Core::Geometry::Point& maxb = {1,1,1});
 
+/// An n^3 grid of unit cubes, each split into six tets around its main diagonal. Element
+/// 6*((k*n + j)*n + i) + t is tet t of cube (i,j,k). Node (i,j,k) is placed at position(i,j,k),
+/// or at Point(i,j,k) without one. Values are allocated and zero.
+SCISHARE FieldHandle CreateTetVolCubeGrid(size_type n, databasis_info_type basis, data_info_type type,
+  const std::function<Core::Geometry::Point(int, int, int)>& position = nullptr);
+
+/// Adds a closed triangulated surface around the origin to vmesh, cut into rings and sectors
+/// with one node at each pole. radius(theta, phi) gives the distance of each node from the
+/// origin. The normals point outward, or inward if flipped.
+SCISHARE void AddTriSurfSphere(VMesh* vmesh, int rings, int sectors,
+  const std::function<double(double, double)>& radius, bool flipped = false);
+
+/// A sphere as above in a new linear TriSurf field. noise > 0 moves every node in or out by up
+/// to that fraction of the radius, in a fixed pseudo-random pattern. Values are allocated.
+SCISHARE FieldHandle CreateTriSurfSphere(int rings, int sectors, double radius = 1.0, double noise = 0.0);
+
+/// Expects the same nodes, elements and double values in the same order, for checking that
+/// a result does not depend on how the work was split.
+SCISHARE void ExpectIdenticalFields(FieldHandle expected, FieldHandle actual);
+
 }}
 
 #endif
@@ -27,8 +27,10 @@
 */
 
 #include <Testing/Utils/SCIRunUnitTests.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun::TestUtils;
+using namespace SCIRun::Core::Thread;
 
 boost::filesystem::path TestResources::rootDir()
 {
@@ -39,3 +41,13 @@ boost::filesystem::path TestResources::rootDir()
 #endif
 }
 
+
+ScopedMaximumCores::ScopedMaximumCores(unsigned int max) : previous_(Parallel::MaximumCores())
+{
+  Parallel::SetMaximumCores(max);
+}
+
+ScopedMaximumCores::~ScopedMaximumCores()
+{
+  Parallel::SetMaximumCores(previous_);
+}
@@ -33,6 +33,8 @@
 #include <gmock/gmock.h>
 #include <boost/filesystem.hpp>
 #include <sci_debug.h>
+#include <boost/noncopyable.hpp>
+#include <utility>
 #include <Testing/Utils/share.h>
 
 namespace SCIRun 
@@ -45,6 +47,34 @@ namespace TestUtils
   {
     static boost::filesystem::path rootDir();
   };
+
+  /// Caps the cores used by Core::Thread::Parallel while it is alive (0 lifts the cap).
+  /// The previous cap is restored on destruction, also when a test fails or throws.
+  class SCISHARE ScopedMaximumCores : boost::noncopyable
+  {
+  public:
+    explicit ScopedMaximumCores(unsigned int max);
+    ~ScopedMaximumCores();
+  private:
+    unsigned int previous_;
+  };
+
+  /// Runs compute once on a single core and once on all cores, for algorithms whose
+  /// split of the work depends on the core count; the two results should be identical.
+  template <class Compute>
+  auto runOnOneAndAllCores(Compute compute) -> std::pair<decltype(compute()), decltype(compute())>
+  {
+    decltype(compute()) serial, parallel;
+    {
+      ScopedMaximumCores one(1);
+      serial = compute();
+    }
+    {
+      ScopedMaximumCores all(0);
+      parallel = compute();
+    }
+    return std::make_pair(serial, parallel);
+  }
   
 }
 